@@ -0,0 +1,190 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "lz4.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+constexpr int MIN_MATCH = 4;
+constexpr int LAST_LITERALS = 5;    // 块的最后5个字节必须是字面量
+constexpr int MF_LIMIT = 12;        // 最后一个匹配必须在块结束前12个字节之前开始
+constexpr int MAX_DISTANCE = 65535;
+constexpr int HASH_LOG = 12;
+constexpr int RUN_MASK = 15;        // token中长度字段的最大值，更长的长度用后续字节表示
+
+inline uint32_t read32(const uint8_t *p) {
+    uint32_t val;
+    memcpy(&val, p, sizeof(val));
+    return val;
+}
+
+inline uint32_t hash_sequence(uint32_t sequence) { return (sequence * 2654435761u) >> (32 - HASH_LOG); }
+
+// 输出长度字段中超过RUN_MASK的部分：每个字节255，最后一个字节小于255
+inline uint8_t *write_length(uint8_t *op, size_t len) {
+    for (; len >= 255; len -= 255) {
+        *op++ = 255;
+    }
+    *op++ = static_cast<uint8_t>(len);
+    return op;
+}
+
+// 输出一个序列所需的最大空间：token、字面量长度、字面量、偏移和匹配长度
+inline size_t sequence_bound(size_t literal_len, size_t match_len) {
+    return 1 + literal_len / 255 + 1 + literal_len + 2 + match_len / 255 + 1;
+}
+
+// 读取长度字段中超过RUN_MASK的部分，输入不完整时返回false
+inline bool read_length(const uint8_t *&ip, const uint8_t *iend, size_t &len) {
+    uint8_t b;
+    do {
+        if (ip >= iend) {
+            return false;
+        }
+        b = *ip++;
+        len += b;
+    } while (b == 255);
+    return true;
+}
+
+}  // namespace
+
+int LZ4_compressBound(int input_size) { return input_size + input_size / 255 + 16; }
+
+int LZ4_compress_default(const char *src, char *dst, int src_size, int dst_capacity) {
+    const uint8_t *base = reinterpret_cast<const uint8_t *>(src);
+    const uint8_t *ip = base;
+    const uint8_t *anchor = base;
+    const uint8_t *iend = base + src_size;
+    uint8_t *op = reinterpret_cast<uint8_t *>(dst);
+    uint8_t *oend = op + dst_capacity;
+
+    if (src_size > MF_LIMIT) {
+        const uint8_t *mflimit = iend - MF_LIMIT;
+        const uint8_t *matchlimit = iend - LAST_LITERALS;
+        // 哈希表记录每个4字节序列最近一次出现的位置
+        uint32_t table[1 << HASH_LOG] = {};
+        ip++;
+        while (ip < mflimit) {
+            uint32_t sequence = read32(ip);
+            uint32_t h = hash_sequence(sequence);
+            const uint8_t *ref = base + table[h];
+            table[h] = static_cast<uint32_t>(ip - base);
+            if (ref >= ip || ip - ref > MAX_DISTANCE || read32(ref) != sequence) {
+                // 连续找不到匹配时加大步长，不可压缩的数据很快扫描完
+                ip += 1 + ((ip - anchor) >> 6);
+                continue;
+            }
+            // 向前扩展匹配
+            while (ip > anchor && ref > base && ip[-1] == ref[-1]) {
+                ip--;
+                ref--;
+            }
+            const uint8_t *match_end = ip + MIN_MATCH;
+            const uint8_t *ref_end = ref + MIN_MATCH;
+            while (match_end < matchlimit && *match_end == *ref_end) {
+                match_end++;
+                ref_end++;
+            }
+
+            size_t literal_len = ip - anchor;
+            size_t match_len = match_end - ip - MIN_MATCH;
+            if (sequence_bound(literal_len, match_len) > static_cast<size_t>(oend - op)) {
+                return 0;
+            }
+            uint8_t *token = op++;
+            *token = static_cast<uint8_t>((literal_len >= RUN_MASK ? RUN_MASK : literal_len) << 4);
+            if (literal_len >= RUN_MASK) {
+                op = write_length(op, literal_len - RUN_MASK);
+            }
+            memcpy(op, anchor, literal_len);
+            op += literal_len;
+            uint16_t offset = static_cast<uint16_t>(ip - ref);
+            *op++ = static_cast<uint8_t>(offset & 0xff);
+            *op++ = static_cast<uint8_t>(offset >> 8);
+            *token |= static_cast<uint8_t>(match_len >= RUN_MASK ? RUN_MASK : match_len);
+            if (match_len >= RUN_MASK) {
+                op = write_length(op, match_len - RUN_MASK);
+            }
+            ip = match_end;
+            anchor = ip;
+        }
+    }
+
+    // 最后一个序列只有字面量
+    size_t literal_len = iend - anchor;
+    if (1 + literal_len / 255 + 1 + literal_len > static_cast<size_t>(oend - op)) {
+        return 0;
+    }
+    *op++ = static_cast<uint8_t>((literal_len >= RUN_MASK ? RUN_MASK : literal_len) << 4);
+    if (literal_len >= RUN_MASK) {
+        op = write_length(op, literal_len - RUN_MASK);
+    }
+    memcpy(op, anchor, literal_len);
+    op += literal_len;
+    return static_cast<int>(op - reinterpret_cast<uint8_t *>(dst));
+}
+
+int LZ4_decompress_safe(const char *src, char *dst, int compressed_size, int dst_capacity) {
+    const uint8_t *ip = reinterpret_cast<const uint8_t *>(src);
+    const uint8_t *iend = ip + compressed_size;
+    uint8_t *ostart = reinterpret_cast<uint8_t *>(dst);
+    uint8_t *op = ostart;
+    uint8_t *oend = op + dst_capacity;
+
+    while (ip < iend) {
+        uint8_t token = *ip++;
+        size_t literal_len = token >> 4;
+        if (literal_len == RUN_MASK && !read_length(ip, iend, literal_len)) {
+            return -1;
+        }
+        if (literal_len > static_cast<size_t>(iend - ip) || literal_len > static_cast<size_t>(oend - op)) {
+            return -1;
+        }
+        memcpy(op, ip, literal_len);
+        op += literal_len;
+        ip += literal_len;
+        if (ip == iend) {
+            break;
+        }
+
+        if (iend - ip < 2) {
+            return -1;
+        }
+        size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - ostart)) {
+            return -1;
+        }
+        size_t match_len = token & RUN_MASK;
+        if (match_len == RUN_MASK && !read_length(ip, iend, match_len)) {
+            return -1;
+        }
+        match_len += MIN_MATCH;
+        if (match_len > static_cast<size_t>(oend - op)) {
+            return -1;
+        }
+        const uint8_t *ref = op - offset;
+        if (offset >= match_len) {
+            memcpy(op, ref, match_len);
+            op += match_len;
+        } else {
+            // 匹配与输出重叠，逐字节复制以重复前面的内容
+            for (size_t i = 0; i < match_len; i++) {
+                *op++ = ref[i];
+            }
+        }
+    }
+    return static_cast<int>(op - ostart);
+}
@@ -0,0 +1,38 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+/* LZ4块格式（https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md）的精简实现，
+ * 只包含单个数据块的压缩和解压，不包含帧格式。函数名和语义与liblz4相同，压缩结果可以用liblz4解压，
+ * 需要时可以直接换成上游的实现 */
+
+// 输入长度为input_size时，压缩结果的最大长度
+int LZ4_compressBound(int input_size);
+
+/**
+ * @description: 压缩一个数据块
+ * @param {char*} src 输入数据
+ * @param {char*} dst 输出缓冲区
+ * @param {int} src_size 输入长度
+ * @param {int} dst_capacity 输出缓冲区长度，不小于LZ4_compressBound(src_size)时一定能压缩成功
+ * @return {int} 压缩后的长度，输出缓冲区放不下时返回0
+ */
+int LZ4_compress_default(const char *src, char *dst, int src_size, int dst_capacity);
+
+/**
+ * @description: 解压一个数据块，输入损坏时不会越界读写
+ * @param {char*} src 压缩数据
+ * @param {char*} dst 输出缓冲区
+ * @param {int} compressed_size 压缩数据的长度
+ * @param {int} dst_capacity 输出缓冲区长度
+ * @return {int} 解压后的长度，输入损坏或输出缓冲区放不下时返回负数
+ */
+int LZ4_decompress_safe(const char *src, char *dst, int compressed_size, int dst_capacity);
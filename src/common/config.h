@@ -35,6 +35,15 @@ static constexpr int HEADER_PAGE_ID = 0;                                      //
 static constexpr int PAGE_SIZE = 4096;                                        // size of a data page in byte  4KB
 static constexpr int BUFFER_POOL_SIZE = 65536;                                // size of buffer pool 256MB
 // static constexpr int BUFFER_POOL_SIZE = 262144;                                // size of buffer pool 1GB
+static constexpr int CACHE_LINE_SIZE = 64;                                    // size of a cpu cache line
+static constexpr int BUFFER_POOL_INSTANCES = 16;                              // number of buffer pool shards
+static constexpr int BUFFER_POOL_MIN_INSTANCE_SIZE = 1024;                    // min frames per buffer pool shard
+static constexpr int IO_URING_QUEUE_DEPTH = 256;                              // max in-flight requests of io_uring
+static constexpr int READ_AHEAD_MIN_PAGES = 4;                                // initial read-ahead window of a sequential scan
+static constexpr int READ_AHEAD_MAX_PAGES = 64;                               // max read-ahead window of a sequential scan
+static constexpr int BACKGROUND_WRITER_INTERVAL_MS = 100;                     // interval between two rounds of the background writer
+static constexpr int BACKGROUND_WRITER_CLEAN_PERCENT = 10;                    // clean evictable frames kept per buffer pool shard
+static constexpr int COMPRESSED_SECTOR_SIZE = 512;                            // allocation unit of a page in a compressed data file
 static constexpr int LOG_BUFFER_SIZE = (1024 * PAGE_SIZE);                    // size of a log buffer in byte
 static constexpr int BUCKET_SIZE = 50;                                        // size of extendible hash bucket
 
@@ -49,7 +58,17 @@ using timestamp_t = int32_t;  // timestamp type, used for transaction concurrenc
 // log file
 static const std::string LOG_FILE_NAME = "db.log";
 
-// replacer
+// page map of a compressed data file, stored next to the data file
+static const std::string COMPRESSED_MAP_SUFFIX = ".pmap";
+
+// per-page min/max of a table's numeric columns, stored next to the data file
+static const std::string ZONE_MAP_SUFFIX = ".zmap";
+
+// replacer: "LRU", "LRU_K", "2Q" or "CLOCK"
 static const std::string REPLACER_TYPE = "LRU";
+static constexpr int LRU_K = 2;                                 // LRU-K中保留的访问历史个数
+static constexpr int LRU_K_CORRELATED_PERIOD = 4;               // 间隔不超过该访问次数的相关访问只算一次
+static constexpr int TWO_Q_A1IN_PERCENT = 25;                   // 2Q中A1in队列占缓冲池的百分比
+static constexpr int TWO_Q_A1OUT_PERCENT = 50;                  // 2Q中A1out幽灵队列记录的页面数占缓冲池的百分比
 
 static const std::string DB_META_NAME = "db.meta";
@@ -155,6 +155,12 @@ class StringOverflowError : public RMDBError {
     StringOverflowError() : RMDBError("String is too long") {}
 };
 
+class InvalidTableOptionError : public RMDBError {
+   public:
+    InvalidTableOptionError(const std::string &key, const std::string &value)
+        : RMDBError("Invalid table option: " + key + " = " + value) {}
+};
+
 class IncompatibleTypeError : public RMDBError {
    public:
     IncompatibleTypeError(const std::string &lhs, const std::string &rhs)
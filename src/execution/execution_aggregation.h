@@ -46,6 +46,10 @@ private:
     std::map<Key, std::vector<Rid>>::iterator iter;   // group by的后分好的rid的map的迭代器
     std::unique_ptr<RmRecord> rm_record;    // 存储RmRecord的指针
     int r_r_size;                           // 存储RmRecord的大小
+    RmRecordView view_;                     // 读取分组中记录时使用的记录视图，固定当前读取的页面
+    RmColumnVector column_;                 // view_固定的页面中正在读取的字段的列向量
+    int column_page_no_ = RM_NO_PAGE;       // column_所在的页面
+    int column_offset_ = -1;                // column_对应的字段在记录中的偏移量
 
 public:
     AggregationExecutor(SmManager *sm_manager_, const std::string &tab_name_, std::vector<Condition> conds_,
@@ -74,6 +78,7 @@ public:
                 offset_all += col_meta_.len;
             }
         }
+        r_r_size = offset_all;
         is_end_ = false;
     }
 
@@ -96,23 +101,21 @@ public:
             }
 
             for (const auto &rid: rids) {
-                auto rec = fh->get_record(rid, context_);
                 std::vector<Value> value_list;
                 for (unsigned int i = 0; i < n; ++i) {
                     auto col_meta = colMetes[i];
-                    int offset = col_meta.offset;
                     int len = col_meta.len;
-                    char *data = rec->data + offset;
+                    const char *data = fetch_value(rid, col_meta);
                     Value value;
                     switch (col_meta.type) {
                         case TYPE_INT: {
-                            int int_value = *reinterpret_cast<int *>(data);
+                            int int_value = *reinterpret_cast<const int *>(data);
                             value.set_int(int_value);
                             value.init_raw(sizeof(int));
                             break;
                         }
                         case TYPE_FLOAT: {
-                            float float_value = *reinterpret_cast<float *>(data);
+                            float float_value = *reinterpret_cast<const float *>(data);
                             value.set_float(float_value);
                             value.init_raw(sizeof(float));
                             break;
@@ -187,6 +190,7 @@ public:
                 group_by_map_t[key].push_back(rid);
             }
         }
+        release_view();
         this->group_by_map = group_by_map_t;
         iter = this->group_by_map.begin();
 
@@ -246,7 +250,47 @@ public:
             return;
         }
         rm_record = std::make_unique<RmRecord>(r_r_size);
-        std::vector<Rid> rids = iter->second;
+        build_group_record(iter->second, rm_record->data);
+        ++iter;
+    }
+
+    size_t tupleLen() const override { return r_r_size; }
+
+    void beginBatch() override {
+        beginTuple();
+    }
+
+    // 分组在beginTuple中已经全部完成，每次把至多一批分组的聚合结果直接写入batch
+    bool nextBatch(RecordBatch &batch) override {
+        batch.reset(r_r_size);
+        if (is_end_) {
+            return false;
+        }
+        // beginTuple已经生成的第一条结果
+        if (rm_record != nullptr) {
+            batch.append_row(rm_record->data);
+            rm_record.reset();
+        }
+        for (; iter != group_by_map.end() && !batch.is_full(); ++iter) {
+            build_group_record(iter->second, batch.append_row());
+        }
+        if (iter == group_by_map.end()) {
+            is_end_ = true;
+        }
+        return !batch.empty();
+    }
+
+    bool is_end() const override {
+        return is_end_;
+    }
+
+    const std::vector<ColMeta> &cols() const override {
+        return outputColumnMetas;
+    }
+
+private:
+    // 计算一个分组的所有聚合值，写入data指向的结果记录
+    void build_group_record(const std::vector<Rid> &rids, char *data) {
         int rm_offset = 0;
 
         for (const auto &aggregateMeta: aggregateMetas) {
@@ -270,26 +314,24 @@ public:
                     break;
                 }
                 case AG_NULL: {
-                    auto rec = fh->get_record(rids[0], context_);
                     auto col_meta = tableMeta.get_col(aggregateMeta.table_column.col_name);
-                    int offset = col_meta->offset;
                     int len = col_meta->len;
-                    char *data = rec->data + offset;
+                    const char *col_data = fetch_value(rids[0], *col_meta);
                     switch (col_meta->type) {
                         case TYPE_INT: {
-                            int int_value = *reinterpret_cast<int *>(data);
+                            int int_value = *reinterpret_cast<const int *>(col_data);
                             val.set_int(int_value);
                             val.init_raw(sizeof(int));
                             break;
                         }
                         case TYPE_FLOAT: {
-                            float float_value = *reinterpret_cast<float *>(data);
+                            float float_value = *reinterpret_cast<const float *>(col_data);
                             val.set_float(float_value);
                             val.init_raw(sizeof(float));
                             break;
                         }
                         case TYPE_STRING: {
-                            std::string str_value(data, len);
+                            std::string str_value(col_data, len);
                             val.set_str(str_value);
                             val.init_raw(sizeof(str_value));
                             break;
@@ -305,29 +347,42 @@ public:
                 }
             }
             if (aggregateMeta.op == AG_COUNT) {
-                memcpy(rm_record->data + rm_offset, val.raw->data, sizeof(int));
+                memcpy(data + rm_offset, val.raw->data, sizeof(int));
                 rm_offset += sizeof(int);
             } else {
                 auto col_meta = tableMeta.get_col(aggregateMeta.table_column.col_name);
-                memcpy(rm_record->data + rm_offset, val.raw->data, col_meta->len);
+                memcpy(data + rm_offset, val.raw->data, col_meta->len);
                 rm_offset += col_meta->len;
             }
         }
-        ++iter;
+        release_view();
     }
 
-    bool is_end() const override {
-        return is_end_;
+    // 读取rid对应记录中col_meta字段的值，返回的数据在下一次调用前有效。
+    // 定长和列存格式的表按页面取出该字段的列向量后直接读取，列存格式只访问该字段的minipage，不需要拼出整条记录
+    const char *fetch_value(const Rid &rid, const ColMeta &col_meta) {
+        if (rid.page_no != column_page_no_ || col_meta.offset != column_offset_) {
+            column_ = fh->get_column_vector(rid.page_no, col_meta.offset, view_);
+            column_page_no_ = rid.page_no;
+            column_offset_ = col_meta.offset;
+        }
+        if (column_.base == nullptr) {
+            // 分槽页中的记录需要解码后读取
+            fh->get_record_view(rid, view_);
+            column_page_no_ = RM_NO_PAGE;
+            return view_.data() + col_meta.offset;
+        }
+        return column_.at(rid.slot_no);
     }
 
-    const std::vector<ColMeta> &cols() const override {
-        return outputColumnMetas;
+    // 释放记录视图固定的页面，缓存的列向量随之失效
+    void release_view() {
+        view_.release();
+        column_page_no_ = RM_NO_PAGE;
     }
 
-private:
     Value getMaxValue(const std::vector<Rid> &rids, const TabCol &tab_col) {
         auto col_meta = tableMeta.get_col(tab_col.col_name);
-        int offset = col_meta->offset;
         int len = col_meta->len;
         Value val;
 
@@ -339,8 +394,7 @@ private:
             case TYPE_INT: {
                 int max_value = INT_MIN;
                 for (const auto &rid: rids) {
-                    auto rec = fh->get_record(rid, context_);
-                    int value = *reinterpret_cast<int *>(rec->data + offset);
+                    int value = *reinterpret_cast<const int *>(fetch_value(rid, *col_meta));
                     max_value = std::max(max_value, value);
                 }
                 val.set_int(max_value);
@@ -350,8 +404,7 @@ private:
             case TYPE_FLOAT: {
                 float max_value = -FLT_MAX;
                 for (const auto &rid: rids) {
-                    auto rec = fh->get_record(rid, context_);
-                    float value = *reinterpret_cast<float *>(rec->data + offset);
+                    float value = *reinterpret_cast<const float *>(fetch_value(rid, *col_meta));
                     max_value = std::max(max_value, value);
                 }
                 val.set_float(max_value);
@@ -359,11 +412,9 @@ private:
                 break;
             }
             case TYPE_STRING: {
-                auto rec = fh->get_record(rids.front(), context_);
-                std::string max_value(rec->data + offset, len);
+                std::string max_value(fetch_value(rids.front(), *col_meta), len);
                 for (const auto &rid: rids) {
-                    auto rec = fh->get_record(rid, context_);
-                    std::string value(rec->data + offset, len);
+                    std::string value(fetch_value(rid, *col_meta), len);
                     if (value > max_value) {
                         max_value = value;
                     }
@@ -381,7 +432,6 @@ private:
 
     Value getMinValue(const std::vector<Rid> &rids, const TabCol &tab_col) {
         auto col_meta = tableMeta.get_col(tab_col.col_name);
-        int offset = col_meta->offset;
         int len = col_meta->len;
         Value val;
 
@@ -393,8 +443,7 @@ private:
             case TYPE_INT: {
                 int min_value = INT_MAX;
                 for (const auto &rid: rids) {
-                    auto rec = fh->get_record(rid, context_);
-                    int value = *reinterpret_cast<int *>(rec->data + offset);
+                    int value = *reinterpret_cast<const int *>(fetch_value(rid, *col_meta));
                     if (value < min_value) {
                         min_value = value;
                     }
@@ -406,8 +455,7 @@ private:
             case TYPE_FLOAT: {
                 float min_value = FLT_MAX;
                 for (const auto &rid: rids) {
-                    auto rec = fh->get_record(rid, context_);
-                    float value = *reinterpret_cast<float *>(rec->data + offset);
+                    float value = *reinterpret_cast<const float *>(fetch_value(rid, *col_meta));
                     min_value = std::min(min_value, value);
                 }
                 val.set_float(min_value);
@@ -415,11 +463,9 @@ private:
                 break;
             }
             case TYPE_STRING: {
-                auto rec = fh->get_record(rids.front(), context_);
-                std::string min_value(rec->data + offset, len);
+                std::string min_value(fetch_value(rids.front(), *col_meta), len);
                 for (const auto &rid: rids) {
-                    auto rec = fh->get_record(rid, context_);
-                    std::string value(rec->data + offset, len);
+                    std::string value(fetch_value(rid, *col_meta), len);
                     min_value = std::min(min_value, value);
                 }
                 val.set_str(min_value);
@@ -435,7 +481,6 @@ private:
 
     Value getSumValue(const std::vector<Rid> &rids, const TabCol &tab_col) {
         auto col_meta = tableMeta.get_col(tab_col.col_name);
-        int offset = col_meta->offset;
         Value val;
         double sum_value = 0.0;
 
@@ -446,8 +491,7 @@ private:
         switch (col_meta->type) {
             case TYPE_INT: {
                 for (const auto &rid: rids) {
-                    auto rec = fh->get_record(rid, context_);
-                    int value = *reinterpret_cast<int *>(rec->data + offset);
+                    int value = *reinterpret_cast<const int *>(fetch_value(rid, *col_meta));
                     if ((sum_value > 0 && value > 0 && sum_value > (std::numeric_limits<int>::max() - value)) ||
                         (sum_value < 0 && value < 0 && sum_value < (std::numeric_limits<int>::min() - value))) {
                         throw RMDBError("Sum value overflow/underflow");
@@ -460,8 +504,7 @@ private:
             }
             case TYPE_FLOAT: {
                 for (const auto &rid: rids) {
-                    auto rec = fh->get_record(rid, context_);
-                    float value = *reinterpret_cast<float *>(rec->data + offset);
+                    float value = *reinterpret_cast<const float *>(fetch_value(rid, *col_meta));
                     if ((sum_value > 0 && value > 0 && sum_value > (std::numeric_limits<float>::max() - value)) ||
                         (sum_value < 0 && value < 0 && sum_value < (std::numeric_limits<float>::min() - value))) {
                         throw RMDBError("Sum value overflow/underflow");
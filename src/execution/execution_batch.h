@@ -0,0 +1,99 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "record/rm_defs.h"
+
+// 执行器之间批量传递记录时，每一批最多包含的记录条数
+static constexpr size_t RECORD_BATCH_SIZE = 1024;
+
+/* 执行器之间批量传递的一组定长记录。记录按行连续存放在一块缓冲区中，
+ * 选择向量记录缓冲区中仍然有效的行，过滤时只修改选择向量而不移动记录 */
+class RecordBatch {
+private:
+    size_t tuple_len_ = 0;                  // 每条记录的长度
+    size_t capacity_ = 0;                   // 缓冲区最多容纳的记录条数
+    size_t num_rows_ = 0;                   // 缓冲区中已经写入的记录条数
+    std::vector<char> data_;                // 记录缓冲区
+    std::vector<uint32_t> sel_;             // 选择向量，保存有效行在缓冲区中的行号
+    bool use_sel_ = false;                  // 为false时缓冲区中所有行都有效
+
+public:
+    RecordBatch() = default;
+
+    explicit RecordBatch(size_t tuple_len, size_t capacity = RECORD_BATCH_SIZE) { reset(tuple_len, capacity); }
+
+    // 清空批次，并按新的记录长度准备缓冲区
+    void reset(size_t tuple_len, size_t capacity = RECORD_BATCH_SIZE) {
+        tuple_len_ = tuple_len;
+        capacity_ = capacity;
+        if (data_.size() < tuple_len * capacity) {
+            data_.resize(tuple_len * capacity);
+        }
+        clear();
+    }
+
+    void clear() {
+        num_rows_ = 0;
+        use_sel_ = false;
+        sel_.clear();
+    }
+
+    size_t tuple_len() const { return tuple_len_; }
+
+    size_t num_rows() const { return num_rows_; }
+
+    bool is_full() const { return num_rows_ == capacity_; }
+
+    // 有效记录的条数
+    size_t size() const { return use_sel_ ? sel_.size() : num_rows_; }
+
+    bool empty() const { return size() == 0; }
+
+    // 在缓冲区末尾追加一行，返回写入位置
+    char *append_row() { return data_.data() + (num_rows_++) * tuple_len_; }
+
+    void append_row(const char *data) { memcpy(append_row(), data, tuple_len_); }
+
+    // 第i条有效记录
+    const char *row(size_t i) const { return raw_row(use_sel_ ? sel_[i] : i); }
+
+    // 缓冲区中第row_no行，不考虑选择向量
+    const char *raw_row(size_t row_no) const { return data_.data() + row_no * tuple_len_; }
+
+    // 按条件过滤有效记录，pred的参数为记录数据
+    template <typename Pred>
+    void filter(Pred &&pred) {
+        if (!use_sel_) {
+            sel_.resize(num_rows_);
+            std::iota(sel_.begin(), sel_.end(), 0);
+            use_sel_ = true;
+        }
+        size_t num_sel = 0;
+        for (uint32_t row_no : sel_) {
+            if (pred(raw_row(row_no))) {
+                sel_[num_sel++] = row_no;
+            }
+        }
+        sel_.resize(num_sel);
+    }
+
+    // 复制出第i条有效记录
+    std::unique_ptr<RmRecord> to_record(size_t i) const {
+        return std::make_unique<RmRecord>(static_cast<int>(tuple_len_), const_cast<char *>(row(i)));
+    }
+};
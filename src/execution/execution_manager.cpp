@@ -24,6 +24,7 @@ const char *help_info = "Supported SQL syntax:\n"
                         "  DELETE FROM table_name [WHERE where_clause]\n"
                         "  UPDATE table_name SET column_name = value [, column_name = value ...] [WHERE where_clause]\n"
                         "  SELECT selector FROM table_name [WHERE where_clause]\n"
+                        "  VACUUM [table_name]\n"
                         "type:\n"
                         "  {INT | FLOAT | CHAR(n)}\n"
                         "where_clause:\n"
@@ -42,7 +43,7 @@ void QlManager::run_multi_query(std::shared_ptr<Plan> plan, Context *context) {
     if (auto x = std::dynamic_pointer_cast<DDLPlan>(plan)) {
         switch (x->tag) {
             case T_CreateTable: {
-                sm_manager_->create_table(x->tab_name_, x->cols_, context);
+                sm_manager_->create_table(x->tab_name_, x->cols_, context, x->options_);
                 break;
             }
             case T_DropTable: {
@@ -110,6 +111,10 @@ void QlManager::run_cmd_utility(std::shared_ptr<Plan> plan, txn_id_t *txn_id, Co
                 context->log_mgr_->static_checkpoint();
                 break;
             }
+            case T_Vacuum: {
+                sm_manager_->vacuum(x->tab_name_, context);
+                break;
+            }
             default:
                 throw InternalError("Unexpected field type");
         }
@@ -165,47 +170,47 @@ void QlManager::select_from(std::unique_ptr<AbstractExecutor> executorTreeRoot,
 
     // Print records
     size_t num_rec = 0;
-    // 执行query_plan
-    for (executorTreeRoot->beginTuple(); !executorTreeRoot->is_end(); executorTreeRoot->nextTuple()) {
-//        if (num_rec == 0) {
-//            std::this_thread::sleep_for(std::chrono::seconds(100));
-//        }
-        auto Tuple = executorTreeRoot->Next();
-        std::vector<std::string> columns;
-        for (auto &col: executorTreeRoot->cols()) {
-            std::string col_str;
-            char *rec_buf = Tuple->data + col.offset;
-            switch (col.type) {
-                case TYPE_INT: {
-                    col_str = std::to_string(*(int *) rec_buf);
-                    break;
-                }
-                case TYPE_FLOAT: {
-                    col_str = std::to_string(*(float *) rec_buf);
-                    break;
-                }
-                case TYPE_STRING: {
-                    col_str = std::string((char *) rec_buf, col.len);
-                    col_str.resize(strlen(col_str.c_str()));
-                    break;
-                }
-                default: {
-                    throw InvalidTypeError();
+    // 执行query_plan，每次从算子树取出一批记录
+    RecordBatch batch;
+    for (executorTreeRoot->beginBatch(); executorTreeRoot->nextBatch(batch);) {
+        for (size_t row = 0; row < batch.size(); row++) {
+            const char *Tuple = batch.row(row);
+            std::vector<std::string> columns;
+            for (auto &col: executorTreeRoot->cols()) {
+                std::string col_str;
+                const char *rec_buf = Tuple + col.offset;
+                switch (col.type) {
+                    case TYPE_INT: {
+                        col_str = std::to_string(*(const int *) rec_buf);
+                        break;
+                    }
+                    case TYPE_FLOAT: {
+                        col_str = std::to_string(*(const float *) rec_buf);
+                        break;
+                    }
+                    case TYPE_STRING: {
+                        col_str = std::string(rec_buf, col.len);
+                        col_str.resize(strlen(col_str.c_str()));
+                        break;
+                    }
+                    default: {
+                        throw InvalidTypeError();
+                    }
                 }
+                columns.push_back(col_str);
             }
-            columns.push_back(col_str);
-        }
-        // print record into buffer
-        rec_printer.print_record(columns, context);
-        // print record into file
-        outfile << "|";
-        for (const auto &column: columns) {
-            outfile << " " << column << " |";
+            // print record into buffer
+            rec_printer.print_record(columns, context);
+            // print record into file
+            outfile << "|";
+            for (const auto &column: columns) {
+                outfile << " " << column << " |";
+            }
+            outfile << "\n";
+            num_rec++;
         }
-        outfile << "\n";
-        outfile.flush();
-        num_rec++;
     }
+    outfile.flush();
     outfile.close();
     executorTreeRoot->end_work();
     // Print footer into buffer
@@ -225,41 +230,43 @@ void QlManager::run_dml(std::unique_ptr<AbstractExecutor> exec) {
 
 std::vector<Value> QlManager::sub_select_from(std::unique_ptr<AbstractExecutor> executorTreeRoot) {
     std::vector<Value> values;
-    for (executorTreeRoot->beginTuple(); !executorTreeRoot->is_end(); executorTreeRoot->nextTuple()) {
-        auto Tuple = executorTreeRoot->Next();
-        for (auto &col: executorTreeRoot->cols()) {
-            Value value;
+    RecordBatch batch;
+    for (executorTreeRoot->beginBatch(); executorTreeRoot->nextBatch(batch);) {
+        for (size_t row = 0; row < batch.size(); row++) {
+            const char *Tuple = batch.row(row);
+            for (auto &col: executorTreeRoot->cols()) {
+                Value value;
 
-            char *rec_buf = Tuple->data + col.offset;
-            switch (col.type) {
-                case TYPE_INT: {
-                    int int_value = *reinterpret_cast<int *>(rec_buf);
-                    value.set_int(int_value);
-                    value.init_raw(sizeof(int));
-                    break;
-                }
-                case TYPE_FLOAT: {
-                    float float_value = *reinterpret_cast<float *>(rec_buf);
-                    value.set_float(float_value);
-                    value.init_raw(sizeof(float));
-                    break;
-                }
-                case TYPE_STRING: {
-                    std::string col_str;
-                    col_str = std::string((char *) rec_buf, col.len);
-                    col_str.resize(strlen(col_str.c_str()));
-//                    std::string str_value(rec_buf, col.len);
-                    value.set_str(col_str);
-                    value.init_raw(sizeof(col_str));
-                    break;
-                }
-                default: {
-                    throw InvalidTypeError();
+                const char *rec_buf = Tuple + col.offset;
+                switch (col.type) {
+                    case TYPE_INT: {
+                        int int_value = *reinterpret_cast<const int *>(rec_buf);
+                        value.set_int(int_value);
+                        value.init_raw(sizeof(int));
+                        break;
+                    }
+                    case TYPE_FLOAT: {
+                        float float_value = *reinterpret_cast<const float *>(rec_buf);
+                        value.set_float(float_value);
+                        value.init_raw(sizeof(float));
+                        break;
+                    }
+                    case TYPE_STRING: {
+                        std::string col_str;
+                        col_str = std::string(rec_buf, col.len);
+                        col_str.resize(strlen(col_str.c_str()));
+//                        std::string str_value(rec_buf, col.len);
+                        value.set_str(col_str);
+                        value.init_raw(sizeof(col_str));
+                        break;
+                    }
+                    default: {
+                        throw InvalidTypeError();
+                    }
                 }
+                values.push_back(value);
             }
-            values.push_back(value);
         }
-
     }
     return values;
 }
\ No newline at end of file
@@ -88,7 +88,7 @@ public:
               tuple_num(0),
               cmp(std::make_shared<ColMeta>(col), is_desc_),
               cmp_wrapper([this](const RecordWithIndex& a, const RecordWithIndex& b) {
-                  return !cmp(a.first, b.first);
+                  return cmp(b.first, a.first);
               }),
               min_heap(cmp_wrapper),
               e_id(e_id_),
@@ -543,9 +543,8 @@ public:
         ++i_num;
         int size;
         if (merge_sort_file->read(reinterpret_cast<char*>(&size), sizeof(size))) {
-            char *data = new char[size];
-            merge_sort_file->read(data, size);
-            merge_tuple = std::make_unique<RmRecord>(size, data);
+            merge_tuple = std::make_unique<RmRecord>(size);
+            merge_sort_file->read(merge_tuple->data, size);
         } else {
             end = true;
         }
@@ -593,6 +592,31 @@ public:
 //        }
     }
 
+    void beginBatch() override {
+        beginTuple();
+    }
+
+    // 从排好序的结果文件中直接把记录读入batch
+    bool nextBatch(RecordBatch &batch) override {
+        batch.reset(len_);
+        if (end) {
+            return false;
+        }
+        // beginTuple已经读出的第一条记录
+        if (merge_tuple != nullptr) {
+            batch.append_row(merge_tuple->data);
+            merge_tuple.reset();
+        }
+        int size;
+        while (!batch.is_full() && merge_sort_file->read(reinterpret_cast<char*>(&size), sizeof(size))) {
+            merge_sort_file->read(batch.append_row(), size);
+        }
+        if (!batch.is_full()) {
+            end = true;
+        }
+        return !batch.empty();
+    }
+
     std::unique_ptr<RmRecord> Next() override {
         auto rm_rcd = std::make_unique<RmRecord>(*merge_tuple);
         return rm_rcd;
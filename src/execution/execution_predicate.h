@@ -0,0 +1,411 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "common/common.h"
+#include "errors.h"
+#include "execution_batch.h"
+#include "record/rm_slot_filter.h"
+#include "system/sm_meta.h"
+
+/* 编译后的单个扫描条件。
+ * 构造扫描算子时把Condition中的列名解析成偏移量，把常量转换成与列相同的编码，
+ * 并按照左右两侧的类型和比较运算符选出一个模板实例化的判断函数，逐行判断时不再查找列、构造Value */
+struct CompiledCondition {
+    using EvalFunc = bool (*)(const CompiledCondition &, const char *);
+
+    EvalFunc eval = nullptr;        // 判断函数
+    ColType lhs_type;
+    int lhs_offset = 0;
+    int lhs_len = 0;
+
+    ColType rhs_type;               // 右侧常量或列的类型
+    int rhs_offset = 0;             // 右侧为列时的偏移量和长度
+    int rhs_len = 0;
+
+    int int_val = 0;                // 右侧常量
+    float float_val = 0;
+    std::string str_val;
+
+    std::vector<int> in_ints;       // IN列表中的整数和浮点数，均已排序
+    std::vector<float> in_floats;
+    std::vector<std::string> in_strs;                   // IN列表中的字符串
+    std::unordered_set<std::string_view> in_str_set;    // 指向in_strs的哈希集合
+
+    bool has_slot_pred = false;     // 条件能否在页面级用SlotFilter判断
+    SlotPredicate slot_pred;
+
+    CompiledCondition() = default;
+
+    // in_str_set中保存的是指向in_strs的视图，复制时需要重新建立
+    CompiledCondition(const CompiledCondition &other) { *this = other; }
+
+    CompiledCondition &operator=(const CompiledCondition &other) {
+        if (this != &other) {
+            eval = other.eval;
+            lhs_type = other.lhs_type;
+            lhs_offset = other.lhs_offset;
+            lhs_len = other.lhs_len;
+            rhs_type = other.rhs_type;
+            rhs_offset = other.rhs_offset;
+            rhs_len = other.rhs_len;
+            int_val = other.int_val;
+            float_val = other.float_val;
+            str_val = other.str_val;
+            in_ints = other.in_ints;
+            in_floats = other.in_floats;
+            in_strs = other.in_strs;
+            has_slot_pred = other.has_slot_pred;
+            slot_pred = other.slot_pred;
+            build_str_set();
+        }
+        return *this;
+    }
+
+    void build_str_set() {
+        in_str_set.clear();
+        for (const auto &str: in_strs) {
+            in_str_set.insert(str);
+        }
+    }
+};
+
+namespace predicate {
+
+// 按列类型从记录中读出数据。字符串列读到第一个'\0'为止，与原先通过strcmp比较的语义一致
+template <ColType type>
+struct ColReader;
+
+template <>
+struct ColReader<TYPE_INT> {
+    static int read(const char *record, int offset, int) {
+        int val;
+        memcpy(&val, record + offset, sizeof(int));
+        return val;
+    }
+
+    static int constant(const CompiledCondition &cond) { return cond.int_val; }
+};
+
+template <>
+struct ColReader<TYPE_FLOAT> {
+    static float read(const char *record, int offset, int) {
+        float val;
+        memcpy(&val, record + offset, sizeof(float));
+        return val;
+    }
+
+    static float constant(const CompiledCondition &cond) { return cond.float_val; }
+};
+
+template <>
+struct ColReader<TYPE_STRING> {
+    static std::string_view read(const char *record, int offset, int len) {
+        const char *data = record + offset;
+        return {data, strnlen(data, len)};
+    }
+
+    static std::string_view constant(const CompiledCondition &cond) { return cond.str_val; }
+};
+
+// 整数与浮点数比较时按C++的算术转换规则把整数转换为浮点数，与Value的比较运算符一致
+template <CompOp op, typename L, typename R>
+inline bool compare(const L &lhs, const R &rhs) {
+    if constexpr (op == OP_EQ) {
+        return lhs == rhs;
+    } else if constexpr (op == OP_NE) {
+        return lhs != rhs;
+    } else if constexpr (op == OP_LT) {
+        return lhs < rhs;
+    } else if constexpr (op == OP_GT) {
+        return lhs > rhs;
+    } else if constexpr (op == OP_LE) {
+        return lhs <= rhs;
+    } else {
+        return lhs >= rhs;
+    }
+}
+
+// 列与常量比较
+template <CompOp op, ColType lhs_type, ColType rhs_type>
+bool eval_col_val(const CompiledCondition &cond, const char *record) {
+    return compare<op>(ColReader<lhs_type>::read(record, cond.lhs_offset, cond.lhs_len),
+                       ColReader<rhs_type>::constant(cond));
+}
+
+// 同一条记录中的两列比较
+template <CompOp op, ColType lhs_type, ColType rhs_type>
+bool eval_col_col(const CompiledCondition &cond, const char *record) {
+    return compare<op>(ColReader<lhs_type>::read(record, cond.lhs_offset, cond.lhs_len),
+                       ColReader<rhs_type>::read(record, cond.rhs_offset, cond.rhs_len));
+}
+
+// IN列表：数值在有序数组中二分查找，字符串在哈希集合中查找
+template <ColType lhs_type>
+bool eval_in(const CompiledCondition &cond, const char *record) {
+    auto val = ColReader<lhs_type>::read(record, cond.lhs_offset, cond.lhs_len);
+    if constexpr (lhs_type == TYPE_STRING) {
+        return cond.in_str_set.count(val) > 0;
+    } else if constexpr (lhs_type == TYPE_INT) {
+        return std::binary_search(cond.in_ints.begin(), cond.in_ints.end(), val) ||
+               std::binary_search(cond.in_floats.begin(), cond.in_floats.end(), static_cast<float>(val));
+    } else {
+        return std::binary_search(cond.in_floats.begin(), cond.in_floats.end(), val);
+    }
+}
+
+// 两侧类型无法比较时，保持原来逐行判断时才抛出异常的行为
+inline bool eval_incompatible(const CompiledCondition &cond, const char *) {
+    throw IncompatibleTypeError(coltype2str(cond.lhs_type), coltype2str(cond.rhs_type));
+}
+
+template <ColType lhs_type, ColType rhs_type>
+CompiledCondition::EvalFunc select_op(CompOp op, bool rhs_is_col) {
+#define PREDICATE_CASE(OP)                                                                           \
+    case OP:                                                                                         \
+        return rhs_is_col ? eval_col_col<OP, lhs_type, rhs_type> : eval_col_val<OP, lhs_type, rhs_type>;
+    switch (op) {
+        PREDICATE_CASE(OP_EQ)
+        PREDICATE_CASE(OP_NE)
+        PREDICATE_CASE(OP_LT)
+        PREDICATE_CASE(OP_GT)
+        PREDICATE_CASE(OP_LE)
+        PREDICATE_CASE(OP_GE)
+        default:
+            return eval_incompatible;
+    }
+#undef PREDICATE_CASE
+}
+
+inline CompiledCondition::EvalFunc select_eval(ColType lhs_type, ColType rhs_type, CompOp op, bool rhs_is_col) {
+    switch (lhs_type) {
+        case TYPE_INT:
+            if (rhs_type == TYPE_INT) {
+                return select_op<TYPE_INT, TYPE_INT>(op, rhs_is_col);
+            } else if (rhs_type == TYPE_FLOAT) {
+                return select_op<TYPE_INT, TYPE_FLOAT>(op, rhs_is_col);
+            }
+            break;
+        case TYPE_FLOAT:
+            if (rhs_type == TYPE_INT) {
+                return select_op<TYPE_FLOAT, TYPE_INT>(op, rhs_is_col);
+            } else if (rhs_type == TYPE_FLOAT) {
+                return select_op<TYPE_FLOAT, TYPE_FLOAT>(op, rhs_is_col);
+            }
+            break;
+        case TYPE_STRING:
+            if (rhs_type == TYPE_STRING) {
+                return select_op<TYPE_STRING, TYPE_STRING>(op, rhs_is_col);
+            }
+            break;
+    }
+    return eval_incompatible;
+}
+
+}  // namespace predicate
+
+/* 一组以AND连接的扫描条件编译后的结果 */
+class CompiledPredicate {
+private:
+    std::vector<CompiledCondition> conds_;
+
+    static const ColMeta &find_col(const std::vector<ColMeta> &cols, const TabCol &target) {
+        auto pos = std::find_if(cols.begin(), cols.end(), [&](const ColMeta &col) {
+            return col.tab_name == target.tab_name && col.name == target.col_name;
+        });
+        if (pos == cols.end()) {
+            throw ColumnNotFoundError(target.tab_name + '.' + target.col_name);
+        }
+        return *pos;
+    }
+
+    static CompiledCondition compile(const std::vector<ColMeta> &cols, const Condition &cond) {
+        CompiledCondition compiled;
+        const ColMeta &lhs_col = find_col(cols, cond.lhs_col);
+        compiled.lhs_type = lhs_col.type;
+        compiled.lhs_offset = lhs_col.offset;
+        compiled.lhs_len = lhs_col.len;
+
+        if (cond.is_rhs_in) {
+            compiled.rhs_type = lhs_col.type;
+            for (const auto &val: cond.rhs_in_vals) {
+                if (!checkType(lhs_col.type, val.type)) {
+                    compiled.rhs_type = val.type;
+                    compiled.eval = predicate::eval_incompatible;
+                    return compiled;
+                }
+                if (val.type == TYPE_STRING) {
+                    compiled.in_strs.push_back(val.str_val);
+                } else if (val.type == TYPE_INT && lhs_col.type == TYPE_INT) {
+                    compiled.in_ints.push_back(val.int_val);
+                } else {
+                    compiled.in_floats.push_back(val.type == TYPE_INT ? static_cast<float>(val.int_val) : val.float_val);
+                }
+            }
+            std::sort(compiled.in_ints.begin(), compiled.in_ints.end());
+            std::sort(compiled.in_floats.begin(), compiled.in_floats.end());
+            compiled.build_str_set();
+            compile_slot_in(compiled);
+            switch (lhs_col.type) {
+                case TYPE_INT:
+                    compiled.eval = predicate::eval_in<TYPE_INT>;
+                    break;
+                case TYPE_FLOAT:
+                    compiled.eval = predicate::eval_in<TYPE_FLOAT>;
+                    break;
+                case TYPE_STRING:
+                    compiled.eval = predicate::eval_in<TYPE_STRING>;
+                    break;
+            }
+            return compiled;
+        }
+
+        if (cond.is_rhs_val) {
+            compiled.rhs_type = cond.rhs_val.type;
+            compiled.int_val = cond.rhs_val.int_val;
+            compiled.float_val = cond.rhs_val.float_val;
+            // 与strcmp的语义一致，常量只取到第一个'\0'为止
+            compiled.str_val = cond.rhs_val.str_val.c_str();
+        } else {
+            const ColMeta &rhs_col = find_col(cols, cond.rhs_col);
+            compiled.rhs_type = rhs_col.type;
+            compiled.rhs_offset = rhs_col.offset;
+            compiled.rhs_len = rhs_col.len;
+        }
+        compiled.eval = predicate::select_eval(compiled.lhs_type, compiled.rhs_type, cond.op, !cond.is_rhs_val);
+        if (cond.is_rhs_val) {
+            compile_slot_val(compiled, cond.op);
+        }
+        return compiled;
+    }
+
+    // 数值列与常量的比较可以在页面级判断
+    static void compile_slot_val(CompiledCondition &compiled, CompOp op) {
+        if (compiled.lhs_type == TYPE_STRING || compiled.rhs_type == TYPE_STRING || op == OP_IN) {
+            return;
+        }
+        SlotPredicate &pred = compiled.slot_pred;
+        pred.type = compiled.lhs_type;
+        pred.int_as_float = compiled.lhs_type == TYPE_INT && compiled.rhs_type == TYPE_FLOAT;
+        pred.offset = compiled.lhs_offset;
+        pred.num_vals = 1;
+        pred.int_vals[0] = compiled.int_val;
+        pred.float_vals[0] = compiled.rhs_type == TYPE_INT ? static_cast<float>(compiled.int_val) : compiled.float_val;
+        static const SlotFilterOp ops[] = {SlotFilterOp::EQ, SlotFilterOp::NE, SlotFilterOp::LT,
+                                           SlotFilterOp::GT, SlotFilterOp::LE, SlotFilterOp::GE};
+        pred.op = ops[op];
+        compiled.has_slot_pred = true;
+    }
+
+    // 数值列上较短的IN列表可以在页面级判断，INT列的列表中只能有整数
+    static void compile_slot_in(CompiledCondition &compiled) {
+        size_t num_vals = compiled.in_ints.size() + compiled.in_floats.size();
+        if (compiled.lhs_type == TYPE_STRING || compiled.eval == predicate::eval_incompatible || num_vals == 0 ||
+            num_vals > SLOT_FILTER_MAX_IN || (compiled.lhs_type == TYPE_INT && !compiled.in_floats.empty())) {
+            return;
+        }
+        SlotPredicate &pred = compiled.slot_pred;
+        pred.type = compiled.lhs_type;
+        pred.op = SlotFilterOp::IN;
+        pred.offset = compiled.lhs_offset;
+        pred.num_vals = static_cast<int>(num_vals);
+        std::copy(compiled.in_ints.begin(), compiled.in_ints.end(), pred.int_vals);
+        std::copy(compiled.in_floats.begin(), compiled.in_floats.end(), pred.float_vals);
+        compiled.has_slot_pred = true;
+    }
+
+public:
+    CompiledPredicate() = default;
+
+    /**
+     * @description: 编译一组条件
+     * @param {vector<ColMeta>} &cols 记录的所有列
+     * @param {vector<Condition>} &conds 以AND连接的条件，条件中的列必须都在cols中
+     */
+    CompiledPredicate(const std::vector<ColMeta> &cols, const std::vector<Condition> &conds) {
+        conds_.reserve(conds.size());
+        for (const auto &cond: conds) {
+            conds_.push_back(compile(cols, cond));
+        }
+    }
+
+    bool empty() const { return conds_.empty(); }
+
+    /**
+     * @description: 把条件分成能在页面级判断的SlotPredicate和剩下的条件。
+     *              同一列上的>=和<=合并成一个BETWEEN，只需要扫描一遍
+     * @param {vector<SlotPredicate>} &slot_preds 输出，页面级条件
+     * @param {CompiledPredicate} &residual 输出，需要逐条记录判断的条件
+     */
+    void split(std::vector<SlotPredicate> &slot_preds, CompiledPredicate &residual) const {
+        slot_preds.clear();
+        residual.conds_.clear();
+        for (const auto &cond: conds_) {
+            if (!cond.has_slot_pred) {
+                residual.conds_.push_back(cond);
+                continue;
+            }
+            const SlotPredicate &pred = cond.slot_pred;
+            bool merged = false;
+            if (pred.op == SlotFilterOp::GE || pred.op == SlotFilterOp::LE) {
+                for (auto &other: slot_preds) {
+                    if (other.offset != pred.offset || other.type != pred.type ||
+                        other.int_as_float != pred.int_as_float ||
+                        other.op != (pred.op == SlotFilterOp::GE ? SlotFilterOp::LE : SlotFilterOp::GE)) {
+                        continue;
+                    }
+                    // other中原有的边界在下标0，先保存下来，避免被新的边界覆盖
+                    int lo = pred.op == SlotFilterOp::GE ? 0 : 1;
+                    int32_t old_int = other.int_vals[0];
+                    float old_float = other.float_vals[0];
+                    other.int_vals[lo] = pred.int_vals[0];
+                    other.float_vals[lo] = pred.float_vals[0];
+                    other.int_vals[1 - lo] = old_int;
+                    other.float_vals[1 - lo] = old_float;
+                    other.op = SlotFilterOp::BETWEEN;
+                    other.num_vals = 2;
+                    merged = true;
+                    break;
+                }
+            }
+            if (!merged) {
+                slot_preds.push_back(pred);
+            }
+        }
+    }
+
+    // 判断一条记录是否满足所有条件
+    bool operator()(const char *record) const {
+        for (const auto &cond: conds_) {
+            if (!cond.eval(cond, record)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 按条件逐个过滤一批记录，每个条件只对前面条件留下的记录判断
+    void filter(RecordBatch &batch) const {
+        for (const auto &cond: conds_) {
+            if (batch.empty()) {
+                return;
+            }
+            batch.filter([&cond](const char *record) { return cond.eval(cond, record); });
+        }
+    }
+};
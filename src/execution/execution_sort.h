@@ -32,6 +32,8 @@ class SortExecutor : public AbstractExecutor {
     std::vector<std::unique_ptr<RmRecord>> tuples;
     int count;
     RmCompare cmp;
+    std::vector<char> rows_;                // 批量执行时读入的全部记录，连续存放
+    std::vector<uint32_t> order_;           // 排序后的记录行号
 
     std::string output_prefix = "merge_out_";
     std::vector<std::string> run_files;
@@ -72,7 +74,7 @@ class SortExecutor : public AbstractExecutor {
               tuple_num(0),
               cmp(std::make_shared<ColMeta>(col), is_desc_),
               cmp_wrapper([this](const RecordWithIndex& a, const RecordWithIndex& b) {
-                  return !cmp(a.first, b.first);
+                  return cmp(b.first, a.first);
               }),
               min_heap(cmp_wrapper) {
         context_ = context;
@@ -94,6 +96,35 @@ class SortExecutor : public AbstractExecutor {
         }
     }
 
+    size_t tupleLen() const override { return prev->tupleLen(); }
+
+    // 批量读入儿子节点的全部记录，只对行号排序，不移动记录
+    void beginBatch() override {
+        size_t len = prev->tupleLen();
+        RecordBatch batch;
+        rows_.clear();
+        order_.clear();
+        for (prev->beginBatch(); prev->nextBatch(batch);) {
+            for (size_t i = 0; i < batch.size(); i++) {
+                rows_.insert(rows_.end(), batch.row(i), batch.row(i) + len);
+                order_.push_back(order_.size());
+            }
+        }
+        std::sort(order_.begin(), order_.end(), [&](uint32_t lhs, uint32_t rhs) {
+            return cmp(rows_.data() + lhs * len, rows_.data() + rhs * len);
+        });
+        count = 0;
+    }
+
+    bool nextBatch(RecordBatch &batch) override {
+        size_t len = prev->tupleLen();
+        batch.reset(len);
+        for (; count < (int) order_.size() && !batch.is_full(); count++) {
+            batch.append_row(rows_.data() + order_[count] * len);
+        }
+        return !batch.empty();
+    }
+
     void normal_sort() {
         used_tuple.clear();
         for (prev->beginTuple(); !prev->is_end(); prev->nextTuple()) {
@@ -10,6 +10,7 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "execution_batch.h"
 #include "execution_defs.h"
 #include "common/common.h"
 #include "index/ix.h"
@@ -45,6 +46,22 @@ public:
 
     virtual ColMeta get_col_offset(const TabCol &target) { return ColMeta(); };
 
+    // 批量执行接口：beginBatch之后反复调用nextBatch，每次取出至多一批记录，返回false表示没有更多记录。
+    // 默认实现把逐行接口适配为批量接口，原生支持批量执行的算子重写这两个函数
+    virtual void beginBatch() { beginTuple(); }
+
+    virtual bool nextBatch(RecordBatch &batch) {
+        batch.reset(tupleLen());
+        while (!is_end() && !batch.is_full()) {
+            auto record = Next();
+            if (record != nullptr) {
+                batch.append_row(record->data);
+            }
+            nextTuple();
+        }
+        return !batch.empty();
+    }
+
     virtual void set_begin(){};
 
     virtual void end_work(){};
@@ -61,7 +78,12 @@ public:
 
     // 从 Record 中取出某一列的 Value
     Value fetch_value(const std::unique_ptr<RmRecord> &record, const ColMeta &columnMeta) const {
-        char *data = record->data + columnMeta.offset;
+        return fetch_value(record->data, columnMeta);
+    }
+
+    // 从记录数据（可以直接指向缓冲池中的页面）中取出某一列的 Value，只用于比较时不需要生成raw
+    Value fetch_value(const char *record, const ColMeta &columnMeta, bool need_raw = true) const {
+        const char *data = record + columnMeta.offset;
         size_t len = columnMeta.len;
         Value result;
         result.type = columnMeta.type;
@@ -79,7 +101,9 @@ public:
         } else {
             throw InvalidTypeError();
         }
-        result.init_raw(len);
+        if (need_raw) {
+            result.init_raw(len);
+        }
         return result;
     }
 
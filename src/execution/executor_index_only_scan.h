@@ -0,0 +1,203 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <memory>
+
+#include "execution_defs.h"
+#include "execution_manager.h"
+#include "execution_predicate.h"
+#include "executor_abstract.h"
+#include "executor_index_scan.h"
+#include "index/ix.h"
+#include "system/sm.h"
+
+/* 覆盖索引扫描：查询涉及的字段都在索引中时，直接用叶子结点中的键构造元组，不再回表读取记录。
+ * 输出元组的格式与索引键相同，即按照索引字段的顺序依次存放，cols()中的偏移量相应地改为在键中的偏移量 */
+class IndexOnlyScanExecutor : public AbstractExecutor {
+private:
+    std::string tab_name_;                      // 表名称
+    TabMeta tab_;                               // 表的元数据
+    std::vector<Condition> conditions_;         // 扫描条件
+    RmFileHandle *fh_;                          // 表的数据文件句柄，只用于申请锁和输出sorted_results
+    std::vector<ColMeta> cols_;                 // 输出的字段，即索引包含的字段
+    size_t len_;                                // 输出的一条元组的长度，即索引键的长度
+    IndexMeta index_meta_;                      // index scan涉及到的索引元数据
+    CompiledPredicate predicate_;               // 在索引键上判断的扫描条件
+
+    Rid rid_;
+    std::unique_ptr<RmRecord> key_;             // 当前叶子结点中的键
+    std::unique_ptr<IxScan> scan_;
+    IxIndexHandle *ih_;
+
+    SmManager *sm_manager_;
+
+    bool is_sort_;
+    bool is_end_;
+
+public:
+    IndexOnlyScanExecutor(SmManager *sm_manager, std::string tab_name, std::vector<Condition> conds,
+                          IndexMeta index_meta, Context *context, bool is_sort) {
+        sm_manager_ = sm_manager;
+        context_ = context;
+        tab_name_ = std::move(tab_name);
+        tab_ = sm_manager_->db_.get_table(tab_name_);
+        conditions_ = std::move(conds);
+        index_meta_ = std::move(index_meta);
+        fh_ = sm_manager_->fhs_.at(tab_name_).get();
+        auto index_name = sm_manager_->get_ix_manager()->get_index_name(tab_name_, index_meta_.cols);
+        ih_ = sm_manager_->ihs_.at(index_name).get();
+
+        int offset = 0;
+        for (auto col: index_meta_.cols) {
+            col.offset = offset;
+            offset += col.len;
+            cols_.push_back(col);
+        }
+        len_ = index_meta_.col_tot_len;
+
+        std::map<CompOp, CompOp> swap_op = {
+                {OP_EQ, OP_EQ},
+                {OP_NE, OP_NE},
+                {OP_LT, OP_GT},
+                {OP_GT, OP_LT},
+                {OP_LE, OP_GE},
+                {OP_GE, OP_LE},
+        };
+
+        for (auto &cond: conditions_) {
+            if (cond.lhs_col.tab_name != tab_name_) {
+                assert(!cond.is_rhs_val && cond.rhs_col.tab_name == tab_name_);
+                std::swap(cond.lhs_col, cond.rhs_col);
+                cond.op = swap_op.at(cond.op);
+            }
+        }
+        predicate_ = CompiledPredicate(cols_, conditions_);
+
+        is_end_ = false;
+        is_sort_ = is_sort;
+
+        // 申请表级共享锁（S）
+        if (context_ != nullptr) {
+            context_->lock_mgr_->lock_shared_on_table(context_->txn_, fh_->GetFd());
+        }
+    }
+
+    void beginTuple() override {
+        // 计算扫描范围
+        RmRecord lower_key(index_meta_.col_tot_len), upper_key(index_meta_.col_tot_len);
+        get_index_scan_range(index_meta_, conditions_, lower_key, upper_key);
+
+        auto lowerId = ih_->lower_bound(lower_key.data);
+        auto upperId = ih_->upper_bound(upper_key.data);
+        scan_ = std::make_unique<IxScan>(ih_, lowerId, upperId, context_);
+        key_ = std::make_unique<RmRecord>(len_);
+        is_end_ = false;
+        find_next();
+    }
+
+    void nextTuple() override {
+        if (is_end()) {
+            return;
+        }
+        scan_->next();
+        find_next();
+    }
+
+    std::unique_ptr<RmRecord> Next() override {
+        if (is_end()) {
+            return nullptr;
+        }
+        return std::make_unique<RmRecord>(*key_);
+    }
+
+    Rid &rid() override { return rid_; }
+
+    size_t tupleLen() const override { return len_; };
+
+    const std::vector<ColMeta> &cols() const override {
+        return cols_;
+    };
+
+    std::string getType() override { return "IndexOnlyScanExecutor"; };
+
+    bool is_end() const override { return is_end_; };
+
+    void set_begin() override {
+        beginTuple();
+    }
+
+    // 与IndexScanExecutor一致，sorted_results中输出表的全部字段，因此这里按rid回表读取记录
+    void end_work() override {
+        if (!is_sort_) {
+            return;
+        }
+        std::fstream sorted_results("sorted_results.txt", std::ios::out | std::ios::app);
+        sorted_results << "|";
+        for (const auto &col: tab_.cols) {
+            sorted_results << " " << col.name << " |";
+        }
+        sorted_results << "\n";
+
+        set_begin();
+        while (!is_end()) {
+            auto rec = fh_->get_record(rid_, context_);
+            sorted_results << "|";
+            for (const auto &col: tab_.cols) {
+                std::string col_str;
+                char *rec_buf = rec->data + col.offset;
+                switch (col.type) {
+                    case TYPE_INT: {
+                        col_str = std::to_string(*(int *) rec_buf);
+                        break;
+                    }
+                    case TYPE_FLOAT: {
+                        col_str = std::to_string(*(float *) rec_buf);
+                        break;
+                    }
+                    case TYPE_STRING: {
+                        col_str = std::string((char *) rec_buf, col.len);
+                        col_str.resize(strlen(col_str.c_str()));
+                        break;
+                    }
+                    default: {
+                        throw InvalidTypeError();
+                    }
+                }
+                sorted_results << " " << col_str << " |";
+            }
+            sorted_results << "\n";
+            nextTuple();
+        }
+        sorted_results.close();
+    }
+
+private:
+    // 从scan_的当前位置开始，找到第一个满足扫描条件的索引项
+    void find_next() {
+        while (!scan_->is_end()) {
+            rid_ = scan_->entry(key_->data);
+
+            // 申请行级共享锁（S锁）
+            context_->lock_mgr_->lock_shared_on_record(context_->txn_, rid_, fh_->GetFd());
+            // 等待锁的过程中该位置上的索引项可能已被修改，加锁后重新读取
+            if (scan_->entry(key_->data) != rid_) {
+                continue;
+            }
+
+            if (predicate_(key_->data)) {
+                return;
+            }
+            scan_->next();
+        }
+        is_end_ = true;
+    }
+};
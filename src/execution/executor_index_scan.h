@@ -18,6 +18,82 @@ See the Mulan PSL v2 for more details. */
 #include "index/ix.h"
 #include "system/sm.h"
 
+// 根据扫描条件计算索引扫描的范围，lower_key和upper_key为记录中格式的键，长度为index_meta.col_tot_len
+inline void get_index_scan_range(const IndexMeta &index_meta, const std::vector<Condition> &conds,
+                                 RmRecord &lower_key, RmRecord &upper_key) {
+    size_t offset = 0;
+    for (const auto &col: index_meta.cols) {
+        Value tmp_max, tmp_min;
+        // 初始化tmp_max和tmp_min
+        switch (col.type) {
+            case TYPE_INT: {
+                tmp_max.set_int(INT32_MAX);
+                tmp_max.init_raw(col.len);
+                tmp_min.set_int(INT32_MIN);
+                tmp_min.init_raw(col.len);
+                break;
+            }
+
+            case TYPE_FLOAT: {
+                tmp_max.set_float(__FLT_MAX__);
+                tmp_max.init_raw(col.len);
+                tmp_min.set_float(-__FLT_MAX__);
+                tmp_min.init_raw(col.len);
+                break;
+            }
+
+            case TYPE_STRING : {
+                tmp_max.set_str(std::string(col.len, (char) 255));
+                tmp_max.init_raw(col.len);
+                tmp_min.set_str(std::string(col.len, 0));
+                tmp_min.init_raw(col.len);
+                break;
+            }
+            default: {
+                throw InvalidTypeError();
+            }
+        }
+
+        for (const auto &cond: conds) {
+            if (cond.lhs_col.col_name == col.name && cond.is_rhs_val) {
+                switch (cond.op) {
+                    case OP_EQ: {
+                        if (cond.rhs_val > tmp_min) {
+                            tmp_min = cond.rhs_val;
+                        }
+                        if (cond.rhs_val < tmp_max) {
+                            tmp_max = cond.rhs_val;
+                        }
+                        break;
+                    }
+                    case OP_GT:
+                    case OP_GE: {
+                        if (cond.rhs_val > tmp_min) {
+                            tmp_min = cond.rhs_val;
+                        }
+                        break;
+                    }
+                    case OP_LT:
+                    case OP_LE: {
+                        if (cond.rhs_val < tmp_max) {
+                            tmp_max = cond.rhs_val;
+                        }
+                        break;
+                    }
+                    default:
+                        break;
+                }
+            }
+        }
+
+        // 检查tmp_min是否小于tmp_max
+        assert(tmp_min <= tmp_max);
+        memcpy(upper_key.data + offset, tmp_max.raw->data, col.len);
+        memcpy(lower_key.data + offset, tmp_min.raw->data, col.len);
+        offset += col.len;
+    }
+}
+
 class IndexScanExecutor : public AbstractExecutor {
 private:
     std::string tab_name_;                      // 表名称
@@ -31,6 +107,7 @@ private:
     IndexMeta index_meta_;                      // index scan涉及到的索引元数据
 
     Rid rid_;
+    RmRecordView view_;     // 当前记录在缓冲池页面中的视图
     std::unique_ptr<IxScan> scan_;
     IxIndexHandle *ih_;
 
@@ -88,78 +165,7 @@ public:
     void beginTuple() override {
         // 计算扫描范围
         RmRecord lower_key(index_meta_.col_tot_len), upper_key(index_meta_.col_tot_len);
-
-        size_t offset = 0;
-        for (const auto &col: index_meta_.cols) {
-            Value tmp_max, tmp_min;
-            // 初始化tmp_max和tmp_min
-            switch (col.type) {
-                case TYPE_INT: {
-                    tmp_max.set_int(INT32_MAX);
-                    tmp_max.init_raw(col.len);
-                    tmp_min.set_int(INT32_MIN);
-                    tmp_min.init_raw(col.len);
-                    break;
-                }
-
-                case TYPE_FLOAT: {
-                    tmp_max.set_float(__FLT_MAX__);
-                    tmp_max.init_raw(col.len);
-                    tmp_min.set_float(-__FLT_MAX__);
-                    tmp_min.init_raw(col.len);
-                    break;
-                }
-
-                case TYPE_STRING : {
-                    tmp_max.set_str(std::string(col.len, (char) 255));
-                    tmp_max.init_raw(col.len);
-                    tmp_min.set_str(std::string(col.len, 0));
-                    tmp_min.init_raw(col.len);
-                    break;
-                }
-                default: {
-                    throw InvalidTypeError();
-                }
-            }
-
-            for (const auto &cond: fedConditions) {
-                if (cond.lhs_col.col_name == col.name && cond.is_rhs_val) {
-                    switch (cond.op) {
-                        case OP_EQ: {
-                            if (cond.rhs_val > tmp_min) {
-                                tmp_min = cond.rhs_val;
-                            }
-                            if (cond.rhs_val < tmp_max) {
-                                tmp_max = cond.rhs_val;
-                            }
-                            break;
-                        }
-                        case OP_GT:
-                        case OP_GE: {
-                            if (cond.rhs_val > tmp_min) {
-                                tmp_min = cond.rhs_val;
-                            }
-                            break;
-                        }
-                        case OP_LT:
-                        case OP_LE: {
-                            if (cond.rhs_val < tmp_max) {
-                                tmp_max = cond.rhs_val;
-                            }
-                            break;
-                        }
-                        default:
-                            break;
-                    }
-                }
-            }
-
-            // 检查tmp_min是否小于tmp_max
-            assert(tmp_min <= tmp_max);
-            memcpy(upper_key.data + offset, tmp_max.raw->data, col.len);
-            memcpy(lower_key.data + offset, tmp_min.raw->data, col.len);
-            offset += col.len;
-        }
+        get_index_scan_range(index_meta_, fedConditions, lower_key, upper_key);
 
         auto lowerId = ih_->lower_bound(lower_key.data);
         auto upperId = ih_->upper_bound(upper_key.data);
@@ -171,11 +177,11 @@ public:
             // 申请行级共享锁（S锁）
             context_->lock_mgr_->lock_shared_on_record(context_->txn_, rid_, fh_->GetFd());
 
-            auto record = fh_->get_record(rid_, context_);
+            fh_->get_record_view(rid_, view_);
             bool is_fit = true;
             for (const auto &fedCond: fedConditions) {
                 auto col = *get_col(cols_, fedCond.lhs_col);
-                auto value = fetch_value(record, col);
+                auto value = fetch_value(view_.data(), col, false);
                 if (fedCond.is_rhs_val && !compare_value(value, fedCond.rhs_val, fedCond.op)) {
                     is_fit = false;
                     break;
@@ -195,6 +201,7 @@ public:
                 scan_->next();
             }
         }
+        view_.release();
         is_end_ = true;
     }
 
@@ -209,11 +216,11 @@ public:
             // 申请行级共享锁（S锁）
             context_->lock_mgr_->lock_shared_on_record(context_->txn_, rid_, fh_->GetFd());
 
-            auto record = fh_->get_record(rid_, context_);
+            fh_->get_record_view(rid_, view_);
             bool is_fit = true;
             for (const auto &fedCond: fedConditions) {
                 auto col = *get_col(cols_, fedCond.lhs_col);
-                auto value = fetch_value(record, col);
+                auto value = fetch_value(view_.data(), col, false);
                 if (fedCond.is_rhs_val && !compare_value(value, fedCond.rhs_val, fedCond.op)) {
                     is_fit = false;
                     break;
@@ -233,6 +240,7 @@ public:
                 scan_->next();
             }
         }
+        view_.release();
         is_end_ = true;
     }
 
@@ -240,7 +248,7 @@ public:
         if (is_end()) {
             return nullptr;
         }
-        return fh_->get_record(rid_, context_);
+        return view_.to_record();
     }
 
     Rid &rid() override { return rid_; }
@@ -30,6 +30,14 @@ private:
     bool is_time_delay_;
     bool is_sort_pre = false;
 
+    // 批量执行时的状态：右表只物化一次，左表按批读取
+    std::vector<char> right_rows_;              // 物化的右表记录
+    size_t right_num_ = 0;                      // 物化的右表记录条数
+    size_t right_idx_ = 0;                      // 当前左表记录下一条要比较的右表记录
+    RecordBatch left_batch_;                    // 当前的一批左表记录
+    size_t left_idx_ = 0;                       // 当前左表记录在left_batch_中的位置
+    std::vector<std::pair<ColMeta, ColMeta>> cond_cols_;   // 每个连接条件左右两边的字段
+
 public:
     NestedLoopJoinExecutor(std::unique_ptr<AbstractExecutor> left, std::unique_ptr<AbstractExecutor> right,
                            std::vector<Condition> conds, bool is_reversal_join, Context *context, bool is_time_delay = false) {
@@ -135,6 +143,80 @@ public:
 //        }
     }
 
+    void beginBatch() override {
+        // 按序合并的连接依赖儿子节点的逐行接口，使用默认的适配实现
+        if (is_sort_pre) {
+            AbstractExecutor::beginBatch();
+            return;
+        }
+        if (is_time_delay_) {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+        if (is_reversal_join_) {
+            right_->beginBatch();
+            left_->beginBatch();
+        } else {
+            left_->beginBatch();
+            right_->beginBatch();
+        }
+        cond_cols_.clear();
+        for (const auto &condition: fed_conds_) {
+            ColMeta rightCol;
+            if (!condition.is_rhs_val && !condition.is_rhs_in) {
+                rightCol = *get_col(right_->cols(), condition.rhs_col);
+            }
+            cond_cols_.emplace_back(*get_col(left_->cols(), condition.lhs_col), rightCol);
+        }
+
+        // 物化右表，之后每一条左表记录都与物化的右表比较，不再重新扫描右表
+        size_t right_len = right_->tupleLen();
+        RecordBatch right_batch;
+        right_rows_.clear();
+        right_num_ = 0;
+        while (right_->nextBatch(right_batch)) {
+            right_rows_.resize((right_num_ + right_batch.size()) * right_len);
+            for (size_t i = 0; i < right_batch.size(); i++) {
+                memcpy(right_rows_.data() + (right_num_++) * right_len, right_batch.row(i), right_len);
+            }
+        }
+        left_batch_.clear();
+        left_idx_ = 0;
+        right_idx_ = 0;
+    }
+
+    bool nextBatch(RecordBatch &batch) override {
+        if (is_sort_pre) {
+            return AbstractExecutor::nextBatch(batch);
+        }
+        batch.reset(len_);
+        size_t left_len = left_->tupleLen();
+        size_t right_len = right_->tupleLen();
+        while (!batch.is_full()) {
+            // 当前这批左表记录已经处理完，取下一批
+            if (left_idx_ >= left_batch_.size()) {
+                if (right_num_ == 0 || !left_->nextBatch(left_batch_)) {
+                    break;
+                }
+                left_idx_ = 0;
+                right_idx_ = 0;
+            }
+            const char *leftRecord = left_batch_.row(left_idx_);
+            for (; right_idx_ < right_num_ && !batch.is_full(); right_idx_++) {
+                const char *rightRecord = right_rows_.data() + right_idx_ * right_len;
+                if (is_fit(leftRecord, rightRecord)) {
+                    char *record = batch.append_row();
+                    memcpy(record, leftRecord, left_len);
+                    memcpy(record + left_len, rightRecord, right_len);
+                }
+            }
+            if (right_idx_ == right_num_) {
+                left_idx_++;
+                right_idx_ = 0;
+            }
+        }
+        return !batch.empty();
+    }
+
     Rid &rid() override { return _abstract_rid; }
 
     void end_work() override {
@@ -157,6 +239,33 @@ public:
         return ColMeta();
     }
 
+    // 判断一对左右表记录是否满足所有连接条件，与findNextValidTuple中的判断相同
+    bool is_fit(const char *leftRecord, const char *rightRecord) {
+        bool isFit = true;
+        for (size_t i = 0; i < fed_conds_.size(); i++) {
+            const auto &condition = fed_conds_[i];
+            auto leftValue = fetch_value(leftRecord, cond_cols_[i].first, false);
+            Value rightValue;
+            if (condition.is_rhs_val) {
+                rightValue = condition.rhs_val;
+            } else if (!condition.is_rhs_in) {
+                rightValue = fetch_value(rightRecord, cond_cols_[i].second, false);
+            }
+            if (condition.is_rhs_in) {
+                for (const auto &rhs_val: condition.rhs_in_vals) {
+                    isFit = false;
+                    if (compare_value(leftValue, rhs_val, OP_EQ)) {
+                        isFit = true;
+                        break;
+                    }
+                }
+            } else if (!compare_value(leftValue, rightValue, condition.op)) {
+                return false;
+            }
+        }
+        return isFit;
+    }
+
     void findNextValidTuple() {
         while (!left_->is_end()) {
             // 取左节点的record和列值
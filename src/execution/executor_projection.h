@@ -22,6 +22,7 @@ private:
     std::vector<ColMeta> cols_;                     // 需要投影的字段
     size_t len_;                                    // 字段总长度
     std::vector<size_t> sel_idxs_;                  // 需要投影的字段在的index
+    RecordBatch prev_batch_;                        // 批量执行时从儿子节点取出的一批记录
 
 public:
     ProjectionExecutor(std::unique_ptr<AbstractExecutor> prev, const std::vector<TabCol> &sel_cols) {
@@ -73,6 +74,29 @@ public:
         return record;
     }
 
+    void beginBatch() override {
+        prev_->beginBatch();
+    }
+
+    bool nextBatch(RecordBatch &batch) override {
+        if (!prev_->nextBatch(prev_batch_)) {
+            batch.reset(len_);
+            return false;
+        }
+        batch.reset(len_);
+        auto &prevCols = prev_->cols();
+        for (size_t row = 0; row < prev_batch_.size(); row++) {
+            const char *prevRecord = prev_batch_.row(row);
+            char *record = batch.append_row();
+            for (size_t i = 0; i < sel_idxs_.size(); i++) {
+                auto &preCol = prevCols[sel_idxs_[i]];
+                auto &selCol = cols_[i];
+                memcpy(record + selCol.offset, prevRecord + preCol.offset, selCol.len);
+            }
+        }
+        return true;
+    }
+
     Rid &rid() override { return _abstract_rid; }
 
     void end_work() override {
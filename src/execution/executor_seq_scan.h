@@ -12,6 +12,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "execution_defs.h"
 #include "execution_manager.h"
+#include "execution_predicate.h"
 #include "executor_abstract.h"
 #include "index/ix.h"
 #include "system/sm.h"
@@ -24,9 +25,26 @@ private:
     std::vector<ColMeta> cols_;
     size_t len_;
     std::vector<Condition> fedConditions;
+    CompiledPredicate predicate_;   // 构造时编译好的扫描条件
+
+    // 批量扫描时按页面判断条件：先用page_preds_得到页面中满足条件的记录位图，再对这些记录判断residual_
+    std::vector<SlotPredicate> page_preds_;
+    CompiledPredicate residual_;
+    std::vector<SlotPredicate> zone_preds_; // 用区域映射跳过整个页面的条件
+    std::vector<char> page_mask_;   // 当前页面的选择位图
+    std::vector<int> page_slots_;   // 当前页面中满足条件的slot_no
+    int num_page_slots_ = 0;
+    int page_slot_idx_ = 0;         // 下一个要读取的page_slots_下标
+    int page_no_ = RM_NO_PAGE;      // 批量扫描的当前页面
+    ReadAheadState read_ahead_;
+
+    // 列存格式的表只取出上层需要的字段（cols_的下标），fetch_subset_为false时取出所有字段
+    std::vector<int> fetch_cols_;
+    bool fetch_subset_ = false;
 
     Rid rid_;
     std::unique_ptr<RecScan> scan_;
+    RmRecordView view_;     // 当前记录在缓冲池页面中的视图，条件直接在页面数据上判断
 
     SmManager *sm_manager_;
 
@@ -43,6 +61,16 @@ public:
         context_ = context;
 
         fedConditions = conditions_;
+        predicate_ = CompiledPredicate(cols_, conditions_);
+        predicate_.split(page_preds_, residual_);
+        if (fh_->is_slotted()) {
+            // 分槽页中的记录需要逐条解码，页面级过滤没有收益，所有条件都在解码后判断，简单条件只用于区域映射
+            residual_ = predicate_;
+            zone_preds_ = std::move(page_preds_);
+            page_preds_.clear();
+        } else {
+            zone_preds_ = page_preds_;
+        }
 
         // 申请表级共享锁（S）
         if(context_!= nullptr){
@@ -50,57 +78,22 @@ public:
         }
     }
 
-    bool is_fed_cond(const std::vector<ColMeta> &rec_cols, const Condition &cond, const RmRecord *target) {
-        auto lhsColMeta = *get_col(rec_cols, cond.lhs_col);
-
-        ColMeta rhsColMeta;
-        if (!cond.is_rhs_val && !cond.is_rhs_in) {
-            rhsColMeta = *get_col(rec_cols, cond.rhs_col);
-        }
-
-        auto rmRecord = std::make_unique<RmRecord>(*target);
-        auto lhsVal = fetch_value(rmRecord, lhsColMeta);
-        Value rhsVal;
-        if (cond.is_rhs_val) {
-            rhsVal = cond.rhs_val;
-        } else if (!cond.is_rhs_in) {
-            rhsVal = fetch_value(rmRecord, rhsColMeta);
-        }
-
-        if (cond.is_rhs_in) {
-            for (const auto &rhs_val: cond.rhs_in_vals) {
-                if (compare_value(lhsVal, rhs_val, OP_EQ)) {
-                    return true;
-                }
-            }
-            return false;
-        } else {
-            return compare_value(lhsVal, rhsVal, cond.op);
-        }
-    }
-
-    bool record_satisfies_conditions(const std::vector<ColMeta> &rec_cols, const std::vector<Condition> &conditions,
-                                     const RmRecord *record) {
-        return std::all_of(conditions.begin(), conditions.end(), [&](const Condition &cond) {
-            return is_fed_cond(rec_cols, cond, record);
-        });
-    }
-
     void beginTuple() override {
-        scan_ = std::make_unique<RmScan>(fh_);
+        scan_ = std::make_unique<RmScan>(fh_, &zone_preds_);
 
         // 扫描表中所有记录，找到第一个满足条件的记录
         while (!scan_->is_end()) {
             // 申请行级共享锁（S锁）
             context_->lock_mgr_->lock_shared_on_record(context_->txn_, scan_->rid(), fh_->GetFd());
 
-            auto record = fh_->get_record(scan_->rid(), context_);
-            if (record_satisfies_conditions(cols_, conditions_, record.get())) {
+            fh_->get_record_view(scan_->rid(), view_, fetch_cols());
+            if (predicate_(view_.data())) {
                 rid_ = scan_->rid();
                 return;
             }
             scan_->next();
         }
+        view_.release();
     }
 
     void nextTuple() override {
@@ -110,24 +103,108 @@ public:
             // 申请行级共享锁（S锁）
             context_->lock_mgr_->lock_shared_on_record(context_->txn_, scan_->rid(), fh_->GetFd());
 
-            auto record = fh_->get_record(scan_->rid(), context_);
-            if (record_satisfies_conditions(cols_, fedConditions, record.get())) {
+            fh_->get_record_view(scan_->rid(), view_, fetch_cols());
+            if (predicate_(view_.data())) {
                 rid_ = scan_->rid();
                 return;
             }
         }
+        // 扫描结束后释放最后一个页面
+        view_.release();
+    }
+
+    void beginBatch() override {
+        RmFileHdr file_hdr = fh_->get_file_hdr();
+        page_mask_.resize(file_hdr.bitmap_size);
+        page_slots_.resize(file_hdr.num_records_per_page);
+        page_no_ = RM_FIRST_RECORD_PAGE - 1;
+        num_page_slots_ = page_slot_idx_ = 0;
+        read_ahead_ = ReadAheadState();
     }
 
+    // 按页面扫描：对每个页面先用SlotFilter一次判断所有记录的简单条件，只有满足条件的记录才会加锁并复制到batch中，
+    // 其余条件在整批记录上判断，不满足条件的记录只从选择向量中去掉
+    bool nextBatch(RecordBatch &batch) override {
+        batch.reset(len_);
+        RmFileHdr file_hdr = fh_->get_file_hdr();
+        while (batch.empty() && (page_slot_idx_ < num_page_slots_ || page_no_ + 1 < file_hdr.num_pages)) {
+            batch.clear();
+            while (!batch.is_full()) {
+                if (page_slot_idx_ == num_page_slots_) {
+                    if (page_no_ + 1 >= file_hdr.num_pages) {
+                        break;
+                    }
+                    // 区域映射表明页面中不可能有满足条件的记录时，不需要读取页面
+                    if (!fh_->page_may_match(page_no_ + 1, zone_preds_)) {
+                        page_no_++;
+                        continue;
+                    }
+                    fh_->filter_page(++page_no_, page_preds_, page_mask_.data(), view_, &read_ahead_);
+                    num_page_slots_ = Bitmap::set_positions(page_mask_.data(), file_hdr.num_records_per_page,
+                                                            page_slots_.data());
+                    page_slot_idx_ = 0;
+                    continue;
+                }
+                Rid rid{page_no_, page_slots_[page_slot_idx_++]};
+                // 申请行级共享锁（S锁）
+                context_->lock_mgr_->lock_shared_on_record(context_->txn_, rid, fh_->GetFd());
+
+                fh_->get_record_view(rid, view_, fetch_cols());
+                batch.append_row(view_.data());
+            }
+            view_.release();
+            residual_.filter(batch);
+            file_hdr = fh_->get_file_hdr();
+        }
+        return !batch.empty();
+    }
+
+    /**
+     * @description: 告诉扫描上层只会用到哪些字段。列存格式的表只从页面中取出这些字段和扫描条件用到的字段，
+     *              输出记录中其余字段的内容不确定；其他格式的表仍然输出整条记录
+     * @param {vector<TabCol>&} out_cols 上层用到的字段，不属于本表的字段被忽略
+     */
+    void set_output_cols(const std::vector<TabCol> &out_cols) {
+        if (!fh_->is_pax()) {
+            return;
+        }
+        std::vector<bool> used(cols_.size(), false);
+        auto mark = [&](const TabCol &target) {
+            for (size_t i = 0; i < cols_.size(); i++) {
+                if (cols_[i].tab_name == target.tab_name && cols_[i].name == target.col_name) {
+                    used[i] = true;
+                }
+            }
+        };
+        for (const auto &col: out_cols) {
+            mark(col);
+        }
+        for (const auto &cond: conditions_) {
+            mark(cond.lhs_col);
+            if (!cond.is_rhs_val && !cond.is_rhs_in) {
+                mark(cond.rhs_col);
+            }
+        }
+        fetch_cols_.clear();
+        for (size_t i = 0; i < cols_.size(); i++) {
+            if (used[i]) {
+                fetch_cols_.push_back(static_cast<int>(i));
+            }
+        }
+        fetch_subset_ = true;
+    }
+
+    // 只在记录需要离开页面时复制一次
     std::unique_ptr<RmRecord> Next() override {
         if (is_end()) {
             return nullptr;
         }
-        return fh_->get_record(rid_, context_);
+        return view_.to_record();
     }
 
     Rid &rid() override { return rid_; }
 
-    bool is_end() const override { return scan_->is_end(); }
+    bool is_end() const override { return scan_ == nullptr || scan_->is_end(); }
 
     const std::vector<ColMeta> &cols() const override { return cols_; }
 
@@ -145,4 +222,7 @@ public:
     void set_begin() {
         beginTuple();
     }
+
+private:
+    const std::vector<int> *fetch_cols() const { return fetch_subset_ ? &fetch_cols_ : nullptr; }
 };
\ No newline at end of file
@@ -23,26 +23,18 @@ public:
     RmCompare() {}
 
     bool operator()(const std::unique_ptr<RmRecord> &lhs, const std::unique_ptr<RmRecord> &rhs) {
-        if (order_col_mete.operator bool()) {
+        return (*this)(lhs->data, rhs->data);
+    }
 
-            auto left_value = fetch_value(lhs, *order_col_mete);
-            auto right_value = fetch_value(rhs, *order_col_mete);
-            bool flag = compare_value(left_value, right_value, OP_GT);
-
-//            // 后面符合条件的元组根据排序顺序 (降序 / 升序)
-//            if ((!flag && is_desc) || (flag && !is_desc)) {
-//                return false;
-//            } else {
-//                return true;
-//            }
-            // 调整比较逻辑
-            if (is_desc) {
-                return flag; // 如果降序排序，则 lhs 应该大于 rhs
-            } else {
-                return !flag; // 如果升序排序，则 lhs 应该小于 rhs
-            }
+    // 严格弱序：lhs应当排在rhs之前时返回true，排序键相同的记录互不先于对方
+    bool operator()(const char *lhs, const char *rhs) {
+        if (order_col_mete.operator bool()) {
+            auto left_value = fetch_value(lhs, *order_col_mete, false);
+            auto right_value = fetch_value(rhs, *order_col_mete, false);
+            // 降序排序时lhs应该大于rhs，升序排序时lhs应该小于rhs
+            return compare_value(left_value, right_value, is_desc ? OP_GT : OP_LT);
         }
-        return true;
+        return false;
     }
 
     Rid &rid() override { return _abstract_rid; }
@@ -0,0 +1,226 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "ix_bulk_loader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+#include "errors.h"
+
+IxBulkLoader::IxBulkLoader(IxIndexHandle *ih, int fill_percent, size_t sort_memory)
+        : ih_(ih), key_len_(ih->file_hdr_->col_tot_len_), entry_size_(key_len_ + static_cast<int>(sizeof(Rid))),
+          sort_memory_(sort_memory) {
+    // 内部结点至少要有两个孩子，否则每层的结点数不会减少
+    per_node_ = std::clamp(ih->file_hdr_->btree_order_ * fill_percent / 100, 2, ih->file_hdr_->btree_order_);
+}
+
+IxBulkLoader::~IxBulkLoader() {
+    for (auto &run : runs_) {
+        fclose(run.file);
+    }
+}
+
+void IxBulkLoader::add(const char *key, const Rid &rid) {
+    if (buffer_.size() >= sort_memory_) {
+        spill();
+    }
+    size_t offset = buffer_.size();
+    buffer_.resize(offset + entry_size_);
+    // 按编码后的键排序，与结点中键的顺序相同
+    ih_->encode_key(key, buffer_.data() + offset);
+    memcpy(buffer_.data() + offset + key_len_, &rid, sizeof(Rid));
+    count_++;
+}
+
+void IxBulkLoader::sort_buffer() {
+    size_t n = buffer_.size() / entry_size_;
+    order_.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        order_[i] = static_cast<uint32_t>(i);
+    }
+    const char *base = buffer_.data();
+    std::sort(order_.begin(), order_.end(), [&](uint32_t a, uint32_t b) {
+        return memcmp(base + static_cast<size_t>(a) * entry_size_, base + static_cast<size_t>(b) * entry_size_,
+                      key_len_) < 0;
+    });
+    order_pos_ = 0;
+}
+
+void IxBulkLoader::spill() {
+    sort_buffer();
+    FILE *file = tmpfile();
+    if (file == nullptr) {
+        throw UnixError();
+    }
+    runs_.push_back(Run{file, std::vector<char>(entry_size_)});
+    for (uint32_t idx : order_) {
+        if (fwrite(buffer_.data() + static_cast<size_t>(idx) * entry_size_, entry_size_, 1, file) != 1) {
+            throw UnixError();
+        }
+    }
+    if (fflush(file) != 0) {
+        throw UnixError();
+    }
+    buffer_.clear();
+    order_.clear();
+}
+
+const char *IxBulkLoader::next_entry() {
+    // 1. 没有写出过有序段，直接按顺序读内存中的键值对
+    if (runs_.empty()) {
+        if (order_pos_ == order_.size()) {
+            return nullptr;
+        }
+        return buffer_.data() + static_cast<size_t>(order_[order_pos_++]) * entry_size_;
+    }
+    // 2. 多路归并：堆顶的有序段读出下一个键值对，上次返回的键值对仍在其entry中，所以先保存到buffer_
+    auto greater = [&](int a, int b) { return memcmp(runs_[a].entry.data(), runs_[b].entry.data(), key_len_) > 0; };
+    if (heap_.empty()) {
+        return nullptr;
+    }
+    std::pop_heap(heap_.begin(), heap_.end(), greater);
+    int top = heap_.back();
+    buffer_.assign(runs_[top].entry.begin(), runs_[top].entry.end());
+    if (fread(runs_[top].entry.data(), entry_size_, 1, runs_[top].file) == 1) {
+        std::push_heap(heap_.begin(), heap_.end(), greater);
+    } else {
+        heap_.pop_back();
+    }
+    return buffer_.data();
+}
+
+void IxBulkLoader::finish() {
+    if (finished_) {
+        return;
+    }
+    finished_ = true;
+    if (runs_.empty()) {
+        sort_buffer();
+    } else {
+        if (!buffer_.empty()) {
+            spill();
+        }
+        auto greater = [&](int a, int b) { return memcmp(runs_[a].entry.data(), runs_[b].entry.data(), key_len_) > 0; };
+        for (size_t i = 0; i < runs_.size(); i++) {
+            rewind(runs_[i].file);
+            if (fread(runs_[i].entry.data(), entry_size_, 1, runs_[i].file) == 1) {
+                heap_.push_back(static_cast<int>(i));
+            }
+        }
+        std::make_heap(heap_.begin(), heap_.end(), greater);
+    }
+    std::unique_lock root_lock{ih_->root_latch_};
+    build();
+}
+
+std::vector<int> IxBulkLoader::distribute(size_t n, int per_node) {
+    size_t num_nodes = std::max<size_t>(1, (n + per_node - 1) / per_node);
+    std::vector<int> sizes(num_nodes);
+    for (size_t i = 0; i < num_nodes; i++) {
+        sizes[i] = static_cast<int>(n / num_nodes + (i < n % num_nodes ? 1 : 0));
+    }
+    return sizes;
+}
+
+void IxBulkLoader::build() {
+    IxFileHdr *file_hdr = ih_->file_hdr_;
+    IxNodeHandle *root = ih_->fetch_node(file_hdr->root_page_);
+    bool empty = root->is_leaf_page() && root->get_size() == 0;
+    ih_->buffer_pool_manager_->unpin_page(root->get_page_id(), false);
+    delete root;
+    if (!empty) {
+        throw InternalError("IxBulkLoader: index is not empty");
+    }
+    if (count_ == 0) {
+        return;
+    }
+
+    // 1. 依次写满叶子结点，第一个叶子结点使用原来空的根结点
+    std::vector<char> children_keys;
+    std::vector<page_id_t> children;
+    std::vector<char> last_key(key_len_);
+    IxNodeHandle *prev = nullptr;
+    for (int size : distribute(count_, per_node_)) {
+        IxNodeHandle *leaf = prev == nullptr ? ih_->fetch_node(file_hdr->first_leaf_) : ih_->create_node();
+        leaf->page_hdr->next_free_page_no = IX_NO_PAGE;
+        leaf->page_hdr->parent = IX_NO_PAGE;
+        leaf->page_hdr->num_key = 0;
+        leaf->page_hdr->is_leaf = true;
+        leaf->page_hdr->prev_leaf = prev == nullptr ? IX_LEAF_HEADER_PAGE : prev->get_page_no();
+        leaf->page_hdr->next_leaf = IX_LEAF_HEADER_PAGE;
+        for (int i = 0; i < size; i++) {
+            const char *entry = next_entry();
+            if (children.size() + i > 0 && memcmp(last_key.data(), entry, key_len_) >= 0) {
+                ih_->buffer_pool_manager_->unpin_page(leaf->get_page_id(), true);
+                delete leaf;
+                if (prev != nullptr) {
+                    ih_->buffer_pool_manager_->unpin_page(prev->get_page_id(), true);
+                    delete prev;
+                }
+                throw InternalError("Non-unique index!");
+            }
+            memcpy(last_key.data(), entry, key_len_);
+            Rid rid;
+            memcpy(&rid, entry + key_len_, sizeof(Rid));
+            leaf->insert_pair(i, entry, rid);
+        }
+        if (prev != nullptr) {
+            prev->set_next_leaf(leaf->get_page_no());
+            ih_->buffer_pool_manager_->unpin_page(prev->get_page_id(), true);
+            delete prev;
+        }
+        children_keys.insert(children_keys.end(), leaf->get_key(0), leaf->get_key(0) + key_len_);
+        children.push_back(leaf->get_page_no());
+        prev = leaf;
+    }
+    page_id_t last_leaf = prev->get_page_no();
+    ih_->buffer_pool_manager_->unpin_page(prev->get_page_id(), true);
+    delete prev;
+    IxNodeHandle *leaf_header = ih_->fetch_node(IX_LEAF_HEADER_PAGE);
+    leaf_header->set_prev_leaf(last_leaf);
+    ih_->buffer_pool_manager_->unpin_page(leaf_header->get_page_id(), true);
+    delete leaf_header;
+
+    // 2. 逐层向上建立内部结点，直到只剩一个结点作为根结点
+    while (children.size() > 1) {
+        build_internal_level(&children_keys, &children);
+    }
+    file_hdr->root_page_ = children[0];
+    std::scoped_lock meta_lock{ih_->meta_latch_};
+    file_hdr->last_leaf_ = last_leaf;
+}
+
+void IxBulkLoader::build_internal_level(std::vector<char> *children_keys, std::vector<page_id_t> *children) {
+    std::vector<char> level_keys;
+    std::vector<page_id_t> level;
+    size_t pos = 0;
+    for (int size : distribute(children->size(), per_node_)) {
+        IxNodeHandle *node = ih_->create_node();
+        node->page_hdr->next_free_page_no = IX_NO_PAGE;
+        node->page_hdr->parent = IX_NO_PAGE;
+        node->page_hdr->num_key = 0;
+        node->page_hdr->is_leaf = false;
+        node->page_hdr->prev_leaf = IX_NO_PAGE;
+        node->page_hdr->next_leaf = IX_NO_PAGE;
+        // 内部结点的第i个键是第i个孩子结点的第一个键
+        for (int i = 0; i < size; i++, pos++) {
+            node->insert_pair(i, children_keys->data() + pos * key_len_, Rid{(*children)[pos], -1});
+            ih_->maintain_child(node, i);
+        }
+        level_keys.insert(level_keys.end(), node->get_key(0), node->get_key(0) + key_len_);
+        level.push_back(node->get_page_no());
+        ih_->buffer_pool_manager_->unpin_page(node->get_page_id(), true);
+        delete node;
+    }
+    *children_keys = std::move(level_keys);
+    *children = std::move(level);
+}
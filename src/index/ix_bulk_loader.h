@@ -0,0 +1,90 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <cstdio>
+#include <vector>
+
+#include "ix_index_handle.h"
+
+/**
+ * @description: 自底向上批量建立B+树，用于在已有数据的表上创建索引。
+ * 调用者通过add逐个加入(key, rid)，键在内存中攒满sort_memory字节后排序并写入临时文件（一个有序段），
+ * finish时多路归并所有有序段，按填充率依次写满叶子结点，再逐层向上建立内部结点，不再逐个键从根结点下降和分裂。
+ * 叶子结点按顺序分配页面，页号连续，之后的范围扫描可以利用预读
+ */
+class IxBulkLoader {
+   public:
+    /**
+     * @param {IxIndexHandle*} ih 刚创建的空索引
+     * @param {int} fill_percent 每个结点填入的键占结点容量的百分比，留出的空间供之后的插入使用
+     * @param {size_t} sort_memory 排序时内存中最多缓存的字节数，超过时写出一个有序段
+     */
+    explicit IxBulkLoader(IxIndexHandle *ih, int fill_percent = IX_BULK_LOAD_FILL_PERCENT,
+                          size_t sort_memory = IX_BULK_LOAD_SORT_MEMORY);
+
+    ~IxBulkLoader();
+
+    IxBulkLoader(const IxBulkLoader &) = delete;
+    IxBulkLoader &operator=(const IxBulkLoader &) = delete;
+
+    // 加入一个键值对，key是记录中格式的原始键
+    void add(const char *key, const Rid &rid);
+
+    /**
+     * @description: 归并所有键值对并建立B+树，有重复的键时抛出异常，此时索引的内容不确定，调用者应删除该索引
+     */
+    void finish();
+
+    // 写出的有序段个数
+    size_t num_runs() const { return runs_.size(); }
+
+   private:
+    // 对内存中的键值对排序，结果存入order_
+    void sort_buffer();
+
+    // 将内存中的键值对排序后写入一个新的临时文件
+    void spill();
+
+    /**
+     * @description: 按键的顺序依次读出entry_size_字节的键值对，没有更多的键值对时返回nullptr
+     */
+    const char *next_entry();
+
+    // 自底向上建立B+树，调用者持有root_latch_
+    void build();
+
+    // 建立一层内部结点，children_keys/children中是下一层各结点的第一个键和页号，返回后替换为本层的
+    void build_internal_level(std::vector<char> *children_keys, std::vector<page_id_t> *children);
+
+    // 把n个键值对平均分到最少的结点中，每个结点不超过per_node个，返回各结点的键值对个数
+    static std::vector<int> distribute(size_t n, int per_node);
+
+    IxIndexHandle *ih_;
+    int key_len_;                       // 编码后的键长度
+    int entry_size_;                    // 键值对的长度：键 + Rid
+    int per_node_;                      // 每个结点中的键个数
+    size_t sort_memory_;
+    size_t count_ = 0;                  // 加入的键值对个数
+    bool finished_ = false;
+
+    std::vector<char> buffer_;          // 内存中的键值对，连续存放
+    std::vector<uint32_t> order_;       // 排序后buffer_中的键值对序号
+    size_t order_pos_ = 0;
+
+    /* 写入临时文件的有序段，归并时每个有序段读出当前的键值对 */
+    struct Run {
+        FILE *file;
+        std::vector<char> entry;
+    };
+    std::vector<Run> runs_;
+    std::vector<int> heap_;             // 归并时按当前键组成的小根堆，存放runs_中的下标
+};
@@ -10,6 +10,7 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <cstddef>
 #include <vector>
 
 #include "defs.h"
@@ -21,10 +22,15 @@ constexpr int IX_LEAF_HEADER_PAGE = 1;
 constexpr int IX_INIT_ROOT_PAGE = 2;
 constexpr int IX_INIT_NUM_PAGES = 3;
 constexpr int IX_MAX_COL_LEN = 512;
+constexpr int IX_BULK_LOAD_FILL_PERCENT = 90;                // 批量建立索引时结点的填充率
+constexpr size_t IX_BULK_LOAD_SORT_MEMORY = 64 << 20;       // 批量建立索引时排序使用的内存
+// 索引文件格式的版本：1为键按memcmp可比较的编码存放、页头在page_lsn之后、文件头包含file_lsn_。
+// 旧文件的文件头中没有版本号，读出为0，打开数据库时需要重建
+constexpr int IX_FILE_VERSION = 1;
 
 class IxFileHdr {
 public: 
-    page_id_t first_free_page_no_;      // 文件中第一个空闲的磁盘页面的页面号
+    page_id_t first_free_page_no_;      // 文件中第一个空闲的磁盘页面的页面号，空闲页面通过页头的next_free_page_no串成链表
     int num_pages_;                     // 磁盘文件中页面的数量
     page_id_t root_page_;               // B+树根节点对应的页面号
     int col_num_;                       // 索引包含的字段数量
@@ -37,10 +43,13 @@ public:
     page_id_t first_leaf_;              // 首叶节点对应的页号，在上层IxManager的open函数进行初始化，初始化为root page_no
     page_id_t last_leaf_;               // 尾叶节点对应的页号
     int tot_len_;                       // 记录结构体的整体长度
-    int32_t file_lsn_;
+    int32_t file_lsn_;                  // 文件中的页面已经包含了lsn不超过file_lsn_的所有日志记录的修改，恢复时跳过这些日志记录
+    int version_;                       // 文件格式的版本，见IX_FILE_VERSION
 
     IxFileHdr() {
         tot_len_ = col_num_ = 0;
+        file_lsn_ = -1;
+        version_ = 0;
     }
 
     IxFileHdr(page_id_t first_free_page_no, int num_pages, page_id_t root_page, int col_num,
@@ -49,11 +58,12 @@ public:
                 col_tot_len_(col_tot_len), btree_order_(btree_order), keys_size_(keys_size), first_leaf_(first_leaf), last_leaf_(last_leaf) {
                     tot_len_ = 0;
                     file_lsn_ = -1;
+                    version_ = IX_FILE_VERSION;
                 } 
 
     void update_tot_len() {
         tot_len_ = 0;
-        tot_len_ += sizeof(page_id_t) * 4 + sizeof(int) * 6;
+        tot_len_ += sizeof(page_id_t) * 4 + sizeof(int) * 7 + sizeof(int32_t);
         tot_len_ += sizeof(ColType) * col_num_ + sizeof(int) * col_num_;
     }
 
@@ -87,8 +97,10 @@ public:
         offset += sizeof(page_id_t);
         memcpy(dest + offset, &last_leaf_, sizeof(page_id_t));
         offset += sizeof(page_id_t);
-//        memcpy(dest + offset, &file_lsn_, sizeof(int32_t));
-//        offset += sizeof(int32_t);
+        memcpy(dest + offset, &file_lsn_, sizeof(int32_t));
+        offset += sizeof(int32_t);
+        memcpy(dest + offset, &version_, sizeof(int));
+        offset += sizeof(int);
         assert(offset == tot_len_);
     }
 
@@ -127,15 +139,22 @@ public:
         offset += sizeof(page_id_t);
         last_leaf_ = *reinterpret_cast<const page_id_t*>(src + offset);
         offset += sizeof(page_id_t);
-//        file_lsn_ = *reinterpret_cast<const int32_t*>(src+offset);
-//        offset += sizeof(int32_t);
-        assert(offset == tot_len_);
+        file_lsn_ = *reinterpret_cast<const int32_t*>(src + offset);
+        offset += sizeof(int32_t);
+        // 版本号在文件头的末尾，旧文件的文件头更短，没有这个字段
+        if (offset < tot_len_) {
+            version_ = *reinterpret_cast<const int*>(src + offset);
+            offset += sizeof(int);
+        } else {
+            version_ = 0;
+        }
     }
 };
 
+/* 结点页面的页头，存放在页面的Page::OFFSET_PAGE_HDR处，页面开头是page_lsn */
 class IxPageHdr {
 public:
-    page_id_t next_free_page_no;    // unused
+    page_id_t next_free_page_no;    // 结点被释放后，指向下一个空闲页面
     page_id_t parent;               // 父亲节点所在页面的叶号
     int num_key;                    // # current keys (always equals to #child - 1) 已插入的keys数量，key_idx∈[0,num_key)
     bool is_leaf;                   // 是否为叶节点
@@ -8,30 +8,42 @@ EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
 MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
+#include <algorithm>
 #include <climits>
 #include "ix_index_handle.h"
 
 #include "ix_scan.h"
+#include "recovery/log_manager.h"
+
+/**
+ * @brief 二分查找[lo, hi)中第一个使before(key_idx)为false的key_idx，before在该区间上必须先为true后为false
+ */
+template <typename Before>
+static int ix_partition_point(int lo, int hi, Before before) {
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (before(mid)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
 
 /**
  * @brief 在当前node中查找第一个>=target的key_idx
  *
  * @return key_idx，范围为[0,num_key)，如果返回的key_idx=num_key，则表示target大于最后一个key
- * @note 返回key index（同时也是rid index），作为slot no
+ * @note 返回key index（同时也是rid index），作为slot no。target和结点中的键都是编码后的键，
+ * 单个INT字段的索引按无符号整数比较，其余索引用memcmp比较
  */
 int IxNodeHandle::lower_bound(const char *target) const {
-    // 查找当前节点中第一个大于等于target的key，并返回key的位置给上层
-
-    // 提示: 可以采用多种查找方式，如顺序遍历、二分查找等；使用ix_compare()函数进行比较
-
-    // 顺序查找
-    int key_idx = 0;
-    for (; key_idx < page_hdr->num_key; key_idx++) {
-        if (ix_compare(target, get_key(key_idx), file_hdr->col_types_, file_hdr->col_lens_) <= 0) {
-            break;
-        }
+    if (file_hdr->col_num_ == 1 && file_hdr->col_types_[0] == TYPE_INT) {
+        uint32_t tar = ix_load_be32(target);
+        return ix_partition_point(0, page_hdr->num_key, [&](int idx) { return ix_load_be32(get_key(idx)) < tar; });
     }
-    return key_idx;
+    return ix_partition_point(0, page_hdr->num_key, [&](int idx) { return compare_key(get_key(idx), target) < 0; });
 }
 
 /**
@@ -41,17 +53,14 @@ int IxNodeHandle::lower_bound(const char *target) const {
  * @note 注意此处的范围从1开始
  */
 int IxNodeHandle::upper_bound(const char *target) const {
-    // 查找当前节点中第一个大于target的key，并返回key的位置给上层
-
-    // 提示: 可以采用多种查找方式：顺序遍历、二分查找等；使用ix_compare()函数进行比较
-    // 顺序查找
-    int key_idx = 1;
-    for (; key_idx < page_hdr->num_key; key_idx++) {
-        if (ix_compare(target, get_key(key_idx), file_hdr->col_types_, file_hdr->col_lens_) < 0) {
-            break;
-        }
+    if (page_hdr->num_key <= 1) {
+        return 1;
     }
-    return key_idx;
+    if (file_hdr->col_num_ == 1 && file_hdr->col_types_[0] == TYPE_INT) {
+        uint32_t tar = ix_load_be32(target);
+        return ix_partition_point(1, page_hdr->num_key, [&](int idx) { return ix_load_be32(get_key(idx)) <= tar; });
+    }
+    return ix_partition_point(1, page_hdr->num_key, [&](int idx) { return compare_key(get_key(idx), target) <= 0; });
 }
 
 /**
@@ -64,10 +73,7 @@ int IxNodeHandle::upper_bound(const char *target) const {
  */
 bool IxNodeHandle::leaf_lookup(const char *key, Rid **value) {
     int tar_idx = lower_bound(key);
-    char *tar_key = get_key(tar_idx);
-    if (tar_key == nullptr || std::strcmp(tar_key, key) != 0
-        || ix_compare(tar_key, key, file_hdr->col_types_, file_hdr->col_lens_) != 0
-        || tar_idx == get_size()) {
+    if (tar_idx == get_size() || compare_key(get_key(tar_idx), key) != 0) {
         return false;
     }
     *value = get_rid(tar_idx);
@@ -137,8 +143,7 @@ void IxNodeHandle::insert_pairs(int pos, const char *key, const Rid *rid, int n)
  */
 int IxNodeHandle::insert(const char *key, const Rid &value) {
     int pos = lower_bound(key);
-    if (pos == get_size() ||
-        ix_compare(get_key(pos), key, file_hdr->col_types_, file_hdr->col_lens_) > 0) {
+    if (pos == get_size() || compare_key(get_key(pos), key) > 0) {
         insert_pair(pos, key, value);
     }
     return get_size();
@@ -176,14 +181,16 @@ void IxNodeHandle::erase_pair(int pos) {
 int IxNodeHandle::remove(const char *key) {
     int key_idx = lower_bound(key);
     if (key_idx != page_hdr->num_key
-        && (ix_compare(get_key(key_idx), key, file_hdr->col_types_, file_hdr->col_lens_) == 0)) {
+        && compare_key(get_key(key_idx), key) == 0) {
         erase_pair(key_idx);
     }
     return page_hdr->num_key;
 }
 
-IxIndexHandle::IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd)
-        : disk_manager_(disk_manager), buffer_pool_manager_(buffer_pool_manager), fd_(fd) {
+IxIndexHandle::IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd,
+                             LogManager *log_manager)
+        : disk_manager_(disk_manager), buffer_pool_manager_(buffer_pool_manager), fd_(fd), log_manager_(log_manager),
+          index_name_(disk_manager->get_file_name(fd)) {
     // init file_hdr_
     disk_manager_->read_page(fd, IX_FILE_HDR_PAGE, (char *) &file_hdr_, sizeof(file_hdr_));
     char buf[PAGE_SIZE];
@@ -192,9 +199,10 @@ IxIndexHandle::IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffe
     file_hdr_ = new IxFileHdr();
     file_hdr_->deserialize(buf);
 
-    // disk_manager管理的fd对应的文件中，设置从file_hdr_->num_pages开始分配page_no
-    int now_page_no = disk_manager_->get_fd2pageno(fd);
-    disk_manager_->set_fd2pageno(fd, now_page_no + 1);
+    // disk_manager管理的fd对应的文件中，设置从file_hdr_->num_pages开始分配page_no，并恢复已经释放的页面
+    disk_manager_->set_fd2pageno(fd, file_hdr_->num_pages_);
+    disk_manager_->load_free_pages(fd, file_hdr_->first_free_page_no_,
+                                   Page::OFFSET_PAGE_HDR + offsetof(IxPageHdr, next_free_page_no));
 }
 
 // IxIndexHandle的析构函数
@@ -204,33 +212,86 @@ IxIndexHandle::~IxIndexHandle() {
 
 /**
  * @brief 用于查找指定键所在的叶子结点
- * @param key 要查找的目标key值
+ * @param key 要查找的目标key值（编码后的键）
  * @param operation 查找到目标键值对后要进行的操作类型
  * @param transaction 事务参数，如果不需要则默认传入nullptr
  * @return [leaf node] and [root_is_latched] 返回目标叶子结点以及根结点是否加锁
  * @note need to Unlatch and unpin the leaf node outside!
- * 注意：用了FindLeafPage之后一定要unlatch叶结点，否则下次latch该结点会堵塞！
+ * 注意：用了FindLeafPage之后一定要调用release_leaf释放叶结点，否则下次latch该结点会堵塞！
+ * 查找时叶子结点加读latch；插入、删除时叶子结点加写latch，内部结点只加读latch（乐观下降），
+ * 叶子结点修改后需要分裂时调用者应释放叶子结点，改用find_leaf_pessimistic重新下降
  */
 std::pair<IxNodeHandle *, bool> IxIndexHandle::find_leaf_page(const char *key, Operation operation,
                                                               Transaction *transaction, bool find_first) {
-    // 1. 获取根节点
-    IxNodeHandle *root_hdl = fetch_node(file_hdr_->root_page_);
-    IxNodeHandle *cur_hdl = root_hdl;
-
-    // 2. 从根节点不断向下查找目标key
-    while (!cur_hdl->is_leaf_page()) {
-        page_id_t child_page_no = cur_hdl->internal_lookup(key);
-        buffer_pool_manager_->unpin_page(cur_hdl->get_page_id(), false);
-        delete cur_hdl;
-        cur_hdl = fetch_node(child_page_no);
+    // 1. 获取根节点，锁住根结点之前根结点页号不能改变
+    std::shared_lock root_lock{root_latch_};
+    IxNodeHandle *cur_hdl = fetch_node(file_hdr_->root_page_);
+    IxNodeHandle *parent_hdl = nullptr;
+
+    // 2. 从根节点不断向下查找目标key，锁住孩子结点之后释放父结点
+    while (true) {
+        if (operation != Operation::FIND && cur_hdl->is_leaf_page()) {
+            cur_hdl->page->rw_latch_.lock_write();
+        } else {
+            cur_hdl->page->rw_latch_.lock_read();
+        }
+        if (parent_hdl != nullptr) {
+            parent_hdl->page->rw_latch_.unlock_read();
+            buffer_pool_manager_->unpin_page(parent_hdl->get_page_id(), false);
+            delete parent_hdl;
+        } else {
+            root_lock.unlock();
+        }
+        if (cur_hdl->is_leaf_page()) {
+            break;
+        }
+        parent_hdl = cur_hdl;
+        cur_hdl = fetch_node(cur_hdl->internal_lookup(key));
     }
 
     // 3. 找到包含该key值的叶子结点停止查找，并返回叶子节点
     return {cur_hdl, find_first};
-//    for(int i = 0; i < cur_hdl->get_size(); i++){
-//        if(cur_hdl->key_at(i) == *(int *)key) return {cur_hdl, find_first};
-//    }
-//    return {nullptr,false};
+}
+
+/**
+ * @brief 悲观下降：对路径上的结点加写latch，遇到执行operation之后仍然安全的结点时释放其所有祖先结点
+ *
+ * @param key 要查找的目标key值（编码后的键）
+ * @param write_set 传出参数，叶子结点和仍持有写latch的祖先结点，用完后调用release_write_set释放
+ * @return 目标叶子结点，也是write_set中的最后一个结点
+ * @note 根结点不安全时返回后仍持有root_latch_的排他锁，此时根结点可以分裂
+ */
+IxNodeHandle *IxIndexHandle::find_leaf_pessimistic(const char *key, Operation operation, WriteSet *write_set) {
+    root_latch_.lock();
+    write_set->root_locked = true;
+    IxNodeHandle *cur_hdl = fetch_node(file_hdr_->root_page_);
+    while (true) {
+        cur_hdl->page->rw_latch_.lock_write();
+        if (cur_hdl->is_safe(operation)) {
+            release_write_set(write_set, false);
+        }
+        write_set->nodes.push_back(cur_hdl);
+        if (cur_hdl->is_leaf_page()) {
+            return cur_hdl;
+        }
+        cur_hdl = fetch_node(cur_hdl->internal_lookup(key));
+    }
+}
+
+/**
+ * @brief 释放write_set中所有结点的写latch并unpin，需要时释放root_latch_
+ */
+void IxIndexHandle::release_write_set(WriteSet *write_set, bool is_dirty) {
+    if (write_set->root_locked) {
+        root_latch_.unlock();
+        write_set->root_locked = false;
+    }
+    for (auto node : write_set->nodes) {
+        node->page->rw_latch_.unlock_write();
+        buffer_pool_manager_->unpin_page(node->get_page_id(), is_dirty);
+        delete node;
+    }
+    write_set->nodes.clear();
 }
 
 /**
@@ -242,39 +303,45 @@ std::pair<IxNodeHandle *, bool> IxIndexHandle::find_leaf_page(const char *key, O
  * @return bool 返回目标键值对是否存在
  */
 bool IxIndexHandle::get_value(const char *key, std::vector<Rid> *result, Transaction *transaction) {
-    std::scoped_lock lock{root_latch_};
+    // 结点中存放的是编码后的键
+    char encoded[IX_MAX_COL_LEN];
+    key = encode_key(key, encoded);
 
-    // 1. 获取目标key值所在的叶子结点
+    // 1. 获取目标key值所在的叶子结点，返回时叶子结点持有读latch
     auto leaf_hdl = find_leaf_page(key, Operation::FIND, transaction).first;
 
     // 2. 在叶子节点中查找目标key值的位置，并读取key对应的rid
     Rid *rid;
-    if (!leaf_hdl->leaf_lookup(key, &rid)) {
-        return false;
-    }
-
-    // 提示：使用完buffer_pool提供的page之后，记得unpin page；记得处理并发的上锁
-    buffer_pool_manager_->unpin_page(leaf_hdl->get_page_id(), false);
+    bool found = leaf_hdl->leaf_lookup(key, &rid);
 
     // 3. 把rid存入result参数中
-    result->push_back(*rid);
-
-    delete leaf_hdl;
+    if (found) {
+        result->push_back(*rid);
+    }
 
-    return true;
+    release_leaf(leaf_hdl, Operation::FIND, false);
+    return found;
 
 }
 
 /**
  * @brief  将传入的一个node拆分(Split)成两个结点，在node的右边生成一个新结点new node
  * @param node 需要拆分的结点
+ * @param new_pages 不为nullptr时记录新结点的页号，用于写日志
+ * @param touched 不为nullptr时，被修改的右兄弟结点和孩子结点不在这里unpin，而是放入touched，由调用者在日志刷盘之后释放
  * @return 拆分得到的new_node
  * @note need to unpin the new node outside
  * 注意：本函数执行完毕后，原node和new node都需要在函数外面进行unpin
+ * 调用者持有node的写latch，新结点还不能从树中访问到，不需要加latch。右兄弟结点的prev_leaf
+ * 和孩子结点的parent只由持有这些结点的父结点或左兄弟结点写latch的写操作读写，这里直接修改，不加latch
  */
-IxNodeHandle *IxIndexHandle::split(IxNodeHandle *node) {
+IxNodeHandle *IxIndexHandle::split(IxNodeHandle *node, std::vector<page_id_t> *new_pages,
+                                   std::vector<IxNodeHandle *> *touched) {
     // 1. 将原结点的键值对平均分配，右半部分分裂为新的右兄弟结点
     IxNodeHandle *new_hdl = create_node();
+    if (new_pages != nullptr) {
+        new_pages->push_back(new_hdl->get_page_no());
+    }
     //初始化新节点 page_hdr
     new_hdl->page_hdr->is_leaf = node->page_hdr->is_leaf;
     new_hdl->page_hdr->num_key = 0;
@@ -289,9 +356,12 @@ IxNodeHandle *IxIndexHandle::split(IxNodeHandle *node) {
         IxNodeHandle *next_node = fetch_node(new_hdl->page_hdr->next_leaf);
 
         next_node->page_hdr->prev_leaf = new_hdl->get_page_no();
-        buffer_pool_manager_->unpin_page(next_node->get_page_id(), true);
-
-        delete next_node;
+        if (touched != nullptr) {
+            touched->push_back(next_node);
+        } else {
+            buffer_pool_manager_->unpin_page(next_node->get_page_id(), true);
+            delete next_node;
+        }
     }
 
     int pos = node->page_hdr->num_key / 2;
@@ -299,7 +369,7 @@ IxNodeHandle *IxIndexHandle::split(IxNodeHandle *node) {
     new_hdl->insert_pairs(0, node->get_key(pos), node->get_rid(pos), n);
     node->page_hdr->num_key = pos;
     for (int i = 0; i < n; i++) {
-        maintain_child(new_hdl, i);
+        maintain_child(new_hdl, i, touched);
     }
     return new_hdl;
 }
@@ -313,17 +383,23 @@ IxNodeHandle *IxIndexHandle::split(IxNodeHandle *node) {
  *
  * @param (old_page, new_page) 原结点为old_page，old_page被分裂之后产生了新的右兄弟结点new_page
  * @param key 要插入parent的key
+ * @param new_pages 不为nullptr时记录分裂产生的新结点和新根结点的页号，用于写日志
+ * @param touched 不为nullptr时，新根结点、分裂产生的新结点以及split修改的其他结点放入touched，由调用者在日志刷盘之后释放
  * @note 一个结点插入了键值对之后需要分裂，分裂后左半部分的键值对保留在原结点，在参数中称为old_page，
  * 右半部分的键值对分裂为新的右兄弟节点，在参数中称为new_page（参考Split函数来理解old_page和new_page）
  * @note 本函数执行完毕后，new page和old page都需要在函数外面进行unpin
  */
 void IxIndexHandle::insert_into_parent(IxNodeHandle *old_page, const char *key, IxNodeHandle *new_page,
-                                       Transaction *transaction) {
+                                       Transaction *transaction, std::vector<page_id_t> *new_pages,
+                                       std::vector<IxNodeHandle *> *touched) {
 
     // 1. 分裂前的结点（原结点, old_page）是否为根结点，如果为根结点需要分配新的root
     if (old_page->is_root_page()) {
         // 创建一个新的根结点
         IxNodeHandle *new_root_page = create_node();
+        if (new_pages != nullptr) {
+            new_pages->push_back(new_root_page->get_page_no());
+        }
 
         // 初始化新的根结点
         new_root_page->page_hdr->num_key = 0;
@@ -344,7 +420,12 @@ void IxIndexHandle::insert_into_parent(IxNodeHandle *old_page, const char *key,
         old_page->page_hdr->parent = new_root_page_no;
 
         // 释放new_root_page
-        delete new_root_page;
+        if (touched != nullptr) {
+            touched->push_back(new_root_page);
+        } else {
+            buffer_pool_manager_->unpin_page(new_root_page->get_page_id(), true);
+            delete new_root_page;
+        }
     } else {
 
         // 2. 获取原结点（old_page）的父亲结点
@@ -357,16 +438,19 @@ void IxIndexHandle::insert_into_parent(IxNodeHandle *old_page, const char *key,
         // 4. 如果父亲结点仍需要继续分裂，则进行递归插入
         if (parent_page->get_size() == parent_page->get_max_size()) {
             // 分裂父节点
-            IxNodeHandle *new_parent_page = split(parent_page);
+            IxNodeHandle *new_parent_page = split(parent_page, new_pages, touched);
 
             // 递归将new_parent_page的第一个key插入到其父节点中
-            insert_into_parent(parent_page, new_parent_page->get_key(0), new_parent_page, transaction);
+            insert_into_parent(parent_page, new_parent_page->get_key(0), new_parent_page, transaction, new_pages,
+                               touched);
 
             // 解除固定新的父节点页面
-            buffer_pool_manager_->unpin_page(new_parent_page->get_page_id(), true);
-
-            // 释放new_parent_page
-            delete new_parent_page;
+            if (touched != nullptr) {
+                touched->push_back(new_parent_page);
+            } else {
+                buffer_pool_manager_->unpin_page(new_parent_page->get_page_id(), true);
+                delete new_parent_page;
+            }
         }
         // 解除固定父节点页面
         buffer_pool_manager_->unpin_page(parent_page->get_page_id(), true);
@@ -382,64 +466,89 @@ void IxIndexHandle::insert_into_parent(IxNodeHandle *old_page, const char *key,
  * @param (ins_key, ins_value) 要插入的键值对
  * @param txn 事务指针
  * @return page_id_t 插入到的叶结点的page_no
+ * @note 先乐观地只对叶子结点加写latch，插入后叶子结点不需要分裂时直接完成；否则从根结点悲观下降重新插入。
+ * 被修改的结点在日志刷盘之后才unpin，缓冲池换出页面时不会写回还没有持久化日志的修改
  */
 page_id_t IxIndexHandle::insert_entry(const char *ins_key, const Rid &ins_value, Transaction *txn) {
-    // 加锁以确保操作的原子性
-    std::scoped_lock tree_lock{root_latch_};
+    // 结点中存放的是编码后的键，日志中记录原始键
+    const char *raw_key = ins_key;
+    char encoded[IX_MAX_COL_LEN];
+    ins_key = encode_key(ins_key, encoded);
 
     // 1. 查找ins_key值应该插入到哪个叶子节点
-    std::pair<IxNodeHandle *, bool> leaf_page_result = find_leaf_page(ins_key, Operation::INSERT, txn);
-
-    // 找不到应该插入哪个叶子节点
-    if (!leaf_page_result.first) {
-        throw IndexEntryNotFoundError();
-    }
-
-    // 获取叶子节点句柄
-    IxNodeHandle *leaf_node_handle = leaf_page_result.first;
+    IxNodeHandle *leaf_node_handle = find_leaf_page(ins_key, Operation::INSERT, txn).first;
 
     // 检查是否存在重复的键
     if (leaf_node_handle->is_exist_key(ins_key)) {
+        release_leaf(leaf_node_handle, Operation::INSERT, false);
         throw InternalError("Non-unique index!");
     }
 
-    // 获取当前叶子节点的大小
-    int current_size = leaf_node_handle->get_size();
+    // 2. 插入后不需要分裂，直接在该叶子节点中插入键值对
+    if (leaf_node_handle->is_safe(Operation::INSERT)) {
+        leaf_node_handle->insert(ins_key, ins_value);
+        page_id_t leaf_page_no = leaf_node_handle->get_page_no();
+        if (is_logged(txn)) {
+            lsn_t lsn = append_log(new IxInsertLogRecord(txn->get_transaction_id(), index_name_, raw_key,
+                                                         file_hdr_->col_tot_len_, ins_value, leaf_page_no), txn);
+            leaf_node_handle->page->set_page_lsn(lsn);
+            log_manager_->flush_log_to_disk();
+        }
+        release_leaf(leaf_node_handle, Operation::INSERT, true);
+        return leaf_page_no;
+    }
+    release_leaf(leaf_node_handle, Operation::INSERT, false);
 
-    // 2. 在该叶子节点中插入键值对
+    // 3. 叶子结点需要分裂，悲观下降，持有所有可能被修改的结点的写latch
+    WriteSet write_set;
+    leaf_node_handle = find_leaf_pessimistic(ins_key, Operation::INSERT, &write_set);
+    int current_size = leaf_node_handle->get_size();
     if (leaf_node_handle->insert(ins_key, ins_value) == current_size) {
-        // 如果插入后键值对数量不变，解除页面固定并返回-1
-        buffer_pool_manager_->unpin_page(leaf_node_handle->get_page_id(), false);
-        return -1;
-    } else if (leaf_node_handle->get_size() == leaf_node_handle->get_max_size()) {
-        // 3. 如果结点已满，分裂结点，并把新结点的相关信息插入父节点
-        IxNodeHandle *new_leaf_node = split(leaf_node_handle);
+        // 释放latch期间其他事务插入了相同的键
+        release_write_set(&write_set, false);
+        throw InternalError("Non-unique index!");
+    }
+    page_id_t leaf_page_no = leaf_node_handle->get_page_no();
+    IxLogRecord *log_record = nullptr;
+    if (is_logged(txn)) {
+        log_record = new IxInsertLogRecord(txn->get_transaction_id(), index_name_, raw_key, file_hdr_->col_tot_len_,
+                                           ins_value, leaf_page_no);
+    }
+    std::vector<page_id_t> new_pages;
+    std::vector<IxNodeHandle *> touched;    // 分裂时修改的write_set之外的结点
+    if (leaf_node_handle->get_size() == leaf_node_handle->get_max_size()) {
+        // 4. 如果结点已满，分裂结点，并把新结点的相关信息插入父节点
+        page_id_t old_root = file_hdr_->root_page_;
+        IxNodeHandle *new_leaf_node = split(leaf_node_handle, &new_pages, &touched);
 
         // 如果该叶子是最后一片叶子，更新文件头部的最后叶子节点页号
-        if (leaf_node_handle->get_page_no() == file_hdr_->last_leaf_) {
-            file_hdr_->last_leaf_ = new_leaf_node->get_page_no();
+        {
+            std::scoped_lock meta_lock{meta_latch_};
+            if (leaf_node_handle->get_page_no() == file_hdr_->last_leaf_) {
+                file_hdr_->last_leaf_ = new_leaf_node->get_page_no();
+                if (log_record != nullptr) {
+                    log_record->last_leaf_ = file_hdr_->last_leaf_;
+                }
+            }
         }
 
-        // 将新叶子节点的第一个键插入到父节点
-        insert_into_parent(leaf_node_handle, new_leaf_node->get_key(0), new_leaf_node, txn);
+        // 将新叶子节点的第一个键插入到父节点，父结点已经在write_set中持有写latch
+        insert_into_parent(leaf_node_handle, new_leaf_node->get_key(0), new_leaf_node, txn, &new_pages, &touched);
 
-        // 解除页面固定
-        buffer_pool_manager_->unpin_page(leaf_node_handle->get_page_id(), true);
+        // 只有持有root_latch_的排他锁时根结点才可能分裂
+        if (log_record != nullptr && write_set.root_locked && file_hdr_->root_page_ != old_root) {
+            log_record->root_page_ = file_hdr_->root_page_;
+        }
 
-        // 释放新叶子节点句柄
-        delete new_leaf_node;
+        touched.push_back(new_leaf_node);
     }
-
-    // 解除页面固定
-    buffer_pool_manager_->unpin_page(leaf_node_handle->get_page_id(), false);
-
-    // 获取叶子节点的页面编号
-    auto leaf_page_id = leaf_node_handle->get_page_no();
-
-    // 释放叶子节点句柄
-    delete leaf_node_handle;
-
-    return leaf_page_id;
+    if (log_record != nullptr) {
+        log_split(log_record, &write_set, new_pages, txn);
+        log_manager_->flush_log_to_disk();
+    }
+    release_write_set(&write_set, true);
+    release_touched(&touched);
+    return leaf_page_no;
 }
 
 
@@ -448,32 +557,180 @@ page_id_t IxIndexHandle::insert_entry(const char *ins_key, const Rid &ins_value,
  * @param key 要删除的key值
  * @param transaction 事务指针
  * @return 如果删除成功返回true，否则返回false
+ * @note 结点不会被合并，删除只修改叶子结点，因此只需要乐观下降。
+ * 父结点中的分隔键仍然是右侧孩子结点中所有键的下界，删除叶子结点的第一个键之后不需要更新父结点
  */
 bool IxIndexHandle::delete_entry(const char *key, Transaction *transaction) {
-    // 加锁以确保操作的原子性
-    std::scoped_lock tree_lock{root_latch_};
-    bool is_root_locked = true;
+    // 结点中存放的是编码后的键，日志中记录原始键
+    const char *raw_key = key;
+    char encoded[IX_MAX_COL_LEN];
+    key = encode_key(key, encoded);
 
     // 1. 获取该键值对所在的叶子结点
-    auto leaf_page_result = find_leaf_page(key, Operation::DELETE, transaction);
-    IxNodeHandle *leaf_node_handle = leaf_page_result.first;
+    IxNodeHandle *leaf_node_handle = find_leaf_page(key, Operation::DELETE, transaction).first;
 
     // 2. 在该叶子结点中删除键值对
-    if (leaf_node_handle->get_size() == leaf_node_handle->remove(key)) {
-        // 2.1 删除失败，解锁并返回false
-        buffer_pool_manager_->unpin_page(leaf_node_handle->get_page_id(), false);
+    int key_idx = leaf_node_handle->lower_bound(key);
+    bool removed = key_idx < leaf_node_handle->get_size() &&
+                   leaf_node_handle->compare_key(leaf_node_handle->get_key(key_idx), key) == 0;
+    bool logged = removed && is_logged(transaction);
+    if (removed) {
+        Rid rid = *leaf_node_handle->get_rid(key_idx);
+        leaf_node_handle->erase_pair(key_idx);
+        if (logged) {
+            lsn_t lsn = append_log(new IxDeleteLogRecord(transaction->get_transaction_id(), index_name_, raw_key,
+                                                         file_hdr_->col_tot_len_, rid,
+                                                         leaf_node_handle->get_page_no()), transaction);
+            leaf_node_handle->page->set_page_lsn(lsn);
+            log_manager_->flush_log_to_disk();
+        }
+    }
+    release_leaf(leaf_node_handle, Operation::DELETE, removed);
+    return removed;
+}
 
-        delete leaf_node_handle;
-        return false;
+/**
+ * @brief 把索引日志记录接到事务txn的日志链上并写入日志缓冲区
+ * @return lsn_t 日志记录的lsn
+ */
+lsn_t IxIndexHandle::append_log(IxLogRecord *log_record, Transaction *txn) {
+    log_record->prev_lsn_ = txn->get_prev_lsn();
+    lsn_t lsn = log_manager_->add_ix_log_record(log_record);
+    txn->set_prev_lsn(lsn);
+    return lsn;
+}
+
+/**
+ * @brief 悲观插入完成后写日志并设置被修改结点的page_lsn
+ *
+ * @param log_record 已经填好键、根结点和最后一个叶子结点的日志记录
+ * @param write_set 持有写latch的结点，叶子结点在最后
+ * @param new_pages 分裂产生的新结点，为空时叶子结点没有分裂，只记录插入的键
+ * @note 发生分裂时write_set中的结点都被修改过：最上面的结点插入了分隔键，其余结点都分裂了。
+ * 新结点仍被调用者固定，调用者在日志刷盘之后才unpin
+ */
+lsn_t IxIndexHandle::log_split(IxLogRecord *log_record, WriteSet *write_set, const std::vector<page_id_t> &new_pages,
+                               Transaction *txn) {
+    if (new_pages.empty()) {
+        lsn_t lsn = append_log(log_record, txn);
+        write_set->nodes.back()->page->set_page_lsn(lsn);
+        return lsn;
+    }
+    for (auto node : write_set->nodes) {
+        log_record->add_image(node->get_page_no(), false, node->page->get_data());
+    }
+    // 新结点还不能从树中访问到，不需要加latch
+    std::vector<IxNodeHandle *> new_nodes;
+    for (page_id_t page_no : new_pages) {
+        IxNodeHandle *node = fetch_node(page_no);
+        log_record->add_image(page_no, true, node->page->get_data());
+        new_nodes.push_back(node);
+    }
+    lsn_t lsn = append_log(log_record, txn);
+    for (auto node : write_set->nodes) {
+        node->page->set_page_lsn(lsn);
+    }
+    for (auto node : new_nodes) {
+        node->page->set_page_lsn(lsn);
+        buffer_pool_manager_->unpin_page(node->get_page_id(), true);
+        delete node;
     }
+    return lsn;
+}
 
-    // 3. 如果删除成功需要调用CoalesceOrRedistribute来进行合并或重分配操作，并根据函数返回结果判断是否有结点需要删除
-    coalesce_or_redistribute(leaf_node_handle, transaction, &is_root_locked);
-    buffer_pool_manager_->unpin_page(leaf_node_handle->get_page_id(), true);
+/**
+ * @brief unpin分裂时修改的结点，需要在日志刷盘之后调用
+ */
+void IxIndexHandle::release_touched(std::vector<IxNodeHandle *> *touched) {
+    for (auto node : *touched) {
+        buffer_pool_manager_->unpin_page(node->get_page_id(), true);
+        delete node;
+    }
+    touched->clear();
+}
 
-    // 删除叶子结点句柄
-    delete leaf_node_handle;
-    return true;
+/**
+ * @brief 恢复时获取一个结点。崩溃前新分配的结点可能还没有写回，此时先在文件末尾补上空页面，并将结点从空闲页面中移除
+ */
+IxNodeHandle *IxIndexHandle::fetch_node_for_redo(page_id_t page_no) {
+    int file_pages = disk_manager_->get_file_size(index_name_) / PAGE_SIZE;
+    if (page_no >= file_pages) {
+        char zero_page[PAGE_SIZE] = {};
+        for (page_id_t i = file_pages; i <= page_no; i++) {
+            disk_manager_->write_page(fd_, i, zero_page, PAGE_SIZE);
+        }
+    }
+    // 文件头和空闲页面链表只在关闭索引时写回，崩溃后其中的页面个数可能偏小，被复用的页面可能仍在空闲页面中。
+    // 日志记录涉及的结点一定已经分配，从空闲页面中移除，避免之后再次被分配
+    disk_manager_->allocate_page_at(fd_, page_no);
+    file_hdr_->num_pages_ = std::max(file_hdr_->num_pages_, page_no + 1);
+    return fetch_node(page_no);
+}
+
+/**
+ * @brief 恢复时重做一条索引日志记录，只访问日志记录中涉及的结点
+ *
+ * @param log_record 索引插入或删除的日志记录
+ * @note lsn不超过file_lsn_的日志记录已经全部写回，直接跳过；page_lsn不小于日志lsn的结点已经包含了该修改。
+ * 恢复时没有其他线程访问索引，不加latch
+ */
+void IxIndexHandle::redo(IxLogRecord *log_record) {
+    lsn_t lsn = log_record->lsn_;
+    if (lsn <= file_hdr_->file_lsn_) {
+        return;
+    }
+
+    // 1. 没有分裂，在叶子结点中重新插入或删除该键
+    if (log_record->images_.empty()) {
+        IxNodeHandle *leaf = fetch_node_for_redo(log_record->leaf_page_no_);
+        bool redone = leaf->page->get_page_lsn() < lsn;
+        if (redone) {
+            char encoded[IX_MAX_COL_LEN];
+            const char *key = encode_key(log_record->key_.data(), encoded);
+            if (log_record->log_type_ == LogType::IX_INSERT) {
+                leaf->insert(key, log_record->rid_);
+            } else {
+                leaf->remove(key);
+            }
+            leaf->page->set_page_lsn(lsn);
+        }
+        buffer_pool_manager_->unpin_page(leaf->get_page_id(), redone);
+        delete leaf;
+        return;
+    }
+
+    // 2. 发生了分裂，恢复被修改结点的页面
+    for (auto &image : log_record->images_) {
+        IxNodeHandle *node = fetch_node_for_redo(image.page_no);
+        bool redone = node->page->get_page_lsn() < lsn;
+        if (redone) {
+            memcpy(node->page->get_data(), image.data.data(), PAGE_SIZE);
+            node->page->set_page_lsn(lsn);
+        }
+        // 新结点的孩子结点和右侧叶子结点没有记录页面，按新结点当前的内容重新设置
+        if (image.is_new) {
+            if (node->is_leaf_page()) {
+                IxNodeHandle *next = fetch_node_for_redo(node->get_next_leaf());
+                next->set_prev_leaf(node->get_page_no());
+                buffer_pool_manager_->unpin_page(next->get_page_id(), true);
+                delete next;
+            } else {
+                for (int i = 0; i < node->get_size(); i++) {
+                    maintain_child(node, i);
+                }
+            }
+        }
+        buffer_pool_manager_->unpin_page(node->get_page_id(), redone);
+        delete node;
+    }
+
+    // 3. 文件头只在关闭索引时写回，按日志顺序重做根结点和最后一个叶子结点的变化
+    if (log_record->root_page_ != INVALID_PAGE_ID) {
+        file_hdr_->root_page_ = log_record->root_page_;
+    }
+    if (log_record->last_leaf_ != INVALID_PAGE_ID) {
+        file_hdr_->last_leaf_ = log_record->last_leaf_;
+    }
 }
 
 
@@ -562,13 +819,10 @@ bool IxIndexHandle::adjust_root(IxNodeHandle *original_root_node) {
 
         return true;
     }
-    // 2. 如果original_root_node是叶结点，且大小为0，则直接更新root page
+    // 2. 如果original_root_node是叶结点，且大小为0，树变为空树。
+    // 保留这个空的根结点：叶子链表仍然指向它，之后的插入也从它开始，因此不能释放
     if (original_root_node->is_leaf_page() && original_root_node->get_size() == 0) {
-        // 释放旧的根节点句柄
-        release_node_handle(*original_root_node);
-        // 将文件头中的根节点页面号设置为无效
-        file_hdr_->root_page_ = INVALID_PAGE_ID;
-        return true;
+        return false;
     }
     // 3. 除了上述两种情况，不需要进行操作
     return false;
@@ -655,8 +909,11 @@ bool IxIndexHandle::coalesce(IxNodeHandle **neighbor_node, IxNodeHandle **node,
     }
 
     // 提示：如果是叶子结点且为最右叶子结点，需要更新file_hdr_.last_leaf
-    if ((*node)->get_page_no() == file_hdr_->last_leaf_) {
-        file_hdr_->last_leaf_ = (*neighbor_node)->get_page_no();
+    {
+        std::scoped_lock meta_lock{meta_latch_};
+        if ((*node)->get_page_no() == file_hdr_->last_leaf_) {
+            file_hdr_->last_leaf_ = (*neighbor_node)->get_page_no();
+        }
     }
 
     // 3. 释放和删除node结点，并删除parent中node结点的信息，返回parent是否需要被删除
@@ -678,12 +935,36 @@ bool IxIndexHandle::coalesce(IxNodeHandle **neighbor_node, IxNodeHandle **node,
  */
 Rid IxIndexHandle::get_rid(const Iid &iid) const {
     IxNodeHandle *node = fetch_node(iid.page_no);
-    if (iid.slot_no >= node->get_size()) {
+    node->page->rw_latch_.lock_read();
+    bool valid = iid.slot_no < node->get_size();
+    Rid rid{};
+    if (valid) {
+        rid = *(node->get_rid(iid.slot_no));
+    }
+    node->page->rw_latch_.unlock_read();
+    buffer_pool_manager_->unpin_page(node->get_page_id(), false);  // unpin it!
+    delete node;
+    if (!valid) {
         throw IndexEntryNotFoundError();
     }
+    return rid;
+}
+
+Rid IxIndexHandle::get_entry(const Iid &iid, char *key) const {
+    IxNodeHandle *node = fetch_node(iid.page_no);
+    node->page->rw_latch_.lock_read();
+    bool valid = iid.slot_no < node->get_size();
+    Rid rid{};
+    if (valid) {
+        ix_decode_key(node->get_key(iid.slot_no), key, file_hdr_->col_types_, file_hdr_->col_lens_);
+        rid = *(node->get_rid(iid.slot_no));
+    }
+    node->page->rw_latch_.unlock_read();
     buffer_pool_manager_->unpin_page(node->get_page_id(), false);  // unpin it!
-    auto rid = *(node->get_rid(iid.slot_no));
     delete node;
+    if (!valid) {
+        throw IndexEntryNotFoundError();
+    }
     return rid;
 }
 
@@ -692,25 +973,21 @@ Rid IxIndexHandle::get_rid(const Iid &iid) const {
  *
  * @param key 要查找的键值
  * @return NId 返回包含页号和槽号的Iid结构
- * @note 上层传入的key本来是int类型，通过(const char *)&key进行了转换
- * 可用*(int *)key转换回去
+ * @note 上层传入的是记录中格式的原始键，查找前先编码
  */
 Iid IxIndexHandle::lower_bound(const char *key) {
+    // 结点中存放的是编码后的键
+    char encoded[IX_MAX_COL_LEN];
+    key = encode_key(key, encoded);
     // 先找到对应的叶子节点
-    std::pair<IxNodeHandle *, bool> leaf_page_entry = find_leaf_page(key, Operation::FIND, nullptr);
-    if (!leaf_page_entry.first) {
-        // 如果找不到叶子节点，返回无效的Nid
-        return Iid{-1, -1};
-    }
-    IxNodeHandle *leaf_node = leaf_page_entry.first;
+    IxNodeHandle *leaf_node = find_leaf_page(key, Operation::FIND, nullptr).first;
 
     // 在叶子节点中找到第一个不小于key的键值对位置
     int lower_bound_idx = leaf_node->lower_bound(key);
     Iid result_iid = {.page_no = leaf_node->get_page_no(), .slot_no = lower_bound_idx};
 
     // 解锁并释放叶子节点
-    buffer_pool_manager_->unpin_page(leaf_node->get_page_id(), false);
-    delete leaf_node;
+    release_leaf(leaf_node, Operation::FIND, false);
 
     return result_iid;
 }
@@ -722,29 +999,24 @@ Iid IxIndexHandle::lower_bound(const char *key) {
  * @return NId 返回包含页号和槽号的Iid结构
  */
 Iid IxIndexHandle::upper_bound(const char *key) {
+    // 结点中存放的是编码后的键
+    char encoded[IX_MAX_COL_LEN];
+    key = encode_key(key, encoded);
     // 先找到对应的叶子节点
-    std::pair<IxNodeHandle *, bool> leaf_page_entry = find_leaf_page(key, Operation::FIND, nullptr);
-    if (!leaf_page_entry.first) {
-        // 如果找不到叶子节点，返回无效的Iid
-        return Iid{-1, -1};
-    }
-    IxNodeHandle *leaf_node = leaf_page_entry.first;
+    IxNodeHandle *leaf_node = find_leaf_page(key, Operation::FIND, nullptr).first;
 
     // 在叶子节点中找到第一个大于key的键值对位置
     int upper_bound_idx = leaf_node->upper_bound(key);
-    Iid result_iid;
+    bool past_leaf = upper_bound_idx >= leaf_node->get_size();
+    Iid result_iid = {.page_no = leaf_node->get_page_no(), .slot_no = upper_bound_idx};
+
+    // 解锁并释放叶子节点，leaf_end需要锁住最后一个叶子结点，不能同时持有当前叶子结点的latch
+    release_leaf(leaf_node, Operation::FIND, false);
 
     // 如果upper_bound_idx等于节点中的键值对数量，说明key大于节点中的所有键值
-    if (upper_bound_idx == leaf_node->get_size()) {
+    if (past_leaf) {
         result_iid = leaf_end();
-    } else {
-        result_iid = {.page_no = leaf_node->get_page_no(), .slot_no = upper_bound_idx};
     }
-
-    // 解锁并释放叶子节点
-    buffer_pool_manager_->unpin_page(leaf_node->get_page_id(), false);
-    delete leaf_node;
-
     return result_iid;
 }
 
@@ -755,8 +1027,15 @@ Iid IxIndexHandle::upper_bound(const char *key) {
  * @return Iid
  */
 Iid IxIndexHandle::leaf_end() const {
-    IxNodeHandle *node = fetch_node(file_hdr_->last_leaf_);
-    Iid iid = {.page_no = file_hdr_->last_leaf_, .slot_no = node->get_size()};
+    page_id_t last_leaf;
+    {
+        std::scoped_lock meta_lock{meta_latch_};
+        last_leaf = file_hdr_->last_leaf_;
+    }
+    IxNodeHandle *node = fetch_node(last_leaf);
+    node->page->rw_latch_.lock_read();
+    Iid iid = {.page_no = last_leaf, .slot_no = node->get_size()};
+    node->page->rw_latch_.unlock_read();
     buffer_pool_manager_->unpin_page(node->get_page_id(), false);
     delete node;
     return iid;
@@ -812,11 +1091,15 @@ int IxIndexHandle::get_key(Iid iid) const {
  */
 IxNodeHandle *IxIndexHandle::create_node() {
     IxNodeHandle *node;
-    file_hdr_->num_pages_++;
 
     PageId new_page_id = {.fd = fd_, .page_no = INVALID_PAGE_ID};
     // 从3开始分配page_no，第一次分配之后，new_page_id.page_no=3，file_hdr_.num_pages=4
+    // 优先复用已经释放的页面，此时num_pages不变
     Page *page = buffer_pool_manager_->new_page(&new_page_id);
+    {
+        std::scoped_lock meta_lock{meta_latch_};
+        file_hdr_->num_pages_ = std::max(file_hdr_->num_pages_, new_page_id.page_no + 1);
+    }
     node = new IxNodeHandle(file_hdr_, page);
     return node;
 }
@@ -875,24 +1158,57 @@ void IxIndexHandle::erase_leaf(IxNodeHandle *leaf) {
 }
 
 /**
- * @brief 删除node时，更新file_hdr_.num_pages
+ * @brief 删除node时，记录需要释放的页面。此时node可能仍被固定，等到所有结点unpin之后由free_released_nodes释放
  *
  * @param node
  */
 void IxIndexHandle::release_node_handle(IxNodeHandle &node) {
-    file_hdr_->num_pages_--;
+    std::scoped_lock meta_lock{meta_latch_};
+    released_pages_.push_back(node.get_page_no());
+}
+
+/**
+ * @brief 将release_node_handle记录的页面从缓冲池中删除，并交还给DiskManager，之后create_node可以复用这些页面
+ */
+void IxIndexHandle::free_released_nodes() {
+    std::scoped_lock meta_lock{meta_latch_};
+    for (page_id_t page_no : released_pages_) {
+        PageId page_id = {.fd = fd_, .page_no = page_no};
+        // 页面仍被固定时不能删除，宁可泄漏这个页面也不能让它被重复分配
+        if (buffer_pool_manager_->delete_page(page_id)) {
+            disk_manager_->deallocate_page(fd_, page_no);
+        }
+    }
+    released_pages_.clear();
+}
+
+/**
+ * @brief 截断索引文件末尾连续的空闲页面
+ *
+ * @return int 截断的页面个数
+ */
+int IxIndexHandle::vacuum() {
+    std::scoped_lock lock{root_latch_, meta_latch_};
+    int old_num_pages = file_hdr_->num_pages_;
+    file_hdr_->num_pages_ = disk_manager_->truncate_free_pages(fd_);
+    return old_num_pages - file_hdr_->num_pages_;
 }
 
 /**
  * @brief 将node的第child_idx个孩子结点的父节点置为node
+ * @param touched 不为nullptr时孩子结点不在这里unpin，而是放入touched
  */
-void IxIndexHandle::maintain_child(IxNodeHandle *node, int child_idx) {
+void IxIndexHandle::maintain_child(IxNodeHandle *node, int child_idx, std::vector<IxNodeHandle *> *touched) {
     if (!node->is_leaf_page()) {
         //  Current node is inner node, load its child and set its parent to current node
         // 非叶子节点
         int child_page_no = node->value_at(child_idx);
         IxNodeHandle *child = fetch_node(child_page_no);
         child->set_parent_page_no(node->get_page_no());
+        if (touched != nullptr) {
+            touched->push_back(child);
+            return;
+        }
         buffer_pool_manager_->unpin_page(child->get_page_id(), true);
 
         delete child;
@@ -902,26 +1218,11 @@ void IxIndexHandle::maintain_child(IxNodeHandle *node, int child_idx) {
 /**
  * @brief 判断当前节点中是否有对应key的pair
  *
- * @param key 要查找的键值
+ * @param key 要查找的键值（编码后的键）
  * @return 是否有对应key的pair
- * @note 遍历当前节点的所有键，检查是否存在与输入key相等的键
+ * @note 二分查找第一个不小于key的键，检查是否与key相等
  */
 bool IxNodeHandle::is_exist_key(const char *key) const {
-    // 获取当前节点中键的数量
-    int num_keys = page_hdr->num_key;
-
-    // 遍历当前节点中的所有键
-    for (int key_index = 0; key_index < num_keys; key_index++) {
-        // 获取当前键的地址
-        char *current_key_addr = get_key(key_index);
-
-        // 比较输入的key和当前键
-        if (ix_compare(key, current_key_addr, file_hdr->col_types_, file_hdr->col_lens_) == 0) {
-            // 如果相等，返回true
-            return true;
-        }
-    }
-
-    // 如果遍历完所有键都没有找到相等的，返回false
-    return false;
+    int key_idx = lower_bound(key);
+    return key_idx < page_hdr->num_key && compare_key(get_key(key_idx), key) == 0;
 }
\ No newline at end of file
@@ -10,15 +10,18 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <shared_mutex>
+
 #include "ix_defs.h"
 #include "transaction/transaction.h"
 
+class LogManager;
+class IxLogRecord;
+
 enum class Operation {
     FIND = 0, INSERT, DELETE
 };  // 三种操作：查找、插入、删除
 
-static const bool binary_search = false;
-
 /**
  * a < b : -1
  * a = b : 0
@@ -54,16 +57,80 @@ ix_compare(const char *a, const char *b, const std::vector<ColType> &col_types,
     return 0;
 }
 
+/**
+ * 索引键的规范化编码：编码后的键直接用memcmp按字节比较，结果与按字段逐个调用ix_compare相同。
+ * INT翻转符号位后按大端序存放；FLOAT非负数翻转符号位、负数翻转所有位后按大端序存放（-0.0编码为0.0）；
+ * 定长字符串原样存放（记录中字符串不足长度的部分已经用'\0'补齐）。
+ * B+树结点中存放的都是编码后的键，IxIndexHandle的接口接收记录中的原始键，在入口处编码
+ */
+inline uint32_t ix_load_be32(const char *src) {
+    uint32_t v;
+    memcpy(&v, src, sizeof(v));
+    return __builtin_bswap32(v);
+}
+
+inline void ix_store_be32(char *dest, uint32_t v) {
+    v = __builtin_bswap32(v);
+    memcpy(dest, &v, sizeof(v));
+}
+
+inline void ix_encode_key(const char *key, char *out, const std::vector<ColType> &col_types,
+                          const std::vector<int> &col_lens) {
+    int offset = 0;
+    for (size_t i = 0; i < col_types.size(); ++i) {
+        const char *src = key + offset;
+        char *dest = out + offset;
+        if (col_types[i] == TYPE_INT) {
+            uint32_t v;
+            memcpy(&v, src, sizeof(v));
+            ix_store_be32(dest, v ^ 0x80000000u);
+        } else if (col_types[i] == TYPE_FLOAT) {
+            float f;
+            memcpy(&f, src, sizeof(f));
+            f = f == 0.0f ? 0.0f : f;
+            uint32_t v;
+            memcpy(&v, &f, sizeof(v));
+            ix_store_be32(dest, (v & 0x80000000u) ? ~v : v ^ 0x80000000u);
+        } else {
+            memcpy(dest, src, col_lens[i]);
+        }
+        offset += col_lens[i];
+    }
+}
+
+// ix_encode_key的逆过程，把结点中的键还原成记录中的格式
+inline void ix_decode_key(const char *key, char *out, const std::vector<ColType> &col_types,
+                          const std::vector<int> &col_lens) {
+    int offset = 0;
+    for (size_t i = 0; i < col_types.size(); ++i) {
+        const char *src = key + offset;
+        char *dest = out + offset;
+        if (col_types[i] == TYPE_INT) {
+            uint32_t v = ix_load_be32(src) ^ 0x80000000u;
+            memcpy(dest, &v, sizeof(v));
+        } else if (col_types[i] == TYPE_FLOAT) {
+            uint32_t v = ix_load_be32(src);
+            v = (v & 0x80000000u) ? v ^ 0x80000000u : ~v;
+            memcpy(dest, &v, sizeof(v));
+        } else {
+            memcpy(dest, src, col_lens[i]);
+        }
+        offset += col_lens[i];
+    }
+}
+
 /* 管理B+树中的每个节点 */
 class IxNodeHandle {
     friend class IxIndexHandle;
 
     friend class IxScan;
 
+    friend class IxBulkLoader;
+
 private:
     const IxFileHdr *file_hdr;      // 节点所在文件的头部信息
     Page *page;                     // 存储节点的页面
-    IxPageHdr *page_hdr;            // page->data的第一部分，指针指向首地址，长度为sizeof(IxPageHdr)
+    IxPageHdr *page_hdr;            // page->data的第一部分，在page_lsn之后，长度为sizeof(IxPageHdr)
     char *keys;                     // page->data的第二部分，指针指向首地址，长度为file_hdr->keys_size，每个key的长度为file_hdr->col_len
     Rid *rids;                      // page->data的第三部分，指针指向首地址
 
@@ -71,11 +138,12 @@ public:
     IxNodeHandle() = default;
 
     IxNodeHandle(const IxFileHdr *file_hdr_, Page *page_) : file_hdr(file_hdr_), page(page_) {
-        page_hdr = reinterpret_cast<IxPageHdr *>(page->get_data());
-        keys = page->get_data() + sizeof(IxPageHdr);
+        page_hdr = reinterpret_cast<IxPageHdr *>(page->get_data() + Page::OFFSET_PAGE_HDR);
+        keys = page->get_data() + Page::OFFSET_PAGE_HDR + sizeof(IxPageHdr);
         rids = reinterpret_cast<Rid *>(keys + file_hdr->keys_size_);
     }
 
+    // 结点执行op之后是否不需要分裂或合并，写操作下降时遇到安全的结点可以释放祖先结点的latch
     bool is_safe(Operation op) {
         if (op == Operation::FIND) {
             return true;
@@ -94,7 +162,8 @@ public:
 
     int get_min_size() { return get_max_size() / 2; }
 
-    int key_at(int i) { return *(int *) get_key(i); }
+    // 单个INT字段的索引中第i个键的值
+    int key_at(int i) { return static_cast<int>(ix_load_be32(get_key(i)) ^ 0x80000000u); }
 
     /* 得到第i个孩子结点的page_no */
     page_id_t value_at(int i) { return get_rid(i)->page_no; }
@@ -123,6 +192,9 @@ public:
 
     char *get_key(int key_idx) const { return keys + key_idx * file_hdr->col_tot_len_; }
 
+    // 比较编码后的键
+    int compare_key(const char *a, const char *b) const { return memcmp(a, b, file_hdr->col_tot_len_); }
+
     Rid *get_rid(int rid_idx) const { return &rids[rid_idx]; }
 
     void set_key(int key_idx, const char *key) {
@@ -182,75 +254,54 @@ public:
     }
 };
 
-/* B+树 */
+/**
+ * B+树。并发控制使用结点页面的rw_latch_（latch crabbing）：
+ * 查找从根到叶子逐层加读latch，锁住孩子结点之后立即释放父结点；
+ * 插入、删除先乐观下降，内部结点加读latch，只对叶子结点加写latch，叶子结点修改后不需要分裂时直接完成；
+ * 否则释放所有latch，从根开始悲观下降，对路径上的结点加写latch，遇到安全的结点时释放其所有祖先结点。
+ * root_latch_保护根结点页号：读取根页号并锁住根结点之前持有共享锁，悲观下降在根结点可能分裂时持有排他锁。
+ * 写操作只按从上到下的顺序加latch，IxScan同一时刻最多持有一个叶子结点的latch，因此不会死锁。
+ * 事务中的插入、删除写入IxLogRecord并设置被修改结点的page_lsn，恢复时由redo重做文件头file_lsn_之后的日志记录
+ */
 class IxIndexHandle {
     friend class IxScan;
 
     friend class IxManager;
 
+    friend class IxBulkLoader;
+
 private:
     DiskManager *disk_manager_;
     BufferPoolManager *buffer_pool_manager_;
     int fd_;                                    // 存储B+树的文件
     IxFileHdr *file_hdr_;                       // 存了root_page，但其初始化为2（第0页存FILE_HDR_PAGE，第1页存LEAF_HEADER_PAGE）
-    std::mutex root_latch_;
+    std::shared_mutex root_latch_;              // 保护file_hdr_->root_page_
+    mutable std::mutex meta_latch_;             // 保护file_hdr_中的num_pages_、last_leaf_和released_pages_
+    std::vector<page_id_t> released_pages_;     // 本次删除中被合并掉、等待释放的结点页面
+    LogManager *log_manager_;                   // 为nullptr时不记录日志
+    std::string index_name_;                    // 索引文件名，日志记录中用来找到索引
+
+    /* 悲观下降时持有写latch的结点，按从上到下的顺序排列 */
+    struct WriteSet {
+        std::vector<IxNodeHandle *> nodes;
+        bool root_locked = false;               // 是否持有root_latch_的排他锁
+    };
 
 public:
-    IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd);
+    IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd,
+                  LogManager *log_manager = nullptr);
 
     ~IxIndexHandle();
 
-    void unlock_all_latch(Transaction *txn) {
-        if (txn == nullptr) {
-            //啥也不做.
-            return;
-        }
-        auto index_latch_pages = txn->get_index_latch_page_set();
-        //先unlock
-        for (auto iter = index_latch_pages->begin(); iter != index_latch_pages->end(); iter++) {
-            unlock(static_cast<Operation>(iter->second), iter->first);
-        }
-        //再删除
-        index_latch_pages->clear();
-    }
-
-    void lock(Operation op, Page *page) {
-        if (op == Operation::FIND) {
-            lock_read(page);
-        } else {
-            lock_write(page);
-        }
-    }
-
-    void unlock(Operation op, Page *page) {
+    // 释放find_leaf_page返回的叶子结点：解除latch并unpin
+    void release_leaf(IxNodeHandle *leaf, Operation op, bool is_dirty) {
         if (op == Operation::FIND) {
-            unlock_read(page);
+            leaf->page->rw_latch_.unlock_read();
         } else {
-            unlock_write(page);
+            leaf->page->rw_latch_.unlock_write();
         }
-    }
-
-    void lock_write(Page *page) {
-        page->add_pin_count();
-        page->rw_latch_.lock_write();
-    }
-
-
-    void unlock_write(Page *page) {
-        page->rw_latch_.unlock_write();
-        this->buffer_pool_manager_->unpin_page(page->get_page_id(), false);
-    }
-
-
-    void lock_read(Page *page) {
-        page->add_pin_count();
-        page->rw_latch_.lock_read();
-    }
-
-
-    void unlock_read(Page *page) {
-        page->rw_latch_.unlock_read();
-        this->buffer_pool_manager_->unpin_page(page->get_page_id(), false);
+        buffer_pool_manager_->unpin_page(leaf->get_page_id(), is_dirty);
+        delete leaf;
     }
 
     // for search
@@ -262,9 +313,11 @@ public:
     // for insert
     page_id_t insert_entry(const char *key, const Rid &value, Transaction *transaction);
 
-    IxNodeHandle *split(IxNodeHandle *node);
+    IxNodeHandle *split(IxNodeHandle *node, std::vector<page_id_t> *new_pages = nullptr,
+                        std::vector<IxNodeHandle *> *touched = nullptr);
 
-    void insert_into_parent(IxNodeHandle *old_node, const char *key, IxNodeHandle *new_node, Transaction *transaction);
+    void insert_into_parent(IxNodeHandle *old_node, const char *key, IxNodeHandle *new_node, Transaction *transaction,
+                            std::vector<page_id_t> *new_pages = nullptr, std::vector<IxNodeHandle *> *touched = nullptr);
 
     // for delete
     bool delete_entry(const char *key, Transaction *transaction);
@@ -287,16 +340,42 @@ public:
 
     Iid leaf_begin() const;
 
+    int vacuum();
+
+    // for recovery
+    void redo(IxLogRecord *log_record);
+
     IxFileHdr getFileHdr(){
         return *this->file_hdr_;
     }
 
-    std::mutex *getMutex() {
+    std::shared_mutex *getMutex() {
         return &this->root_latch_;
     }
 
 private:
+    // for concurrency
+    IxNodeHandle *find_leaf_pessimistic(const char *key, Operation operation, WriteSet *write_set);
+
+    void release_write_set(WriteSet *write_set, bool is_dirty);
+
+    // for log
+    bool is_logged(Transaction *txn) const { return log_manager_ != nullptr && txn != nullptr; }
+
+    lsn_t append_log(IxLogRecord *log_record, Transaction *txn);
+
+    lsn_t log_split(IxLogRecord *log_record, WriteSet *write_set, const std::vector<page_id_t> &new_pages,
+                    Transaction *txn);
+
+    IxNodeHandle *fetch_node_for_redo(page_id_t page_no);
+
     // 辅助函数
+    // 把记录中的原始键编码为结点中存放的格式，返回out
+    const char *encode_key(const char *key, char *out) const {
+        ix_encode_key(key, out, file_hdr_->col_types_, file_hdr_->col_lens_);
+        return out;
+    }
+
     void update_root_page_no(page_id_t root) { file_hdr_->root_page_ = root; }
 
     bool is_empty() const { return file_hdr_->root_page_ == IX_NO_PAGE; }
@@ -313,10 +392,17 @@ private:
 
     void release_node_handle(IxNodeHandle &node);
 
-    void maintain_child(IxNodeHandle *node, int child_idx);
+    void free_released_nodes();
+
+    void maintain_child(IxNodeHandle *node, int child_idx, std::vector<IxNodeHandle *> *touched = nullptr);
+
+    void release_touched(std::vector<IxNodeHandle *> *touched);
 
     // for index test
     Rid get_rid(const Iid &iid) const;
 
+    // 读取iid处的键（还原为记录中的格式）和rid，供覆盖索引扫描直接从叶子结点构造元组
+    Rid get_entry(const Iid &iid, char *key) const;
+
     int get_key(Iid iid) const;
 };
\ No newline at end of file
@@ -16,15 +16,17 @@ See the Mulan PSL v2 for more details. */
 #include "system/sm_meta.h"
 #include "ix_defs.h"
 #include "ix_index_handle.h"
+#include "recovery/log_manager.h"
 
 class IxManager {
 private:
     DiskManager *disk_manager_;
     BufferPoolManager *buffer_pool_manager_;
+    LogManager *log_manager_;       // 打开的索引用它记录日志，为nullptr时不记录日志
 
 public:
-    IxManager(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager)
-            : disk_manager_(disk_manager), buffer_pool_manager_(buffer_pool_manager) {}
+    IxManager(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, LogManager *log_manager = nullptr)
+            : disk_manager_(disk_manager), buffer_pool_manager_(buffer_pool_manager), log_manager_(log_manager) {}
 
     std::string get_index_name(const std::string &filename, const std::vector<std::string> &index_cols) {
         std::string index_name = filename;
@@ -75,7 +77,9 @@ public:
         }
         // 根据 |page_hdr| + (|attr| + |rid|) * (n + 1) <= PAGE_SIZE 求得n的最大值btree_order
         // 即 n <= btree_order，那么btree_order就是每个结点最多可插入的键值对数量（实际还多留了一个空位，但其不可插入）
-        int btree_order = static_cast<int>((PAGE_SIZE - sizeof(IxPageHdr)) / (col_tot_len + sizeof(Rid)) - 1);
+        // 页面开头存放page_lsn，page_hdr从Page::OFFSET_PAGE_HDR开始
+        int btree_order = static_cast<int>((PAGE_SIZE - Page::OFFSET_PAGE_HDR - sizeof(IxPageHdr)) /
+                                           (col_tot_len + sizeof(Rid)) - 1);
         assert(btree_order > 2);
 
         // Create file header and write to file
@@ -87,11 +91,16 @@ public:
             fhdr->col_lens_.push_back(index_cols[i].len);
         }
         fhdr->update_tot_len();
+        // 同名的旧索引留下的日志记录不属于这个文件，恢复时跳过
+        if (log_manager_ != nullptr) {
+            fhdr->file_lsn_ = log_manager_->get_persist_lsn_();
+        }
 
         char *data = new char[fhdr->tot_len_];
         fhdr->serialize(data);
 
         disk_manager_->write_page(fd, IX_FILE_HDR_PAGE, data, fhdr->tot_len_);
+        delete[] data;
 
         // 释放fhdr的内存
         delete fhdr;
@@ -102,7 +111,7 @@ public:
         // Create leaf list header page and write to file
         {
             memset(page_buf, 0, PAGE_SIZE);
-            auto phdr = reinterpret_cast<IxPageHdr *>(page_buf);
+            auto phdr = reinterpret_cast<IxPageHdr *>(page_buf + Page::OFFSET_PAGE_HDR);
             *phdr = {
                     .next_free_page_no = IX_NO_PAGE,
                     .parent = IX_NO_PAGE,
@@ -117,7 +126,7 @@ public:
         // Create root node and write to file
         {
             memset(page_buf, 0, PAGE_SIZE);
-            auto phdr = reinterpret_cast<IxPageHdr *>(page_buf);
+            auto phdr = reinterpret_cast<IxPageHdr *>(page_buf + Page::OFFSET_PAGE_HDR);
             *phdr = {
                     .next_free_page_no = IX_NO_PAGE,
                     .parent = IX_NO_PAGE,
@@ -149,25 +158,58 @@ public:
         disk_manager_->destroy_file(ix_name);
     }
 
+    /**
+     * @description: 索引文件的格式是否是当前版本，旧格式的索引需要删除后重建
+     */
+    bool is_current_version(const std::string &filename, const std::vector<ColMeta> &index_cols) {
+        std::string ix_name = get_index_name(filename, index_cols);
+        int fd = disk_manager_->open_file(ix_name);
+        char buf[PAGE_SIZE];
+        memset(buf, 0, PAGE_SIZE);
+        disk_manager_->read_page(fd, IX_FILE_HDR_PAGE, buf, PAGE_SIZE);
+        disk_manager_->close_file(fd);
+        IxFileHdr file_hdr;
+        file_hdr.deserialize(buf);
+        return file_hdr.version_ == IX_FILE_VERSION;
+    }
+
     // 注意这里打开文件，创建并返回了index file handle的指针
     std::unique_ptr<IxIndexHandle> open_index(const std::string &filename, const std::vector<ColMeta> &index_cols) {
         std::string ix_name = get_index_name(filename, index_cols);
         int fd = disk_manager_->open_file(ix_name);
-        return std::make_unique<IxIndexHandle>(disk_manager_, buffer_pool_manager_, fd);
+        return std::make_unique<IxIndexHandle>(disk_manager_, buffer_pool_manager_, fd, log_manager_);
     }
 
     std::unique_ptr<IxIndexHandle> open_index(const std::string &filename, const std::vector<std::string> &index_cols) {
         std::string ix_name = get_index_name(filename, index_cols);
         int fd = disk_manager_->open_file(ix_name);
-        return std::make_unique<IxIndexHandle>(disk_manager_, buffer_pool_manager_, fd);
+        return std::make_unique<IxIndexHandle>(disk_manager_, buffer_pool_manager_, fd, log_manager_);
     }
 
-    void close_index(const IxIndexHandle *ih) {
+    /**
+     * @description: 把索引的所有页面和文件头写回磁盘。页面先于文件头写回，
+     * 文件头中的file_lsn_记录此时已经持久化的日志，恢复时跳过这些日志记录
+     */
+    void flush_index(const IxIndexHandle *ih) {
+        // 已释放的结点页面串成链表写入磁盘，链表头记录在文件头中
+        ih->file_hdr_->first_free_page_no_ =
+                disk_manager_->save_free_pages(ih->fd_, Page::OFFSET_PAGE_HDR + offsetof(IxPageHdr, next_free_page_no));
+        if (log_manager_ != nullptr) {
+            log_manager_->flush_log_to_disk();
+        }
+        buffer_pool_manager_->flush_all_pages(ih->fd_);
+        if (log_manager_ != nullptr) {
+            ih->file_hdr_->file_lsn_ = log_manager_->get_persist_lsn_();
+        }
         char *data = new char[ih->file_hdr_->tot_len_];
         ih->file_hdr_->serialize(data);
         disk_manager_->write_page(ih->fd_, IX_FILE_HDR_PAGE, data, ih->file_hdr_->tot_len_);
+        delete[] data;
+    }
+
+    void close_index(const IxIndexHandle *ih) {
         // 缓冲区的所有页刷到磁盘，注意这句话必须写在close_file前面
-        buffer_pool_manager_->flush_all_pages(ih->fd_);
+        flush_index(ih);
         disk_manager_->close_file(ih->fd_);
     }
 };
\ No newline at end of file
@@ -10,37 +10,46 @@ See the Mulan PSL v2 for more details. */
 
 #include "ix_scan.h"
 
-/**
- * @brief 
- * @todo 加上读锁（需要使用缓冲池得到page）
- */
 void IxScan::next() {
     assert(!is_end());
-    IxNodeHandle *node = ih_->fetch_node(iid_.page_no);
-    assert(node->is_leaf_page());
-    assert(iid_.slot_no < node->get_size());
     // increment slot no
     iid_.slot_no++;
-    if (iid_.page_no != ih_->file_hdr_->last_leaf_ && iid_.slot_no == node->get_size()) {
-        // go to next leaf
-        iid_.slot_no = 0;
-        iid_.page_no = node->get_next_leaf();
+    normalize();
+}
 
-#ifdef ENABLE_LOCK_CRABBING
-        ih_->lock(Operation::FIND, node_buffer->page);
-        if (node_buffer->is_safe(Operation::FIND)) {
-            ih_->unlock_all_latch(context_->txn_);
+void IxScan::normalize() {
+    while (!is_end()) {
+        update_node_buffer(iid_.page_no);
+        IxNodeHandle *node = node_buffer;
+        node->page->rw_latch_.lock_read();
+        assert(node->is_leaf_page());
+        int size = node->get_size();
+        page_id_t next_leaf = node->get_next_leaf();
+        node->page->rw_latch_.unlock_read();
+        if (iid_.slot_no < size) {
+            return;
         }
-        context_->txn_->append_index_latch_page_set(node_buffer->page, static_cast<int>(Operation::FIND));
-#endif
+        if (next_leaf == IX_LEAF_HEADER_PAGE || iid_.page_no == end_.page_no) {
+            // 已经是最后一个叶子结点，或者end_就在当前叶子结点中
+            iid_ = end_;
+            return;
+        }
+        // go to next leaf
+        iid_.slot_no = 0;
+        iid_.page_no = next_leaf;
+        // 叶子结点的页号连续时，提示缓冲池预读后续叶子结点
+        ih_->buffer_pool_manager_->read_ahead({ih_->fd_, iid_.page_no}, ih_->file_hdr_->num_pages_, &read_ahead_);
     }
-    delete node;
 }
 
 Rid IxScan::rid() const {
     return ih_->get_rid(iid_);
 }
 
+Rid IxScan::entry(char *key) const {
+    return ih_->get_entry(iid_, key);
+}
+
 void IxScan::update_node_buffer(page_id_t page_no) {
     if (node_buffer != nullptr && page_no != node_buffer->get_page_no()) {
         ih_->buffer_pool_manager_->unpin_page(node_buffer->get_page_id(), false);
@@ -50,4 +59,4 @@ void IxScan::update_node_buffer(page_id_t page_no) {
     if ((node_buffer == nullptr || page_no != node_buffer->get_page_no()) && page_no != INVALID_PAGE_ID) {
         node_buffer = ih_->fetch_node(page_no);
     }
-}
\ No newline at end of file
+}
@@ -16,23 +16,24 @@ See the Mulan PSL v2 for more details. */
 
 // 用于遍历叶子结点
 // 用于直接遍历叶子结点，而不用findleafpage来得到叶子结点
-// TODO：对page遍历时，要加上读锁
+// 读取叶子结点时加读latch，读完立即释放，两次调用之间只固定当前叶子结点而不持有latch，
+// 因此扫描不会与持有事务锁的写操作互相等待；扫描期间并发的插入、删除可能使结点中的槽位移动
 class IxScan : public RecScan {
     IxIndexHandle *ih_;
     Iid iid_;  // 初始为lower（用于遍历的指针）
     Iid end_;  // 初始为upper
     Context *context_;
     IxNodeHandle *node_buffer;
+    ReadAheadState read_ahead_;     // 沿next_leaf遍历叶子结点时的预读状态
 
 public:
     txn_id_t txn_id;
 
     IxScan(IxIndexHandle *ih, const Iid &lower, const Iid &upper, Context *context)
             : ih_(ih), iid_(lower), end_(upper), context_(context) {
+        node_buffer = nullptr;
         if (iid_.page_no != -1) {
-            node_buffer = ih_->fetch_node(iid_.page_no);
-        } else {
-            node_buffer = nullptr;
+            normalize();
         }
     }
 
@@ -44,6 +45,9 @@ public:
 
     Rid rid() const override;
 
+    // 把当前位置的键（记录中的格式）写入key，并返回对应的rid
+    Rid entry(char *key) const;
+
     const Iid &iid() const { return iid_; }
 
     void update_node_buffer(page_id_t page_no);
@@ -56,6 +60,10 @@ public:
         update_node_buffer(INVALID_PAGE_ID);
         iid_ = lower;
         end_ = upper;
-        node_buffer = ih_->fetch_node(iid_.page_no);
+        normalize();
     }
+
+private:
+    // 当前位置超出叶子结点中的键时（包括空的叶子结点），移动到后继叶子结点的第一个键，或者移动到end_
+    void normalize();
 };
\ No newline at end of file
@@ -58,6 +58,9 @@ class Optimizer {
             return std::make_shared<OtherPlan>(T_Transaction_Rollback, std::string());
         } else if (auto x = std::dynamic_pointer_cast<ast::StaticCheckpoint>(query->parse)) {
             return std::make_shared<OtherPlan>(T_Static_Checkpoint, std::string());
+        } else if (auto x = std::dynamic_pointer_cast<ast::Vacuum>(query->parse)) {
+            // vacuum [table];
+            return std::make_shared<OtherPlan>(T_Vacuum, x->tab_name);
         } else if (auto x = std::dynamic_pointer_cast<ast::SetStmt>(query->parse)) {
             // Set Knob Plan
             return std::make_shared<SetKnobPlan>(x->set_knob_type_, x->bool_val_);
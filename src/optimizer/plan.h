@@ -44,6 +44,7 @@ typedef enum PlanTag {
     // 扫描数据
     T_SeqScan,
     T_IndexScan,
+    T_IndexOnlyScan,
     // 循环
     T_NestLoop,
     // 排序
@@ -55,7 +56,9 @@ typedef enum PlanTag {
     // 聚合函数
     T_SvAggregate,
     // 静态检查点
-    T_Static_Checkpoint
+    T_Static_Checkpoint,
+    // 整理数据文件
+    T_Vacuum
 } PlanTag;
 
 // 查询执行计划
@@ -197,6 +200,7 @@ public:
     std::string tab_name_;
     std::vector<std::string> tab_col_names_;
     std::vector<ColDef> cols_;
+    TabOptions options_;        // create table的表选项
 };
 
 // help; show tables; desc tables; begin; abort; commit; rollback语句对应的plan
@@ -10,6 +10,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "planner.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "execution/executor_delete.h"
@@ -291,6 +292,38 @@ std::shared_ptr<Plan> Planner::physical_optimization(std::shared_ptr<Query> quer
 }
 
 
+/**
+ * @brief 判断索引是否覆盖了查询：投影列、扫描条件涉及的列以及排序列都是索引中的字段
+ *
+ * @param index_meta 扫描使用的索引
+ * @param query 查询
+ * @param conds 下推到该表上的扫描条件
+ */
+bool Planner::is_index_covered(const IndexMeta &index_meta, const std::shared_ptr<Query> &query,
+                               const std::vector<Condition> &conds) {
+    auto covered = [&](const TabCol &col) {
+        return col.tab_name == index_meta.tab_name && index_meta.contains_column(col.col_name);
+    };
+    if (query->cols.empty()) {
+        return false;
+    }
+    for (const auto &col: query->cols) {
+        if (!covered(col)) {
+            return false;
+        }
+    }
+    for (const auto &cond: conds) {
+        if (!covered(cond.lhs_col) || (!cond.is_rhs_val && !cond.is_rhs_in && !covered(cond.rhs_col))) {
+            return false;
+        }
+    }
+    auto x = std::dynamic_pointer_cast<ast::SelectStmt>(query->parse);
+    if (x->has_sort && !covered(query->sort_mete->tab_col)) {
+        return false;
+    }
+    return true;
+}
+
 std::shared_ptr<Plan> Planner::make_one_rel(std::shared_ptr<Query> query, Context *context) {
     auto x = std::dynamic_pointer_cast<ast::SelectStmt>(query->parse);
     std::vector<std::string> tables = query->tables;
@@ -332,7 +365,10 @@ std::shared_ptr<Plan> Planner::make_one_rel(std::shared_ptr<Query> query, Contex
             }
         } else {
             is_time_delay = false;
-            auto index_scan = std::make_shared<ScanPlan>(T_IndexScan, sm_manager_, tables[i], curr_conds,
+            // 单表查询涉及的字段都在索引中时，使用覆盖索引扫描，不再回表
+            PlanTag scan_tag = tables.size() == 1 && is_index_covered(index_meta, query, curr_conds)
+                               ? T_IndexOnlyScan : T_IndexScan;
+            auto index_scan = std::make_shared<ScanPlan>(scan_tag, sm_manager_, tables[i], curr_conds,
                                                          index_col_names, true);
             // 将找到的最匹配的索引赋给index_scan plan
             index_scan->index_meta_ = index_meta;
@@ -505,6 +541,31 @@ std::shared_ptr<Plan> Planner::generate_select_plan(std::shared_ptr<Query> query
     return plannerRoot;
 }
 
+/**
+ * @description: 解析create table语句中的表选项，选项名和取值不区分大小写
+ * @param {vector<shared_ptr<ast::TableOption>>&} sv_options 语法树中的表选项
+ * @return {TabOptions} 表选项
+ */
+TabOptions Planner::interp_table_options(const std::vector<std::shared_ptr<ast::TableOption>> &sv_options) {
+    TabOptions options;
+    for (auto &sv_option : sv_options) {
+        auto lower = [](std::string str) {
+            std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+            return str;
+        };
+        std::string key = lower(sv_option->key);
+        std::string value = lower(sv_option->value);
+        if (key == "compression" && (value == "lz4" || value == "none")) {
+            options.compressed = value == "lz4";
+        } else if (key == "layout" && (value == "columnar" || value == "row")) {
+            options.columnar = value == "columnar";
+        } else {
+            throw InvalidTableOptionError(sv_option->key, sv_option->value);
+        }
+    }
+    return options;
+}
+
 // 生成DDL语句和DML语句的查询执行计划
 std::shared_ptr<Plan> Planner::do_planner(std::shared_ptr<Query> query, Context *context) {
     std::shared_ptr<Plan> plannerRoot;
@@ -515,13 +576,16 @@ std::shared_ptr<Plan> Planner::do_planner(std::shared_ptr<Query> query, Context
             if (auto sv_col_def = std::dynamic_pointer_cast<ast::ColDef>(field)) {
                 ColDef col_def = {.name = sv_col_def->col_name,
                         .type = interp_sv_type(sv_col_def->type_len->type),
-                        .len = sv_col_def->type_len->len};
+                        .len = sv_col_def->type_len->len,
+                        .is_varchar = sv_col_def->type_len->type == ast::SV_TYPE_VARCHAR};
                 col_defs.push_back(col_def);
             } else {
                 throw InternalError("Unexpected field type");
             }
         }
-        plannerRoot = std::make_shared<DDLPlan>(T_CreateTable, x->tab_name, std::vector<std::string>(), col_defs);
+        auto ddl_plan = std::make_shared<DDLPlan>(T_CreateTable, x->tab_name, std::vector<std::string>(), col_defs);
+        ddl_plan->options_ = interp_table_options(x->options);
+        plannerRoot = ddl_plan;
     } else if (auto x = std::dynamic_pointer_cast<ast::DropTable>(query->parse)) {
         // drop table;
         plannerRoot = std::make_shared<DDLPlan>(T_DropTable, x->tab_name, std::vector<std::string>(),
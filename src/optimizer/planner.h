@@ -53,11 +53,17 @@ private:
     std::pair<bool, IndexMeta> get_index_cols_with_col(const std::string &tab_name, std::vector<Condition> curr_conditions,
                                               std::vector<std::string> &index_col_names, std::vector<TabCol> cols);
 
+    bool is_index_covered(const IndexMeta &index_meta, const std::shared_ptr<Query> &query,
+                          const std::vector<Condition> &conds);
+
+    TabOptions interp_table_options(const std::vector<std::shared_ptr<ast::TableOption>> &sv_options);
+
     ColType interp_sv_type(ast::SvType sv_type) {
         std::map<ast::SvType, ColType> m = {
                 {ast::SV_TYPE_INT,      TYPE_INT},
                 {ast::SV_TYPE_FLOAT,    TYPE_FLOAT},
-                {ast::SV_TYPE_STRING,   TYPE_STRING}};
+                {ast::SV_TYPE_STRING,   TYPE_STRING},
+                {ast::SV_TYPE_VARCHAR,  TYPE_STRING}};
         return m.at(sv_type);
     }
 };
\ No newline at end of file
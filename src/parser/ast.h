@@ -20,7 +20,7 @@ enum JoinType {
 namespace ast {
 
 enum SvType {
-    SV_TYPE_INT, SV_TYPE_FLOAT, SV_TYPE_STRING, SV_TYPE_BOOL
+    SV_TYPE_INT, SV_TYPE_FLOAT, SV_TYPE_STRING, SV_TYPE_BOOL, SV_TYPE_VARCHAR
 };
 
 enum SvCompOp {
@@ -81,6 +81,13 @@ struct TxnRollback : public TreeNode {
 struct StaticCheckpoint : public TreeNode {
 };
 
+// tab_name为空时整理所有的表
+struct Vacuum : public TreeNode {
+    std::string tab_name;
+
+    Vacuum(std::string tab_name_) : tab_name(std::move(tab_name_)) {}
+};
+
 struct TypeLen : public TreeNode {
     SvType type;
     int len;
@@ -99,12 +106,22 @@ struct ColDef : public Field {
             col_name(std::move(col_name_)), type_len(std::move(type_len_)) {}
 };
 
+// CREATE TABLE ... WITH (key = value, ...)中的一个表选项
+struct TableOption : public TreeNode {
+    std::string key;
+    std::string value;
+
+    TableOption(std::string key_, std::string value_) : key(std::move(key_)), value(std::move(value_)) {}
+};
+
 struct CreateTable : public TreeNode {
     std::string tab_name;
     std::vector<std::shared_ptr<Field>> fields;
+    std::vector<std::shared_ptr<TableOption>> options;
 
-    CreateTable(std::string tab_name_, std::vector<std::shared_ptr<Field>> fields_) :
-            tab_name(std::move(tab_name_)), fields(std::move(fields_)) {}
+    CreateTable(std::string tab_name_, std::vector<std::shared_ptr<Field>> fields_,
+                std::vector<std::shared_ptr<TableOption>> options_ = {}) :
+            tab_name(std::move(tab_name_)), fields(std::move(fields_)), options(std::move(options_)) {}
 };
 
 struct DropTable : public TreeNode {
@@ -377,6 +394,9 @@ struct SemValue {
     std::shared_ptr<Field> sv_field;
     std::vector<std::shared_ptr<Field>> sv_fields;
 
+    std::shared_ptr<TableOption> sv_table_option;
+    std::vector<std::shared_ptr<TableOption>> sv_table_options;
+
     std::shared_ptr<Expr> sv_expr;
 
     std::shared_ptr<ArtExpr> sv_art_expr;
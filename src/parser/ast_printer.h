@@ -45,7 +45,8 @@ namespace ast {
             static std::map<SvType, std::string> m{
                     {SV_TYPE_INT,      "INT"},
                     {SV_TYPE_FLOAT,    "FLOAT"},
-                    {SV_TYPE_STRING,   "STRING"}
+                    {SV_TYPE_STRING,   "STRING"},
+                    {SV_TYPE_VARCHAR,  "VARCHAR"}
             };
             return m.at(type);
         }
@@ -83,12 +84,20 @@ namespace ast {
                 std::cout << "CREATE_TABLE\n";
                 print_val(x->tab_name, offset);
                 print_node_list(x->fields, offset);
+                print_node_list(x->options, offset);
+            } else if (auto x = std::dynamic_pointer_cast<TableOption>(node)) {
+                std::cout << "TABLE_OPTION\n";
+                print_val(x->key, offset);
+                print_val(x->value, offset);
             } else if (auto x = std::dynamic_pointer_cast<DropTable>(node)) {
                 std::cout << "DROP_TABLE\n";
                 print_val(x->tab_name, offset);
             } else if (auto x = std::dynamic_pointer_cast<DescTable>(node)) {
                 std::cout << "DESC_TABLE\n";
                 print_val(x->tab_name, offset);
+            } else if (auto x = std::dynamic_pointer_cast<Vacuum>(node)) {
+                std::cout << "VACUUM\n";
+                print_val(x->tab_name, offset);
             } else if (auto x = std::dynamic_pointer_cast<CreateIndex>(node)) {
                 std::cout << "CREATE_INDEX\n";
                 print_val(x->tab_name, offset);
@@ -1331,6 +1331,18 @@ case 58:
 YY_RULE_SETUP
 #line 119 "lex.l"
 {
+    /* 与lex.l中的"VACUUM"规则等价：该关键字加入时扫描器表没有重新生成 */
+    if (strcasecmp(yytext, "VACUUM") == 0) {
+        return VACUUM;
+    }
+    /* 与lex.l中的"VARCHAR"规则等价 */
+    if (strcasecmp(yytext, "VARCHAR") == 0) {
+        return VARCHAR;
+    }
+    /* 与lex.l中的"WITH"规则等价 */
+    if (strcasecmp(yytext, "WITH") == 0) {
+        return WITH;
+    }
     yylval->sv_str = yytext;
     return IDENTIFIER;
 }
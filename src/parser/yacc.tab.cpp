@@ -105,7 +105,7 @@ using namespace ast;
 #  endif
 # endif
 
-#include "yacc.tab.hpp"
+#include "yacc.tab.h"
 /* Symbol kind.  */
 enum yysymbol_kind_t
 {
@@ -154,77 +154,83 @@ enum yysymbol_kind_t
   YYSYMBOL_IN = 41,                        /* IN  */
   YYSYMBOL_STATIC_CHECKPOINT = 42,         /* STATIC_CHECKPOINT  */
   YYSYMBOL_LOAD = 43,                      /* LOAD  */
-  YYSYMBOL_LEQ = 44,                       /* LEQ  */
-  YYSYMBOL_NEQ = 45,                       /* NEQ  */
-  YYSYMBOL_GEQ = 46,                       /* GEQ  */
-  YYSYMBOL_T_EOF = 47,                     /* T_EOF  */
-  YYSYMBOL_COUNT = 48,                     /* COUNT  */
-  YYSYMBOL_MAX = 49,                       /* MAX  */
-  YYSYMBOL_MIN = 50,                       /* MIN  */
-  YYSYMBOL_SUM = 51,                       /* SUM  */
-  YYSYMBOL_IDENTIFIER = 52,                /* IDENTIFIER  */
-  YYSYMBOL_VALUE_STRING = 53,              /* VALUE_STRING  */
-  YYSYMBOL_VALUE_INT = 54,                 /* VALUE_INT  */
-  YYSYMBOL_VALUE_FLOAT = 55,               /* VALUE_FLOAT  */
-  YYSYMBOL_VALUE_BOOL = 56,                /* VALUE_BOOL  */
-  YYSYMBOL_FILE_PATH_VALUE = 57,           /* FILE_PATH_VALUE  */
-  YYSYMBOL_TABLE_COL = 58,                 /* TABLE_COL  */
-  YYSYMBOL_59_ = 59,                       /* ';'  */
-  YYSYMBOL_60_ = 60,                       /* '='  */
-  YYSYMBOL_61_ = 61,                       /* '('  */
-  YYSYMBOL_62_ = 62,                       /* ')'  */
-  YYSYMBOL_63_ = 63,                       /* ','  */
-  YYSYMBOL_64_ = 64,                       /* '*'  */
-  YYSYMBOL_65_ = 65,                       /* '<'  */
-  YYSYMBOL_66_ = 66,                       /* '>'  */
-  YYSYMBOL_67_ = 67,                       /* '+'  */
-  YYSYMBOL_68_ = 68,                       /* '-'  */
-  YYSYMBOL_69_ = 69,                       /* '/'  */
-  YYSYMBOL_YYACCEPT = 70,                  /* $accept  */
-  YYSYMBOL_start = 71,                     /* start  */
-  YYSYMBOL_stmt = 72,                      /* stmt  */
-  YYSYMBOL_txnStmt = 73,                   /* txnStmt  */
-  YYSYMBOL_dbStmt = 74,                    /* dbStmt  */
-  YYSYMBOL_setStmt = 75,                   /* setStmt  */
-  YYSYMBOL_ddl = 76,                       /* ddl  */
-  YYSYMBOL_dml = 77,                       /* dml  */
-  YYSYMBOL_fieldList = 78,                 /* fieldList  */
-  YYSYMBOL_colNameList = 79,               /* colNameList  */
-  YYSYMBOL_field = 80,                     /* field  */
-  YYSYMBOL_type = 81,                      /* type  */
-  YYSYMBOL_valueList = 82,                 /* valueList  */
-  YYSYMBOL_value = 83,                     /* value  */
-  YYSYMBOL_condition = 84,                 /* condition  */
-  YYSYMBOL_optWhereClause = 85,            /* optWhereClause  */
-  YYSYMBOL_whereClause = 86,               /* whereClause  */
-  YYSYMBOL_col = 87,                       /* col  */
-  YYSYMBOL_colList = 88,                   /* colList  */
-  YYSYMBOL_op = 89,                        /* op  */
-  YYSYMBOL_art_op = 90,                    /* art_op  */
-  YYSYMBOL_expr = 91,                      /* expr  */
-  YYSYMBOL_sub_select_stmt = 92,           /* sub_select_stmt  */
-  YYSYMBOL_in_op_vlaue = 93,               /* in_op_vlaue  */
-  YYSYMBOL_in_sub_query = 94,              /* in_sub_query  */
-  YYSYMBOL_setClauses = 95,                /* setClauses  */
-  YYSYMBOL_setClause = 96,                 /* setClause  */
-  YYSYMBOL_artExpr = 97,                   /* artExpr  */
-  YYSYMBOL_selector = 98,                  /* selector  */
-  YYSYMBOL_AGGREGATE_SUM = 99,             /* AGGREGATE_SUM  */
-  YYSYMBOL_AGGREGATE_COUNT = 100,          /* AGGREGATE_COUNT  */
-  YYSYMBOL_AGGREGATE_MAX = 101,            /* AGGREGATE_MAX  */
-  YYSYMBOL_AGGREGATE_MIN = 102,            /* AGGREGATE_MIN  */
-  YYSYMBOL_sv_group_by_col = 103,          /* sv_group_by_col  */
-  YYSYMBOL_group_by_cols = 104,            /* group_by_cols  */
-  YYSYMBOL_sv_group_by = 105,              /* sv_group_by  */
-  YYSYMBOL_tableList = 106,                /* tableList  */
-  YYSYMBOL_opt_order_clause = 107,         /* opt_order_clause  */
-  YYSYMBOL_order_clause = 108,             /* order_clause  */
-  YYSYMBOL_opt_asc_desc = 109,             /* opt_asc_desc  */
-  YYSYMBOL_set_knob_type = 110,            /* set_knob_type  */
-  YYSYMBOL_tbName = 111,                   /* tbName  */
-  YYSYMBOL_colName = 112,                  /* colName  */
-  YYSYMBOL_file_path = 113,                /* file_path  */
-  YYSYMBOL_table_col_name = 114            /* table_col_name  */
+  YYSYMBOL_VACUUM = 44,                    /* VACUUM  */
+  YYSYMBOL_VARCHAR = 45,                   /* VARCHAR  */
+  YYSYMBOL_WITH = 46,                      /* WITH  */
+  YYSYMBOL_LEQ = 47,                       /* LEQ  */
+  YYSYMBOL_NEQ = 48,                       /* NEQ  */
+  YYSYMBOL_GEQ = 49,                       /* GEQ  */
+  YYSYMBOL_T_EOF = 50,                     /* T_EOF  */
+  YYSYMBOL_COUNT = 51,                     /* COUNT  */
+  YYSYMBOL_MAX = 52,                       /* MAX  */
+  YYSYMBOL_MIN = 53,                       /* MIN  */
+  YYSYMBOL_SUM = 54,                       /* SUM  */
+  YYSYMBOL_IDENTIFIER = 55,                /* IDENTIFIER  */
+  YYSYMBOL_VALUE_STRING = 56,              /* VALUE_STRING  */
+  YYSYMBOL_VALUE_INT = 57,                 /* VALUE_INT  */
+  YYSYMBOL_VALUE_FLOAT = 58,               /* VALUE_FLOAT  */
+  YYSYMBOL_VALUE_BOOL = 59,                /* VALUE_BOOL  */
+  YYSYMBOL_FILE_PATH_VALUE = 60,           /* FILE_PATH_VALUE  */
+  YYSYMBOL_TABLE_COL = 61,                 /* TABLE_COL  */
+  YYSYMBOL_62_ = 62,                       /* ';'  */
+  YYSYMBOL_63_ = 63,                       /* '='  */
+  YYSYMBOL_64_ = 64,                       /* '('  */
+  YYSYMBOL_65_ = 65,                       /* ')'  */
+  YYSYMBOL_66_ = 66,                       /* ','  */
+  YYSYMBOL_67_ = 67,                       /* '*'  */
+  YYSYMBOL_68_ = 68,                       /* '<'  */
+  YYSYMBOL_69_ = 69,                       /* '>'  */
+  YYSYMBOL_70_ = 70,                       /* '+'  */
+  YYSYMBOL_71_ = 71,                       /* '-'  */
+  YYSYMBOL_72_ = 72,                       /* '/'  */
+  YYSYMBOL_YYACCEPT = 73,                  /* $accept  */
+  YYSYMBOL_start = 74,                     /* start  */
+  YYSYMBOL_stmt = 75,                      /* stmt  */
+  YYSYMBOL_txnStmt = 76,                   /* txnStmt  */
+  YYSYMBOL_dbStmt = 77,                    /* dbStmt  */
+  YYSYMBOL_setStmt = 78,                   /* setStmt  */
+  YYSYMBOL_ddl = 79,                       /* ddl  */
+  YYSYMBOL_dml = 80,                       /* dml  */
+  YYSYMBOL_fieldList = 81,                 /* fieldList  */
+  YYSYMBOL_colNameList = 82,               /* colNameList  */
+  YYSYMBOL_optTableOptions = 83,           /* optTableOptions  */
+  YYSYMBOL_tableOptionList = 84,           /* tableOptionList  */
+  YYSYMBOL_tableOption = 85,               /* tableOption  */
+  YYSYMBOL_field = 86,                     /* field  */
+  YYSYMBOL_type = 87,                      /* type  */
+  YYSYMBOL_valueList = 88,                 /* valueList  */
+  YYSYMBOL_value = 89,                     /* value  */
+  YYSYMBOL_condition = 90,                 /* condition  */
+  YYSYMBOL_optWhereClause = 91,            /* optWhereClause  */
+  YYSYMBOL_whereClause = 92,               /* whereClause  */
+  YYSYMBOL_col = 93,                       /* col  */
+  YYSYMBOL_colList = 94,                   /* colList  */
+  YYSYMBOL_op = 95,                        /* op  */
+  YYSYMBOL_art_op = 96,                    /* art_op  */
+  YYSYMBOL_expr = 97,                      /* expr  */
+  YYSYMBOL_sub_select_stmt = 98,           /* sub_select_stmt  */
+  YYSYMBOL_in_op_vlaue = 99,               /* in_op_vlaue  */
+  YYSYMBOL_in_sub_query = 100,             /* in_sub_query  */
+  YYSYMBOL_setClauses = 101,               /* setClauses  */
+  YYSYMBOL_setClause = 102,                /* setClause  */
+  YYSYMBOL_artExpr = 103,                  /* artExpr  */
+  YYSYMBOL_selector = 104,                 /* selector  */
+  YYSYMBOL_AGGREGATE_SUM = 105,            /* AGGREGATE_SUM  */
+  YYSYMBOL_AGGREGATE_COUNT = 106,          /* AGGREGATE_COUNT  */
+  YYSYMBOL_AGGREGATE_MAX = 107,            /* AGGREGATE_MAX  */
+  YYSYMBOL_AGGREGATE_MIN = 108,            /* AGGREGATE_MIN  */
+  YYSYMBOL_sv_group_by_col = 109,          /* sv_group_by_col  */
+  YYSYMBOL_group_by_cols = 110,            /* group_by_cols  */
+  YYSYMBOL_sv_group_by = 111,              /* sv_group_by  */
+  YYSYMBOL_tableList = 112,                /* tableList  */
+  YYSYMBOL_opt_order_clause = 113,         /* opt_order_clause  */
+  YYSYMBOL_order_clause = 114,             /* order_clause  */
+  YYSYMBOL_opt_asc_desc = 115,             /* opt_asc_desc  */
+  YYSYMBOL_set_knob_type = 116,            /* set_knob_type  */
+  YYSYMBOL_tbName = 117,                   /* tbName  */
+  YYSYMBOL_colName = 118,                  /* colName  */
+  YYSYMBOL_file_path = 119,                /* file_path  */
+  YYSYMBOL_table_col_name = 120            /* table_col_name  */
 };
 typedef enum yysymbol_kind_t yysymbol_kind_t;
 
@@ -553,21 +559,21 @@ union yyalloc
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  58
+#define YYFINAL  60
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   220
+#define YYLAST   238
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  70
+#define YYNTOKENS  73
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  45
+#define YYNNTS  48
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  113
+#define YYNRULES  121
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  211
+#define YYNSTATES  228
 
 /* YYMAXUTOK -- Last valid token kind.  */
-#define YYMAXUTOK   313
+#define YYMAXUTOK   316
 
 
 /* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
@@ -585,9 +591,9 @@ static const yytype_int8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-      61,    62,    64,    67,    63,    68,     2,    69,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,    59,
-      65,    60,    66,     2,     2,     2,     2,     2,     2,     2,
+      64,    65,    67,    70,    66,    71,     2,    72,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,    62,
+      68,    63,    69,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -612,25 +618,26 @@ static const yytype_int8 yytranslate[] =
       25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
       35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
       45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
-      55,    56,    57,    58
+      55,    56,    57,    58,    59,    60,    61
 };
 
 #if YYDEBUG
 /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,    82,    82,    87,    92,    97,   105,   106,   107,   108,
-     109,   113,   117,   121,   125,   132,   137,   144,   151,   155,
-     159,   163,   167,   171,   175,   183,   187,   191,   195,   202,
-     206,   213,   217,   224,   231,   235,   239,   243,   250,   254,
-     261,   265,   269,   273,   280,   284,   288,   295,   296,   303,
-     307,   314,   318,   322,   326,   330,   334,   338,   342,   346,
-     350,   354,   358,   362,   369,   373,   380,   384,   388,   392,
-     396,   400,   407,   411,   415,   419,   427,   431,   435,   442,
-     449,   456,   460,   467,   471,   478,   482,   489,   496,   500,
-     507,   514,   521,   528,   532,   539,   543,   550,   551,   557,
-     561,   565,   572,   576,   580,   587,   588,   589,   593,   594,
-     597,   599,   601,   603
+       0,    84,    84,    89,    94,    99,   107,   108,   109,   110,
+     111,   115,   119,   123,   127,   134,   139,   143,   147,   154,
+     161,   165,   169,   173,   177,   181,   185,   193,   197,   201,
+     205,   212,   216,   223,   227,   234,   235,   242,   246,   253,
+     260,   267,   271,   275,   279,   283,   290,   294,   301,   305,
+     309,   313,   320,   324,   328,   335,   336,   343,   347,   354,
+     358,   362,   366,   370,   374,   378,   382,   386,   390,   394,
+     398,   402,   409,   413,   420,   424,   428,   432,   436,   440,
+     447,   451,   455,   459,   467,   471,   475,   482,   489,   496,
+     500,   507,   511,   518,   522,   529,   536,   540,   547,   554,
+     561,   568,   572,   579,   583,   590,   591,   597,   601,   605,
+     612,   616,   620,   627,   628,   629,   633,   634,   637,   639,
+     641,   643
 };
 #endif
 
@@ -652,19 +659,20 @@ static const char *const yytname[] =
   "SELECT", "INT", "CHAR", "FLOAT", "DATETIME", "INDEX", "AND", "JOIN",
   "EXIT", "HELP", "TXN_BEGIN", "TXN_COMMIT", "TXN_ABORT", "TXN_ROLLBACK",
   "ORDER_BY", "ENABLE_NESTLOOP", "ENABLE_SORTMERGE", "GROUP_BY", "HAVING",
-  "IN", "STATIC_CHECKPOINT", "LOAD", "LEQ", "NEQ", "GEQ", "T_EOF", "COUNT",
-  "MAX", "MIN", "SUM", "IDENTIFIER", "VALUE_STRING", "VALUE_INT",
-  "VALUE_FLOAT", "VALUE_BOOL", "FILE_PATH_VALUE", "TABLE_COL", "';'",
-  "'='", "'('", "')'", "','", "'*'", "'<'", "'>'", "'+'", "'-'", "'/'",
-  "$accept", "start", "stmt", "txnStmt", "dbStmt", "setStmt", "ddl", "dml",
-  "fieldList", "colNameList", "field", "type", "valueList", "value",
-  "condition", "optWhereClause", "whereClause", "col", "colList", "op",
-  "art_op", "expr", "sub_select_stmt", "in_op_vlaue", "in_sub_query",
-  "setClauses", "setClause", "artExpr", "selector", "AGGREGATE_SUM",
-  "AGGREGATE_COUNT", "AGGREGATE_MAX", "AGGREGATE_MIN", "sv_group_by_col",
-  "group_by_cols", "sv_group_by", "tableList", "opt_order_clause",
-  "order_clause", "opt_asc_desc", "set_knob_type", "tbName", "colName",
-  "file_path", "table_col_name", YY_NULLPTR
+  "IN", "STATIC_CHECKPOINT", "LOAD", "VACUUM", "VARCHAR", "WITH", "LEQ",
+  "NEQ", "GEQ", "T_EOF", "COUNT", "MAX", "MIN", "SUM", "IDENTIFIER",
+  "VALUE_STRING", "VALUE_INT", "VALUE_FLOAT", "VALUE_BOOL",
+  "FILE_PATH_VALUE", "TABLE_COL", "';'", "'='", "'('", "')'", "','", "'*'",
+  "'<'", "'>'", "'+'", "'-'", "'/'", "$accept", "start", "stmt", "txnStmt",
+  "dbStmt", "setStmt", "ddl", "dml", "fieldList", "colNameList",
+  "optTableOptions", "tableOptionList", "tableOption", "field", "type",
+  "valueList", "value", "condition", "optWhereClause", "whereClause",
+  "col", "colList", "op", "art_op", "expr", "sub_select_stmt",
+  "in_op_vlaue", "in_sub_query", "setClauses", "setClause", "artExpr",
+  "selector", "AGGREGATE_SUM", "AGGREGATE_COUNT", "AGGREGATE_MAX",
+  "AGGREGATE_MIN", "sv_group_by_col", "group_by_cols", "sv_group_by",
+  "tableList", "opt_order_clause", "order_clause", "opt_asc_desc",
+  "set_knob_type", "tbName", "colName", "file_path", "table_col_name", YY_NULLPTR
 };
 
 static const char *
@@ -674,7 +682,7 @@ yysymbol_name (yysymbol_kind_t yysymbol)
 }
 #endif
 
-#define YYPACT_NINF (-105)
+#define YYPACT_NINF (-107)
 
 #define yypact_value_is_default(Yyn) \
   ((Yyn) == YYPACT_NINF)
@@ -688,28 +696,29 @@ yysymbol_name (yysymbol_kind_t yysymbol)
    STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-      62,     7,    11,    12,   -30,    21,    23,   -30,    14,    27,
-    -105,  -105,  -105,  -105,  -105,  -105,   -33,  -105,    41,   -13,
-    -105,  -105,  -105,  -105,  -105,  -105,    43,   -30,   -30,  -105,
-     -30,   -30,  -105,  -105,   -30,   -30,    36,  -105,  -105,     6,
-    -105,  -105,  -105,  -105,  -105,  -105,  -105,  -105,     9,    87,
-      45,    50,    55,    59,  -105,  -105,  -105,    94,  -105,  -105,
-     -30,    67,    84,  -105,    86,   122,   129,    98,    95,    27,
-     -30,    98,   -29,    98,    98,   -30,  -105,    98,    98,    98,
-     105,    27,  -105,     0,  -105,   108,  -105,  -105,     1,  -105,
-     119,   123,   125,   127,   128,  -105,    18,  -105,    89,    56,
-    -105,    68,    71,  -105,   139,    57,    98,  -105,   124,   -30,
-     -30,   154,   153,   167,   169,   174,   175,  -105,    98,  -105,
-     132,  -105,  -105,  -105,  -105,    98,  -105,  -105,  -105,  -105,
-    -105,    72,  -105,    27,   133,  -105,  -105,  -105,  -105,  -105,
-    -105,    88,  -105,  -105,   -24,  -105,  -105,  -105,   179,   180,
-      98,    98,    98,    98,    98,  -105,   143,  -105,  -105,    71,
-    -105,    -6,    27,   107,  -105,  -105,  -105,  -105,  -105,  -105,
-    -105,  -105,    71,    27,   183,  -105,  -105,  -105,  -105,  -105,
-    -105,   138,  -105,   140,  -105,  -105,   142,    -1,   144,  -105,
-      13,  -105,    27,  -105,  -105,   -30,  -105,  -105,  -105,  -105,
-     161,  -105,   145,     1,    27,    27,   154,   139,  -105,   180,
-    -105
+      95,     5,    10,    14,   -45,    33,    34,   -45,    11,   131,
+    -107,  -107,  -107,  -107,  -107,  -107,    -3,   -45,  -107,    50,
+       3,  -107,  -107,  -107,  -107,  -107,  -107,    48,   -45,   -45,
+    -107,   -45,   -45,  -107,  -107,   -45,   -45,    43,  -107,  -107,
+      26,  -107,  -107,  -107,  -107,  -107,  -107,  -107,  -107,     1,
+      58,    35,    54,    59,    60,  -107,  -107,  -107,    87,  -107,
+    -107,  -107,   -45,    67,    68,  -107,    69,   126,   121,    88,
+      85,   131,   -45,    88,   -27,    88,    88,   -45,  -107,    88,
+      88,    88,    82,   131,  -107,   -11,  -107,    84,  -107,  -107,
+       2,  -107,    92,    98,   104,   115,   123,  -107,   -30,  -107,
+      -1,   -12,  -107,     4,   109,  -107,   134,    73,    88,  -107,
+     120,   -45,   -45,   174,   173,   176,   177,   178,   179,   151,
+      88,  -107,   135,  -107,  -107,   136,  -107,  -107,    88,  -107,
+    -107,  -107,  -107,  -107,     8,  -107,   131,   137,  -107,  -107,
+    -107,  -107,  -107,  -107,    97,  -107,  -107,    41,  -107,  -107,
+    -107,   186,   185,    88,    88,    88,    88,    88,   140,  -107,
+    -107,   148,   149,  -107,  -107,   109,  -107,    20,   131,    29,
+    -107,  -107,  -107,  -107,  -107,  -107,  -107,  -107,   109,   131,
+     191,  -107,  -107,  -107,  -107,  -107,  -107,   153,   144,   145,
+    -107,   146,  -107,  -107,   150,   -10,   152,  -107,    31,  -107,
+     131,   155,    40,  -107,  -107,  -107,  -107,   -45,  -107,  -107,
+    -107,  -107,   180,  -107,   147,   159,  -107,   153,     2,   131,
+     131,  -107,  -107,   174,   134,  -107,   185,  -107
 };
 
 /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
@@ -718,47 +727,48 @@ static const yytype_int16 yypact[] =
 static const yytype_int8 yydefact[] =
 {
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       4,     3,    11,    12,    13,    14,     0,     5,     0,     0,
-       9,     6,    10,     7,     8,    15,     0,     0,     0,    23,
-       0,     0,   110,    20,     0,     0,     0,   108,   109,     0,
-      90,    91,    92,    89,   111,   113,    51,    64,    88,     0,
-       0,     0,     0,     0,    53,    52,   112,     0,     1,     2,
-       0,     0,     0,    19,     0,     0,    47,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,    16,     0,     0,     0,
-       0,     0,    26,    47,    83,     0,    17,    65,    47,    99,
-       0,     0,     0,     0,     0,    24,     0,    29,     0,     0,
-      31,     0,     0,    49,    48,     0,     0,    27,     0,     0,
-       0,   103,    59,    63,    62,    61,    60,    18,     0,    34,
-       0,    36,    37,    33,    21,     0,    22,    42,    40,    41,
-      43,     0,    38,     0,     0,    70,    69,    71,    66,    67,
-      68,     0,    84,    85,     0,    86,   101,   100,     0,    97,
-       0,     0,     0,     0,     0,    30,     0,    32,    25,     0,
-      50,     0,     0,     0,    76,    77,    44,    78,    74,    72,
-      73,    75,     0,     0,     0,    28,    54,    58,    57,    56,
-      55,     0,    39,    80,    81,    82,     0,     0,     0,    87,
-     107,   102,     0,    35,    46,     0,    45,   106,   105,   104,
-      93,    95,    98,    47,     0,     0,   103,    94,    96,    97,
-      79
+       4,     3,    11,    12,    13,    14,     0,    17,     5,     0,
+       0,     9,     6,    10,     7,     8,    15,     0,     0,     0,
+      25,     0,     0,   118,    22,     0,     0,     0,   116,   117,
+       0,    98,    99,   100,    97,   119,   121,    59,    72,    96,
+       0,     0,     0,     0,     0,    61,    60,   120,     0,    18,
+       1,     2,     0,     0,     0,    21,     0,     0,    55,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,    16,     0,
+       0,     0,     0,     0,    28,    55,    91,     0,    19,    73,
+      55,   107,     0,     0,     0,     0,     0,    26,     0,    31,
+       0,     0,    33,     0,     0,    57,    56,     0,     0,    29,
+       0,     0,     0,   111,    67,    71,    70,    69,    68,    35,
+       0,    41,     0,    44,    45,     0,    40,    23,     0,    24,
+      50,    48,    49,    51,     0,    46,     0,     0,    78,    77,
+      79,    74,    75,    76,     0,    92,    93,     0,    94,   109,
+     108,     0,   105,     0,     0,     0,     0,     0,     0,    20,
+      32,     0,     0,    34,    27,     0,    58,     0,     0,     0,
+      84,    85,    52,    86,    82,    80,    81,    83,     0,     0,
+       0,    30,    62,    66,    65,    64,    63,     0,     0,     0,
+      47,    88,    89,    90,     0,     0,     0,    95,   115,   110,
+       0,     0,     0,    37,    42,    43,    54,     0,    53,   114,
+     113,   112,   101,   103,   106,     0,    36,     0,    55,     0,
+       0,    39,    38,   111,   102,   104,   105,    87
 };
 
 /* YYPGOTO[NTERM-NUM].  */
-static const yytype_int8 yypgoto[] =
+static const yytype_int16 yypgoto[] =
 {
-    -105,  -105,  -105,  -105,  -105,  -105,  -105,  -105,  -105,   126,
-      91,  -105,    46,  -104,    69,   -82,     8,    -9,    48,  -105,
-    -105,    51,    52,  -105,  -105,  -105,   109,  -105,  -105,  -105,
-    -105,  -105,  -105,    15,  -105,     2,    22,    10,  -105,  -105,
-    -105,    -2,   -64,  -105,  -105
+    -107,  -107,  -107,  -107,  -107,  -107,  -107,  -107,  -107,   138,
+    -107,  -107,     6,    96,  -107,    55,  -106,    89,   -84,     7,
+      -9,    53,  -107,  -107,    61,    57,  -107,  -107,  -107,   119,
+    -107,  -107,  -107,  -107,  -107,  -107,     9,  -107,    12,    21,
+      13,  -107,  -107,  -107,    -2,   -62,  -107,  -107
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_uint8 yydefgoto[] =
 {
-       0,    18,    19,    20,    21,    22,    23,    24,    96,    99,
-      97,   123,   131,   132,   103,    82,   104,   105,    48,   141,
-     172,   166,   167,   185,   186,    83,    84,   145,    49,    50,
-      51,    52,    53,   201,   202,   175,    88,   149,   191,   199,
-      39,    89,    54,    57,    55
+       0,    19,    20,    21,    22,    23,    24,    25,    98,   101,
+     159,   202,   203,    99,   126,   134,   135,   105,    84,   106,
+     107,    49,   144,   178,   172,   173,   193,   194,    85,    86,
+     148,    50,    51,    52,    53,    54,   213,   214,   181,    90,
+     152,   199,   211,    40,    91,    55,    58,    56
 };
 
 /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
@@ -766,56 +776,58 @@ static const yytype_uint8 yydefgoto[] =
    number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_uint8 yytable[] =
 {
-      47,   107,    33,    85,   143,    36,   111,    90,    92,    93,
-      94,    25,   195,    98,   100,   100,   162,    27,    30,    81,
-      81,   197,    32,    44,    56,    61,    62,   198,    63,    64,
-     109,    34,    65,    66,    26,    91,    35,   164,    28,    31,
-     168,    58,    85,   169,   170,   171,    59,   127,   128,   129,
-     130,    37,    38,    29,    98,   182,    60,    67,    76,   164,
-      87,   157,    69,   106,   110,     1,    68,     2,   189,     3,
-       4,     5,    69,    95,     6,    40,    41,    42,    43,    44,
-     117,   118,     7,     8,     9,    45,   176,   177,   178,   179,
-     180,    46,    10,    11,    12,    13,    14,    15,   134,   144,
-      70,   135,   136,   137,    75,    16,    71,   146,   147,    17,
-     162,    72,   119,   120,   121,   122,    73,   138,   124,   125,
-      74,   206,   139,   140,   127,   128,   129,   130,    77,   162,
-     126,   125,   165,    80,   158,   159,    40,    41,    42,    43,
-      44,   127,   128,   129,   130,    78,    45,    79,    81,   163,
-      44,    86,    46,    47,   165,    40,    41,    42,    43,    44,
-     127,   128,   129,   130,   190,    45,   102,   133,   108,   148,
-     150,    46,    40,    41,    42,    43,    44,   127,   128,   129,
-     130,   112,    45,   200,   151,   113,   152,   114,    46,   115,
-     116,   153,   154,   156,   161,   173,   200,   181,   174,   192,
-     193,   204,   160,   159,   194,   101,   196,   183,   205,   155,
-     187,   210,   207,   184,   188,   142,   209,   203,     0,     0,
-     208
+      48,   109,    34,   207,   146,    37,   113,    87,    83,    26,
+      33,    92,    94,    95,    96,    59,    28,   100,   102,   102,
+      31,    83,   121,   122,   123,   124,    63,    64,    45,    65,
+      66,   111,    27,    67,    68,   119,   120,    29,   170,   209,
+      93,    32,   168,    35,   125,   210,    87,    36,    38,    39,
+      60,   168,    30,   127,   128,   108,    71,    57,   100,   190,
+      78,    62,    89,   170,    69,    61,   163,    71,   112,   129,
+     128,    72,   197,   164,   165,    97,   130,   131,   132,   133,
+      41,    42,    43,    44,    45,   130,   131,   132,   133,    70,
+      46,   182,   183,   184,   185,   186,    47,    77,     1,    73,
+       2,   147,     3,     4,     5,   216,   217,     6,   174,   149,
+     150,   175,   176,   177,   137,     7,     8,     9,    74,   168,
+     138,   139,   140,    75,    76,    10,    11,    12,    13,    14,
+      15,    79,    80,    81,   223,   171,   141,    82,    16,    17,
+      83,   142,   143,    45,    88,    18,   104,   110,    41,    42,
+      43,    44,    45,   130,   131,   132,   133,   114,    46,    48,
+     171,   169,   136,   115,    47,   130,   131,   132,   133,   116,
+     198,    41,    42,    43,    44,    45,   130,   131,   132,   133,
+     117,    46,    41,    42,    43,    44,    45,    47,   118,   151,
+     153,   212,    46,   154,   155,   156,   157,   158,    47,   161,
+     162,   167,   179,   180,   187,   188,   189,   200,   201,   204,
+     205,   212,   165,   220,   221,   206,   160,   208,   215,   103,
+     219,   195,   191,   222,   192,   166,   224,   145,   218,   225,
+     196,     0,     0,     0,     0,     0,   226,     0,   227
 };
 
 static const yytype_int16 yycheck[] =
 {
-       9,    83,     4,    67,   108,     7,    88,    71,    72,    73,
-      74,     4,    13,    77,    78,    79,    22,     6,     6,    19,
-      19,     8,    52,    52,    57,    27,    28,    14,    30,    31,
-      29,    10,    34,    35,    27,    64,    13,   141,    27,    27,
-      64,     0,   106,    67,    68,    69,    59,    53,    54,    55,
-      56,    37,    38,    42,   118,   159,    13,    21,    60,   163,
-      69,   125,    63,    63,    63,     3,    60,     5,   172,     7,
-       8,     9,    63,    75,    12,    48,    49,    50,    51,    52,
-      62,    63,    20,    21,    22,    58,   150,   151,   152,   153,
-     154,    64,    30,    31,    32,    33,    34,    35,    41,   108,
-      13,    44,    45,    46,    10,    43,    61,   109,   110,    47,
-      22,    61,    23,    24,    25,    26,    61,    60,    62,    63,
-      61,   203,    65,    66,    53,    54,    55,    56,    61,    22,
-      62,    63,   141,    11,    62,    63,    48,    49,    50,    51,
-      52,    53,    54,    55,    56,    61,    58,    61,    19,    61,
-      52,    56,    64,   162,   163,    48,    49,    50,    51,    52,
-      53,    54,    55,    56,   173,    58,    61,    28,    60,    15,
-      17,    64,    48,    49,    50,    51,    52,    53,    54,    55,
-      56,    62,    58,   192,    17,    62,    17,    62,    64,    62,
-      62,    17,    17,    61,    61,    16,   205,    54,    18,    16,
-      62,    40,   133,    63,    62,    79,    62,   161,    63,   118,
-     162,   209,   204,   161,   163,   106,   206,   195,    -1,    -1,
-     205
+       9,    85,     4,    13,   110,     7,    90,    69,    19,     4,
+      55,    73,    74,    75,    76,    17,     6,    79,    80,    81,
+       6,    19,    23,    24,    25,    26,    28,    29,    55,    31,
+      32,    29,    27,    35,    36,    65,    66,    27,   144,     8,
+      67,    27,    22,    10,    45,    14,   108,    13,    37,    38,
+       0,    22,    42,    65,    66,    66,    66,    60,   120,   165,
+      62,    13,    71,   169,    21,    62,   128,    66,    66,    65,
+      66,    13,   178,    65,    66,    77,    56,    57,    58,    59,
+      51,    52,    53,    54,    55,    56,    57,    58,    59,    63,
+      61,   153,   154,   155,   156,   157,    67,    10,     3,    64,
+       5,   110,     7,     8,     9,    65,    66,    12,    67,   111,
+     112,    70,    71,    72,    41,    20,    21,    22,    64,    22,
+      47,    48,    49,    64,    64,    30,    31,    32,    33,    34,
+      35,    64,    64,    64,   218,   144,    63,    11,    43,    44,
+      19,    68,    69,    55,    59,    50,    64,    63,    51,    52,
+      53,    54,    55,    56,    57,    58,    59,    65,    61,   168,
+     169,    64,    28,    65,    67,    56,    57,    58,    59,    65,
+     179,    51,    52,    53,    54,    55,    56,    57,    58,    59,
+      65,    61,    51,    52,    53,    54,    55,    67,    65,    15,
+      17,   200,    61,    17,    17,    17,    17,    46,    67,    64,
+      64,    64,    16,    18,    64,    57,    57,    16,    55,    65,
+      65,   220,    66,    66,    55,    65,   120,    65,    63,    81,
+      40,   168,   167,   217,   167,   136,   219,   108,   207,   220,
+     169,    -1,    -1,    -1,    -1,    -1,   223,    -1,   226
 };
 
 /* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
@@ -823,61 +835,64 @@ static const yytype_int16 yycheck[] =
 static const yytype_int8 yystos[] =
 {
        0,     3,     5,     7,     8,     9,    12,    20,    21,    22,
-      30,    31,    32,    33,    34,    35,    43,    47,    71,    72,
-      73,    74,    75,    76,    77,     4,    27,     6,    27,    42,
-       6,    27,    52,   111,    10,    13,   111,    37,    38,   110,
-      48,    49,    50,    51,    52,    58,    64,    87,    88,    98,
-      99,   100,   101,   102,   112,   114,    57,   113,     0,    59,
-      13,   111,   111,   111,   111,   111,   111,    21,    60,    63,
-      13,    61,    61,    61,    61,    10,   111,    61,    61,    61,
-      11,    19,    85,    95,    96,   112,    56,    87,   106,   111,
-     112,    64,   112,   112,   112,   111,    78,    80,   112,    79,
-     112,    79,    61,    84,    86,    87,    63,    85,    60,    29,
-      63,    85,    62,    62,    62,    62,    62,    62,    63,    23,
-      24,    25,    26,    81,    62,    63,    62,    53,    54,    55,
-      56,    82,    83,    28,    41,    44,    45,    46,    60,    65,
-      66,    89,    96,    83,    87,    97,   111,   111,    15,   107,
-      17,    17,    17,    17,    17,    80,    61,   112,    62,    63,
-      84,    61,    22,    61,    83,    87,    91,    92,    64,    67,
-      68,    69,    90,    16,    18,   105,   112,   112,   112,   112,
-     112,    54,    83,    82,    92,    93,    94,    88,    91,    83,
-      87,   108,    16,    62,    62,    13,    62,     8,    14,   109,
-      87,   103,   104,   106,    40,    63,    85,    86,   103,   107,
-     105
+      30,    31,    32,    33,    34,    35,    43,    44,    50,    74,
+      75,    76,    77,    78,    79,    80,     4,    27,     6,    27,
+      42,     6,    27,    55,   117,    10,    13,   117,    37,    38,
+     116,    51,    52,    53,    54,    55,    61,    67,    93,    94,
+     104,   105,   106,   107,   108,   118,   120,    60,   119,   117,
+       0,    62,    13,   117,   117,   117,   117,   117,   117,    21,
+      63,    66,    13,    64,    64,    64,    64,    10,   117,    64,
+      64,    64,    11,    19,    91,   101,   102,   118,    59,    93,
+     112,   117,   118,    67,   118,   118,   118,   117,    81,    86,
+     118,    82,   118,    82,    64,    90,    92,    93,    66,    91,
+      63,    29,    66,    91,    65,    65,    65,    65,    65,    65,
+      66,    23,    24,    25,    26,    45,    87,    65,    66,    65,
+      56,    57,    58,    59,    88,    89,    28,    41,    47,    48,
+      49,    63,    68,    69,    95,   102,    89,    93,   103,   117,
+     117,    15,   113,    17,    17,    17,    17,    17,    46,    83,
+      86,    64,    64,   118,    65,    66,    90,    64,    22,    64,
+      89,    93,    97,    98,    67,    70,    71,    72,    96,    16,
+      18,   111,   118,   118,   118,   118,   118,    64,    57,    57,
+      89,    88,    98,    99,   100,    94,    97,    89,    93,   114,
+      16,    55,    84,    85,    65,    65,    65,    13,    65,     8,
+      14,   115,    93,   109,   110,    63,    65,    66,   112,    40,
+      66,    55,    85,    91,    92,   109,   113,   111
 };
 
 /* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr1[] =
 {
-       0,    70,    71,    71,    71,    71,    72,    72,    72,    72,
-      72,    73,    73,    73,    73,    74,    74,    75,    76,    76,
-      76,    76,    76,    76,    76,    77,    77,    77,    77,    78,
-      78,    79,    79,    80,    81,    81,    81,    81,    82,    82,
-      83,    83,    83,    83,    84,    84,    84,    85,    85,    86,
-      86,    87,    87,    87,    87,    87,    87,    87,    87,    87,
-      87,    87,    87,    87,    88,    88,    89,    89,    89,    89,
-      89,    89,    90,    90,    90,    90,    91,    91,    91,    92,
-      93,    94,    94,    95,    95,    96,    96,    97,    98,    99,
-     100,   101,   102,   103,   103,   104,   104,   105,   105,   106,
-     106,   106,   107,   107,   108,   109,   109,   109,   110,   110,
-     111,   112,   113,   114
+       0,    73,    74,    74,    74,    74,    75,    75,    75,    75,
+      75,    76,    76,    76,    76,    77,    77,    77,    77,    78,
+      79,    79,    79,    79,    79,    79,    79,    80,    80,    80,
+      80,    81,    81,    82,    82,    83,    83,    84,    84,    85,
+      86,    87,    87,    87,    87,    87,    88,    88,    89,    89,
+      89,    89,    90,    90,    90,    91,    91,    92,    92,    93,
+      93,    93,    93,    93,    93,    93,    93,    93,    93,    93,
+      93,    93,    94,    94,    95,    95,    95,    95,    95,    95,
+      96,    96,    96,    96,    97,    97,    97,    98,    99,   100,
+     100,   101,   101,   102,   102,   103,   104,   105,   106,   107,
+     108,   109,   109,   110,   110,   111,   111,   112,   112,   112,
+     113,   113,   114,   115,   115,   115,   116,   116,   117,   118,
+     119,   120
 };
 
 /* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr2[] =
 {
        0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     2,     4,     4,     6,     3,
-       2,     6,     6,     2,     4,     7,     4,     5,     7,     1,
-       3,     1,     3,     2,     1,     4,     1,     1,     1,     3,
-       1,     1,     1,     1,     3,     5,     5,     0,     2,     1,
-       3,     1,     1,     1,     6,     6,     6,     6,     6,     4,
-       4,     4,     4,     4,     1,     3,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     1,     7,
-       1,     1,     1,     1,     3,     3,     3,     3,     1,     1,
-       1,     1,     1,     1,     3,     1,     3,     0,     3,     1,
-       3,     3,     3,     0,     2,     1,     1,     0,     1,     1,
-       1,     1,     1,     1
+       1,     1,     1,     1,     1,     2,     4,     1,     2,     4,
+       7,     3,     2,     6,     6,     2,     4,     7,     4,     5,
+       7,     1,     3,     1,     3,     0,     4,     1,     3,     3,
+       2,     1,     4,     4,     1,     1,     1,     3,     1,     1,
+       1,     1,     3,     5,     5,     0,     2,     1,     3,     1,
+       1,     1,     6,     6,     6,     6,     6,     4,     4,     4,
+       4,     4,     1,     3,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     7,     1,     1,
+       1,     1,     3,     3,     3,     3,     1,     1,     1,     1,
+       1,     1,     3,     1,     3,     0,     3,     1,     3,     3,
+       3,     0,     2,     1,     1,     0,     1,     1,     1,     1,
+       1,     1
 };
 
 
@@ -1733,812 +1748,874 @@ yyreduce:
   switch (yyn)
     {
   case 2: /* start: stmt ';'  */
-#line 83 "yacc.y"
+#line 85 "yacc.y"
     {
         parse_tree = (yyvsp[-1].sv_node);
         YYACCEPT;
     }
-#line 1742 "yacc.tab.cpp"
+#line 1757 "yacc.tab.cpp"
     break;
 
   case 3: /* start: HELP  */
-#line 88 "yacc.y"
+#line 90 "yacc.y"
     {
         parse_tree = std::make_shared<Help>();
         YYACCEPT;
     }
-#line 1751 "yacc.tab.cpp"
+#line 1766 "yacc.tab.cpp"
     break;
 
   case 4: /* start: EXIT  */
-#line 93 "yacc.y"
+#line 95 "yacc.y"
     {
         parse_tree = nullptr;
         YYACCEPT;
     }
-#line 1760 "yacc.tab.cpp"
+#line 1775 "yacc.tab.cpp"
     break;
 
   case 5: /* start: T_EOF  */
-#line 98 "yacc.y"
+#line 100 "yacc.y"
     {
         parse_tree = nullptr;
         YYACCEPT;
     }
-#line 1769 "yacc.tab.cpp"
+#line 1784 "yacc.tab.cpp"
     break;
 
   case 11: /* txnStmt: TXN_BEGIN  */
-#line 114 "yacc.y"
+#line 116 "yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnBegin>();
     }
-#line 1777 "yacc.tab.cpp"
+#line 1792 "yacc.tab.cpp"
     break;
 
   case 12: /* txnStmt: TXN_COMMIT  */
-#line 118 "yacc.y"
+#line 120 "yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnCommit>();
     }
-#line 1785 "yacc.tab.cpp"
+#line 1800 "yacc.tab.cpp"
     break;
 
   case 13: /* txnStmt: TXN_ABORT  */
-#line 122 "yacc.y"
+#line 124 "yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnAbort>();
     }
-#line 1793 "yacc.tab.cpp"
+#line 1808 "yacc.tab.cpp"
     break;
 
   case 14: /* txnStmt: TXN_ROLLBACK  */
-#line 126 "yacc.y"
+#line 128 "yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnRollback>();
     }
-#line 1801 "yacc.tab.cpp"
+#line 1816 "yacc.tab.cpp"
     break;
 
   case 15: /* dbStmt: SHOW TABLES  */
-#line 133 "yacc.y"
+#line 135 "yacc.y"
     {
         (yyval.sv_node) = std::make_shared<ShowTables>();
     }
-#line 1809 "yacc.tab.cpp"
+#line 1824 "yacc.tab.cpp"
     break;
 
   case 16: /* dbStmt: SHOW INDEX FROM tbName  */
-#line 138 "yacc.y"
+#line 140 "yacc.y"
     {
 	(yyval.sv_node) = std::make_shared<ShowIndex>((yyvsp[0].sv_str));
     }
-#line 1817 "yacc.tab.cpp"
+#line 1832 "yacc.tab.cpp"
+    break;
+
+  case 17: /* dbStmt: VACUUM  */
+#line 144 "yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<Vacuum>("");
+    }
+#line 1840 "yacc.tab.cpp"
     break;
 
-  case 17: /* setStmt: SET set_knob_type '=' VALUE_BOOL  */
-#line 145 "yacc.y"
+  case 18: /* dbStmt: VACUUM tbName  */
+#line 148 "yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<Vacuum>((yyvsp[0].sv_str));
+    }
+#line 1848 "yacc.tab.cpp"
+    break;
+
+  case 19: /* setStmt: SET set_knob_type '=' VALUE_BOOL  */
+#line 155 "yacc.y"
     {
         (yyval.sv_node) = std::make_shared<SetStmt>((yyvsp[-2].sv_setKnobType), (yyvsp[0].sv_bool));
     }
-#line 1825 "yacc.tab.cpp"
+#line 1856 "yacc.tab.cpp"
     break;
 
-  case 18: /* ddl: CREATE TABLE tbName '(' fieldList ')'  */
-#line 152 "yacc.y"
+  case 20: /* ddl: CREATE TABLE tbName '(' fieldList ')' optTableOptions  */
+#line 162 "yacc.y"
     {
-        (yyval.sv_node) = std::make_shared<CreateTable>((yyvsp[-3].sv_str), (yyvsp[-1].sv_fields));
+        (yyval.sv_node) = std::make_shared<CreateTable>((yyvsp[-4].sv_str), (yyvsp[-2].sv_fields), (yyvsp[0].sv_table_options));
     }
-#line 1833 "yacc.tab.cpp"
+#line 1864 "yacc.tab.cpp"
     break;
 
-  case 19: /* ddl: DROP TABLE tbName  */
-#line 156 "yacc.y"
+  case 21: /* ddl: DROP TABLE tbName  */
+#line 166 "yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DropTable>((yyvsp[0].sv_str));
     }
-#line 1841 "yacc.tab.cpp"
+#line 1872 "yacc.tab.cpp"
     break;
 
-  case 20: /* ddl: DESC tbName  */
-#line 160 "yacc.y"
+  case 22: /* ddl: DESC tbName  */
+#line 170 "yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DescTable>((yyvsp[0].sv_str));
     }
-#line 1849 "yacc.tab.cpp"
+#line 1880 "yacc.tab.cpp"
     break;
 
-  case 21: /* ddl: CREATE INDEX tbName '(' colNameList ')'  */
-#line 164 "yacc.y"
+  case 23: /* ddl: CREATE INDEX tbName '(' colNameList ')'  */
+#line 174 "yacc.y"
     {
         (yyval.sv_node) = std::make_shared<CreateIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_strs));
     }
-#line 1857 "yacc.tab.cpp"
+#line 1888 "yacc.tab.cpp"
     break;
 
-  case 22: /* ddl: DROP INDEX tbName '(' colNameList ')'  */
-#line 168 "yacc.y"
+  case 24: /* ddl: DROP INDEX tbName '(' colNameList ')'  */
+#line 178 "yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DropIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_strs));
     }
-#line 1865 "yacc.tab.cpp"
+#line 1896 "yacc.tab.cpp"
     break;
 
-  case 23: /* ddl: CREATE STATIC_CHECKPOINT  */
-#line 172 "yacc.y"
+  case 25: /* ddl: CREATE STATIC_CHECKPOINT  */
+#line 182 "yacc.y"
     {
     	(yyval.sv_node) = std::make_shared<StaticCheckpoint>();
     }
-#line 1873 "yacc.tab.cpp"
+#line 1904 "yacc.tab.cpp"
     break;
 
-  case 24: /* ddl: LOAD file_path INTO tbName  */
-#line 176 "yacc.y"
+  case 26: /* ddl: LOAD file_path INTO tbName  */
+#line 186 "yacc.y"
     {
          (yyval.sv_node) = std::make_shared<LoadStmt>((yyvsp[-2].sv_str), (yyvsp[0].sv_str));
          std::cout << "Parsed file path: " << (yyvsp[-2].sv_str) << std::endl;
     }
-#line 1882 "yacc.tab.cpp"
+#line 1913 "yacc.tab.cpp"
     break;
 
-  case 25: /* dml: INSERT INTO tbName VALUES '(' valueList ')'  */
-#line 184 "yacc.y"
+  case 27: /* dml: INSERT INTO tbName VALUES '(' valueList ')'  */
+#line 194 "yacc.y"
     {
         (yyval.sv_node) = std::make_shared<InsertStmt>((yyvsp[-4].sv_str), (yyvsp[-1].sv_vals));
     }
-#line 1890 "yacc.tab.cpp"
+#line 1921 "yacc.tab.cpp"
     break;
 
-  case 26: /* dml: DELETE FROM tbName optWhereClause  */
-#line 188 "yacc.y"
+  case 28: /* dml: DELETE FROM tbName optWhereClause  */
+#line 198 "yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DeleteStmt>((yyvsp[-1].sv_str), (yyvsp[0].sv_conds));
     }
-#line 1898 "yacc.tab.cpp"
+#line 1929 "yacc.tab.cpp"
     break;
 
-  case 27: /* dml: UPDATE tbName SET setClauses optWhereClause  */
-#line 192 "yacc.y"
+  case 29: /* dml: UPDATE tbName SET setClauses optWhereClause  */
+#line 202 "yacc.y"
     {
         (yyval.sv_node) = std::make_shared<UpdateStmt>((yyvsp[-3].sv_str), (yyvsp[-1].sv_set_clauses), (yyvsp[0].sv_conds));
     }
-#line 1906 "yacc.tab.cpp"
+#line 1937 "yacc.tab.cpp"
     break;
 
-  case 28: /* dml: SELECT selector FROM tableList optWhereClause opt_order_clause sv_group_by  */
-#line 196 "yacc.y"
+  case 30: /* dml: SELECT selector FROM tableList optWhereClause opt_order_clause sv_group_by  */
+#line 206 "yacc.y"
     {
         (yyval.sv_node) = std::make_shared<SelectStmt>((yyvsp[-5].sv_cols), (yyvsp[-3].sv_strs), (yyvsp[-2].sv_conds), (yyvsp[-1].sv_orderby), (yyvsp[0].sv_group_by_cols));
     }
-#line 1914 "yacc.tab.cpp"
+#line 1945 "yacc.tab.cpp"
     break;
 
-  case 29: /* fieldList: field  */
-#line 203 "yacc.y"
+  case 31: /* fieldList: field  */
+#line 213 "yacc.y"
     {
         (yyval.sv_fields) = std::vector<std::shared_ptr<Field>>{(yyvsp[0].sv_field)};
     }
-#line 1922 "yacc.tab.cpp"
+#line 1953 "yacc.tab.cpp"
     break;
 
-  case 30: /* fieldList: fieldList ',' field  */
-#line 207 "yacc.y"
+  case 32: /* fieldList: fieldList ',' field  */
+#line 217 "yacc.y"
     {
         (yyval.sv_fields).push_back((yyvsp[0].sv_field));
     }
-#line 1930 "yacc.tab.cpp"
+#line 1961 "yacc.tab.cpp"
     break;
 
-  case 31: /* colNameList: colName  */
-#line 214 "yacc.y"
+  case 33: /* colNameList: colName  */
+#line 224 "yacc.y"
     {
         (yyval.sv_strs) = std::vector<std::string>{(yyvsp[0].sv_str)};
     }
-#line 1938 "yacc.tab.cpp"
+#line 1969 "yacc.tab.cpp"
     break;
 
-  case 32: /* colNameList: colNameList ',' colName  */
-#line 218 "yacc.y"
+  case 34: /* colNameList: colNameList ',' colName  */
+#line 228 "yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 1946 "yacc.tab.cpp"
+#line 1977 "yacc.tab.cpp"
+    break;
+
+  case 35: /* optTableOptions: %empty  */
+#line 234 "yacc.y"
+                      { /* ignore*/ }
+#line 1983 "yacc.tab.cpp"
+    break;
+
+  case 36: /* optTableOptions: WITH '(' tableOptionList ')'  */
+#line 236 "yacc.y"
+    {
+        (yyval.sv_table_options) = (yyvsp[-1].sv_table_options);
+    }
+#line 1991 "yacc.tab.cpp"
+    break;
+
+  case 37: /* tableOptionList: tableOption  */
+#line 243 "yacc.y"
+    {
+        (yyval.sv_table_options) = std::vector<std::shared_ptr<TableOption>>{(yyvsp[0].sv_table_option)};
+    }
+#line 1999 "yacc.tab.cpp"
     break;
 
-  case 33: /* field: colName type  */
-#line 225 "yacc.y"
+  case 38: /* tableOptionList: tableOptionList ',' tableOption  */
+#line 247 "yacc.y"
+    {
+        (yyval.sv_table_options).push_back((yyvsp[0].sv_table_option));
+    }
+#line 2007 "yacc.tab.cpp"
+    break;
+
+  case 39: /* tableOption: IDENTIFIER '=' IDENTIFIER  */
+#line 254 "yacc.y"
+    {
+        (yyval.sv_table_option) = std::make_shared<TableOption>((yyvsp[-2].sv_str), (yyvsp[0].sv_str));
+    }
+#line 2015 "yacc.tab.cpp"
+    break;
+
+  case 40: /* field: colName type  */
+#line 261 "yacc.y"
     {
         (yyval.sv_field) = std::make_shared<ColDef>((yyvsp[-1].sv_str), (yyvsp[0].sv_type_len));
     }
-#line 1954 "yacc.tab.cpp"
+#line 2023 "yacc.tab.cpp"
     break;
 
-  case 34: /* type: INT  */
-#line 232 "yacc.y"
+  case 41: /* type: INT  */
+#line 268 "yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_INT, sizeof(int));
     }
-#line 1962 "yacc.tab.cpp"
+#line 2031 "yacc.tab.cpp"
     break;
 
-  case 35: /* type: CHAR '(' VALUE_INT ')'  */
-#line 236 "yacc.y"
+  case 42: /* type: CHAR '(' VALUE_INT ')'  */
+#line 272 "yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_STRING, (yyvsp[-1].sv_int));
     }
-#line 1970 "yacc.tab.cpp"
+#line 2039 "yacc.tab.cpp"
     break;
 
-  case 36: /* type: FLOAT  */
-#line 240 "yacc.y"
+  case 43: /* type: VARCHAR '(' VALUE_INT ')'  */
+#line 276 "yacc.y"
+    {
+        (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_VARCHAR, (yyvsp[-1].sv_int));
+    }
+#line 2047 "yacc.tab.cpp"
+    break;
+
+  case 44: /* type: FLOAT  */
+#line 280 "yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_FLOAT, sizeof(float));
     }
-#line 1978 "yacc.tab.cpp"
+#line 2055 "yacc.tab.cpp"
     break;
 
-  case 37: /* type: DATETIME  */
-#line 244 "yacc.y"
+  case 45: /* type: DATETIME  */
+#line 284 "yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_STRING, 30);
     }
-#line 1986 "yacc.tab.cpp"
+#line 2063 "yacc.tab.cpp"
     break;
 
-  case 38: /* valueList: value  */
-#line 251 "yacc.y"
+  case 46: /* valueList: value  */
+#line 291 "yacc.y"
     {
         (yyval.sv_vals) = std::vector<std::shared_ptr<Value>>{(yyvsp[0].sv_val)};
     }
-#line 1994 "yacc.tab.cpp"
+#line 2071 "yacc.tab.cpp"
     break;
 
-  case 39: /* valueList: valueList ',' value  */
-#line 255 "yacc.y"
+  case 47: /* valueList: valueList ',' value  */
+#line 295 "yacc.y"
     {
         (yyval.sv_vals).push_back((yyvsp[0].sv_val));
     }
-#line 2002 "yacc.tab.cpp"
+#line 2079 "yacc.tab.cpp"
     break;
 
-  case 40: /* value: VALUE_INT  */
-#line 262 "yacc.y"
+  case 48: /* value: VALUE_INT  */
+#line 302 "yacc.y"
     {
         (yyval.sv_val) = std::make_shared<IntLit>((yyvsp[0].sv_int));
     }
-#line 2010 "yacc.tab.cpp"
+#line 2087 "yacc.tab.cpp"
     break;
 
-  case 41: /* value: VALUE_FLOAT  */
-#line 266 "yacc.y"
+  case 49: /* value: VALUE_FLOAT  */
+#line 306 "yacc.y"
     {
         (yyval.sv_val) = std::make_shared<FloatLit>((yyvsp[0].sv_float));
     }
-#line 2018 "yacc.tab.cpp"
+#line 2095 "yacc.tab.cpp"
     break;
 
-  case 42: /* value: VALUE_STRING  */
-#line 270 "yacc.y"
+  case 50: /* value: VALUE_STRING  */
+#line 310 "yacc.y"
     {
         (yyval.sv_val) = std::make_shared<StringLit>((yyvsp[0].sv_str));
     }
-#line 2026 "yacc.tab.cpp"
+#line 2103 "yacc.tab.cpp"
     break;
 
-  case 43: /* value: VALUE_BOOL  */
-#line 274 "yacc.y"
+  case 51: /* value: VALUE_BOOL  */
+#line 314 "yacc.y"
     {
         (yyval.sv_val) = std::make_shared<BoolLit>((yyvsp[0].sv_bool));
     }
-#line 2034 "yacc.tab.cpp"
+#line 2111 "yacc.tab.cpp"
     break;
 
-  case 44: /* condition: col op expr  */
-#line 281 "yacc.y"
+  case 52: /* condition: col op expr  */
+#line 321 "yacc.y"
     {
         (yyval.sv_cond) = std::make_shared<BinaryExpr>((yyvsp[-2].sv_col), (yyvsp[-1].sv_comp_op), (yyvsp[0].sv_expr));
     }
-#line 2042 "yacc.tab.cpp"
+#line 2119 "yacc.tab.cpp"
     break;
 
-  case 45: /* condition: col op '(' expr ')'  */
-#line 285 "yacc.y"
+  case 53: /* condition: col op '(' expr ')'  */
+#line 325 "yacc.y"
     {
     	(yyval.sv_cond) = std::make_shared<BinaryExpr>((yyvsp[-4].sv_col), (yyvsp[-3].sv_comp_op), (yyvsp[-1].sv_expr));
     }
-#line 2050 "yacc.tab.cpp"
+#line 2127 "yacc.tab.cpp"
     break;
 
-  case 46: /* condition: col IN '(' in_sub_query ')'  */
-#line 289 "yacc.y"
+  case 54: /* condition: col IN '(' in_sub_query ')'  */
+#line 329 "yacc.y"
     {
     	(yyval.sv_cond) = std::make_shared<BinaryExpr>((yyvsp[-4].sv_col), SV_OP_IN, (yyvsp[-1].in_sub_query));
     }
-#line 2058 "yacc.tab.cpp"
+#line 2135 "yacc.tab.cpp"
     break;
 
-  case 47: /* optWhereClause: %empty  */
-#line 295 "yacc.y"
+  case 55: /* optWhereClause: %empty  */
+#line 335 "yacc.y"
                       { /* ignore*/ }
-#line 2064 "yacc.tab.cpp"
+#line 2141 "yacc.tab.cpp"
     break;
 
-  case 48: /* optWhereClause: WHERE whereClause  */
-#line 297 "yacc.y"
+  case 56: /* optWhereClause: WHERE whereClause  */
+#line 337 "yacc.y"
     {
         (yyval.sv_conds) = (yyvsp[0].sv_conds);
     }
-#line 2072 "yacc.tab.cpp"
+#line 2149 "yacc.tab.cpp"
     break;
 
-  case 49: /* whereClause: condition  */
-#line 304 "yacc.y"
+  case 57: /* whereClause: condition  */
+#line 344 "yacc.y"
     {
         (yyval.sv_conds) = std::vector<std::shared_ptr<BinaryExpr>>{(yyvsp[0].sv_cond)};
     }
-#line 2080 "yacc.tab.cpp"
+#line 2157 "yacc.tab.cpp"
     break;
 
-  case 50: /* whereClause: whereClause AND condition  */
-#line 308 "yacc.y"
+  case 58: /* whereClause: whereClause AND condition  */
+#line 348 "yacc.y"
     {
         (yyval.sv_conds).push_back((yyvsp[0].sv_cond));
     }
-#line 2088 "yacc.tab.cpp"
+#line 2165 "yacc.tab.cpp"
     break;
 
-  case 51: /* col: '*'  */
-#line 315 "yacc.y"
+  case 59: /* col: '*'  */
+#line 355 "yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>("", "", SV_AGGREGATE_NULL, "");
     }
-#line 2096 "yacc.tab.cpp"
+#line 2173 "yacc.tab.cpp"
     break;
 
-  case 52: /* col: table_col_name  */
-#line 319 "yacc.y"
+  case 60: /* col: table_col_name  */
+#line 359 "yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>((yyvsp[0].sv_str), SV_AGGREGATE_NULL, "");
     }
-#line 2104 "yacc.tab.cpp"
+#line 2181 "yacc.tab.cpp"
     break;
 
-  case 53: /* col: colName  */
-#line 323 "yacc.y"
+  case 61: /* col: colName  */
+#line 363 "yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>("", (yyvsp[0].sv_str), SV_AGGREGATE_NULL, "");
     }
-#line 2112 "yacc.tab.cpp"
+#line 2189 "yacc.tab.cpp"
     break;
 
-  case 54: /* col: AGGREGATE_SUM '(' colName ')' AS colName  */
-#line 327 "yacc.y"
+  case 62: /* col: AGGREGATE_SUM '(' colName ')' AS colName  */
+#line 367 "yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>("", (yyvsp[-3].sv_str), (yyvsp[-5].sv_aggregate_type), (yyvsp[0].sv_str));
     }
-#line 2120 "yacc.tab.cpp"
+#line 2197 "yacc.tab.cpp"
     break;
 
-  case 55: /* col: AGGREGATE_MIN '(' colName ')' AS colName  */
-#line 331 "yacc.y"
+  case 63: /* col: AGGREGATE_MIN '(' colName ')' AS colName  */
+#line 371 "yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>("", (yyvsp[-3].sv_str), (yyvsp[-5].sv_aggregate_type), (yyvsp[0].sv_str));
     }
-#line 2128 "yacc.tab.cpp"
+#line 2205 "yacc.tab.cpp"
     break;
 
-  case 56: /* col: AGGREGATE_MAX '(' colName ')' AS colName  */
-#line 335 "yacc.y"
+  case 64: /* col: AGGREGATE_MAX '(' colName ')' AS colName  */
+#line 375 "yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>("", (yyvsp[-3].sv_str), (yyvsp[-5].sv_aggregate_type), (yyvsp[0].sv_str));
     }
-#line 2136 "yacc.tab.cpp"
+#line 2213 "yacc.tab.cpp"
     break;
 
-  case 57: /* col: AGGREGATE_COUNT '(' colName ')' AS colName  */
-#line 339 "yacc.y"
+  case 65: /* col: AGGREGATE_COUNT '(' colName ')' AS colName  */
+#line 379 "yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>("", (yyvsp[-3].sv_str), (yyvsp[-5].sv_aggregate_type), (yyvsp[0].sv_str));
     }
-#line 2144 "yacc.tab.cpp"
+#line 2221 "yacc.tab.cpp"
     break;
 
-  case 58: /* col: AGGREGATE_COUNT '(' '*' ')' AS colName  */
-#line 343 "yacc.y"
+  case 66: /* col: AGGREGATE_COUNT '(' '*' ')' AS colName  */
+#line 383 "yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>("", "", (yyvsp[-5].sv_aggregate_type), (yyvsp[0].sv_str));
     }
-#line 2152 "yacc.tab.cpp"
+#line 2229 "yacc.tab.cpp"
     break;
 
-  case 59: /* col: AGGREGATE_SUM '(' colName ')'  */
-#line 347 "yacc.y"
+  case 67: /* col: AGGREGATE_SUM '(' colName ')'  */
+#line 387 "yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>("", (yyvsp[-1].sv_str), (yyvsp[-3].sv_aggregate_type), "");
     }
-#line 2160 "yacc.tab.cpp"
+#line 2237 "yacc.tab.cpp"
     break;
 
-  case 60: /* col: AGGREGATE_MIN '(' colName ')'  */
-#line 351 "yacc.y"
+  case 68: /* col: AGGREGATE_MIN '(' colName ')'  */
+#line 391 "yacc.y"
     {
          (yyval.sv_col) = std::make_shared<Col>("", (yyvsp[-1].sv_str), (yyvsp[-3].sv_aggregate_type), "");
     }
-#line 2168 "yacc.tab.cpp"
+#line 2245 "yacc.tab.cpp"
     break;
 
-  case 61: /* col: AGGREGATE_MAX '(' colName ')'  */
-#line 355 "yacc.y"
+  case 69: /* col: AGGREGATE_MAX '(' colName ')'  */
+#line 395 "yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>("", (yyvsp[-1].sv_str), (yyvsp[-3].sv_aggregate_type), "");
     }
-#line 2176 "yacc.tab.cpp"
+#line 2253 "yacc.tab.cpp"
     break;
 
-  case 62: /* col: AGGREGATE_COUNT '(' colName ')'  */
-#line 359 "yacc.y"
+  case 70: /* col: AGGREGATE_COUNT '(' colName ')'  */
+#line 399 "yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>("", (yyvsp[-1].sv_str), (yyvsp[-3].sv_aggregate_type), "");
     }
-#line 2184 "yacc.tab.cpp"
+#line 2261 "yacc.tab.cpp"
     break;
 
-  case 63: /* col: AGGREGATE_COUNT '(' '*' ')'  */
-#line 363 "yacc.y"
+  case 71: /* col: AGGREGATE_COUNT '(' '*' ')'  */
+#line 403 "yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>("", "", (yyvsp[-3].sv_aggregate_type), "");
     }
-#line 2192 "yacc.tab.cpp"
+#line 2269 "yacc.tab.cpp"
     break;
 
-  case 64: /* colList: col  */
-#line 370 "yacc.y"
+  case 72: /* colList: col  */
+#line 410 "yacc.y"
     {
         (yyval.sv_cols) = std::vector<std::shared_ptr<Col>>{(yyvsp[0].sv_col)};
     }
-#line 2200 "yacc.tab.cpp"
+#line 2277 "yacc.tab.cpp"
     break;
 
-  case 65: /* colList: colList ',' col  */
-#line 374 "yacc.y"
+  case 73: /* colList: colList ',' col  */
+#line 414 "yacc.y"
     {
         (yyval.sv_cols).push_back((yyvsp[0].sv_col));
     }
-#line 2208 "yacc.tab.cpp"
+#line 2285 "yacc.tab.cpp"
     break;
 
-  case 66: /* op: '='  */
-#line 381 "yacc.y"
+  case 74: /* op: '='  */
+#line 421 "yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_EQ;
     }
-#line 2216 "yacc.tab.cpp"
+#line 2293 "yacc.tab.cpp"
     break;
 
-  case 67: /* op: '<'  */
-#line 385 "yacc.y"
+  case 75: /* op: '<'  */
+#line 425 "yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_LT;
     }
-#line 2224 "yacc.tab.cpp"
+#line 2301 "yacc.tab.cpp"
     break;
 
-  case 68: /* op: '>'  */
-#line 389 "yacc.y"
+  case 76: /* op: '>'  */
+#line 429 "yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_GT;
     }
-#line 2232 "yacc.tab.cpp"
+#line 2309 "yacc.tab.cpp"
     break;
 
-  case 69: /* op: NEQ  */
-#line 393 "yacc.y"
+  case 77: /* op: NEQ  */
+#line 433 "yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_NE;
     }
-#line 2240 "yacc.tab.cpp"
+#line 2317 "yacc.tab.cpp"
     break;
 
-  case 70: /* op: LEQ  */
-#line 397 "yacc.y"
+  case 78: /* op: LEQ  */
+#line 437 "yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_LE;
     }
-#line 2248 "yacc.tab.cpp"
+#line 2325 "yacc.tab.cpp"
     break;
 
-  case 71: /* op: GEQ  */
-#line 401 "yacc.y"
+  case 79: /* op: GEQ  */
+#line 441 "yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_GE;
     }
-#line 2256 "yacc.tab.cpp"
+#line 2333 "yacc.tab.cpp"
     break;
 
-  case 72: /* art_op: '+'  */
-#line 408 "yacc.y"
+  case 80: /* art_op: '+'  */
+#line 448 "yacc.y"
     {
         (yyval.sv_art_op) = AGG_OP_ADD;
     }
-#line 2264 "yacc.tab.cpp"
+#line 2341 "yacc.tab.cpp"
     break;
 
-  case 73: /* art_op: '-'  */
-#line 412 "yacc.y"
+  case 81: /* art_op: '-'  */
+#line 452 "yacc.y"
     {
     	(yyval.sv_art_op) = AGG_OP_SUB;
     }
-#line 2272 "yacc.tab.cpp"
+#line 2349 "yacc.tab.cpp"
     break;
 
-  case 74: /* art_op: '*'  */
-#line 416 "yacc.y"
+  case 82: /* art_op: '*'  */
+#line 456 "yacc.y"
     {
     	(yyval.sv_art_op) = AGG_OP_MUL;
     }
-#line 2280 "yacc.tab.cpp"
+#line 2357 "yacc.tab.cpp"
     break;
 
-  case 75: /* art_op: '/'  */
-#line 420 "yacc.y"
+  case 83: /* art_op: '/'  */
+#line 460 "yacc.y"
     {
     	(yyval.sv_art_op) = AGG_OP_DIV;
     }
-#line 2288 "yacc.tab.cpp"
+#line 2365 "yacc.tab.cpp"
     break;
 
-  case 76: /* expr: value  */
-#line 428 "yacc.y"
+  case 84: /* expr: value  */
+#line 468 "yacc.y"
     {
         (yyval.sv_expr) = std::static_pointer_cast<Expr>((yyvsp[0].sv_val));
     }
-#line 2296 "yacc.tab.cpp"
+#line 2373 "yacc.tab.cpp"
     break;
 
-  case 77: /* expr: col  */
-#line 432 "yacc.y"
+  case 85: /* expr: col  */
+#line 472 "yacc.y"
     {
         (yyval.sv_expr) = std::static_pointer_cast<Expr>((yyvsp[0].sv_col));
     }
-#line 2304 "yacc.tab.cpp"
+#line 2381 "yacc.tab.cpp"
     break;
 
-  case 78: /* expr: sub_select_stmt  */
-#line 436 "yacc.y"
+  case 86: /* expr: sub_select_stmt  */
+#line 476 "yacc.y"
     {
     	(yyval.sv_expr) = std::static_pointer_cast<Expr>((yyvsp[0].sub_select_stmt));
     }
-#line 2312 "yacc.tab.cpp"
+#line 2389 "yacc.tab.cpp"
     break;
 
-  case 79: /* sub_select_stmt: SELECT colList FROM tableList optWhereClause opt_order_clause sv_group_by  */
-#line 443 "yacc.y"
+  case 87: /* sub_select_stmt: SELECT colList FROM tableList optWhereClause opt_order_clause sv_group_by  */
+#line 483 "yacc.y"
     {
         (yyval.sub_select_stmt) = std::make_shared<SubSelectStmt>((yyvsp[-5].sv_cols), (yyvsp[-3].sv_strs), (yyvsp[-2].sv_conds), (yyvsp[-1].sv_orderby), (yyvsp[0].sv_group_by_cols));
     }
-#line 2320 "yacc.tab.cpp"
+#line 2397 "yacc.tab.cpp"
     break;
 
-  case 80: /* in_op_vlaue: valueList  */
-#line 450 "yacc.y"
+  case 88: /* in_op_vlaue: valueList  */
+#line 490 "yacc.y"
     {
         (yyval.in_op_value) = std::make_shared<InOpValue>((yyvsp[0].sv_vals));
     }
-#line 2328 "yacc.tab.cpp"
+#line 2405 "yacc.tab.cpp"
     break;
 
-  case 81: /* in_sub_query: sub_select_stmt  */
-#line 457 "yacc.y"
+  case 89: /* in_sub_query: sub_select_stmt  */
+#line 497 "yacc.y"
     {
 	(yyval.in_sub_query) = std::static_pointer_cast<Expr>((yyvsp[0].sub_select_stmt));
     }
-#line 2336 "yacc.tab.cpp"
+#line 2413 "yacc.tab.cpp"
     break;
 
-  case 82: /* in_sub_query: in_op_vlaue  */
-#line 461 "yacc.y"
+  case 90: /* in_sub_query: in_op_vlaue  */
+#line 501 "yacc.y"
     {
     	(yyval.in_sub_query) = std::static_pointer_cast<Expr>((yyvsp[0].in_op_value));
     }
-#line 2344 "yacc.tab.cpp"
+#line 2421 "yacc.tab.cpp"
     break;
 
-  case 83: /* setClauses: setClause  */
-#line 468 "yacc.y"
+  case 91: /* setClauses: setClause  */
+#line 508 "yacc.y"
     {
         (yyval.sv_set_clauses) = std::vector<std::shared_ptr<SetClause>>{(yyvsp[0].sv_set_clause)};
     }
-#line 2352 "yacc.tab.cpp"
+#line 2429 "yacc.tab.cpp"
     break;
 
-  case 84: /* setClauses: setClauses ',' setClause  */
-#line 472 "yacc.y"
+  case 92: /* setClauses: setClauses ',' setClause  */
+#line 512 "yacc.y"
     {
         (yyval.sv_set_clauses).push_back((yyvsp[0].sv_set_clause));
     }
-#line 2360 "yacc.tab.cpp"
+#line 2437 "yacc.tab.cpp"
     break;
 
-  case 85: /* setClause: colName '=' value  */
-#line 479 "yacc.y"
+  case 93: /* setClause: colName '=' value  */
+#line 519 "yacc.y"
     {
         (yyval.sv_set_clause) = std::make_shared<SetClause>((yyvsp[-2].sv_str), (yyvsp[0].sv_val));
     }
-#line 2368 "yacc.tab.cpp"
+#line 2445 "yacc.tab.cpp"
     break;
 
-  case 86: /* setClause: colName '=' artExpr  */
-#line 483 "yacc.y"
+  case 94: /* setClause: colName '=' artExpr  */
+#line 523 "yacc.y"
     {
     	(yyval.sv_set_clause) = std::make_shared<SetClauseCol>((yyvsp[-2].sv_str), (yyvsp[0].sv_art_expr));
     }
-#line 2376 "yacc.tab.cpp"
+#line 2453 "yacc.tab.cpp"
     break;
 
-  case 87: /* artExpr: col art_op value  */
-#line 490 "yacc.y"
+  case 95: /* artExpr: col art_op value  */
+#line 530 "yacc.y"
     {
     	(yyval.sv_art_expr) = std::make_shared<ArtExpr>((yyvsp[-2].sv_col), (yyvsp[-1].sv_art_op), (yyvsp[0].sv_val));
     }
-#line 2384 "yacc.tab.cpp"
+#line 2461 "yacc.tab.cpp"
     break;
 
-  case 89: /* AGGREGATE_SUM: SUM  */
-#line 501 "yacc.y"
+  case 97: /* AGGREGATE_SUM: SUM  */
+#line 541 "yacc.y"
     {
         (yyval.sv_aggregate_type) = SV_AGGREGATE_SUM;
     }
-#line 2392 "yacc.tab.cpp"
+#line 2469 "yacc.tab.cpp"
     break;
 
-  case 90: /* AGGREGATE_COUNT: COUNT  */
-#line 508 "yacc.y"
+  case 98: /* AGGREGATE_COUNT: COUNT  */
+#line 548 "yacc.y"
     {
         (yyval.sv_aggregate_type) = SV_AGGREGATE_COUNT;
     }
-#line 2400 "yacc.tab.cpp"
+#line 2477 "yacc.tab.cpp"
     break;
 
-  case 91: /* AGGREGATE_MAX: MAX  */
-#line 515 "yacc.y"
+  case 99: /* AGGREGATE_MAX: MAX  */
+#line 555 "yacc.y"
     {
         (yyval.sv_aggregate_type) = SV_AGGREGATE_MAX;
     }
-#line 2408 "yacc.tab.cpp"
+#line 2485 "yacc.tab.cpp"
     break;
 
-  case 92: /* AGGREGATE_MIN: MIN  */
-#line 522 "yacc.y"
+  case 100: /* AGGREGATE_MIN: MIN  */
+#line 562 "yacc.y"
     {
         (yyval.sv_aggregate_type) = SV_AGGREGATE_MIN;
     }
-#line 2416 "yacc.tab.cpp"
+#line 2493 "yacc.tab.cpp"
     break;
 
-  case 93: /* sv_group_by_col: col  */
-#line 529 "yacc.y"
+  case 101: /* sv_group_by_col: col  */
+#line 569 "yacc.y"
     {
 	(yyval.sv_group_by_col) = std::make_shared<GroupBy>((yyvsp[0].sv_col), std::vector<std::shared_ptr<BinaryExpr>>{});
     }
-#line 2424 "yacc.tab.cpp"
+#line 2501 "yacc.tab.cpp"
     break;
 
-  case 94: /* sv_group_by_col: col HAVING whereClause  */
-#line 533 "yacc.y"
+  case 102: /* sv_group_by_col: col HAVING whereClause  */
+#line 573 "yacc.y"
     {
 	(yyval.sv_group_by_col) = std::make_shared<GroupBy>((yyvsp[-2].sv_col), (yyvsp[0].sv_conds));
     }
-#line 2432 "yacc.tab.cpp"
+#line 2509 "yacc.tab.cpp"
     break;
 
-  case 95: /* group_by_cols: sv_group_by_col  */
-#line 540 "yacc.y"
+  case 103: /* group_by_cols: sv_group_by_col  */
+#line 580 "yacc.y"
     {
     	(yyval.sv_group_by_cols) = std::vector<std::shared_ptr<GroupBy>>{(yyvsp[0].sv_group_by_col)};
     }
-#line 2440 "yacc.tab.cpp"
+#line 2517 "yacc.tab.cpp"
     break;
 
-  case 96: /* group_by_cols: group_by_cols ',' sv_group_by_col  */
-#line 544 "yacc.y"
+  case 104: /* group_by_cols: group_by_cols ',' sv_group_by_col  */
+#line 584 "yacc.y"
     {
     	(yyval.sv_group_by_cols).push_back((yyvsp[0].sv_group_by_col));
     }
-#line 2448 "yacc.tab.cpp"
+#line 2525 "yacc.tab.cpp"
     break;
 
-  case 97: /* sv_group_by: %empty  */
-#line 550 "yacc.y"
+  case 105: /* sv_group_by: %empty  */
+#line 590 "yacc.y"
                       { /* ignore*/ }
-#line 2454 "yacc.tab.cpp"
+#line 2531 "yacc.tab.cpp"
     break;
 
-  case 98: /* sv_group_by: GROUP BY group_by_cols  */
-#line 552 "yacc.y"
+  case 106: /* sv_group_by: GROUP BY group_by_cols  */
+#line 592 "yacc.y"
     {
     	(yyval.sv_group_by_cols) = (yyvsp[0].sv_group_by_cols);
     }
-#line 2462 "yacc.tab.cpp"
+#line 2539 "yacc.tab.cpp"
     break;
 
-  case 99: /* tableList: tbName  */
-#line 558 "yacc.y"
+  case 107: /* tableList: tbName  */
+#line 598 "yacc.y"
     {
         (yyval.sv_strs) = std::vector<std::string>{(yyvsp[0].sv_str)};
     }
-#line 2470 "yacc.tab.cpp"
+#line 2547 "yacc.tab.cpp"
     break;
 
-  case 100: /* tableList: tableList ',' tbName  */
-#line 562 "yacc.y"
+  case 108: /* tableList: tableList ',' tbName  */
+#line 602 "yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 2478 "yacc.tab.cpp"
+#line 2555 "yacc.tab.cpp"
     break;
 
-  case 101: /* tableList: tableList JOIN tbName  */
-#line 566 "yacc.y"
+  case 109: /* tableList: tableList JOIN tbName  */
+#line 606 "yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 2486 "yacc.tab.cpp"
+#line 2563 "yacc.tab.cpp"
     break;
 
-  case 102: /* opt_order_clause: ORDER BY order_clause  */
-#line 573 "yacc.y"
+  case 110: /* opt_order_clause: ORDER BY order_clause  */
+#line 613 "yacc.y"
     {
         (yyval.sv_orderby) = (yyvsp[0].sv_orderby);
     }
-#line 2494 "yacc.tab.cpp"
+#line 2571 "yacc.tab.cpp"
     break;
 
-  case 103: /* opt_order_clause: %empty  */
-#line 576 "yacc.y"
+  case 111: /* opt_order_clause: %empty  */
+#line 616 "yacc.y"
                       { /* ignore*/ }
-#line 2500 "yacc.tab.cpp"
+#line 2577 "yacc.tab.cpp"
     break;
 
-  case 104: /* order_clause: col opt_asc_desc  */
-#line 581 "yacc.y"
+  case 112: /* order_clause: col opt_asc_desc  */
+#line 621 "yacc.y"
     {
         (yyval.sv_orderby) = std::make_shared<OrderBy>((yyvsp[-1].sv_col), (yyvsp[0].sv_orderby_dir));
     }
-#line 2508 "yacc.tab.cpp"
+#line 2585 "yacc.tab.cpp"
     break;
 
-  case 105: /* opt_asc_desc: ASC  */
-#line 587 "yacc.y"
+  case 113: /* opt_asc_desc: ASC  */
+#line 627 "yacc.y"
                  { (yyval.sv_orderby_dir) = OrderBy_ASC;     }
-#line 2514 "yacc.tab.cpp"
+#line 2591 "yacc.tab.cpp"
     break;
 
-  case 106: /* opt_asc_desc: DESC  */
-#line 588 "yacc.y"
+  case 114: /* opt_asc_desc: DESC  */
+#line 628 "yacc.y"
                  { (yyval.sv_orderby_dir) = OrderBy_DESC;    }
-#line 2520 "yacc.tab.cpp"
+#line 2597 "yacc.tab.cpp"
     break;
 
-  case 107: /* opt_asc_desc: %empty  */
-#line 589 "yacc.y"
+  case 115: /* opt_asc_desc: %empty  */
+#line 629 "yacc.y"
             { (yyval.sv_orderby_dir) = OrderBy_DEFAULT; }
-#line 2526 "yacc.tab.cpp"
+#line 2603 "yacc.tab.cpp"
     break;
 
-  case 108: /* set_knob_type: ENABLE_NESTLOOP  */
-#line 593 "yacc.y"
+  case 116: /* set_knob_type: ENABLE_NESTLOOP  */
+#line 633 "yacc.y"
                     { (yyval.sv_setKnobType) = EnableNestLoop; }
-#line 2532 "yacc.tab.cpp"
+#line 2609 "yacc.tab.cpp"
     break;
 
-  case 109: /* set_knob_type: ENABLE_SORTMERGE  */
-#line 594 "yacc.y"
+  case 117: /* set_knob_type: ENABLE_SORTMERGE  */
+#line 634 "yacc.y"
                          { (yyval.sv_setKnobType) = EnableSortMerge; }
-#line 2538 "yacc.tab.cpp"
+#line 2615 "yacc.tab.cpp"
     break;
 
 
-#line 2542 "yacc.tab.cpp"
+#line 2619 "yacc.tab.cpp"
 
       default: break;
     }
@@ -2767,5 +2844,5 @@ yyreturnlab:
   return yyresult;
 }
 
-#line 604 "yacc.y"
+#line 644 "yacc.y"
 
@@ -35,8 +35,8 @@
    especially those whose name start with YY_ or yy_.  They are
    private implementation details that can be changed or removed.  */
 
-#ifndef YY_YY_HOME_TZIH_CLIONPROJECTS_DB2024_X_SRC_PARSER_YACC_TAB_H_INCLUDED
-# define YY_YY_HOME_TZIH_CLIONPROJECTS_DB2024_X_SRC_PARSER_YACC_TAB_H_INCLUDED
+#ifndef YY_YY_YACC_TAB_H_INCLUDED
+# define YY_YY_YACC_TAB_H_INCLUDED
 /* Debug traces.  */
 #ifndef YYDEBUG
 # define YYDEBUG 0
@@ -95,21 +95,24 @@ extern int yydebug;
     IN = 296,                      /* IN  */
     STATIC_CHECKPOINT = 297,       /* STATIC_CHECKPOINT  */
     LOAD = 298,                    /* LOAD  */
-    LEQ = 299,                     /* LEQ  */
-    NEQ = 300,                     /* NEQ  */
-    GEQ = 301,                     /* GEQ  */
-    T_EOF = 302,                   /* T_EOF  */
-    COUNT = 303,                   /* COUNT  */
-    MAX = 304,                     /* MAX  */
-    MIN = 305,                     /* MIN  */
-    SUM = 306,                     /* SUM  */
-    IDENTIFIER = 307,              /* IDENTIFIER  */
-    VALUE_STRING = 308,            /* VALUE_STRING  */
-    VALUE_INT = 309,               /* VALUE_INT  */
-    VALUE_FLOAT = 310,             /* VALUE_FLOAT  */
-    VALUE_BOOL = 311,              /* VALUE_BOOL  */
-    FILE_PATH_VALUE = 312,         /* FILE_PATH_VALUE  */
-    TABLE_COL = 313                /* TABLE_COL  */
+    VACUUM = 299,                  /* VACUUM  */
+    VARCHAR = 300,                 /* VARCHAR  */
+    WITH = 301,                    /* WITH  */
+    LEQ = 302,                     /* LEQ  */
+    NEQ = 303,                     /* NEQ  */
+    GEQ = 304,                     /* GEQ  */
+    T_EOF = 305,                   /* T_EOF  */
+    COUNT = 306,                   /* COUNT  */
+    MAX = 307,                     /* MAX  */
+    MIN = 308,                     /* MIN  */
+    SUM = 309,                     /* SUM  */
+    IDENTIFIER = 310,              /* IDENTIFIER  */
+    VALUE_STRING = 311,            /* VALUE_STRING  */
+    VALUE_INT = 312,               /* VALUE_INT  */
+    VALUE_FLOAT = 313,             /* VALUE_FLOAT  */
+    VALUE_BOOL = 314,              /* VALUE_BOOL  */
+    FILE_PATH_VALUE = 315,         /* FILE_PATH_VALUE  */
+    TABLE_COL = 316                /* TABLE_COL  */
   };
   typedef enum yytokentype yytoken_kind_t;
 #endif
@@ -136,4 +139,4 @@ struct YYLTYPE
 int yyparse (void);
 
 
-#endif /* !YY_YY_HOME_TZIH_CLIONPROJECTS_DB2024_X_SRC_PARSER_YACC_TAB_H_INCLUDED  */
+#endif /* !YY_YY_YACC_TAB_H_INCLUDED  */
@@ -23,7 +23,7 @@ using namespace ast;
 // keywords
 %token SHOW TABLES CREATE TABLE DROP DESC INSERT INTO VALUES DELETE FROM ASC ORDER BY AS GROUP
 WHERE UPDATE SET SELECT INT CHAR FLOAT DATETIME INDEX AND JOIN EXIT HELP TXN_BEGIN TXN_COMMIT TXN_ABORT TXN_ROLLBACK ORDER_BY ENABLE_NESTLOOP ENABLE_SORTMERGE
-GROUP_BY HAVING IN STATIC_CHECKPOINT LOAD
+GROUP_BY HAVING IN STATIC_CHECKPOINT LOAD VACUUM VARCHAR WITH
 
 // non-keywords
 %token LEQ NEQ GEQ T_EOF
@@ -45,6 +45,8 @@ GROUP_BY HAVING IN STATIC_CHECKPOINT LOAD
 %type <sv_node> stmt dbStmt ddl dml txnStmt setStmt
 %type <sv_field> field
 %type <sv_fields> fieldList
+%type <sv_table_option> tableOption
+%type <sv_table_options> tableOptionList optTableOptions
 %type <sv_type_len> type
 %type <sv_comp_op> op
 %type <sv_art_op> art_op
@@ -138,6 +140,14 @@ dbStmt:
     {
 	$$ = std::make_shared<ShowIndex>($4);
     }
+    |   VACUUM
+    {
+        $$ = std::make_shared<Vacuum>("");
+    }
+    |   VACUUM tbName
+    {
+        $$ = std::make_shared<Vacuum>($2);
+    }
     ;
 
 setStmt:
@@ -148,9 +158,9 @@ setStmt:
     ;
 
 ddl:
-        CREATE TABLE tbName '(' fieldList ')'
+        CREATE TABLE tbName '(' fieldList ')' optTableOptions
     {
-        $$ = std::make_shared<CreateTable>($3, $5);
+        $$ = std::make_shared<CreateTable>($3, $5, $7);
     }
     |   DROP TABLE tbName
     {
@@ -220,6 +230,32 @@ colNameList:
     }
     ;
 
+optTableOptions:
+        /* epsilon */ { /* ignore*/ }
+    |   WITH '(' tableOptionList ')'
+    {
+        $$ = $3;
+    }
+    ;
+
+tableOptionList:
+        tableOption
+    {
+        $$ = std::vector<std::shared_ptr<TableOption>>{$1};
+    }
+    |   tableOptionList ',' tableOption
+    {
+        $$.push_back($3);
+    }
+    ;
+
+tableOption:
+        IDENTIFIER '=' IDENTIFIER
+    {
+        $$ = std::make_shared<TableOption>($1, $3);
+    }
+    ;
+
 field:
         colName type
     {
@@ -236,6 +272,10 @@ type:
     {
         $$ = std::make_shared<TypeLen>(SV_TYPE_STRING, $3);
     }
+    |   VARCHAR '(' VALUE_INT ')'
+    {
+        $$ = std::make_shared<TypeLen>(SV_TYPE_VARCHAR, $3);
+    }
     |   FLOAT
     {
         $$ = std::make_shared<TypeLen>(SV_TYPE_FLOAT, sizeof(float));
@@ -19,6 +19,7 @@ See the Mulan PSL v2 for more details. */
 #include "execution/executor_projection.h"
 #include "execution/executor_seq_scan.h"
 #include "execution/executor_index_scan.h"
+#include "execution/executor_index_only_scan.h"
 #include "execution/executor_update.h"
 #include "execution/executor_insert.h"
 #include "execution/executor_delete.h"
@@ -116,6 +117,10 @@ public:
                 case T_SvAggregate: {
                     // 转为SeqScanExecutor
                     std::unique_ptr<AbstractExecutor> scan = convert_plan_executor(x->subplan_, context);
+                    // 扫描只用来收集rid，列存格式的表只需要取出条件用到的字段，聚合值由AggregationExecutor按列读取
+                    if (auto seq_scan = dynamic_cast<SeqScanExecutor *>(scan.get())) {
+                        seq_scan->set_output_cols({});
+                    }
 
                     // 进行扫描，获取所有的rid
                     std::vector<Rid> rids;
@@ -184,12 +189,20 @@ public:
 
     std::unique_ptr<AbstractExecutor> convert_plan_executor(std::shared_ptr<Plan> plan, Context *context) {
         if (auto x = std::dynamic_pointer_cast<ProjectionPlan>(plan)) {
-            return std::make_unique<ProjectionExecutor>(convert_plan_executor(x->subplan_, context),
-                                                        x->sel_cols_);
+            std::unique_ptr<AbstractExecutor> child = convert_plan_executor(x->subplan_, context);
+            // 投影直接作用在顺序扫描上时，列存格式的表只需要取出被投影的字段
+            if (auto scan = dynamic_cast<SeqScanExecutor *>(child.get())) {
+                scan->set_output_cols(x->sel_cols_);
+            }
+            return std::make_unique<ProjectionExecutor>(std::move(child), x->sel_cols_);
         } else if (auto x = std::dynamic_pointer_cast<ScanPlan>(plan)) {
             if (x->tag == T_SeqScan) {
                 // 顺序扫描
                 return std::make_unique<SeqScanExecutor>(sm_manager_, x->tab_name_, x->conditions_, context);
+            } else if (x->tag == T_IndexOnlyScan) {
+                // 覆盖索引扫描
+                return std::make_unique<IndexOnlyScanExecutor>(sm_manager_, x->tab_name_, x->conditions_,
+                                                               x->index_meta_, context, x->is_sort_);
             } else {
                 // 索引扫描
                 return std::make_unique<IndexScanExecutor>(sm_manager_, x->tab_name_, x->conditions_,
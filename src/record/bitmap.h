@@ -38,26 +38,30 @@ class Bitmap {
      * @param bm 要找的起始地址为bm
      * @param max_n 要找的从起始地址开始的偏移为[curr+1,max_n)
      * @param curr 要找的从起始地址开始的偏移为[curr+1,max_n)
+     * @param is_deleted 找为0的位时，跳过前is_deleted个为0的位
      * @return 找到了就返回偏移位置，没找到就返回max_n
      */
     static int next_bit(bool bit, const char *bm, int max_n, int curr, int is_deleted) {
-        if (!bit) {
-//            is_deleted == 0 ? 0 : is_deleted -= 7;
-            int num = 0;
-            for (int i = curr + 1; i < max_n; i++) {
-                if (is_set(bm, i) == bit) {
-                    if (num == is_deleted) {
-                        return i;
-                    }
-                    ++num;
-                }
+        int skip = bit ? 0 : is_deleted;
+        for (int pos = (curr + 1) & ~(WORD_BITS - 1); pos < max_n; pos += WORD_BITS) {
+            // 把要找的位变成1，并去掉[curr+1,max_n)之外的位
+            uint64_t word = load_word(bm, pos, max_n);
+            if (!bit) {
+                word = ~word & range_mask(pos, max_n);
             }
-        } else {
-            for (int i = curr + 1; i < max_n; i++) {
-                if (is_set(bm, i) == bit) {
-                    return i;
-                }
+            if (pos <= curr) {
+                word &= ~uint64_t(0) >> (curr + 1 - pos);
             }
+            int num = __builtin_popcountll(word);
+            if (num <= skip) {
+                skip -= num;
+                continue;
+            }
+            // 去掉最高的skip个1
+            for (; skip > 0; skip--) {
+                word &= ~(uint64_t(1) << (WORD_BITS - 1 - __builtin_clzll(word)));
+            }
+            return pos + __builtin_clzll(word);
         }
         return max_n;
     }
@@ -71,7 +75,75 @@ class Bitmap {
     // rid_.slot_no = Bitmap::next_bit(true, page_handle.bitmap, file_handle_->file_hdr_.num_records_per_page,
     // rid_.slot_no); int slot_no = Bitmap::first_bit(false, page_handle.bitmap, file_hdr_.num_records_per_page);
 
+    // 前max_n位中为1的位的个数
+    static int count(const char *bm, int max_n) {
+        int num = 0;
+        for (int pos = 0; pos < max_n; pos += WORD_BITS) {
+            num += __builtin_popcountll(load_word(bm, pos, max_n));
+        }
+        return num;
+    }
+
+    // 前max_n位是否全为0
+    static bool is_empty(const char *bm, int max_n) {
+        for (int pos = 0; pos < max_n; pos += WORD_BITS) {
+            if (load_word(bm, pos, max_n) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 前max_n位是否全为1
+    static bool is_full(const char *bm, int max_n) {
+        for (int pos = 0; pos < max_n; pos += WORD_BITS) {
+            if (load_word(bm, pos, max_n) != range_mask(pos, max_n)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 一次取出前max_n位中所有为1的位
+     * @param bm 位图的起始地址
+     * @param max_n 位图的位数
+     * @param positions 输出，按从小到大的顺序保存所有为1的位的偏移，长度至少为max_n
+     * @return 为1的位的个数
+     */
+    static int set_positions(const char *bm, int max_n, int *positions) {
+        int num = 0;
+        for (int pos = 0; pos < max_n; pos += WORD_BITS) {
+            for (uint64_t word = load_word(bm, pos, max_n); word != 0;) {
+                int lead = __builtin_clzll(word);
+                positions[num++] = pos + lead;
+                word &= ~(uint64_t(1) << (WORD_BITS - 1 - lead));
+            }
+        }
+        return num;
+    }
+
    private:
+    static constexpr int WORD_BITS = 64;
+
+    /* 以pos（64的倍数）开始的64位组成一个字，第pos位是字的最高位，与位图中每个字节从高位开始的顺序一致；
+     * 位图在max_n位之后的部分不会被读取，对应的位为0 */
+    static uint64_t load_word(const char *bm, int pos, int max_n) {
+        uint64_t word = 0;
+        int num_bytes = std::min(WORD_BITS, max_n - pos + BITMAP_WIDTH - 1) / BITMAP_WIDTH;
+        memcpy(&word, bm + pos / BITMAP_WIDTH, num_bytes);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        word = __builtin_bswap64(word);
+#endif
+        return word & range_mask(pos, max_n);
+    }
+
+    // 以pos开始的字中，偏移小于max_n的位为1
+    static uint64_t range_mask(int pos, int max_n) {
+        int num_bits = max_n - pos;
+        return num_bits >= WORD_BITS ? ~uint64_t(0) : ~(~uint64_t(0) >> num_bits);
+    }
+
     static int get_bucket(int pos) { return pos / BITMAP_WIDTH; }
 
     static char get_bit(int pos) { return BITMAP_HIGHEST_BIT >> static_cast<char>(pos % BITMAP_WIDTH); }
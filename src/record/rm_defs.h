@@ -10,6 +10,9 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 #include "defs.h"
 #include "storage/buffer_pool_manager.h"
 
@@ -18,21 +21,72 @@ constexpr int RM_FILE_HDR_PAGE = 0;
 constexpr int RM_FIRST_RECORD_PAGE = 1;
 constexpr int RM_MAX_RECORD_SIZE = 512;
 
+// 定长格式的页面中，页头和删除计数预留的空间
+constexpr int RM_FIXED_PAGE_RESERVED = 24;
+// 一张表中最多包含的变长字段个数
+constexpr int RM_MAX_VAR_COLS = 32;
+// 列存格式的表中最多包含的字段个数
+constexpr int RM_MAX_PAX_COLS = 128;
+
+/* 数据页的格式 */
+enum RmPageFormat {
+    RM_FORMAT_FIXED = 0,    // 定长记录按slot_no * record_size连续存放
+    RM_FORMAT_SLOTTED = 1,  // 分槽页：页头之后是slot目录，变长记录从页尾向前存放
+    RM_FORMAT_PAX = 2       // 列存（PAX）：页面按字段划分为minipage，同一字段的值在minipage中按slot_no连续存放
+};
+
+/* 字段在定长记录中的位置 */
+struct RmColRange {
+    short offset;
+    short len;
+};
+
 /* 文件头，记录表数据文件的元信息，写入磁盘中文件的第0号页面 */
 struct RmFileHdr {
-    int record_size;            // 表中每条记录的大小，由于不包含变长字段，因此当前字段初始化后保持不变
+    int record_size;            // 表中每条记录在内存中的大小（变长字段按最大长度计算），初始化后保持不变
     int num_pages;              // 文件中分配的页面个数（初始化为1）
     int num_records_per_page;   // 每个页面最多能存储的元组个数
-    int first_free_page_no;     // 文件中当前第一个包含空闲空间的页面号（初始化为-1）
+    int first_free_page_no;     // 旧版本中空闲页面链表的表头，插入记录时已经改为使用内存中的RmFreeSpaceMap
     int bitmap_size;            // 每个页面bitmap大小
+    int first_dealloc_page_no;  // 已经释放的页面组成的链表的表头，链表指针存放在页头的next_free_page_no中（初始化为-1）
+    int format;                 // 页面格式，见RmPageFormat；旧的文件中为0，即定长格式
+    int num_var_cols;           // 变长字段的个数
+    RmColRange var_cols[RM_MAX_VAR_COLS];   // 变长字段的位置，按offset从小到大排列
+    int num_pax_cols;           // 列存格式：字段的个数
+    RmColRange pax_cols[RM_MAX_PAX_COLS];   // 列存格式：所有字段的位置，按offset从小到大排列
+    int dirty;                  // 文件打开期间为1，正常关闭时清0；打开时为1说明上次没有正常关闭，first_dealloc_page_no已经过时
 };
 
 /* 表数据文件中每个页面的页头，记录每个页面的元信息 */
 struct RmPageHdr {
-    int next_free_page_no;  // 当前页面满了之后，下一个包含空闲空间的页面号（初始化为-1）
+    int next_free_page_no;  // 当前页面满了之后，下一个包含空闲空间的页面号（初始化为-1）；页面被释放后指向下一个被释放的页面
     int num_records;        // 当前页面中当前已经存储的记录个数（初始化为0）
 };
 
+/* 分槽页中位图之后的页面元信息 */
+struct RmSlottedHdr {
+    int deleted;                // 页面中已经删除的记录个数
+    uint16_t num_slots;         // slot目录中已经使用过的项数，目录只增长，被删除的项可以复用
+    uint16_t free_end;          // 记录区的起始位置（相对页面数据首地址），记录区从页尾向前增长
+};
+
+/* 分槽页slot目录中的一项。len为0表示该项空闲；
+ * RM_SLOT_FORWARD表示记录因为更新变长而搬到了其他页面，记录区中保存的是搬迁后的位置（Rid）；
+ * RM_SLOT_MOVED_IN表示这是从其他页面搬来的记录，只能通过原来的位置访问，扫描时不可见（位图中对应的位为0） */
+struct RmSlot {
+    uint16_t offset;            // 记录在页面中的位置
+    uint16_t len;               // 低14位为记录的长度，高2位为标志
+};
+
+constexpr uint16_t RM_SLOT_FORWARD = 0x8000;
+constexpr uint16_t RM_SLOT_MOVED_IN = 0x4000;
+constexpr uint16_t RM_SLOT_LEN_MASK = 0x3fff;
+// 分槽页中每条记录至少占用的空间，保证记录搬走之后原来的位置能存下一个Rid
+constexpr int RM_SLOT_MIN_SPACE = 8;
+
+// 被释放的页面中，指向下一个被释放页面的指针（即页头的next_free_page_no）在页面中的偏移
+constexpr size_t RM_FREE_PAGE_LINK_OFFSET = Page::OFFSET_PAGE_HDR + offsetof(RmPageHdr, next_free_page_no);
+
 /* 表中的记录 */
 struct RmRecord {
     char *data;  // 记录的数据
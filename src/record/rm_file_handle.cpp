@@ -1,6 +1,19 @@
 #include "rm_file_handle.h"
+
+#include <algorithm>
+#include <cstring>
 #include <shared_mutex>
 
+namespace {
+
+// 分槽页中的一条记录占用的空间
+inline int slot_space(int len) { return std::max(len, RM_SLOT_MIN_SPACE); }
+
+// 编码后的记录的最大长度：每个变长字段多出2字节的长度
+constexpr int RM_MAX_ENCODED_SIZE = RM_MAX_RECORD_SIZE + 2 * RM_MAX_VAR_COLS;
+
+}  // namespace
+
 /**
  * @description: 获取当前表中记录号为rid的记录
  * @param {Rid&} rid 记录号，指定记录的位置
@@ -26,17 +39,152 @@ std::unique_ptr<RmRecord> RmFileHandle::get_record(const Rid &rid, Context *cont
     auto rm_rcd = std::make_unique<RmRecord>(record_size);
 
     // 赋值其内部的data和size
-    char *data_ptr = page_hdl.get_slot(rid.slot_no);
     if (!Bitmap::is_set(page_hdl.bitmap, rid.slot_no)) {
         throw RecordNotFoundError(rid.page_no, rid.slot_no);
     }
-    std::memcpy(rm_rcd->data, data_ptr, record_size);
+    read_record(page_hdl, rid.slot_no, rm_rcd->data);
     rm_rcd->size = record_size;
 
     buffer_pool_manager_->unpin_page(page_hdl.page->get_page_id(), false);
     return rm_rcd;
 }
 
+/**
+ * @description: 获取记录号为rid的记录的只读视图，不复制记录数据。
+ *              view已经固定了rid所在的页面时直接复用，顺序扫描同一页面中的记录只需要固定一次页面
+ * @param {Rid&} rid 记录号，指定记录的位置
+ * @param {RmRecordView&} view 输出的记录视图，原来固定的其他页面会被释放
+ * @param {vector<int>*} col_ids 列存格式：只取出这些字段（file_hdr_.pax_cols的下标），视图中其余字段的内容不确定；
+ *                               为nullptr时取出所有字段。其他格式忽略该参数
+ */
+void RmFileHandle::get_record_view(const Rid &rid, RmRecordView &view, const std::vector<int> *col_ids) const {
+    std::shared_lock<std::shared_mutex> lock{latch_};
+    if (view.page_ == nullptr || !(view.page_->get_page_id() == PageId{fd_, rid.page_no})) {
+        view.release();
+        view.buffer_pool_manager_ = buffer_pool_manager_;
+        view.page_ = fetch_page_handle(rid.page_no).page;
+    }
+    RmPageHandle page_hdl(&file_hdr_, view.page_);
+    if (!Bitmap::is_set(page_hdl.bitmap, rid.slot_no)) {
+        view.release();
+        throw RecordNotFoundError(rid.page_no, rid.slot_no);
+    }
+    if (is_slotted()) {
+        // 分槽页中的记录是编码后的变长格式，解码到视图自己的缓冲区中
+        view.buf_.resize(file_hdr_.record_size);
+        read_slot(page_hdl, rid.slot_no, view.buf_.data());
+        view.data_ = view.buf_.data();
+    } else if (is_pax()) {
+        // 列存格式中一条记录的字段分散在各个minipage中，只把需要的字段拼到视图的缓冲区中
+        view.buf_.resize(file_hdr_.record_size);
+        gather_record(page_hdl, rid.slot_no, view.buf_.data(), col_ids);
+        view.data_ = view.buf_.data();
+    } else {
+        view.data_ = page_hdl.get_slot(rid.slot_no);
+    }
+    view.size_ = file_hdr_.record_size;
+}
+
+/**
+ * @description: 取出一个数据页中某个字段的列向量，不复制数据。view固定该页面，列向量在view释放或固定其他页面之前有效
+ * @param {int} page_no 数据页的页号
+ * @param {int} col_offset 字段在记录中的偏移量
+ * @param {RmRecordView} &view 用于固定页面的视图
+ * @return {RmColumnVector} 列向量，分槽页中的记录位置不固定，返回的base为nullptr
+ */
+RmColumnVector RmFileHandle::get_column_vector(int page_no, int col_offset, RmRecordView &view) const {
+    std::shared_lock<std::shared_mutex> lock{latch_};
+    if (view.page_ == nullptr || !(view.page_->get_page_id() == PageId{fd_, page_no})) {
+        view.release();
+        view.buffer_pool_manager_ = buffer_pool_manager_;
+        view.page_ = fetch_page_handle(page_no).page;
+    }
+    view.data_ = nullptr;
+    RmPageHandle page_hdl(&file_hdr_, view.page_);
+    RmColumnVector column;
+    if (is_pax()) {
+        const RmColRange &col = file_hdr_.pax_cols[find_pax_col(col_offset)];
+        column.base = page_hdl.get_column(col) + (col_offset - col.offset);
+        column.stride = col.len;
+    } else if (!is_slotted()) {
+        column.base = page_hdl.slots + col_offset;
+        column.stride = file_hdr_.record_size;
+    }
+    return column;
+}
+
+/**
+ * @description: 对一个数据页中所有记录判断一组简单条件，得到页面中满足条件的记录的位图，不需要逐条读出记录。
+ *              view固定该页面，之后用get_record_view读取页面中的记录时不需要再次固定
+ * @param {int} page_no 数据页的页号
+ * @param {vector<SlotPredicate>} &preds 以AND连接的条件
+ * @param {char*} mask 输出，长度为file_hdr_.bitmap_size，格式与页面位图相同
+ * @param {RmRecordView} &view 用于固定页面的视图
+ * @param {ReadAheadState*} read_ahead 顺序扫描时的预读状态，为nullptr时不预读
+ */
+void RmFileHandle::filter_page(int page_no, const std::vector<SlotPredicate> &preds, char *mask, RmRecordView &view,
+                               ReadAheadState *read_ahead) const {
+    if (read_ahead != nullptr) {
+        buffer_pool_manager_->read_ahead({fd_, page_no}, file_hdr_.num_pages, read_ahead);
+    }
+    std::shared_lock<std::shared_mutex> lock{latch_};
+    if (view.page_ == nullptr || !(view.page_->get_page_id() == PageId{fd_, page_no})) {
+        view.release();
+        view.buffer_pool_manager_ = buffer_pool_manager_;
+        view.page_ = fetch_page_handle(page_no).page;
+    }
+    view.data_ = nullptr;
+    RmPageHandle page_hdl(&file_hdr_, view.page_);
+    memcpy(mask, page_hdl.bitmap, file_hdr_.bitmap_size);
+    if (is_slotted()) {
+        // 分槽页中记录的位置不固定，只能逐条解码后判断
+        if (preds.empty()) {
+            return;
+        }
+        std::vector<char> record(file_hdr_.record_size);
+        int num_slots = page_hdl.slotted_hdr->num_slots;
+        for (int slot_no = Bitmap::next_bit(true, mask, num_slots, -1, 0); slot_no < num_slots;
+             slot_no = Bitmap::next_bit(true, mask, num_slots, slot_no, 0)) {
+            read_slot(page_hdl, slot_no, record.data());
+            char bit = static_cast<char>(BITMAP_HIGHEST_BIT);
+            for (const auto &pred: preds) {
+                SlotFilter::filter_scalar(pred, record.data(), file_hdr_.record_size, 1, &bit);
+            }
+            if (bit == 0) {
+                Bitmap::reset(mask, slot_no);
+            }
+        }
+        return;
+    }
+    if (is_pax()) {
+        // 列存格式：条件只读取所在字段的minipage，minipage可以看作记录长度为字段长度的定长页面
+        for (const auto &pred: preds) {
+            const RmColRange &col = file_hdr_.pax_cols[find_pax_col(pred.offset)];
+            SlotPredicate col_pred = pred;
+            col_pred.offset = pred.offset - col.offset;
+            SlotFilter::filter(col_pred, page_hdl.get_column(col), col.len, file_hdr_.num_records_per_page, mask);
+        }
+        return;
+    }
+    for (const auto &pred: preds) {
+        SlotFilter::filter(pred, page_hdl.slots, file_hdr_.record_size, file_hdr_.num_records_per_page, mask);
+    }
+}
+
+/**
+ * @description: 根据区域映射判断页面中是否可能有满足所有条件的记录，返回false时可以跳过整个页面
+ * @param {int} page_no 数据页的页号
+ * @param {vector<SlotPredicate>} &preds 以AND连接的条件
+ */
+bool RmFileHandle::page_may_match(int page_no, const std::vector<SlotPredicate> &preds) const {
+    if (preds.empty()) {
+        return true;
+    }
+    std::shared_lock<std::shared_mutex> lock{latch_};
+    std::scoped_lock meta_lock{meta_latch_};
+    return zone_map_.may_match(page_no, preds);
+}
+
 /**
  * @description: 在当前表中插入一条记录，不指定插入位置
  * @param {char*} buf 要插入的记录的数据
@@ -44,17 +192,45 @@ std::unique_ptr<RmRecord> RmFileHandle::get_record(const Rid &rid, Context *cont
  * @return {Rid} 插入的记录的记录号（位置）
  */
 Rid RmFileHandle::insert_record(char *buf, Context *context, bool is_abort) {
+    // 插入只加共享锁：空闲空间索引保证并发的插入写不同的页面，删除、更新、整理仍然与插入互斥
     std::shared_lock<std::shared_mutex> lock{latch_};
-    // 1.获取当前未满的page handle
-    RmPageHandle page_hdl = create_page_handle();
+    build_free_space_map();
 
-    // 在page_hdl中找到空闲slot位置
     int record_size = file_hdr_.record_size;
     int record_nums = file_hdr_.num_records_per_page;
-    int slot_no = Bitmap::first_bit(false, page_hdl.bitmap, record_nums, *page_hdl.deleted);
-    if (slot_no == record_nums) {
+    char encoded[RM_MAX_ENCODED_SIZE];
+    int len = is_slotted() ? encode_record(buf, encoded) : record_size;
+    // 1. 从空闲空间索引中取出一个放得下的页面，没有时创建新页面
+    RmPageHandle page_hdl;
+    int slot_no;
+    while (true) {
+        int page_no = free_space_map_.acquire(is_slotted() ? slot_space(len) : 1);
+        if (page_no == RM_NO_PAGE) {
+            std::scoped_lock meta_lock{meta_latch_};
+            page_hdl = create_new_page_handle();
+        } else {
+            page_hdl = fetch_page_handle(page_no);
+        }
+        // 2. 在页面中找到空闲slot位置，索引中的空闲空间只是估计值，放不下时更新索引后换下一个页面
+        if (is_slotted()) {
+            slot_no = alloc_slot(page_hdl, encoded, len, 0);
+        } else {
+            slot_no = first_free_slot(page_hdl);
+            slot_no = slot_no == record_nums ? -1 : slot_no;
+        }
+        if (slot_no >= 0) {
+            break;
+        }
+        free_space_map_.release(page_hdl.page->get_page_id().page_no, 0);
         buffer_pool_manager_->unpin_page(page_hdl.page->get_page_id(), true);
-        throw InvalidSlotNoError(slot_no, record_nums);
+    }
+    if (!is_slotted()) {
+        // 将buf复制到空闲slot位置
+        if (is_pax()) {
+            scatter_record(page_hdl, slot_no, buf);
+        } else {
+            std::memcpy(page_hdl.get_slot(slot_no), buf, record_size);
+        }
     }
 
 //    // 对record加X锁
@@ -63,16 +239,16 @@ Rid RmFileHandle::insert_record(char *buf, Context *context, bool is_abort) {
 //        context->lock_mgr_->lock_exclusive_on_record(context->txn_, rid, fd_);
 //    }
 
-    // 将buf复制到空闲slot位置
-    char *slot_ptr = page_hdl.get_slot(slot_no);
-    std::memcpy(slot_ptr, buf, record_size);
     Bitmap::set(page_hdl.bitmap, slot_no);
-
-    // 更新page_handle.page_hdr的数据结构
-    if (++page_hdl.page_hdr->num_records == record_nums) {
-        file_hdr_.first_free_page_no = page_hdl.page_hdr->next_free_page_no;
+    {
+        std::scoped_lock meta_lock{meta_latch_};
+        zone_map_.add(page_hdl.page->get_page_id().page_no, buf);
     }
 
+    // 3. 更新page_handle.page_hdr的数据结构，把页面连同剩余的空闲空间归还给空闲空间索引
+    ++page_hdl.page_hdr->num_records;
+    free_space_map_.release(page_hdl.page->get_page_id().page_no, page_free_space(page_hdl));
+
     Rid rid = Rid{page_hdl.page->get_page_id().page_no, slot_no};
 
     if(context != nullptr && !is_abort) {
@@ -135,13 +311,22 @@ void RmFileHandle::insert_record(Rid &rid, char *buf, Context *context, bool is_
 //    }
 
     // 在指定位置插入记录
-    std::memcpy(page_hdl.get_slot(rid.slot_no), buf, file_hdr_.record_size);
+    if (is_slotted()) {
+        write_slot(page_hdl, rid.slot_no, buf);
+    } else if (is_pax()) {
+        scatter_record(page_hdl, rid.slot_no, buf);
+    } else {
+        std::memcpy(page_hdl.get_slot(rid.slot_no), buf, file_hdr_.record_size);
+    }
 
-    // 更新page_handle中的数据结构
+    // 更新page_handle中的数据结构，回滚删除时记录仍计在num_records中
     Bitmap::set(page_hdl.bitmap, rid.slot_no);
-    int record_nums = file_hdr_.num_records_per_page;
-    if (++page_hdl.page_hdr->num_records == record_nums) {
-        file_hdr_.first_free_page_no = page_hdl.page_hdr->next_free_page_no;
+    zone_map_.add(rid.page_no, buf);
+    if (!take_uncommitted_delete(page_hdl, rid.slot_no)) {
+        ++page_hdl.page_hdr->num_records;
+    }
+    if (free_space_built_) {
+        free_space_map_.release(rid.page_no, page_free_space(page_hdl));
     }
 
     if(context != nullptr && !is_abort) {
@@ -200,13 +385,20 @@ void RmFileHandle::insert_record(const Rid &rid, char *buf) {
 //    }
 
     // 在指定位置插入记录
-    std::memcpy(page_hdl.get_slot(rid.slot_no), buf, file_hdr_.record_size);
+    if (is_slotted()) {
+        write_slot(page_hdl, rid.slot_no, buf);
+    } else if (is_pax()) {
+        scatter_record(page_hdl, rid.slot_no, buf);
+    } else {
+        std::memcpy(page_hdl.get_slot(rid.slot_no), buf, file_hdr_.record_size);
+    }
 
     // 更新page_handle中的数据结构
     Bitmap::set(page_hdl.bitmap, rid.slot_no);
-    int record_nums = file_hdr_.num_records_per_page;
-    if (++page_hdl.page_hdr->num_records == record_nums) {
-        file_hdr_.first_free_page_no = page_hdl.page_hdr->next_free_page_no;
+    zone_map_.add(rid.page_no, buf);
+    ++page_hdl.page_hdr->num_records;
+    if (free_space_built_) {
+        free_space_map_.release(rid.page_no, page_free_space(page_hdl));
     }
     buffer_pool_manager_->unpin_page(page_hdl.page->get_page_id(), true);
 }
@@ -243,7 +435,6 @@ void RmFileHandle::delete_record(Rid &rid, Context *context, bool is_abort) {
         //日志管理
         lsn_t lsn = context->log_mgr_->add_delete_log_record(context->txn_->get_transaction_id(), *rec, rid, disk_manager_->get_file_name(fd_));
         context->log_mgr_->flush_log_to_disk();
-        buffer_pool_manager_->unpin_page(page_hdl.page->get_page_id(), true);
 
         txn->set_prev_lsn(lsn);
 
@@ -265,7 +456,14 @@ void RmFileHandle::delete_record(Rid &rid, Context *context, bool is_abort) {
 
     // 2.1 测试bitmap对应位,测试成功则重置
     Bitmap::reset(page_hdl.bitmap, rid.slot_no);
-    (*page_hdl.deleted)++;
+    if (context != nullptr && !is_abort) {
+        // 事务提交之前保留该位置，由release_deleted_slot释放
+        (*page_hdl.deleted)++;
+        uncommitted_deletes_[rid.page_no].insert(rid.slot_no);
+    } else {
+        // 不在事务中的删除和插入的回滚不会再用到该位置，立即释放
+        free_deleted_slot(page_hdl, rid.slot_no);
+    }
 
     // 如果page从满变为未满状态,调用release_page_handle()
     int record_nums = file_hdr_.num_records_per_page;
@@ -279,6 +477,22 @@ void RmFileHandle::delete_record(Rid &rid, Context *context, bool is_abort) {
 }
 
 
+/**
+ * @description: 删除记录的事务提交之后调用，被删除记录的位置可以分配给新插入的记录
+ * @param {Rid&} rid 被删除的记录的位置
+ */
+void RmFileHandle::release_deleted_slot(const Rid &rid) {
+    std::unique_lock<std::shared_mutex> lock{latch_};
+    auto iter = uncommitted_deletes_.find(rid.page_no);
+    if (iter == uncommitted_deletes_.end() || iter->second.count(rid.slot_no) == 0) {
+        return;
+    }
+    RmPageHandle page_hdl = fetch_page_handle(rid.page_no);
+    take_uncommitted_delete(page_hdl, rid.slot_no);
+    free_deleted_slot(page_hdl, rid.slot_no);
+    buffer_pool_manager_->unpin_page(page_hdl.page->get_page_id(), true);
+}
+
 /**
  * @description: 更新记录文件中记录号为rid的记录
  * @param {Rid&} rid 要更新的记录的记录号（位置）
@@ -361,7 +575,14 @@ void RmFileHandle::update_record(Rid &rid, char *buf, Context *context, bool is_
     }
 
     // 2. 更新记录
-    std::memcpy(page_hdl.get_slot(rid.slot_no), buf, file_hdr_.record_size);
+    if (is_slotted()) {
+        write_slot(page_hdl, rid.slot_no, buf);
+    } else if (is_pax()) {
+        scatter_record(page_hdl, rid.slot_no, buf);
+    } else {
+        std::memcpy(page_hdl.get_slot(rid.slot_no), buf, file_hdr_.record_size);
+    }
+    zone_map_.add(rid.page_no, buf);
 
     buffer_pool_manager_->unpin_page(page_hdl.page->get_page_id(), true);
 }
@@ -408,48 +629,549 @@ RmPageHandle RmFileHandle::create_new_page_handle() {
 
     // 2. 更新page handle的相关信息
     RmPageHandle page_hdl(&file_hdr_, page);
+    init_page_handle(page_hdl);
+    return page_hdl;
+}
+
+/**
+ * @description: 初始化新分配的页面，并更新file_hdr_。新页面可能复用了文件中已经释放的页面，num_pages只记录已分配页号的上界
+ */
+void RmFileHandle::init_page_handle(RmPageHandle &page_hdl) {
+    int page_no = page_hdl.page->get_page_id().page_no;
     Bitmap::init(page_hdl.bitmap, file_hdr_.bitmap_size);
     page_hdl.page_hdr->num_records = 0;
     page_hdl.page_hdr->next_free_page_no = RM_NO_PAGE;
-
-    // 3. 更新file_hdr_
-    file_hdr_.num_pages++;
-    file_hdr_.first_free_page_no = page_hdl.page->get_page_id().page_no;
-    return page_hdl;
+    *page_hdl.deleted = 0;
+    if (is_slotted()) {
+        page_hdl.slotted_hdr->num_slots = 0;
+        page_hdl.slotted_hdr->free_end = PAGE_SIZE;
+    }
+    zone_map_.reset_page(page_no);
+    file_hdr_.num_pages = std::max(file_hdr_.num_pages, page_no + 1);
 }
 
 /**
- * @brief 创建或获取一个空闲的page handle
- *
- * @return RmPageHandle 返回生成的空闲page handle
- * @note pin the page, remember to unpin it outside!
+ * @description: 读出页面中的一条记录，转换为定长格式
+ * @param {RmPageHandle&} page_hdl 记录所在的页面
+ * @param {int} slot_no 记录的slot_no
+ * @param {char*} out 输出，长度为file_hdr_.record_size
  */
-RmPageHandle RmFileHandle::create_page_handle() {
-    // 1. 判断file_hdr_中是否还有空闲页
-    int page_no = file_hdr_.first_free_page_no;
+void RmFileHandle::read_record(const RmPageHandle &page_hdl, int slot_no, char *out) const {
+    if (is_slotted()) {
+        read_slot(page_hdl, slot_no, out);
+    } else if (is_pax()) {
+        gather_record(page_hdl, slot_no, out);
+    } else {
+        std::memcpy(out, page_hdl.get_slot(slot_no), file_hdr_.record_size);
+    }
+}
 
-    // 1.1 没有空闲页：使用缓冲池来创建一个新page；可直接调用create_new_page_handle()
-    if (page_no == RM_NO_PAGE) {
-        return create_new_page_handle();
+/**
+ * @description: 扫描数据文件重新计算所有页面的取值范围，区域映射文件在上次打开后没有正常写回时调用
+ */
+void RmFileHandle::rebuild_zone_map() {
+    std::unique_lock<std::shared_mutex> lock{latch_};
+    if (zone_map_.empty()) {
+        return;
+    }
+    for (int page_no = RM_FIRST_RECORD_PAGE; page_no < file_hdr_.num_pages; page_no++) {
+        if (disk_manager_->is_free_page(fd_, page_no)) {
+            continue;
+        }
+        RmPageHandle page_hdl = fetch_page_handle(page_no);
+        rebuild_page_zone(page_hdl);
+        buffer_pool_manager_->unpin_page(page_hdl.page->get_page_id(), false);
     }
-    // 2. 生成page handle并返回给上层
-    return fetch_page_handle(page_no);
 }
 
 /**
- * @description: 当一个页面从没有空闲空间的状态变为有空闲空间状态时，更新文件头和页头中空闲页面相关的元数据
+ * @description: 按页面中的有效记录重新计算页面的取值范围，调用者需持有latch_
  */
-void RmFileHandle::release_page_handle(RmPageHandle &page_handle) {
-    // 1. 更新文件头和页头中空闲页面相关的元数据
-    page_handle.page_hdr->next_free_page_no = file_hdr_.first_free_page_no;
-    file_hdr_.first_free_page_no = page_handle.page->get_page_id().page_no;
+void RmFileHandle::rebuild_page_zone(const RmPageHandle &page_hdl) {
+    int page_no = page_hdl.page->get_page_id().page_no;
+    zone_map_.reset_page(page_no);
+    if (zone_map_.empty()) {
+        return;
+    }
+    int record_nums = file_hdr_.num_records_per_page;
+    std::vector<char> record(file_hdr_.record_size);
+    for (int slot_no = Bitmap::next_bit(true, page_hdl.bitmap, record_nums, -1, 0); slot_no < record_nums;
+         slot_no = Bitmap::next_bit(true, page_hdl.bitmap, record_nums, slot_no, 0)) {
+        read_record(page_hdl, slot_no, record.data());
+        zone_map_.add(page_no, record.data());
+    }
 }
 
+/**
+ * @description: 恢复时重做插入或更新之前调用，保证rid所在的页面已经分配。崩溃前分配的页面可能仍在空闲页面中，
+ *              也可能超出文件头中记录的页面个数，此时只分配rid.page_no（以及文件末尾到它之间的页面），不从空闲页面中取其他页面
+ * @param {Rid&} rid 要重做的记录的位置
+ */
 void RmFileHandle::allocpage(Rid& rid){
-    while(rid.page_no >= get_file_hdr().num_pages) {
-        RmPageHandle rm_page_hd = create_new_page_handle();
-//        free_pageno_set.insert(rm_page_hd.page->get_page_id().page_no);
-        release_page_handle(rm_page_hd);
-        buffer_pool_manager_->unpin_page(rm_page_hd.page->get_page_id(), false);
+    for (int page_no = std::min(file_hdr_.num_pages, rid.page_no); page_no <= rid.page_no; page_no++) {
+        if (!disk_manager_->allocate_page_at(fd_, page_no)) {
+            continue;
+        }
+        Page *page = buffer_pool_manager_->new_page_at({fd_, page_no});
+        if (page == nullptr) {
+            throw std::runtime_error("Failed to create new page");
+        }
+        RmPageHandle page_hdl(&file_hdr_, page);
+        init_page_handle(page_hdl);
+        if (free_space_built_) {
+            free_space_map_.release(page_no, page_free_space(page_hdl));
+        }
+        buffer_pool_manager_->unpin_page(page->get_page_id(), true);
+    }
+}
+
+/**
+ * @description: 上次没有正常关闭文件时，文件头中的空闲页面链表可能包含崩溃前已经被复用的页面，
+ *              此时不使用该链表，扫描所有页面，把不包含记录的页面作为空闲页面
+ */
+void RmFileHandle::rebuild_free_pages() {
+    int record_nums = file_hdr_.num_records_per_page;
+    for (int page_no = RM_FIRST_RECORD_PAGE; page_no < file_hdr_.num_pages; page_no++) {
+        RmPageHandle page_hdl = fetch_page_handle(page_no);
+        PageId page_id = page_hdl.page->get_page_id();
+        bool is_free = Bitmap::count(page_hdl.bitmap, record_nums) == 0;
+        if (is_free && is_slotted()) {
+            // 分槽页中还可能有从其他页面搬来的记录，它们在位图中对应的位为0
+            for (int slot_no = 0; slot_no < page_hdl.slotted_hdr->num_slots && is_free; slot_no++) {
+                is_free = page_hdl.dir[slot_no].len == 0;
+            }
+        }
+        buffer_pool_manager_->unpin_page(page_id, false);
+        if (is_free && buffer_pool_manager_->delete_page(page_id)) {
+            disk_manager_->deallocate_page(fd_, page_no);
+        }
+    }
+}
+/**
+ * @description: 打开文件后第一次分配空间时扫描所有页面，建立空闲空间索引
+ */
+void RmFileHandle::build_free_space_map() {
+    if (free_space_built_) {
+        return;
     }
-}
\ No newline at end of file
+    std::scoped_lock meta_lock{meta_latch_};
+    if (free_space_built_) {
+        return;
+    }
+    free_space_map_.reset(is_slotted() ? PAGE_SIZE : file_hdr_.num_records_per_page);
+    for (int page_no = RM_FIRST_RECORD_PAGE; page_no < file_hdr_.num_pages; page_no++) {
+        if (disk_manager_->is_free_page(fd_, page_no)) {
+            continue;
+        }
+        RmPageHandle page_hdl = fetch_page_handle(page_no);
+        free_space_map_.release(page_no, page_free_space(page_hdl));
+        buffer_pool_manager_->unpin_page(page_hdl.page->get_page_id(), false);
+    }
+    free_space_built_ = true;
+}
+
+/**
+ * @description: 页面中还能用于插入新记录的空间，定长和列存格式为slot个数，分槽页为字节数。
+ *              分槽页只计算连续的空闲空间并扣除一个目录项，放不下最短的记录时返回0
+ */
+int RmFileHandle::page_free_space(const RmPageHandle &page_hdl) const {
+    if (!is_slotted()) {
+        return std::max(0, file_hdr_.num_records_per_page - page_hdl.page_hdr->num_records);
+    }
+    const RmSlottedHdr *hdr = page_hdl.slotted_hdr;
+    if (hdr->num_slots >= file_hdr_.num_records_per_page) {
+        return 0;
+    }
+    int dir_end = reinterpret_cast<char *>(page_hdl.dir + hdr->num_slots + 1) - page_hdl.page->get_data();
+    int free = hdr->free_end - dir_end;
+    return free >= slot_space(min_encoded_size()) ? free : 0;
+}
+
+/**
+ * @description: 定长和列存格式的页面中第一个可以分配给新记录的slot，跳过被未提交的事务删除的位置
+ * @return {int} slot号，没有时返回num_records_per_page
+ */
+int RmFileHandle::first_free_slot(const RmPageHandle &page_hdl) const {
+    int record_nums = file_hdr_.num_records_per_page;
+    int slot_no = Bitmap::first_bit(false, page_hdl.bitmap, record_nums, 0);
+    auto iter = uncommitted_deletes_.find(page_hdl.page->get_page_id().page_no);
+    if (iter == uncommitted_deletes_.end()) {
+        return slot_no;
+    }
+    while (slot_no < record_nums && iter->second.count(slot_no) != 0) {
+        slot_no = Bitmap::next_bit(false, page_hdl.bitmap, record_nums, slot_no, 0);
+    }
+    return slot_no;
+}
+
+/**
+ * @description: 释放被删除记录占用的位置：分槽页释放目录项和记录区的空间，并把页面的空闲空间更新到空闲空间索引
+ */
+void RmFileHandle::free_deleted_slot(RmPageHandle &page_hdl, int slot_no) {
+    if (is_slotted() && slot_no < page_hdl.slotted_hdr->num_slots) {
+        free_slot(page_hdl, slot_no);
+    }
+    page_hdl.page_hdr->num_records = std::max(0, page_hdl.page_hdr->num_records - 1);
+    if (free_space_built_) {
+        free_space_map_.release(page_hdl.page->get_page_id().page_no, page_free_space(page_hdl));
+    }
+}
+
+/**
+ * @description: slot是被未提交的事务删除的位置时，取消对它的保留并减少页面的删除计数
+ * @return {bool} slot是否是被未提交的事务删除的位置
+ */
+bool RmFileHandle::take_uncommitted_delete(RmPageHandle &page_hdl, int slot_no) {
+    auto iter = uncommitted_deletes_.find(page_hdl.page->get_page_id().page_no);
+    if (iter == uncommitted_deletes_.end() || iter->second.erase(slot_no) == 0) {
+        return false;
+    }
+    if (iter->second.empty()) {
+        uncommitted_deletes_.erase(iter);
+    }
+    *page_hdl.deleted = std::max(0, *page_hdl.deleted - 1);
+    return true;
+}
+
+/**
+ * @description: 整理表的数据文件：释放不再包含记录的页面，并截断文件末尾连续的空闲页面；
+ * 其余页面中被删除的slot重新变为可用，按整理后的页面重新建立空闲空间索引。
+ * 调用者需保证此时没有未提交的事务修改过本表（已删除记录的位置不会再被回滚使用）
+ * @return {int} 截断之后文件中剩余的空闲页面个数
+ */
+int RmFileHandle::vacuum() {
+    std::unique_lock<std::shared_mutex> lock{latch_};
+    int record_nums = file_hdr_.num_records_per_page;
+    free_space_map_.reset(is_slotted() ? PAGE_SIZE : record_nums);
+    for (int page_no = file_hdr_.num_pages - 1; page_no >= RM_FIRST_RECORD_PAGE; page_no--) {
+        if (disk_manager_->is_free_page(fd_, page_no)) {
+            continue;
+        }
+        RmPageHandle page_hdl = fetch_page_handle(page_no);
+        PageId page_id = page_hdl.page->get_page_id();
+        int num_live = Bitmap::count(page_hdl.bitmap, record_nums);
+        bool has_moved_in = false;
+        if (is_slotted()) {
+            // 分槽页：释放被删除记录的空间（连同搬到其他页面的部分），截掉目录末尾的空闲项后压缩记录区
+            RmSlottedHdr *hdr = page_hdl.slotted_hdr;
+            for (int slot_no = 0; slot_no < hdr->num_slots; slot_no++) {
+                uint16_t len = page_hdl.dir[slot_no].len;
+                if (len != 0 && (len & RM_SLOT_MOVED_IN) == 0 && !Bitmap::is_set(page_hdl.bitmap, slot_no)) {
+                    free_slot(page_hdl, slot_no);
+                }
+            }
+            while (hdr->num_slots > 0 && page_hdl.dir[hdr->num_slots - 1].len == 0) {
+                hdr->num_slots--;
+            }
+            compact_page(page_hdl);
+            // 目录中剩下的项要么对应有效记录，要么是从其他页面搬来的记录
+            has_moved_in = hdr->num_slots > 0;
+        }
+        if (num_live == 0 && !has_moved_in) {
+            // 1. 页面中没有记录，从缓冲池中删除后交还给DiskManager
+            zone_map_.reset_page(page_no);
+            buffer_pool_manager_->unpin_page(page_id, false);
+            if (buffer_pool_manager_->delete_page(page_id)) {
+                disk_manager_->deallocate_page(fd_, page_no);
+            }
+            continue;
+        }
+        // 2. 被删除的slot重新可用，页面未满时加入空闲空间索引；按剩下的记录重新计算页面的取值范围
+        rebuild_page_zone(page_hdl);
+        page_hdl.page_hdr->num_records = num_live;
+        *page_hdl.deleted = 0;
+        free_space_map_.release(page_no, page_free_space(page_hdl));
+        buffer_pool_manager_->unpin_page(page_id, true);
+    }
+    free_space_built_ = true;
+    // 3. 截断文件末尾连续的空闲页面
+    file_hdr_.num_pages = disk_manager_->truncate_free_pages(fd_);
+    return static_cast<int>(disk_manager_->get_num_free_pages(fd_));
+}
+
+/**
+ * 以下为列存格式的辅助函数。列存页面的布局与定长格式相同，只是记录区按字段划分为minipage：
+ * 字段col的minipage位于slots + col.offset * num_records_per_page，其中第slot_no条记录的值位于minipage + slot_no * col.len
+ */
+
+/**
+ * @description: 将列存页面中的一条记录拼成定长格式
+ * @param {RmPageHandle&} page_hdl 记录所在的页面
+ * @param {int} slot_no 记录的slot_no
+ * @param {char*} out 输出，长度为file_hdr_.record_size
+ * @param {vector<int>*} col_ids 只取出这些字段，为nullptr时取出所有字段
+ */
+void RmFileHandle::gather_record(const RmPageHandle &page_hdl, int slot_no, char *out,
+                                 const std::vector<int> *col_ids) const {
+    if (col_ids == nullptr) {
+        for (int i = 0; i < file_hdr_.num_pax_cols; i++) {
+            const RmColRange &col = file_hdr_.pax_cols[i];
+            std::memcpy(out + col.offset, page_hdl.get_column(col) + slot_no * col.len, col.len);
+        }
+        return;
+    }
+    for (int col_id : *col_ids) {
+        const RmColRange &col = file_hdr_.pax_cols[col_id];
+        std::memcpy(out + col.offset, page_hdl.get_column(col) + slot_no * col.len, col.len);
+    }
+}
+
+/**
+ * @description: 将定长格式的记录拆开写入列存页面的各个minipage
+ * @param {RmPageHandle&} page_hdl 记录所在的页面
+ * @param {int} slot_no 记录的slot_no
+ * @param {char*} buf 定长格式的记录
+ */
+void RmFileHandle::scatter_record(RmPageHandle &page_hdl, int slot_no, const char *buf) {
+    for (int i = 0; i < file_hdr_.num_pax_cols; i++) {
+        const RmColRange &col = file_hdr_.pax_cols[i];
+        std::memcpy(page_hdl.get_column(col) + slot_no * col.len, buf + col.offset, col.len);
+    }
+}
+
+/**
+ * @description: 找到包含记录中offset处数据的字段
+ * @return {int} 字段在file_hdr_.pax_cols中的下标
+ */
+int RmFileHandle::find_pax_col(int offset) const {
+    // pax_cols按offset从小到大排列，找到最后一个起始位置不超过offset的字段
+    const RmColRange *end = file_hdr_.pax_cols + file_hdr_.num_pax_cols;
+    const RmColRange *pos = std::upper_bound(file_hdr_.pax_cols, end, offset,
+                                             [](int off, const RmColRange &col) { return off < col.offset; });
+    if (pos == file_hdr_.pax_cols || offset >= (pos - 1)->offset + (pos - 1)->len) {
+        throw InternalError("RmFileHandle::find_pax_col: offset out of range");
+    }
+    return static_cast<int>(pos - 1 - file_hdr_.pax_cols);
+}
+
+/**
+ * 以下为分槽页的辅助函数。分槽页的布局为：页头、位图、RmSlottedHdr、slot目录（向后增长），
+ * 记录区从页尾向前增长，二者之间是连续的空闲空间。记录以变长格式存放：每个变长字段只保存
+ * 2字节的实际长度和实际内容，读出时解码为定长格式，因此上层看到的记录与定长格式相同
+ */
+
+/**
+ * @description: 将定长格式的记录编码为分槽页中存放的变长格式
+ * @param {char*} buf 定长格式的记录
+ * @param {char*} out 输出，长度至少为RM_MAX_ENCODED_SIZE
+ * @return {int} 编码后的长度
+ */
+int RmFileHandle::encode_record(const char *buf, char *out) const {
+    int pos = 0;
+    int prev = 0;
+    for (int i = 0; i < file_hdr_.num_var_cols; i++) {
+        const RmColRange &col = file_hdr_.var_cols[i];
+        memcpy(out + pos, buf + prev, col.offset - prev);
+        pos += col.offset - prev;
+        uint16_t len = static_cast<uint16_t>(strnlen(buf + col.offset, col.len));
+        memcpy(out + pos, &len, sizeof(len));
+        pos += sizeof(len);
+        memcpy(out + pos, buf + col.offset, len);
+        pos += len;
+        prev = col.offset + col.len;
+    }
+    memcpy(out + pos, buf + prev, file_hdr_.record_size - prev);
+    return pos + file_hdr_.record_size - prev;
+}
+
+/**
+ * @description: 将变长格式的记录解码为定长格式，变长字段的剩余部分补0
+ * @param {char*} data 变长格式的记录
+ * @param {char*} out 输出，长度为file_hdr_.record_size
+ */
+void RmFileHandle::decode_record(const char *data, char *out) const {
+    int pos = 0;
+    int prev = 0;
+    for (int i = 0; i < file_hdr_.num_var_cols; i++) {
+        const RmColRange &col = file_hdr_.var_cols[i];
+        memcpy(out + prev, data + pos, col.offset - prev);
+        pos += col.offset - prev;
+        uint16_t len;
+        memcpy(&len, data + pos, sizeof(len));
+        pos += sizeof(len);
+        memcpy(out + col.offset, data + pos, len);
+        memset(out + col.offset + len, 0, col.len - len);
+        pos += len;
+        prev = col.offset + col.len;
+    }
+    memcpy(out + prev, data + pos, file_hdr_.record_size - prev);
+}
+
+/**
+ * @description: 读出分槽页中的一条记录并解码，记录被搬到其他页面时到搬迁后的位置读取
+ */
+void RmFileHandle::read_slot(const RmPageHandle &page_hdl, int slot_no, char *out) const {
+    const RmSlot &slot = page_hdl.dir[slot_no];
+    const char *data = page_hdl.page->get_data() + slot.offset;
+    if ((slot.len & RM_SLOT_FORWARD) == 0) {
+        decode_record(data, out);
+        return;
+    }
+    Rid target;
+    memcpy(&target, data, sizeof(Rid));
+    RmPageHandle target_hdl = fetch_page_handle(target.page_no);
+    decode_record(target_hdl.page->get_data() + target_hdl.dir[target.slot_no].offset, out);
+    buffer_pool_manager_->unpin_page(target_hdl.page->get_page_id(), false);
+}
+
+/**
+ * @description: 将记录写入分槽页的指定位置，用于更新记录和在指定位置插入记录。
+ *              原来的空间放得下时原地写入，否则在本页面中重新分配空间，本页面放不下时搬到其他页面，
+ *              原位置只保存搬迁后的Rid，记录的Rid保持不变
+ * @param {RmPageHandle&} page_hdl 记录所在页面
+ * @param {int} slot_no 记录的slot号
+ * @param {char*} buf 定长格式的记录
+ */
+void RmFileHandle::write_slot(RmPageHandle &page_hdl, int slot_no, const char *buf) {
+    char encoded[RM_MAX_ENCODED_SIZE];
+    int len = encode_record(buf, encoded);
+    if (slot_no < page_hdl.slotted_hdr->num_slots) {
+        RmSlot &slot = page_hdl.dir[slot_no];
+        if (slot.len & RM_SLOT_FORWARD) {
+            // 记录已经搬到其他页面，那里的空间放得下时直接写入
+            Rid target;
+            memcpy(&target, page_hdl.page->get_data() + slot.offset, sizeof(Rid));
+            RmPageHandle target_hdl = fetch_page_handle(target.page_no);
+            RmSlot &target_slot = target_hdl.dir[target.slot_no];
+            bool fits = len <= slot_space(target_slot.len & RM_SLOT_LEN_MASK);
+            if (fits) {
+                memcpy(target_hdl.page->get_data() + target_slot.offset, encoded, len);
+                target_slot.len = static_cast<uint16_t>(len) | RM_SLOT_MOVED_IN;
+            }
+            buffer_pool_manager_->unpin_page(target_hdl.page->get_page_id(), fits);
+            if (fits) {
+                return;
+            }
+            free_slot(page_hdl, slot_no);
+        } else if (slot.len != 0 && len <= slot_space(slot.len & RM_SLOT_LEN_MASK)) {
+            memcpy(page_hdl.page->get_data() + slot.offset, encoded, len);
+            slot.len = static_cast<uint16_t>(len);
+            return;
+        } else {
+            slot.len = 0;
+        }
+    }
+    if (place_slot(page_hdl, slot_no, encoded, len, 0)) {
+        return;
+    }
+    Rid target = move_out(page_hdl.page->get_page_id().page_no, encoded, len);
+    if (!place_slot(page_hdl, slot_no, reinterpret_cast<const char *>(&target), sizeof(Rid), RM_SLOT_FORWARD)) {
+        throw InternalError("RmFileHandle::write_slot: no space for forwarding address");
+    }
+}
+
+/**
+ * @description: 在分槽页中为一条新记录分配slot并写入，优先复用目录中的空闲项
+ * @return {int} 分配的slot号，页面放不下时返回-1
+ */
+int RmFileHandle::alloc_slot(RmPageHandle &page_hdl, const char *data, int len, uint16_t flags) {
+    int num_slots = page_hdl.slotted_hdr->num_slots;
+    int slot_no = 0;
+    while (slot_no < num_slots && (page_hdl.dir[slot_no].len != 0 || Bitmap::is_set(page_hdl.bitmap, slot_no))) {
+        slot_no++;
+    }
+    if (slot_no == file_hdr_.num_records_per_page || !place_slot(page_hdl, slot_no, data, len, flags)) {
+        return -1;
+    }
+    return slot_no;
+}
+
+/**
+ * @description: 在分槽页的记录区中分配空间并写入数据，slot目录需要时向后增长。
+ *              连续的空闲空间不够而总的空闲空间足够时先压缩页面
+ * @param {int} slot_no 目录项，调用者保证该项空闲
+ * @param {uint16_t} flags 目录项的标志
+ * @return {bool} 页面放不下时返回false，页面不变
+ */
+bool RmFileHandle::place_slot(RmPageHandle &page_hdl, int slot_no, const char *data, int len, uint16_t flags) {
+    RmSlottedHdr *hdr = page_hdl.slotted_hdr;
+    int new_entries = std::max(0, slot_no + 1 - static_cast<int>(hdr->num_slots));
+    int need = slot_space(len) + new_entries * static_cast<int>(sizeof(RmSlot));
+    int dir_end = reinterpret_cast<char *>(page_hdl.dir + hdr->num_slots) - page_hdl.page->get_data();
+    if (hdr->free_end - dir_end < need) {
+        if (slotted_free_space(page_hdl) < need) {
+            return false;
+        }
+        compact_page(page_hdl);
+    }
+    for (int i = hdr->num_slots; i <= slot_no; i++) {
+        page_hdl.dir[i] = RmSlot{0, 0};
+    }
+    hdr->num_slots = std::max(static_cast<int>(hdr->num_slots), slot_no + 1);
+    hdr->free_end -= slot_space(len);
+    memcpy(page_hdl.page->get_data() + hdr->free_end, data, len);
+    page_hdl.dir[slot_no] = RmSlot{hdr->free_end, static_cast<uint16_t>(len | flags)};
+    return true;
+}
+
+/**
+ * @description: 记录在原页面中放不下时，把记录搬到空闲空间索引中一个放得下的页面
+ * @param {int} home_page_no 记录原来所在的页面
+ * @return {Rid} 搬迁后的位置
+ */
+Rid RmFileHandle::move_out(int home_page_no, const char *data, int len) {
+    build_free_space_map();
+    while (true) {
+        int page_no = free_space_map_.acquire(slot_space(len), home_page_no);
+        RmPageHandle page_hdl = page_no == RM_NO_PAGE ? create_new_page_handle() : fetch_page_handle(page_no);
+        page_no = page_hdl.page->get_page_id().page_no;
+        int slot_no = alloc_slot(page_hdl, data, len, RM_SLOT_MOVED_IN);
+        // 放不下时页面的空闲空间记为0，之后不再尝试这个页面
+        free_space_map_.release(page_no, slot_no >= 0 ? page_free_space(page_hdl) : 0);
+        buffer_pool_manager_->unpin_page(page_hdl.page->get_page_id(), true);
+        if (slot_no >= 0) {
+            return Rid{page_no, slot_no};
+        }
+    }
+}
+
+/**
+ * @description: 释放分槽页中一个目录项占用的空间，记录被搬到其他页面时一并释放搬迁后的空间。
+ *              记录区中的空间在下次压缩页面时回收
+ */
+void RmFileHandle::free_slot(RmPageHandle &page_hdl, int slot_no) {
+    RmSlot &slot = page_hdl.dir[slot_no];
+    if (slot.len & RM_SLOT_FORWARD) {
+        Rid target;
+        memcpy(&target, page_hdl.page->get_data() + slot.offset, sizeof(Rid));
+        RmPageHandle target_hdl = fetch_page_handle(target.page_no);
+        target_hdl.dir[target.slot_no].len = 0;
+        buffer_pool_manager_->unpin_page(target_hdl.page->get_page_id(), true);
+    }
+    slot.len = 0;
+}
+
+/**
+ * @description: 压缩分槽页的记录区，使所有空闲空间连续
+ */
+void RmFileHandle::compact_page(RmPageHandle &page_hdl) const {
+    char *data = page_hdl.page->get_data();
+    std::vector<char> copy(data, data + PAGE_SIZE);
+    int free_end = PAGE_SIZE;
+    for (int slot_no = 0; slot_no < page_hdl.slotted_hdr->num_slots; slot_no++) {
+        RmSlot &slot = page_hdl.dir[slot_no];
+        int len = slot.len & RM_SLOT_LEN_MASK;
+        if (len == 0) {
+            continue;
+        }
+        free_end -= slot_space(len);
+        memcpy(data + free_end, copy.data() + slot.offset, len);
+        slot.offset = static_cast<uint16_t>(free_end);
+    }
+    page_hdl.slotted_hdr->free_end = static_cast<uint16_t>(free_end);
+}
+
+/**
+ * @description: 分槽页中总的空闲空间，包括记录被删除或变短后留下的碎片
+ */
+int RmFileHandle::slotted_free_space(const RmPageHandle &page_hdl) const {
+    int num_slots = page_hdl.slotted_hdr->num_slots;
+    int used = reinterpret_cast<char *>(page_hdl.dir + num_slots) - page_hdl.page->get_data();
+    for (int slot_no = 0; slot_no < num_slots; slot_no++) {
+        int len = page_hdl.dir[slot_no].len & RM_SLOT_LEN_MASK;
+        if (len != 0) {
+            used += slot_space(len);
+        }
+    }
+    return PAGE_SIZE - used;
+}
@@ -10,28 +10,49 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "bitmap.h"
 #include "common/context.h"
 #include "rm_defs.h"
+#include "rm_free_space_map.h"
+#include "rm_slot_filter.h"
+#include "rm_zone_map.h"
 
 class RmManager;
 
 /* 对表数据文件中的页面进行封装 */
 struct RmPageHandle {
-    const RmFileHdr *file_hdr;  // 当前页面所在文件的文件头指针
-    Page *page;                 // 页面的实际数据，包括页面存储的数据、元信息等
-    RmPageHdr *page_hdr;        // page->data的第一部分，存储页面元信息，指针指向首地址，长度为sizeof(RmPageHdr)
-    char *bitmap;               // page->data的第二部分，存储页面的bitmap，指针指向首地址，长度为file_hdr->bitmap_size
-    char *slots;                // page->data的第三部分，存储表的记录，指针指向首地址，每个slot的长度为file_hdr->record_size
+    const RmFileHdr *file_hdr = nullptr;    // 当前页面所在文件的文件头指针
+    Page *page = nullptr;       // 页面的实际数据，包括页面存储的数据、元信息等
+    RmPageHdr *page_hdr = nullptr;  // page->data的第一部分，存储页面元信息，指针指向首地址，长度为sizeof(RmPageHdr)
+    char *bitmap = nullptr;     // page->data的第二部分，存储页面的bitmap，指针指向首地址，长度为file_hdr->bitmap_size
+    char *slots = nullptr;      // page->data的第三部分，存储表的记录，指针指向首地址，每个slot的长度为file_hdr->record_size；
+                                // 列存格式中是第一个minipage的首地址
     int *deleted = 0;            // 当前页面中已经删除的记录个数
+    RmSlottedHdr *slotted_hdr = nullptr;    // 分槽页：位图之后的页面元信息
+    RmSlot *dir = nullptr;                  // 分槽页：slot目录
+
+    RmPageHandle() = default;
 
     RmPageHandle(const RmFileHdr *fhdr_, Page *page_)
             : file_hdr(fhdr_), page(page_) {
         page_hdr = reinterpret_cast<RmPageHdr *>(page->get_data() + page->OFFSET_PAGE_HDR);
         bitmap = page->get_data() + sizeof(RmPageHdr) + page->OFFSET_PAGE_HDR;
+        if (file_hdr->format == RM_FORMAT_SLOTTED) {
+            // 分槽页中没有定长的记录区，slots为nullptr
+            slotted_hdr = reinterpret_cast<RmSlottedHdr *>(page->get_data() + slotted_hdr_offset(file_hdr));
+            dir = reinterpret_cast<RmSlot *>(slotted_hdr + 1);
+            slots = nullptr;
+            deleted = &slotted_hdr->deleted;
+            return;
+        }
         slots = bitmap + file_hdr->bitmap_size;
         deleted = reinterpret_cast<int *>(slots + file_hdr->record_size * file_hdr->num_records_per_page); // Assuming this part of the page is reserved for storing the deleted count
     }
@@ -40,6 +61,84 @@ struct RmPageHandle {
     char *get_slot(int slot_no) const {
         return slots + slot_no * file_hdr->record_size;  // slots的首地址 + slot个数 * 每个slot的大小(每个record的大小)
     }
+
+    // 列存格式：返回字段col的minipage首地址，第slot_no条记录的该字段位于minipage + slot_no * col.len
+    char *get_column(const RmColRange &col) const {
+        return slots + col.offset * file_hdr->num_records_per_page;
+    }
+
+    // 分槽页中RmSlottedHdr相对页面数据首地址的偏移，按4字节对齐
+    static int slotted_hdr_offset(const RmFileHdr *file_hdr) {
+        int offset = Page::OFFSET_PAGE_HDR + sizeof(RmPageHdr) + file_hdr->bitmap_size;
+        return (offset + 3) & ~3;
+    }
+};
+
+/* 指向缓冲池页面中一条记录的只读视图，不复制记录数据。视图存活期间固定（pin）记录所在的页面，析构时自动unpin；
+ * 记录需要在页面释放之后继续使用时，调用to_record()复制一份 */
+class RmRecordView {
+    friend class RmFileHandle;
+
+private:
+    BufferPoolManager *buffer_pool_manager_ = nullptr;
+    Page *page_ = nullptr;          // 被固定的页面，为nullptr时视图无效
+    const char *data_ = nullptr;    // 记录在页面中的地址
+    int size_ = 0;
+    std::vector<char> buf_;         // 分槽页中的记录需要解码，解码后的记录存放在这里，data_指向buf_
+
+public:
+    RmRecordView() = default;
+
+    RmRecordView(const RmRecordView &) = delete;
+
+    RmRecordView &operator=(const RmRecordView &) = delete;
+
+    RmRecordView(RmRecordView &&other) noexcept { *this = std::move(other); }
+
+    RmRecordView &operator=(RmRecordView &&other) noexcept {
+        if (this != &other) {
+            release();
+            buffer_pool_manager_ = other.buffer_pool_manager_;
+            page_ = other.page_;
+            data_ = other.data_;
+            size_ = other.size_;
+            buf_ = std::move(other.buf_);
+            other.page_ = nullptr;
+            other.data_ = nullptr;
+        }
+        return *this;
+    }
+
+    ~RmRecordView() { release(); }
+
+    bool is_valid() const { return data_ != nullptr; }
+
+    const char *data() const { return data_; }
+
+    int size() const { return size_; }
+
+    // 复制出一条独立的记录
+    std::unique_ptr<RmRecord> to_record() const {
+        return std::make_unique<RmRecord>(size_, const_cast<char *>(data_));
+    }
+
+    // 提前释放对页面的固定，之后视图无效
+    void release() {
+        if (page_ != nullptr) {
+            buffer_pool_manager_->unpin_page(page_->get_page_id(), false);
+            page_ = nullptr;
+        }
+        data_ = nullptr;
+    }
+};
+
+/* 一个页面中某个字段的所有值，第slot_no条记录的值位于base + slot_no * stride。
+ * 定长格式中stride为记录长度，列存格式中stride为字段长度，即值在minipage中连续存放 */
+struct RmColumnVector {
+    const char *base = nullptr;     // 为nullptr时该页面不能按列读取（分槽页）
+    int stride = 0;
+
+    const char *at(int slot_no) const { return base + slot_no * stride; }
 };
 
 /* 每个RmFileHandle对应一个表的数据文件，里面有多个page，每个page的数据封装在RmPageHandle中 */
@@ -53,39 +152,69 @@ private:
     BufferPoolManager *buffer_pool_manager_;
     int fd_;        // 打开文件后产生的文件句柄
     RmFileHdr file_hdr_;    // 文件头，维护当前表文件的元数据
+    RmZoneMap zone_map_;    // 每个页面中字段的取值范围，由RmManager在打开和关闭文件时读写
+    RmFreeSpaceMap free_space_map_;     // 包含空闲空间的页面
+    std::atomic<bool> free_space_built_{false};   // free_space_map_是否已经建立
+    // 被未提交的事务删除的记录位置（page_no -> slot_no），回滚时要在原位置插回，提交之前不能分配给新记录
+    std::unordered_map<int, std::unordered_set<int>> uncommitted_deletes_;
 
-    // 锁
+    // 锁。插入记录只加latch_的共享锁，并发的插入之间用meta_latch_保护file_hdr_的页面分配和zone_map_
     mutable std::shared_mutex latch_;
+    mutable std::mutex meta_latch_;
 
 public:
     RmFileHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd)
             : disk_manager_(disk_manager), buffer_pool_manager_(buffer_pool_manager), fd_(fd) {
         // 注意：这里从磁盘中读出文件描述符为fd的文件的file_hdr，读到内存中
         // 这里实际就是初始化file_hdr，只不过是从磁盘中读出进行初始化
-        // init file_hdr_
-        disk_manager_->read_page(fd, RM_FILE_HDR_PAGE, (char *) &file_hdr_, sizeof(file_hdr_));
+        // init file_hdr_，旧版本的文件头只有前5个字段，没有数据页时文件只有这么长，之后的字段按0处理
+        int hdr_size = sizeof(file_hdr_);
+        if (!disk_manager_->is_compressed_fd(fd)) {
+            hdr_size = std::min(hdr_size, disk_manager_->get_file_size(disk_manager_->get_file_name(fd)));
+        }
+        file_hdr_ = RmFileHdr{};
+        disk_manager_->read_page(fd, RM_FILE_HDR_PAGE, (char *) &file_hdr_, hdr_size);
         // disk_manager管理的fd对应的文件中，设置从file_hdr_.num_pages开始分配page_no
         disk_manager_->set_fd2pageno(fd, file_hdr_.num_pages);
     }
 
     RmFileHdr get_file_hdr() { return file_hdr_; }
 
+    // 是否使用分槽页存放变长记录
+    bool is_slotted() const { return file_hdr_.format == RM_FORMAT_SLOTTED; }
+
+    // 是否使用列存（PAX）格式
+    bool is_pax() const { return file_hdr_.format == RM_FORMAT_PAX; }
+
     int GetFd() { return fd_; }
 
     /* 判断指定位置上是否已经存在一条记录，通过Bitmap来判断 */
     bool is_record(const Rid &rid) const {
         RmPageHandle page_handle = fetch_page_handle(rid.page_no);
-        return Bitmap::is_set(page_handle.bitmap, rid.slot_no);  // page的slot_no位置上是否有record
+        bool exist = Bitmap::is_set(page_handle.bitmap, rid.slot_no);  // page的slot_no位置上是否有record
+        buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), false);
+        return exist;
     }
 
     std::unique_ptr<RmRecord> get_record(const Rid &rid, Context *context, bool was_get_lock = false) const;
 
+    void get_record_view(const Rid &rid, RmRecordView &view, const std::vector<int> *col_ids = nullptr) const;
+
+    RmColumnVector get_column_vector(int page_no, int col_offset, RmRecordView &view) const;
+
+    void filter_page(int page_no, const std::vector<SlotPredicate> &preds, char *mask, RmRecordView &view,
+                     ReadAheadState *read_ahead = nullptr) const;
+
+    bool page_may_match(int page_no, const std::vector<SlotPredicate> &preds) const;
+
     Rid insert_record(char *buf, Context *context, bool is_abort = false);
     void insert_record(Rid &rid, char *buf, Context *context, bool is_abort = false);
     void insert_record(const Rid &rid, char *buf);
 
     void delete_record(Rid &rid, Context *context, bool is_abort = false);
 
+    void release_deleted_slot(const Rid &rid);
+
     void update_record(Rid &rid, char *buf, Context *context, bool is_abort = false);
 
     RmPageHandle create_new_page_handle();
@@ -94,8 +223,66 @@ public:
 
     void allocpage(Rid& rid);
 
+    int vacuum();
+
 private:
-    RmPageHandle create_page_handle();
+    void build_free_space_map();
+
+    void init_page_handle(RmPageHandle &page_hdl);
+
+    void rebuild_free_pages();
+
+    int page_free_space(const RmPageHandle &page_hdl) const;
+
+    int first_free_slot(const RmPageHandle &page_hdl) const;
+
+    void free_deleted_slot(RmPageHandle &page_hdl, int slot_no);
+
+    bool take_uncommitted_delete(RmPageHandle &page_hdl, int slot_no);
+
+    void read_record(const RmPageHandle &page_hdl, int slot_no, char *out) const;
+
+    void rebuild_zone_map();
+
+    void rebuild_page_zone(const RmPageHandle &page_hdl);
+
+    // 以下为列存格式的辅助函数
+
+    void gather_record(const RmPageHandle &page_hdl, int slot_no, char *out,
+                       const std::vector<int> *col_ids = nullptr) const;
+
+    void scatter_record(RmPageHandle &page_hdl, int slot_no, const char *buf);
+
+    int find_pax_col(int offset) const;
+
+    // 以下为分槽页的辅助函数，调用者需持有latch_
+
+    int encode_record(const char *buf, char *out) const;
+
+    // 所有变长字段都为空串时编码后的长度
+    int min_encoded_size() const {
+        int len = file_hdr_.record_size;
+        for (int i = 0; i < file_hdr_.num_var_cols; i++) {
+            len += static_cast<int>(sizeof(uint16_t)) - file_hdr_.var_cols[i].len;
+        }
+        return len;
+    }
+
+    void decode_record(const char *data, char *out) const;
+
+    void read_slot(const RmPageHandle &page_hdl, int slot_no, char *out) const;
+
+    void write_slot(RmPageHandle &page_hdl, int slot_no, const char *buf);
+
+    int alloc_slot(RmPageHandle &page_hdl, const char *data, int len, uint16_t flags);
+
+    bool place_slot(RmPageHandle &page_hdl, int slot_no, const char *data, int len, uint16_t flags);
+
+    Rid move_out(int home_page_no, const char *data, int len);
+
+    void free_slot(RmPageHandle &page_hdl, int slot_no);
+
+    void compact_page(RmPageHandle &page_hdl) const;
 
-    void release_page_handle(RmPageHandle &page_handle);
+    int slotted_free_space(const RmPageHandle &page_hdl) const;
 };
\ No newline at end of file
@@ -0,0 +1,93 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "rm_free_space_map.h"
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+#include "rm_defs.h"
+
+void RmFreeSpaceMap::reset(int capacity) {
+    std::scoped_lock lock{mutex_};
+    capacity_ = std::max(capacity, 1);
+    free_.clear();
+    for (auto &bucket: buckets_) {
+        bucket.clear();
+    }
+    std::fill(lane_pages_, lane_pages_ + NUM_LANES, RM_NO_PAGE);
+}
+
+int RmFreeSpaceMap::acquire(int need, int exclude) {
+    int lane = current_lane();
+    std::scoped_lock lock{mutex_};
+    // 1. 优先使用本通道上次使用的页面
+    int page_no = lane_pages_[lane];
+    auto pos = free_.find(page_no);
+    if (page_no != exclude && pos != free_.end() && pos->second >= need) {
+        erase_locked(page_no);
+        return page_no;
+    }
+    // 2. 从较满的桶开始找，第一遍跳过其他通道正在使用的页面
+    for (int pass = 0; pass < 2; pass++) {
+        for (const auto &bucket: buckets_) {
+            for (int candidate: bucket) {
+                if (candidate == exclude || free_.at(candidate) < need) {
+                    continue;
+                }
+                if (pass == 0 && std::find(lane_pages_, lane_pages_ + NUM_LANES, candidate) != lane_pages_ + NUM_LANES) {
+                    continue;
+                }
+                erase_locked(candidate);
+                lane_pages_[lane] = candidate;
+                return candidate;
+            }
+        }
+    }
+    return RM_NO_PAGE;
+}
+
+void RmFreeSpaceMap::release(int page_no, int free) {
+    int lane = current_lane();
+    std::scoped_lock lock{mutex_};
+    erase_locked(page_no);
+    if (free > 0) {
+        free_[page_no] = free;
+        buckets_[bucket_of(free)].insert(page_no);
+        lane_pages_[lane] = page_no;
+    }
+}
+
+void RmFreeSpaceMap::remove(int page_no) {
+    std::scoped_lock lock{mutex_};
+    erase_locked(page_no);
+}
+
+size_t RmFreeSpaceMap::num_pages() {
+    std::scoped_lock lock{mutex_};
+    return free_.size();
+}
+
+int RmFreeSpaceMap::bucket_of(int free) const {
+    return std::min(NUM_BUCKETS - 1, free * NUM_BUCKETS / capacity_);
+}
+
+int RmFreeSpaceMap::current_lane() {
+    return static_cast<int>(std::hash<std::thread::id>{}(std::this_thread::get_id()) % NUM_LANES);
+}
+
+void RmFreeSpaceMap::erase_locked(int page_no) {
+    auto pos = free_.find(page_no);
+    if (pos != free_.end()) {
+        buckets_[bucket_of(pos->second)].erase(page_no);
+        free_.erase(pos);
+    }
+}
@@ -0,0 +1,63 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <mutex>
+#include <set>
+#include <unordered_map>
+
+/**
+ * @description: 表数据文件的空闲空间索引，只在内存中维护，打开文件后第一次插入时扫描所有页面建立。
+ * 包含空闲空间的页面按空闲比例分桶，插入时优先选择较满的页面，使记录集中存放。
+ * 页面被acquire取出后不再分配给其他插入者，直到release归还并更新空闲空间，因此并发的插入总是写不同的页面；
+ * 每个线程按线程id对应一个插入通道，通道记住上次使用的页面，之后优先继续使用，避免多个线程争用同一个页面。
+ * 空闲空间的单位由调用者决定（定长格式为slot个数，分槽页为字节数）
+ */
+class RmFreeSpaceMap {
+   public:
+    static constexpr int NUM_BUCKETS = 4;   // 按空闲比例分桶的个数
+    static constexpr int NUM_LANES = 16;    // 插入通道的个数
+
+    /**
+     * @description: 清空索引
+     * @param {int} capacity 空页面的空闲空间
+     */
+    void reset(int capacity);
+
+    /**
+     * @description: 取出一个空闲空间不小于need的页面，页面归还之前不会再被取出
+     * @param {int} exclude 不能取出的页面
+     * @return {int} 页面号，没有这样的页面时返回RM_NO_PAGE，调用者应创建新页面，用完后同样调用release
+     */
+    int acquire(int need, int exclude = -1);
+
+    // 归还页面并记录其当前的空闲空间，也用于更新未被取出的页面的空闲空间
+    void release(int page_no, int free);
+
+    // 页面被释放，从索引中删除
+    void remove(int page_no);
+
+    // 索引中包含空闲空间的页面个数（不含被取出的页面）
+    size_t num_pages();
+
+   private:
+    int bucket_of(int free) const;
+
+    static int current_lane();
+
+    void erase_locked(int page_no);
+
+    std::mutex mutex_;
+    int capacity_ = 1;
+    std::unordered_map<int, int> free_;         // 未被取出的页面的空闲空间
+    std::set<int> buckets_[NUM_BUCKETS];        // 第i个桶中页面的空闲比例在[i / NUM_BUCKETS, (i + 1) / NUM_BUCKETS)，桶内按页号排列
+    int lane_pages_[NUM_LANES] = {};            // 每个通道上次使用的页面
+};
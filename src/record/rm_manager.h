@@ -12,6 +12,9 @@ See the Mulan PSL v2 for more details. */
 
 #include <assert.h>
 
+#include <algorithm>
+#include <vector>
+
 #include "bitmap.h"
 #include "rm_defs.h"
 #include "rm_file_handle.h"
@@ -30,12 +33,26 @@ public:
      * @description: 创建表的数据文件并初始化相关信息
      * @param {string&} filename 要创建的文件名称
      * @param {int} record_size 表中记录的大小
+     * @param {vector<RmColRange>&} var_cols 变长字段在记录中的位置，非空时使用分槽页存放变长记录
+     * @param {bool} compressed 是否压缩存放数据文件中的页面
+     * @param {vector<RmColRange>&} pax_cols 所有字段在记录中的位置，非空时使用列存格式，此时忽略var_cols，变长字段按最大长度存放
      */
-    void create_file(const std::string &filename, int record_size) {
+    void create_file(const std::string &filename, int record_size, const std::vector<RmColRange> &var_cols = {},
+                     bool compressed = false, const std::vector<RmColRange> &pax_cols = {}) {
         if (record_size < 1 || record_size > RM_MAX_RECORD_SIZE) {
             throw InvalidRecordSizeError(record_size);
         }
-        disk_manager_->create_file(filename);
+        if (var_cols.size() > static_cast<size_t>(RM_MAX_VAR_COLS)) {
+            throw InternalError("RmManager::create_file: too many variable-length columns");
+        }
+        if (pax_cols.size() > static_cast<size_t>(RM_MAX_PAX_COLS)) {
+            throw InternalError("RmManager::create_file: too many columns for columnar layout");
+        }
+        if (compressed) {
+            disk_manager_->create_compressed_file(filename);
+        } else {
+            disk_manager_->create_file(filename);
+        }
         int fd = disk_manager_->open_file(filename);
 
         // 初始化file header
@@ -43,9 +60,26 @@ public:
         file_hdr.record_size = record_size;
         file_hdr.num_pages = 1;
         file_hdr.first_free_page_no = RM_NO_PAGE;
-        // We have: sizeof(hdr) + (n + 7) / 8 + n * record_size <= PAGE_SIZE
-        file_hdr.num_records_per_page =
-                (BITMAP_WIDTH * (PAGE_SIZE - 1 - (int) sizeof(RmFileHdr)) + 1) / (1 + record_size * BITMAP_WIDTH);
+        file_hdr.first_dealloc_page_no = RM_NO_PAGE;
+        if (!pax_cols.empty()) {
+            // 列存格式的页面与定长格式容量相同，只是记录区按字段重新排列
+            file_hdr.format = RM_FORMAT_PAX;
+            file_hdr.num_pax_cols = static_cast<int>(pax_cols.size());
+            std::copy(pax_cols.begin(), pax_cols.end(), file_hdr.pax_cols);
+            std::sort(file_hdr.pax_cols, file_hdr.pax_cols + file_hdr.num_pax_cols,
+                      [](const RmColRange &a, const RmColRange &b) { return a.offset < b.offset; });
+            file_hdr.num_records_per_page = fixed_records_per_page(record_size);
+        } else if (var_cols.empty()) {
+            file_hdr.format = RM_FORMAT_FIXED;
+            file_hdr.num_records_per_page = fixed_records_per_page(record_size);
+        } else {
+            file_hdr.format = RM_FORMAT_SLOTTED;
+            file_hdr.num_var_cols = static_cast<int>(var_cols.size());
+            std::copy(var_cols.begin(), var_cols.end(), file_hdr.var_cols);
+            std::sort(file_hdr.var_cols, file_hdr.var_cols + file_hdr.num_var_cols,
+                      [](const RmColRange &a, const RmColRange &b) { return a.offset < b.offset; });
+            file_hdr.num_records_per_page = slotted_records_per_page(record_size, var_cols);
+        }
         file_hdr.bitmap_size = (file_hdr.num_records_per_page + BITMAP_WIDTH - 1) / BITMAP_WIDTH;
 
         // 将file header写入磁盘文件（名为file name，文件描述符为fd）中的第0页
@@ -54,6 +88,42 @@ public:
         disk_manager_->close_file(fd);
     }
 
+    /**
+     * @description: 定长格式的页面中最多能存放的记录个数
+     * @param {int} record_size 记录的大小
+     */
+    static int fixed_records_per_page(int record_size) {
+        // We have: reserved + (n + 7) / 8 + n * record_size <= PAGE_SIZE
+        return (BITMAP_WIDTH * (PAGE_SIZE - 1 - RM_FIXED_PAGE_RESERVED) + 1) / (1 + record_size * BITMAP_WIDTH);
+    }
+
+    /**
+     * @description: 分槽页中最多能存放的记录个数，按所有变长字段都为空串计算，即位图和slot目录的大小上限，
+     *              实际能存放的记录个数取决于变长字段的长度
+     * @param {int} record_size 记录在内存中的大小
+     * @param {vector<RmColRange>&} var_cols 变长字段
+     */
+    static int slotted_records_per_page(int record_size, const std::vector<RmColRange> &var_cols) {
+        int min_len = record_size;
+        for (const auto &col : var_cols) {
+            min_len += static_cast<int>(sizeof(uint16_t)) - col.len;
+        }
+        int space = std::max(min_len, RM_SLOT_MIN_SPACE) + static_cast<int>(sizeof(RmSlot));
+        // 页头、RmSlottedHdr及其对齐占用的空间，另留1字节给位图向上取整
+        int avail = PAGE_SIZE - Page::OFFSET_PAGE_HDR - static_cast<int>(sizeof(RmPageHdr) + sizeof(RmSlottedHdr)) - 3 - 1;
+        // We have: n / 8 + n * space <= avail
+        return BITMAP_WIDTH * avail / (1 + space * BITMAP_WIDTH);
+    }
+
+    /**
+     * @description: 为表的数据文件创建空的区域映射，之后打开数据文件时会维护其中字段的取值范围
+     * @param {string&} filename 数据文件的名称
+     * @param {vector<RmZoneCol>&} cols 需要记录取值范围的INT、FLOAT字段
+     */
+    void create_zone_map(const std::string &filename, const std::vector<RmZoneCol> &cols) {
+        RmZoneMap(cols).save(filename + ZONE_MAP_SUFFIX);
+    }
+
     /**
      * @description: 删除表的数据文件
      * @param {string&} filename 要删除的文件名称
@@ -63,6 +133,10 @@ public:
         int fd = disk_manager_->get_file_fd(filename);
         disk_manager_->close_file(fd);
         disk_manager_->destroy_file(filename);
+        std::string zone_map_path = filename + ZONE_MAP_SUFFIX;
+        if (disk_manager_->is_file(zone_map_path)) {
+            disk_manager_->destroy_file(zone_map_path);
+        }
     }
 
     // 注意这里打开文件，创建并返回了record file handle的指针
@@ -73,7 +147,22 @@ public:
      */
     std::unique_ptr<RmFileHandle> open_file(const std::string &filename) {
         int fd = disk_manager_->open_file(filename);
-        return std::make_unique<RmFileHandle>(disk_manager_, buffer_pool_manager_, fd);
+        auto file_handle = std::make_unique<RmFileHandle>(disk_manager_, buffer_pool_manager_, fd);
+        // 恢复文件中已经释放的页面，之后创建新页面时优先复用；上次没有正常关闭时空闲页面链表已经过时，扫描页面重新计算
+        RmFileHdr &file_hdr = file_handle->file_hdr_;
+        if (file_hdr.dirty) {
+            file_handle->rebuild_free_pages();
+        } else {
+            disk_manager_->load_free_pages(fd, file_hdr.first_dealloc_page_no, RM_FREE_PAGE_LINK_OFFSET);
+        }
+        file_hdr.dirty = 1;
+        disk_manager_->write_page(fd, RM_FILE_HDR_PAGE, (char *) &file_hdr, sizeof(file_hdr));
+        // 读出区域映射，上次没有正常关闭时扫描数据文件重新计算
+        std::string zone_map_path = filename + ZONE_MAP_SUFFIX;
+        if (disk_manager_->is_file(zone_map_path) && !file_handle->zone_map_.load(zone_map_path)) {
+            file_handle->rebuild_zone_map();
+        }
+        return file_handle;
     }
 
     /**
@@ -81,10 +170,18 @@ public:
      * @param {RmFileHandle*} file_handle 要关闭文件的句柄
      */
     void close_file(const RmFileHandle *file_handle) {
-        disk_manager_->write_page(file_handle->fd_, RM_FILE_HDR_PAGE, (char *) &file_handle->file_hdr_,
-                                  sizeof(file_handle->file_hdr_));
+        // 已释放的页面串成链表写入磁盘，链表头记录在文件头中
+        RmFileHdr file_hdr = file_handle->file_hdr_;
+        file_hdr.first_dealloc_page_no = disk_manager_->save_free_pages(file_handle->fd_, RM_FREE_PAGE_LINK_OFFSET);
         // 缓冲区的所有页刷到磁盘，注意这句话必须写在close_file前面
         buffer_pool_manager_->flush_all_pages(file_handle->fd_);
+        // 数据页和空闲页面链表都写回之后，最后写回文件头并清除dirty标记
+        file_hdr.dirty = 0;
+        disk_manager_->write_page(file_handle->fd_, RM_FILE_HDR_PAGE, (char *) &file_hdr, sizeof(file_hdr));
+        // 数据页写回之后再写回区域映射并清除dirty标记
+        if (!file_handle->zone_map_.empty()) {
+            file_handle->zone_map_.save(disk_manager_->get_file_name(file_handle->fd_) + ZONE_MAP_SUFFIX);
+        }
         disk_manager_->close_file(file_handle->fd_);
     }
 };
\ No newline at end of file
@@ -15,7 +15,8 @@ See the Mulan PSL v2 for more details. */
  * @brief 初始化file_handle和rid
  * @param file_handle
  */
-RmScan::RmScan(const RmFileHandle *file_handle) : file_handle_(file_handle) {
+RmScan::RmScan(const RmFileHandle *file_handle, const std::vector<SlotPredicate> *page_preds)
+        : file_handle_(file_handle), page_preds_(page_preds) {
     // 初始化file_handle和rid
     rid_.page_no = RM_FIRST_RECORD_PAGE;
     rid_.slot_no = -1;
@@ -34,10 +35,20 @@ void RmScan::next() {
     for (; rid_.page_no < file_handle_->file_hdr_.num_pages; rid_.page_no++) {
         // 用位图找到下一个为1的位
         int num_record = file_handle_->file_hdr_.num_records_per_page;
+        // 区域映射表明页面中不可能有满足条件的记录时，跳过整个页面
+        if (rid_.slot_no == -1 && page_preds_ != nullptr && !file_handle_->page_may_match(rid_.page_no, *page_preds_)) {
+            continue;
+        }
+        // 进入新的页面时提示缓冲池预读后续页面
+        if (rid_.slot_no == -1) {
+            file_handle_->buffer_pool_manager_->read_ahead({file_handle_->fd_, rid_.page_no},
+                                                           file_handle_->file_hdr_.num_pages, &read_ahead_);
+        }
         auto pageHandle = file_handle_->fetch_page_handle(rid_.page_no);
         rid_.slot_no = Bitmap::next_bit(
                 true, pageHandle.bitmap, num_record,
                 rid_.slot_no, *pageHandle.deleted);
+        file_handle_->buffer_pool_manager_->unpin_page(pageHandle.page->get_page_id(), false);
         if (rid_.slot_no < num_record) {
             return;
         }
@@ -10,15 +10,20 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <vector>
+
 #include "rm_defs.h"
+#include "rm_slot_filter.h"
 
 class RmFileHandle;
 
 class RmScan : public RecScan {
     const RmFileHandle *file_handle_;
     Rid rid_;
+    ReadAheadState read_ahead_;     // 顺序扫描数据页时的预读状态
+    const std::vector<SlotPredicate> *page_preds_;  // 用区域映射判断页面是否需要扫描的条件，为nullptr时扫描所有页面
 public:
-    RmScan(const RmFileHandle *file_handle);
+    RmScan(const RmFileHandle *file_handle, const std::vector<SlotPredicate> *page_preds = nullptr);
 
     void next() override;
 
@@ -0,0 +1,252 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL
+v2. You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "rm_slot_filter.h"
+
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SLOT_FILTER_X86 1
+#endif
+
+namespace {
+
+// 页面位图中第i位是字节i/8的第7-i%8位（从高位开始），movemask得到的第i位是字节的第i位，需要把字节按位反转
+struct ReverseTable {
+    unsigned char table[256];
+
+    ReverseTable() {
+        for (int i = 0; i < 256; i++) {
+            unsigned char b = 0;
+            for (int j = 0; j < 8; j++) {
+                if (i & (1 << j)) {
+                    b |= static_cast<unsigned char>(0x80u >> j);
+                }
+            }
+            table[i] = b;
+        }
+    }
+};
+
+const ReverseTable reverse_bits;
+
+template <typename T>
+inline T load(const char *data) {
+    T val;
+    memcpy(&val, data, sizeof(T));
+    return val;
+}
+
+template <SlotFilterOp op, typename T>
+inline bool match(T val, const T *vals, int num_vals) {
+    if constexpr (op == SlotFilterOp::EQ) {
+        return val == vals[0];
+    } else if constexpr (op == SlotFilterOp::NE) {
+        return val != vals[0];
+    } else if constexpr (op == SlotFilterOp::LT) {
+        return val < vals[0];
+    } else if constexpr (op == SlotFilterOp::GT) {
+        return val > vals[0];
+    } else if constexpr (op == SlotFilterOp::LE) {
+        return val <= vals[0];
+    } else if constexpr (op == SlotFilterOp::GE) {
+        return val >= vals[0];
+    } else if constexpr (op == SlotFilterOp::BETWEEN) {
+        return val >= vals[0] && val <= vals[1];
+    } else {
+        for (int i = 0; i < num_vals; i++) {
+            if (val == vals[i]) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+// 逐条判断[begin, num_slots)中的记录。T是比较时使用的类型，int_as_float表示列是INT但按float比较
+template <SlotFilterOp op, typename T, bool int_as_float>
+struct ScalarKernel {
+    static void run(const SlotPredicate &pred, const char *slots, int record_size, int begin, int num_slots,
+                    char *mask) {
+        const T *vals;
+        if constexpr (std::is_same_v<T, float>) {
+            vals = pred.float_vals;
+        } else {
+            vals = pred.int_vals;
+        }
+        const char *data = slots + static_cast<size_t>(begin) * record_size + pred.offset;
+        for (int slot_no = begin; slot_no < num_slots; slot_no++, data += record_size) {
+            unsigned char bit = 0x80u >> (slot_no % 8);
+            if ((mask[slot_no / 8] & bit) == 0) {
+                continue;
+            }
+            T val;
+            if constexpr (int_as_float) {
+                val = static_cast<float>(load<int32_t>(data));
+            } else {
+                val = load<T>(data);
+            }
+            if (!match<op>(val, vals, pred.num_vals)) {
+                mask[slot_no / 8] &= static_cast<char>(~bit);
+            }
+        }
+    }
+};
+
+#ifdef SLOT_FILTER_X86
+
+template <SlotFilterOp op>
+__attribute__((target("avx2"))) inline int compare_int_avx2(__m256i val, const SlotPredicate &pred) {
+    const __m256i ones = _mm256_set1_epi32(-1);
+    const __m256i c0 = _mm256_set1_epi32(pred.int_vals[0]);
+    __m256i res;
+    if constexpr (op == SlotFilterOp::EQ) {
+        res = _mm256_cmpeq_epi32(val, c0);
+    } else if constexpr (op == SlotFilterOp::NE) {
+        res = _mm256_xor_si256(_mm256_cmpeq_epi32(val, c0), ones);
+    } else if constexpr (op == SlotFilterOp::LT) {
+        res = _mm256_cmpgt_epi32(c0, val);
+    } else if constexpr (op == SlotFilterOp::GT) {
+        res = _mm256_cmpgt_epi32(val, c0);
+    } else if constexpr (op == SlotFilterOp::LE) {
+        res = _mm256_xor_si256(_mm256_cmpgt_epi32(val, c0), ones);
+    } else if constexpr (op == SlotFilterOp::GE) {
+        res = _mm256_xor_si256(_mm256_cmpgt_epi32(c0, val), ones);
+    } else if constexpr (op == SlotFilterOp::BETWEEN) {
+        const __m256i c1 = _mm256_set1_epi32(pred.int_vals[1]);
+        res = _mm256_xor_si256(_mm256_or_si256(_mm256_cmpgt_epi32(c0, val), _mm256_cmpgt_epi32(val, c1)), ones);
+    } else {
+        res = _mm256_cmpeq_epi32(val, c0);
+        for (int i = 1; i < pred.num_vals; i++) {
+            res = _mm256_or_si256(res, _mm256_cmpeq_epi32(val, _mm256_set1_epi32(pred.int_vals[i])));
+        }
+    }
+    return _mm256_movemask_ps(_mm256_castsi256_ps(res));
+}
+
+// 浮点数比较与C++的比较运算符一致：出现NaN时只有!=成立
+template <SlotFilterOp op>
+__attribute__((target("avx2"))) inline int compare_float_avx2(__m256 val, const SlotPredicate &pred) {
+    const __m256 c0 = _mm256_set1_ps(pred.float_vals[0]);
+    __m256 res;
+    if constexpr (op == SlotFilterOp::EQ) {
+        res = _mm256_cmp_ps(val, c0, _CMP_EQ_OQ);
+    } else if constexpr (op == SlotFilterOp::NE) {
+        res = _mm256_cmp_ps(val, c0, _CMP_NEQ_UQ);
+    } else if constexpr (op == SlotFilterOp::LT) {
+        res = _mm256_cmp_ps(val, c0, _CMP_LT_OQ);
+    } else if constexpr (op == SlotFilterOp::GT) {
+        res = _mm256_cmp_ps(val, c0, _CMP_GT_OQ);
+    } else if constexpr (op == SlotFilterOp::LE) {
+        res = _mm256_cmp_ps(val, c0, _CMP_LE_OQ);
+    } else if constexpr (op == SlotFilterOp::GE) {
+        res = _mm256_cmp_ps(val, c0, _CMP_GE_OQ);
+    } else if constexpr (op == SlotFilterOp::BETWEEN) {
+        const __m256 c1 = _mm256_set1_ps(pred.float_vals[1]);
+        res = _mm256_and_ps(_mm256_cmp_ps(val, c0, _CMP_GE_OQ), _mm256_cmp_ps(val, c1, _CMP_LE_OQ));
+    } else {
+        res = _mm256_cmp_ps(val, c0, _CMP_EQ_OQ);
+        for (int i = 1; i < pred.num_vals; i++) {
+            res = _mm256_or_ps(res, _mm256_cmp_ps(val, _mm256_set1_ps(pred.float_vals[i]), _CMP_EQ_OQ));
+        }
+    }
+    return _mm256_movemask_ps(res);
+}
+
+// 每次用gather取出连续8个slot中同一列的值，位图中全为0的8个slot直接跳过；不足8个的尾部逐条判断
+template <SlotFilterOp op, typename T, bool int_as_float>
+struct Avx2Kernel {
+    __attribute__((target("avx2"))) static void run(const SlotPredicate &pred, const char *slots, int record_size,
+                                                     int begin, int num_slots, char *mask) {
+        const __m256i index = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                                 _mm256_set1_epi32(record_size));
+        const size_t group_stride = static_cast<size_t>(record_size) * 8;
+        int num_groups = num_slots / 8;
+        const char *data = slots + (begin / 8) * group_stride + pred.offset;
+        for (int group = begin / 8; group < num_groups; group++, data += group_stride) {
+            if (mask[group] == 0) {
+                continue;
+            }
+            __m256i val = _mm256_i32gather_epi32(reinterpret_cast<const int *>(data), index, 1);
+            int bits;
+            if constexpr (std::is_same_v<T, float>) {
+                bits = compare_float_avx2<op>(int_as_float ? _mm256_cvtepi32_ps(val) : _mm256_castsi256_ps(val),
+                                              pred);
+            } else {
+                bits = compare_int_avx2<op>(val, pred);
+            }
+            mask[group] &= static_cast<char>(reverse_bits.table[bits]);
+        }
+        ScalarKernel<op, T, int_as_float>::run(pred, slots, record_size, num_groups * 8, num_slots, mask);
+    }
+};
+
+#endif
+
+// 按比较运算符和比较类型选择模板实例
+template <template <SlotFilterOp, typename, bool> class Kernel, SlotFilterOp op>
+void dispatch_type(const SlotPredicate &pred, const char *slots, int record_size, int num_slots, char *mask) {
+    if (pred.type == TYPE_FLOAT) {
+        Kernel<op, float, false>::run(pred, slots, record_size, 0, num_slots, mask);
+    } else if (pred.int_as_float) {
+        Kernel<op, float, true>::run(pred, slots, record_size, 0, num_slots, mask);
+    } else {
+        Kernel<op, int32_t, false>::run(pred, slots, record_size, 0, num_slots, mask);
+    }
+}
+
+template <template <SlotFilterOp, typename, bool> class Kernel>
+void dispatch(const SlotPredicate &pred, const char *slots, int record_size, int num_slots, char *mask) {
+    switch (pred.op) {
+        case SlotFilterOp::EQ:
+            return dispatch_type<Kernel, SlotFilterOp::EQ>(pred, slots, record_size, num_slots, mask);
+        case SlotFilterOp::NE:
+            return dispatch_type<Kernel, SlotFilterOp::NE>(pred, slots, record_size, num_slots, mask);
+        case SlotFilterOp::LT:
+            return dispatch_type<Kernel, SlotFilterOp::LT>(pred, slots, record_size, num_slots, mask);
+        case SlotFilterOp::GT:
+            return dispatch_type<Kernel, SlotFilterOp::GT>(pred, slots, record_size, num_slots, mask);
+        case SlotFilterOp::LE:
+            return dispatch_type<Kernel, SlotFilterOp::LE>(pred, slots, record_size, num_slots, mask);
+        case SlotFilterOp::GE:
+            return dispatch_type<Kernel, SlotFilterOp::GE>(pred, slots, record_size, num_slots, mask);
+        case SlotFilterOp::BETWEEN:
+            return dispatch_type<Kernel, SlotFilterOp::BETWEEN>(pred, slots, record_size, num_slots, mask);
+        case SlotFilterOp::IN:
+            return dispatch_type<Kernel, SlotFilterOp::IN>(pred, slots, record_size, num_slots, mask);
+    }
+}
+
+}  // namespace
+
+void SlotFilter::filter_scalar(const SlotPredicate &pred, const char *slots, int record_size, int num_slots,
+                               char *mask) {
+    dispatch<ScalarKernel>(pred, slots, record_size, num_slots, mask);
+}
+
+void SlotFilter::filter_avx2(const SlotPredicate &pred, const char *slots, int record_size, int num_slots,
+                             char *mask) {
+#ifdef SLOT_FILTER_X86
+    dispatch<Avx2Kernel>(pred, slots, record_size, num_slots, mask);
+#else
+    filter_scalar(pred, slots, record_size, num_slots, mask);
+#endif
+}
+
+bool SlotFilter::has_avx2() {
+#ifdef SLOT_FILTER_X86
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
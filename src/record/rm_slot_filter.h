@@ -0,0 +1,62 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <cstdint>
+
+#include "defs.h"
+
+// IN列表中最多包含的常量个数，更长的列表不使用页面级过滤
+static constexpr int SLOT_FILTER_MAX_IN = 8;
+
+enum class SlotFilterOp {
+    EQ, NE, LT, GT, LE, GE, BETWEEN, IN
+};
+
+/* 对页面中每条记录的一个INT或FLOAT列执行的简单比较。
+ * BETWEEN的下界和上界分别在vals[0]和vals[1]中（闭区间），IN的常量在vals[0, num_vals)中 */
+struct SlotPredicate {
+    ColType type = TYPE_INT;        // 列的类型，只能是TYPE_INT或TYPE_FLOAT
+    bool int_as_float = false;      // INT列与浮点数常量比较时，先把列的值转换为float
+    SlotFilterOp op = SlotFilterOp::EQ;
+    int offset = 0;                 // 列在记录中的偏移量
+    int num_vals = 0;
+    int32_t int_vals[SLOT_FILTER_MAX_IN] = {};      // 按整数比较时的常量
+    float float_vals[SLOT_FILTER_MAX_IN] = {};      // 按浮点数比较时的常量
+};
+
+/* 页面级谓词过滤。定长记录在页面中按slot_no * record_size连续存放，同一列的数据间隔固定，
+ * 因此可以一次对一个页面中所有记录判断条件，结果是与页面位图格式相同的选择位图。
+ * CPU支持AVX2时每次用gather指令取出8条记录的列值比较，否则逐条判断 */
+class SlotFilter {
+public:
+    /**
+     * @description: 对页面中所有记录判断条件，mask中不满足条件的记录对应的位被清0
+     * @param {SlotPredicate} &pred 条件
+     * @param {char*} slots 页面中第一个slot的地址
+     * @param {int} record_size 记录长度
+     * @param {int} num_slots 页面中slot的个数
+     * @param {char*} mask 输入时一般是页面位图的副本，只判断其中为1的位对应的记录
+     */
+    static void filter(const SlotPredicate &pred, const char *slots, int record_size, int num_slots, char *mask) {
+        (has_avx2() ? filter_avx2 : filter_scalar)(pred, slots, record_size, num_slots, mask);
+    }
+
+    static void filter_scalar(const SlotPredicate &pred, const char *slots, int record_size, int num_slots,
+                              char *mask);
+
+    // 只能在has_avx2()为true时调用
+    static void filter_avx2(const SlotPredicate &pred, const char *slots, int record_size, int num_slots,
+                            char *mask);
+
+    // 运行时检测CPU是否支持AVX2，结果只检测一次
+    static bool has_avx2();
+};
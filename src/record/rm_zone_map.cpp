@@ -0,0 +1,165 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "rm_zone_map.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+
+#include "errors.h"
+
+namespace {
+
+constexpr uint32_t ZONE_MAP_MAGIC = 0x5a4d4150;     // "ZMAP"
+
+/* 区域映射文件的文件头，之后依次是num_cols个RmZoneCol和num_zones个RmZone */
+struct RmZoneMapHdr {
+    uint32_t magic;
+    int32_t dirty;
+    int32_t num_cols;
+    int32_t num_zones;
+};
+
+// 取值范围[lo, hi]中是否可能有满足条件的值
+template <typename T>
+bool range_may_match(const SlotPredicate &pred, const T *vals, T lo, T hi) {
+    switch (pred.op) {
+        case SlotFilterOp::EQ:
+            return lo <= vals[0] && vals[0] <= hi;
+        case SlotFilterOp::NE:
+            return !(lo == vals[0] && hi == vals[0]);
+        case SlotFilterOp::LT:
+            return lo < vals[0];
+        case SlotFilterOp::GT:
+            return hi > vals[0];
+        case SlotFilterOp::LE:
+            return lo <= vals[0];
+        case SlotFilterOp::GE:
+            return hi >= vals[0];
+        case SlotFilterOp::BETWEEN:
+            return lo <= vals[1] && hi >= vals[0];
+        case SlotFilterOp::IN:
+            return std::any_of(vals, vals + pred.num_vals, [&](T val) { return lo <= val && val <= hi; });
+    }
+    return true;
+}
+
+}  // namespace
+
+void RmZoneMap::reset_page(int page_no) {
+    size_t begin = static_cast<size_t>(page_no) * cols_.size();
+    if (begin < zones_.size()) {
+        std::fill(zones_.begin() + begin, zones_.begin() + begin + cols_.size(), RmZone());
+    }
+}
+
+void RmZoneMap::add(int page_no, const char *record) {
+    if (cols_.empty()) {
+        return;
+    }
+    size_t begin = static_cast<size_t>(page_no) * cols_.size();
+    if (begin + cols_.size() > zones_.size()) {
+        zones_.resize(begin + cols_.size());
+    }
+    for (size_t i = 0; i < cols_.size(); i++) {
+        RmZone &zone = zones_[begin + i];
+        const char *data = record + cols_[i].offset;
+        if (cols_[i].type == TYPE_INT) {
+            int32_t val;
+            memcpy(&val, data, sizeof(val));
+            zone.int_min = zone.valid ? std::min(zone.int_min, val) : val;
+            zone.int_max = zone.valid ? std::max(zone.int_max, val) : val;
+        } else {
+            float val;
+            memcpy(&val, data, sizeof(val));
+            zone.float_min = zone.valid ? std::min(zone.float_min, val) : val;
+            zone.float_max = zone.valid ? std::max(zone.float_max, val) : val;
+        }
+        zone.valid = true;
+    }
+}
+
+const RmZone *RmZoneMap::find_zone(int page_no, int col_idx) const {
+    size_t pos = static_cast<size_t>(page_no) * cols_.size() + col_idx;
+    return pos < zones_.size() ? &zones_[pos] : nullptr;
+}
+
+bool RmZoneMap::may_match(int page_no, const std::vector<SlotPredicate> &preds) const {
+    if (cols_.empty()) {
+        return true;
+    }
+    for (const auto &pred: preds) {
+        auto col = std::find_if(cols_.begin(), cols_.end(),
+                                [&](const RmZoneCol &zone_col) { return zone_col.offset == pred.offset; });
+        if (col == cols_.end()) {
+            continue;
+        }
+        const RmZone *zone = find_zone(page_no, static_cast<int>(col - cols_.begin()));
+        if (zone == nullptr || !zone->valid) {
+            // 页面中没有写入过记录
+            return false;
+        }
+        bool match;
+        if (col->type == TYPE_FLOAT) {
+            match = range_may_match(pred, pred.float_vals, zone->float_min, zone->float_max);
+        } else if (pred.int_as_float) {
+            // INT到float的转换保持大小关系，范围的端点转换后仍然是范围的端点
+            match = range_may_match(pred, pred.float_vals, static_cast<float>(zone->int_min),
+                                    static_cast<float>(zone->int_max));
+        } else {
+            match = range_may_match(pred, pred.int_vals, zone->int_min, zone->int_max);
+        }
+        if (!match) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RmZoneMap::load(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    RmZoneMapHdr hdr{};
+    if (!in.read(reinterpret_cast<char *>(&hdr), sizeof(hdr)) || hdr.magic != ZONE_MAP_MAGIC) {
+        throw InternalError("RmZoneMap::load: invalid zone map file " + path);
+    }
+    cols_.resize(hdr.num_cols);
+    zones_.resize(hdr.num_zones);
+    in.read(reinterpret_cast<char *>(cols_.data()), static_cast<std::streamsize>(cols_.size() * sizeof(RmZoneCol)));
+    in.read(reinterpret_cast<char *>(zones_.data()), static_cast<std::streamsize>(zones_.size() * sizeof(RmZone)));
+    if (!in) {
+        throw InternalError("RmZoneMap::load: truncated zone map file " + path);
+    }
+    in.close();
+
+    // 表打开期间文件中的范围不再准确，直到正常关闭时写回
+    std::fstream out(path, std::ios::binary | std::ios::in | std::ios::out);
+    int32_t dirty = 1;
+    out.seekp(offsetof(RmZoneMapHdr, dirty));
+    out.write(reinterpret_cast<const char *>(&dirty), sizeof(dirty));
+    out.flush();
+    if (hdr.dirty) {
+        zones_.clear();
+        return false;
+    }
+    return true;
+}
+
+void RmZoneMap::save(const std::string &path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    RmZoneMapHdr hdr{ZONE_MAP_MAGIC, 0, static_cast<int32_t>(cols_.size()), static_cast<int32_t>(zones_.size())};
+    out.write(reinterpret_cast<const char *>(&hdr), sizeof(hdr));
+    out.write(reinterpret_cast<const char *>(cols_.data()), static_cast<std::streamsize>(cols_.size() * sizeof(RmZoneCol)));
+    out.write(reinterpret_cast<const char *>(zones_.data()), static_cast<std::streamsize>(zones_.size() * sizeof(RmZone)));
+    if (!out.flush()) {
+        throw UnixError();
+    }
+}
@@ -0,0 +1,76 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "defs.h"
+#include "rm_slot_filter.h"
+
+/* 区域映射中记录取值范围的字段，只能是TYPE_INT或TYPE_FLOAT */
+struct RmZoneCol {
+    int offset;     // 字段在记录中的偏移量
+    ColType type;
+};
+
+/* 一个页面中一个字段的取值范围 */
+struct RmZone {
+    bool valid = false;     // 为false时页面中没有写入过记录
+    int32_t int_min = 0;
+    int32_t int_max = 0;
+    float float_min = 0;
+    float float_max = 0;
+};
+
+/**
+ * @description: 表数据文件的区域映射（zone map）。为每个页面的每个INT、FLOAT字段记录写入过的最小值和最大值，
+ * 顺序扫描时先用扫描条件判断页面的取值范围，范围内不可能有满足条件的记录时直接跳过整个页面。
+ * 插入和更新记录时扩大范围，删除记录时不缩小范围（范围只需要包含页面中所有的有效记录），整理文件时重新计算。
+ * 区域映射保存在数据文件同名的ZONE_MAP_SUFFIX文件中：打开表时读出并标记为dirty，正常关闭表时写回并清除标记；
+ * 打开时发现dirty标记说明上次没有正常关闭，文件中的范围可能不完整，需要扫描数据文件重新计算
+ */
+class RmZoneMap {
+   public:
+    RmZoneMap() = default;
+
+    explicit RmZoneMap(std::vector<RmZoneCol> cols) : cols_(std::move(cols)) {}
+
+    // 没有需要记录范围的字段时，所有页面都需要扫描
+    bool empty() const { return cols_.empty(); }
+
+    const std::vector<RmZoneCol> &cols() const { return cols_; }
+
+    // 清空页面的取值范围，页面被释放或重新计算范围时调用
+    void reset_page(int page_no);
+
+    // 用一条记录扩大页面的取值范围
+    void add(int page_no, const char *record);
+
+    // 页面中是否可能有满足所有条件的记录
+    bool may_match(int page_no, const std::vector<SlotPredicate> &preds) const;
+
+    /**
+     * @description: 从文件中读出区域映射，读出之后文件被标记为dirty
+     * @return {bool} 文件带有dirty标记时返回false，此时字段已经读出，但各页面的范围需要调用者重新计算
+     */
+    bool load(const std::string &path);
+
+    // 将区域映射写入文件，并清除dirty标记
+    void save(const std::string &path) const;
+
+   private:
+    const RmZone *find_zone(int page_no, int col_idx) const;
+
+    std::vector<RmZoneCol> cols_;
+    std::vector<RmZone> zones_;     // 第page_no个页面的第i个字段的范围在zones_[page_no * cols_.size() + i]
+};
@@ -111,6 +111,13 @@ lsn_t LogManager::add_commit_log_record(txn_id_t txn_id) {
 lsn_t LogManager::add_abort_log_record(txn_id_t txn_id) {
     return add_log_record(new AbortLogRecord(txn_id));
 }
+
+/**
+ * @description: 添加一条索引操作的日志记录，调用者需设置好prev_lsn_，log_record由本函数释放
+ */
+lsn_t LogManager::add_ix_log_record(IxLogRecord *log_record) {
+    return add_log_record(log_record);
+}
 // 静态检查点
 void LogManager::static_checkpoint() {
 //    std::lock_guard<std::mutex> lg(this->latch_);
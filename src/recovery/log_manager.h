@@ -34,7 +34,9 @@ static std::string LogTypeStr[] = {
         "DELETE",
         "BEGIN",
         "COMMIT",
-        "ABORT"
+        "ABORT",
+        "IX_INSERT",
+        "IX_DELETE"
 };
 
 class LogRecord {
@@ -416,6 +418,152 @@ public:
     size_t table_name_size_;    // 表名称的大小
 };
 
+/* 索引结构修改时，日志中记录的一个结点页面修改后的完整内容 */
+struct IxPageImage {
+    page_id_t page_no;
+    bool is_new;                // 是否为本次操作新分配的结点
+    std::vector<char> data;     // PAGE_SIZE字节
+};
+
+/**
+ * 索引操作的日志记录，只在叶子结点中插入或删除一个键时是逻辑记录，redo时在leaf_page_no_页面中重新插入或删除该键；
+ * 插入导致结点分裂时是物理记录：记录所有被修改结点修改后的完整页面，以及变化后的根结点和最后一个叶子结点的页号。
+ * 新结点的孩子结点的parent、新叶子结点右侧叶子结点的prev_leaf不记录页面，redo时根据新结点的内容重新设置
+ */
+class IxLogRecord: public LogRecord {
+public:
+    explicit IxLogRecord(LogType log_type) {
+        log_type_ = log_type;
+        lsn_ = INVALID_LSN;
+        log_tot_len_ = LOG_HEADER_SIZE + sizeof(size_t) + sizeof(int) + sizeof(Rid) + sizeof(page_id_t) * 3 + sizeof(int);
+        log_tid_ = INVALID_TXN_ID;
+        prev_lsn_ = INVALID_LSN;
+        leaf_page_no_ = root_page_ = last_leaf_ = INVALID_PAGE_ID;
+    }
+    IxLogRecord(LogType log_type, txn_id_t txn_id, const std::string& index_name, const char* key, int key_len,
+                const Rid& rid, page_id_t leaf_page_no)
+            : IxLogRecord(log_type) {
+        log_tid_ = txn_id;
+        index_name_ = index_name;
+        key_.assign(key, key + key_len);
+        rid_ = rid;
+        leaf_page_no_ = leaf_page_no;
+        log_tot_len_ += index_name_.size() + key_len;
+    }
+
+    // 加入一个结点页面修改后的内容
+    void add_image(page_id_t page_no, bool is_new, const char* data) {
+        images_.push_back(IxPageImage{page_no, is_new, std::vector<char>(data, data + PAGE_SIZE)});
+        log_tot_len_ += sizeof(page_id_t) + sizeof(int) + PAGE_SIZE;
+    }
+
+    // 把索引日志记录序列化到dest中
+    void serialize(char* dest) const override {
+        LogRecord::serialize(dest);
+        int offset = OFFSET_LOG_DATA;
+        size_t name_size = index_name_.size();
+        memcpy(dest + offset, &name_size, sizeof(size_t));
+        offset += sizeof(size_t);
+        memcpy(dest + offset, index_name_.data(), name_size);
+        offset += name_size;
+        int key_len = static_cast<int>(key_.size());
+        memcpy(dest + offset, &key_len, sizeof(int));
+        offset += sizeof(int);
+        memcpy(dest + offset, key_.data(), key_len);
+        offset += key_len;
+        memcpy(dest + offset, &rid_, sizeof(Rid));
+        offset += sizeof(Rid);
+        memcpy(dest + offset, &leaf_page_no_, sizeof(page_id_t));
+        offset += sizeof(page_id_t);
+        memcpy(dest + offset, &root_page_, sizeof(page_id_t));
+        offset += sizeof(page_id_t);
+        memcpy(dest + offset, &last_leaf_, sizeof(page_id_t));
+        offset += sizeof(page_id_t);
+        int num_images = static_cast<int>(images_.size());
+        memcpy(dest + offset, &num_images, sizeof(int));
+        offset += sizeof(int);
+        for (auto &image : images_) {
+            memcpy(dest + offset, &image.page_no, sizeof(page_id_t));
+            offset += sizeof(page_id_t);
+            int is_new = image.is_new;
+            memcpy(dest + offset, &is_new, sizeof(int));
+            offset += sizeof(int);
+            memcpy(dest + offset, image.data.data(), PAGE_SIZE);
+            offset += PAGE_SIZE;
+        }
+    }
+    // 从src中反序列化出一条索引日志记录
+    void deserialize(const char* src) override {
+        LogRecord::deserialize(src);
+        int offset = OFFSET_LOG_DATA;
+        size_t name_size = *reinterpret_cast<const size_t*>(src + offset);
+        offset += sizeof(size_t);
+        index_name_.assign(src + offset, name_size);
+        offset += name_size;
+        int key_len = *reinterpret_cast<const int*>(src + offset);
+        offset += sizeof(int);
+        key_.assign(src + offset, src + offset + key_len);
+        offset += key_len;
+        rid_ = *reinterpret_cast<const Rid*>(src + offset);
+        offset += sizeof(Rid);
+        leaf_page_no_ = *reinterpret_cast<const page_id_t*>(src + offset);
+        offset += sizeof(page_id_t);
+        root_page_ = *reinterpret_cast<const page_id_t*>(src + offset);
+        offset += sizeof(page_id_t);
+        last_leaf_ = *reinterpret_cast<const page_id_t*>(src + offset);
+        offset += sizeof(page_id_t);
+        int num_images = *reinterpret_cast<const int*>(src + offset);
+        offset += sizeof(int);
+        images_.clear();
+        for (int i = 0; i < num_images; i++) {
+            page_id_t page_no = *reinterpret_cast<const page_id_t*>(src + offset);
+            offset += sizeof(page_id_t);
+            bool is_new = *reinterpret_cast<const int*>(src + offset) != 0;
+            offset += sizeof(int);
+            images_.push_back(IxPageImage{page_no, is_new, std::vector<char>(src + offset, src + offset + PAGE_SIZE)});
+            offset += PAGE_SIZE;
+        }
+    }
+    void format_print() override {
+        printf("index record\n");
+        LogRecord::format_print();
+        printf("index name: %s\n", index_name_.c_str());
+        printf("rid: %d, %d\n", rid_.page_no, rid_.slot_no);
+        printf("leaf page: %d, root page: %d, last leaf: %d\n", leaf_page_no_, root_page_, last_leaf_);
+        printf("page images: %zu\n", images_.size());
+    }
+
+    std::string index_name_;            // 索引文件名
+    std::vector<char> key_;             // 记录中格式的原始键
+    Rid rid_;                           // 键对应的记录位置
+    page_id_t leaf_page_no_;            // 键所在的叶子结点
+    page_id_t root_page_;               // 新的根结点页号，没有变化时为INVALID_PAGE_ID
+    page_id_t last_leaf_;               // 新的最后一个叶子结点页号，没有变化时为INVALID_PAGE_ID
+    std::vector<IxPageImage> images_;   // 结点分裂时被修改的结点页面
+};
+
+/**
+ * 索引插入操作的日志记录
+ */
+class IxInsertLogRecord: public IxLogRecord {
+public:
+    IxInsertLogRecord() : IxLogRecord(LogType::IX_INSERT) {}
+    IxInsertLogRecord(txn_id_t txn_id, const std::string& index_name, const char* key, int key_len, const Rid& rid,
+                      page_id_t leaf_page_no)
+            : IxLogRecord(LogType::IX_INSERT, txn_id, index_name, key, key_len, rid, leaf_page_no) {}
+};
+
+/**
+ * 索引删除操作的日志记录
+ */
+class IxDeleteLogRecord: public IxLogRecord {
+public:
+    IxDeleteLogRecord() : IxLogRecord(LogType::IX_DELETE) {}
+    IxDeleteLogRecord(txn_id_t txn_id, const std::string& index_name, const char* key, int key_len, const Rid& rid,
+                      page_id_t leaf_page_no)
+            : IxLogRecord(LogType::IX_DELETE, txn_id, index_name, key, key_len, rid, leaf_page_no) {}
+};
+
 
 /* 日志缓冲区，只有一个buffer，因此需要阻塞地去把日志写入缓冲区中 */
 
@@ -461,6 +609,7 @@ public:
     lsn_t add_begin_log_record(txn_id_t txn_id);
     lsn_t add_commit_log_record(txn_id_t txn_id);
     lsn_t add_abort_log_record(txn_id_t txn_id);
+    lsn_t add_ix_log_record(IxLogRecord* log_record);
     static void static_checkpoint();
 
     void set_global_lsn_(lsn_t lsn_){
@@ -480,6 +629,6 @@ private:
     std::atomic<lsn_t> global_lsn_{0};  // 全局lsn，递增，用于为每条记录分发lsn
     std::mutex latch_;                  // 用于对log_buffer_的互斥访问
     LogBuffer log_buffer_;              // 日志缓冲区
-    lsn_t persist_lsn_;                 // 记录已经持久化到磁盘中的最后一条日志的日志号
+    std::atomic<lsn_t> persist_lsn_{INVALID_LSN};   // 记录已经持久化到磁盘中的最后一条日志的日志号，后台写线程会并发读取
     DiskManager* disk_manager_;
 };
\ No newline at end of file
@@ -61,22 +61,7 @@ void RecoveryManager::undo() {
         delete *iter;
     }
 
-    //重建索引
-    for (auto &iter: this->sm_manager_->db_.get_tables()) {
-        std::vector<IndexMeta> t_indexes;
-        auto tab = iter.second;
-        for (auto &indexe: iter.second.indexes) {
-            t_indexes.emplace_back(indexe);
-        }
-        for (auto &t_index: t_indexes) {
-            sm_manager_->drop_index(t_index.tab_name, t_index.cols, nullptr);
-            std::vector<std::string> col_names;
-            for (auto &col: t_index.cols) {
-                col_names.emplace_back(col.name);
-            }
-            sm_manager_->create_index(t_index.tab_name, col_names, nullptr);
-        }
-    }
+    // 索引的修改已经和表的修改一起被redo/undo，不再重建索引
 
     delete[] this->buffer_;
 }
@@ -141,10 +126,14 @@ void RecoveryManager::RedoLog(LogRecord *log_record, lsn_t now_lsn) {
             }
             break;
         }
-        case IX_DELETE: {
-            break;
-        }
+        case IX_DELETE:
         case IX_INSERT: {
+            auto *ix_rec = dynamic_cast<IxLogRecord *>(log_record);
+            auto ih = this->sm_manager_->ihs_.find(ix_rec->index_name_);
+            // 之后被删除的索引不需要redo
+            if (ih != this->sm_manager_->ihs_.end()) {
+                ih->second->redo(ix_rec);
+            }
             break;
         }
         default: {
@@ -205,6 +194,21 @@ void RecoveryManager::UndoLog(LogRecord *log_record) {
             }
             break;
         }
+        case IX_DELETE:
+        case IX_INSERT: {
+            auto *ix_rec = dynamic_cast<IxLogRecord *>(log_record);
+            auto ih = this->sm_manager_->ihs_.find(ix_rec->index_name_);
+            if (this->undo_list.find(ix_rec->log_tid_) != this->undo_list.end() && ih != this->sm_manager_->ihs_.end()) {
+                // 以原事务的身份执行相反的操作，写入的日志记录保证undo的结果也能被redo
+                Transaction undo_txn(ix_rec->log_tid_);
+                if (ix_rec->log_type_ == IX_INSERT) {
+                    ih->second->delete_entry(ix_rec->key_.data(), &undo_txn);
+                } else {
+                    ih->second->insert_entry(ix_rec->key_.data(), ix_rec->rid_, &undo_txn);
+                }
+            }
+            break;
+        }
         default: {
             assert(0);
         }
@@ -264,6 +268,20 @@ void RecoveryManager::parseLog() {
                 offset += up_log_rec->log_tot_len_;
                 break;
             }
+            case IX_INSERT: {
+                auto *ix_ins_log_rec = new IxInsertLogRecord();
+                ix_ins_log_rec->deserialize(this->buffer_ + offset);
+                this->read_log_records.emplace_back(ix_ins_log_rec);
+                offset += ix_ins_log_rec->log_tot_len_;
+                break;
+            }
+            case IX_DELETE: {
+                auto *ix_del_log_rec = new IxDeleteLogRecord();
+                ix_del_log_rec->deserialize(this->buffer_ + offset);
+                this->read_log_records.emplace_back(ix_del_log_rec);
+                offset += ix_del_log_rec->log_tot_len_;
+                break;
+            }
             default: {
                 assert(0);
             }
@@ -0,0 +1,91 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "clock_replacer.h"
+
+ClockReplacer::ClockReplacer(size_t num_pages)
+    : num_frames_(num_pages), states_(new std::atomic<uint8_t>[num_pages]) {
+    for (size_t i = 0; i < num_frames_; i++) {
+        states_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+ClockReplacer::~ClockReplacer() = default;
+
+/**
+ * @description: 使用CLOCK策略删除一个victim frame，并返回该frame的id。
+ *              时钟指针依次检查各帧：跳过不可淘汰的帧，清除被访问过的帧的访问位，淘汰第一个没有访问位的可淘汰帧。
+ * @param {frame_id_t*} frame_id 被移除的frame的id，如果没有frame被移除返回nullptr
+ * @return {bool} 如果成功淘汰了一个页面则返回true，否则返回false
+ */
+bool ClockReplacer::victim(frame_id_t *frame_id) {
+    std::scoped_lock lock{hand_latch_};
+    // 转两圈以内必然能找到可淘汰的帧：第一圈清除所有访问位，第二圈淘汰；
+    // 其他线程可能在清除后重新设置访问位，因此只要还有可淘汰的帧就继续转动
+    while (size_.load(std::memory_order_acquire) > 0) {
+        for (size_t step = 0; step < 2 * num_frames_; step++) {
+            std::atomic<uint8_t> &state = states_[hand_];
+            frame_id_t frame = static_cast<frame_id_t>(hand_);
+            hand_ = hand_ + 1 == num_frames_ ? 0 : hand_ + 1;
+
+            uint8_t value = state.load(std::memory_order_acquire);
+            if (!(value & EVICTABLE)) {
+                continue;
+            }
+            if (value & REFERENCED) {
+                state.compare_exchange_strong(value, value & ~REFERENCED, std::memory_order_acq_rel);
+                continue;
+            }
+            // 帧的状态可能刚刚被pin修改，CAS失败时跳过该帧
+            if (state.compare_exchange_strong(value, 0, std::memory_order_acq_rel)) {
+                size_.fetch_sub(1, std::memory_order_acq_rel);
+                *frame_id = frame;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @description: 固定指定的frame，即该页面无法被淘汰
+ * @param {frame_id_t} 需要固定的frame的id
+ */
+void ClockReplacer::pin(frame_id_t frame_id) {
+    uint8_t prev = states_[frame_id].fetch_and(static_cast<uint8_t>(~EVICTABLE), std::memory_order_acq_rel);
+    if (prev & EVICTABLE) {
+        size_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+/**
+ * @description: 取消固定一个frame，代表该页面可以被淘汰，同时设置访问位
+ * @param {frame_id_t} frame_id 取消固定的frame的id
+ */
+void ClockReplacer::unpin(frame_id_t frame_id) {
+    uint8_t prev = states_[frame_id].fetch_or(EVICTABLE | REFERENCED, std::memory_order_acq_rel);
+    if (!(prev & EVICTABLE)) {
+        size_.fetch_add(1, std::memory_order_acq_rel);
+    }
+}
+
+/**
+ * @description: 记录一次对帧中页面的访问，设置访问位
+ * @param {frame_id_t} frame_id 被访问的帧
+ * @param {PageId&} page_id 帧中的页面，CLOCK不需要区分页面
+ */
+void ClockReplacer::record_access(frame_id_t frame_id, const PageId &page_id) {
+    states_[frame_id].fetch_or(REFERENCED, std::memory_order_acq_rel);
+}
+
+/**
+ * @description: 获取当前replacer中可以被淘汰的页面数量
+ */
+size_t ClockReplacer::Size() { return size_.load(std::memory_order_acquire); }
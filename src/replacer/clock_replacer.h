@@ -0,0 +1,53 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include "common/config.h"
+#include "replacer/replacer.h"
+
+/*
+ClockReplacer实现了CLOCK替换策略。每个帧的状态是一个原子变量，包含“可淘汰”和“最近被访问”两位，
+pin、unpin和record_access只修改对应帧的状态，不加锁也不分配内存；只有victim中移动时钟指针的过程需要互斥。
+*/
+class ClockReplacer : public Replacer {
+public:
+    /**
+     * @description: 创建一个新的ClockReplacer
+     * @param {size_t} num_pages ClockReplacer最多需要存储的page数量
+     */
+    explicit ClockReplacer(size_t num_pages);
+
+    ~ClockReplacer();
+
+    bool victim(frame_id_t *frame_id);
+
+    void pin(frame_id_t frame_id);
+
+    void unpin(frame_id_t frame_id);
+
+    void record_access(frame_id_t frame_id, const PageId &page_id);
+
+    size_t Size();
+
+private:
+    static constexpr uint8_t EVICTABLE = 1;     // 帧可以被淘汰
+    static constexpr uint8_t REFERENCED = 2;    // 帧在时钟指针上次经过之后被访问过
+
+    size_t num_frames_;
+    std::unique_ptr<std::atomic<uint8_t>[]> states_;    // 每个帧的状态位
+    std::atomic<size_t> size_{0};                       // 可淘汰的帧数
+    std::mutex hand_latch_;                             // 保护时钟指针
+    size_t hand_ = 0;                                   // 时钟指针，指向下一个检查的帧
+};
@@ -0,0 +1,151 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "lru_k_replacer.h"
+
+LRUKReplacer::LRUKReplacer(size_t num_pages, size_t k, size_t correlated_period)
+    : k_(k), correlated_period_(correlated_period), frames_(num_pages) {}
+
+LRUKReplacer::~LRUKReplacer() = default;
+
+/**
+ * @description: 计算帧在淘汰顺序中的位置，键越小越先被淘汰
+ * @return {pair<size_t, frame_id_t>} 访问不足K次时为最早一次访问的时间，否则为倒数第K次访问的时间
+ * @param {frame_id_t} frame_id 帧的id
+ */
+std::pair<size_t, frame_id_t> LRUKReplacer::evict_key(frame_id_t frame_id) const {
+    const FrameInfo &info = frames_[frame_id];
+    if (info.history.empty()) {
+        return {info.unpin_time, frame_id};
+    }
+    return {info.history.front(), frame_id};
+}
+
+void LRUKReplacer::add_evictable(frame_id_t frame_id) {
+    FrameInfo &info = frames_[frame_id];
+    info.evictable = true;
+    if (info.history.size() < k_) {
+        history_frames_.insert(evict_key(frame_id));
+    } else {
+        cache_frames_.insert(evict_key(frame_id));
+    }
+}
+
+void LRUKReplacer::remove_evictable(frame_id_t frame_id) {
+    FrameInfo &info = frames_[frame_id];
+    info.evictable = false;
+    if (info.history.size() < k_) {
+        history_frames_.erase(evict_key(frame_id));
+    } else {
+        cache_frames_.erase(evict_key(frame_id));
+    }
+}
+
+/**
+ * @description: 使用LRU-K策略删除一个victim frame，并返回该frame的id
+ * @param {frame_id_t*} frame_id 被移除的frame的id，如果没有frame被移除返回nullptr
+ * @return {bool} 如果成功淘汰了一个页面则返回true，否则返回false
+ */
+bool LRUKReplacer::victim(frame_id_t *frame_id) {
+    std::scoped_lock lock{latch_};
+
+    // 1.优先淘汰访问不足K次的帧，其倒数第K次访问距今为无穷大；
+    //   仍处于相关访问期内的帧正在被使用，跳过它们，每次访问最多使一个帧进入相关访问期，因此最多跳过correlated_period_个帧
+    frame_id_t frame = INVALID_FRAME_ID;
+    for (auto *frames: {&history_frames_, &cache_frames_}) {
+        for (auto &[key, candidate]: *frames) {
+            if (current_time_ - frames_[candidate].last_access > correlated_period_) {
+                frame = candidate;
+                break;
+            }
+        }
+        if (frame != INVALID_FRAME_ID) {
+            break;
+        }
+    }
+    // 2.所有帧都处于相关访问期内时，退化为按键淘汰
+    if (frame == INVALID_FRAME_ID) {
+        auto &frames = history_frames_.empty() ? cache_frames_ : history_frames_;
+        if (frames.empty()) {
+            return false;
+        }
+        frame = frames.begin()->second;
+    }
+    // 3.淘汰选中的帧，并清空它的访问历史
+    remove_evictable(frame);
+    frames_[frame] = FrameInfo();
+    *frame_id = frame;
+    return true;
+}
+
+/**
+ * @description: 固定指定的frame，即该页面无法被淘汰
+ * @param {frame_id_t} 需要固定的frame的id
+ */
+void LRUKReplacer::pin(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    if (frames_[frame_id].evictable) {
+        remove_evictable(frame_id);
+    }
+}
+
+/**
+ * @description: 取消固定一个frame，代表该页面可以被淘汰
+ * @param {frame_id_t} frame_id 取消固定的frame的id
+ */
+void LRUKReplacer::unpin(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    FrameInfo &info = frames_[frame_id];
+    if (info.evictable) {
+        return;
+    }
+    info.unpin_time = ++current_time_;
+    add_evictable(frame_id);
+}
+
+/**
+ * @description: 记录一次对帧中页面的访问。帧中换入了新页面时清空访问历史；
+ *              距上次访问不超过correlated_period_的访问为相关访问，只更新最近访问时间。
+ * @param {frame_id_t} frame_id 被访问的帧
+ * @param {PageId&} page_id 帧中的页面
+ */
+void LRUKReplacer::record_access(frame_id_t frame_id, const PageId &page_id) {
+    std::scoped_lock lock{latch_};
+    FrameInfo &info = frames_[frame_id];
+    bool evictable = info.evictable;
+    if (evictable) {
+        remove_evictable(frame_id);
+    }
+
+    size_t now = ++current_time_;
+    if (!(info.page_id == page_id)) {
+        info.page_id = page_id;
+        info.history.clear();
+    }
+    if (info.history.empty() || now - info.last_access > correlated_period_) {
+        info.history.push_back(now);
+        if (info.history.size() > k_) {
+            info.history.pop_front();
+        }
+    }
+    info.last_access = now;
+
+    if (evictable) {
+        add_evictable(frame_id);
+    }
+}
+
+/**
+ * @description: 获取当前replacer中可以被淘汰的页面数量
+ */
+size_t LRUKReplacer::Size() {
+    std::scoped_lock lock{latch_};
+    return history_frames_.size() + cache_frames_.size();
+}
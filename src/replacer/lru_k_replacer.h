@@ -0,0 +1,72 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "common/config.h"
+#include "replacer/replacer.h"
+
+/*
+LRUKReplacer实现了LRU-K替换策略：淘汰倒数第K次访问距今最久的页面，访问不足K次的页面优先淘汰。
+间隔不超过correlated_period次访问的重复访问视为同一次访问（例如扫描逐条读取同一页面中的记录），
+因此一次全表扫描读入的页面只有一次访问历史，会先于被反复访问的热点页面被淘汰。
+*/
+class LRUKReplacer : public Replacer {
+public:
+    /**
+     * @description: 创建一个新的LRUKReplacer
+     * @param {size_t} num_pages LRUKReplacer最多需要存储的page数量
+     * @param {size_t} k 保留的访问历史个数
+     * @param {size_t} correlated_period 相关访问的最大间隔
+     */
+    explicit LRUKReplacer(size_t num_pages, size_t k = LRU_K, size_t correlated_period = LRU_K_CORRELATED_PERIOD);
+
+    ~LRUKReplacer();
+
+    bool victim(frame_id_t *frame_id);
+
+    void pin(frame_id_t frame_id);
+
+    void unpin(frame_id_t frame_id);
+
+    void record_access(frame_id_t frame_id, const PageId &page_id);
+
+    size_t Size();
+
+private:
+    // 每个帧的访问历史
+    struct FrameInfo {
+        PageId page_id;                 // 帧中的页面，页面改变时清空访问历史
+        std::deque<size_t> history;     // 最近K次（非相关）访问的时间戳，从旧到新
+        size_t last_access = 0;         // 最近一次访问的时间戳，包括相关访问
+        size_t unpin_time = 0;          // 最近一次变为可淘汰的时间戳，用于没有访问历史的帧
+        bool evictable = false;
+    };
+
+    std::pair<size_t, frame_id_t> evict_key(frame_id_t frame_id) const;
+
+    void add_evictable(frame_id_t frame_id);
+
+    void remove_evictable(frame_id_t frame_id);
+
+    std::mutex latch_;                  // 互斥锁
+    size_t k_;
+    size_t correlated_period_;
+    size_t current_time_ = 0;           // 逻辑时钟，每次访问或unpin加一
+    std::vector<FrameInfo> frames_;
+    std::set<std::pair<size_t, frame_id_t>> history_frames_;    // 访问不足K次的可淘汰帧，按最早访问时间排序
+    std::set<std::pair<size_t, frame_id_t>> cache_frames_;      // 访问达到K次的可淘汰帧，按倒数第K次访问时间排序
+};
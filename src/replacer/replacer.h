@@ -11,6 +11,7 @@ See the Mulan PSL v2 for more details. */
 #pragma once
 
 #include "common/config.h"
+#include "storage/page.h"
 
 /**
  * Replacer is an abstract class that tracks page usage.
@@ -39,6 +40,14 @@ class Replacer {
      */
     virtual void unpin(frame_id_t frame_id) = 0;
 
+    /**
+     * Records an access to the page held by a frame. Policies that keep access history (LRU-K, 2Q) use it
+     * to tell hot pages from pages touched by a single scan; the default LRU policy ignores it.
+     * @param frame_id the id of the frame being accessed
+     * @param page_id the page held by the frame, a different page means the frame has been reused
+     */
+    virtual void record_access(frame_id_t frame_id, const PageId &page_id) {}
+
     /** @return the number of elements in the replacer that can be victimized */
     virtual size_t Size() = 0;
 };
@@ -0,0 +1,169 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "two_q_replacer.h"
+
+#include <algorithm>
+
+TwoQReplacer::TwoQReplacer(size_t num_pages, size_t a1in_size, size_t a1out_size)
+    : a1in_size_(a1in_size), a1out_size_(a1out_size), frames_(num_pages) {
+    // 未指定时按配置的比例计算队列大小
+    if (a1in_size_ == 0) {
+        a1in_size_ = std::max<size_t>(1, num_pages * TWO_Q_A1IN_PERCENT / 100);
+    }
+    if (a1out_size_ == 0) {
+        a1out_size_ = std::max<size_t>(1, num_pages * TWO_Q_A1OUT_PERCENT / 100);
+    }
+}
+
+TwoQReplacer::~TwoQReplacer() = default;
+
+std::set<std::pair<size_t, frame_id_t>> &TwoQReplacer::queue_of(const FrameInfo &info) {
+    return info.queue == Queue::AM ? am_ : a1in_;
+}
+
+void TwoQReplacer::add_evictable(frame_id_t frame_id) {
+    FrameInfo &info = frames_[frame_id];
+    info.evictable = true;
+    queue_of(info).emplace(info.time, frame_id);
+}
+
+void TwoQReplacer::remove_evictable(frame_id_t frame_id) {
+    FrameInfo &info = frames_[frame_id];
+    info.evictable = false;
+    queue_of(info).erase({info.time, frame_id});
+}
+
+/**
+ * @description: 把从A1in淘汰的页面记录到A1out，A1out已满时丢弃最旧的记录
+ * @param {PageId&} page_id 被淘汰的页面
+ */
+void TwoQReplacer::remember_evicted(const PageId &page_id) {
+    if (page_id.page_no == INVALID_PAGE_ID || a1out_hash_.count(page_id)) {
+        return;
+    }
+    a1out_.push_back(page_id);
+    a1out_hash_.emplace(page_id, std::prev(a1out_.end()));
+    if (a1out_.size() > a1out_size_) {
+        a1out_hash_.erase(a1out_.front());
+        a1out_.pop_front();
+    }
+}
+
+/**
+ * @description: 使用2Q策略删除一个victim frame，并返回该frame的id。
+ *              A1in超过目标大小或Am中没有可淘汰的帧时淘汰A1in中最早进入的帧，否则淘汰Am中最久未访问的帧。
+ * @param {frame_id_t*} frame_id 被移除的frame的id，如果没有frame被移除返回nullptr
+ * @return {bool} 如果成功淘汰了一个页面则返回true，否则返回false
+ */
+bool TwoQReplacer::victim(frame_id_t *frame_id) {
+    std::scoped_lock lock{latch_};
+
+    // 1.选择淘汰的队列
+    std::set<std::pair<size_t, frame_id_t>> *queue;
+    if (!a1in_.empty() && (a1in_count_ > a1in_size_ || am_.empty())) {
+        queue = &a1in_;
+    } else if (!am_.empty()) {
+        queue = &am_;
+    } else {
+        return false;
+    }
+    // 2.淘汰队列中最旧的帧，A1in中的页面记录到A1out
+    frame_id_t frame = queue->begin()->second;
+    FrameInfo &info = frames_[frame];
+    remove_evictable(frame);
+    if (info.queue == Queue::A1IN) {
+        a1in_count_--;
+        remember_evicted(info.page_id);
+    }
+    info = FrameInfo();
+    *frame_id = frame;
+    return true;
+}
+
+/**
+ * @description: 固定指定的frame，即该页面无法被淘汰
+ * @param {frame_id_t} 需要固定的frame的id
+ */
+void TwoQReplacer::pin(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    if (frames_[frame_id].evictable) {
+        remove_evictable(frame_id);
+    }
+}
+
+/**
+ * @description: 取消固定一个frame，代表该页面可以被淘汰。没有访问记录的帧（例如预读的页面）视为刚进入A1in。
+ * @param {frame_id_t} frame_id 取消固定的frame的id
+ */
+void TwoQReplacer::unpin(frame_id_t frame_id) {
+    std::scoped_lock lock{latch_};
+    FrameInfo &info = frames_[frame_id];
+    if (info.evictable) {
+        return;
+    }
+    if (info.queue == Queue::NONE) {
+        info.queue = Queue::A1IN;
+        info.time = ++current_time_;
+        a1in_count_++;
+    }
+    add_evictable(frame_id);
+}
+
+/**
+ * @description: 记录一次对帧中页面的访问。Am中的页面移到队尾；A1in中的页面保持不动；
+ *              新换入的页面若在A1out中有记录则进入Am，否则进入A1in。
+ * @param {frame_id_t} frame_id 被访问的帧
+ * @param {PageId&} page_id 帧中的页面
+ */
+void TwoQReplacer::record_access(frame_id_t frame_id, const PageId &page_id) {
+    std::scoped_lock lock{latch_};
+    FrameInfo &info = frames_[frame_id];
+    bool evictable = info.evictable;
+    if (evictable) {
+        remove_evictable(frame_id);
+    }
+
+    size_t now = ++current_time_;
+    if (info.queue != Queue::NONE && info.page_id == page_id) {
+        // 1.仍在缓冲池中的页面，只有Am中的页面更新访问时间
+        if (info.queue == Queue::AM) {
+            info.time = now;
+        }
+    } else {
+        // 2.帧中换入了新的页面
+        if (info.queue == Queue::A1IN) {
+            a1in_count_--;
+        }
+        info.page_id = page_id;
+        info.time = now;
+        auto iter = a1out_hash_.find(page_id);
+        if (iter != a1out_hash_.end()) {
+            a1out_.erase(iter->second);
+            a1out_hash_.erase(iter);
+            info.queue = Queue::AM;
+        } else {
+            info.queue = Queue::A1IN;
+            a1in_count_++;
+        }
+    }
+
+    if (evictable) {
+        add_evictable(frame_id);
+    }
+}
+
+/**
+ * @description: 获取当前replacer中可以被淘汰的页面数量
+ */
+size_t TwoQReplacer::Size() {
+    std::scoped_lock lock{latch_};
+    return a1in_.size() + am_.size();
+}
@@ -0,0 +1,78 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/config.h"
+#include "replacer/replacer.h"
+
+/*
+TwoQReplacer实现了2Q替换策略（完整版本）：
+第一次被访问的页面进入FIFO队列A1in，在A1in中的重复访问不改变其位置；从A1in淘汰的页面记录在幽灵队列A1out中，
+只有在A1out中的页面再次被访问时才进入LRU队列Am。一次全表扫描读入的页面只会经过A1in，不会挤出Am中的热点页面。
+*/
+class TwoQReplacer : public Replacer {
+public:
+    /**
+     * @description: 创建一个新的TwoQReplacer
+     * @param {size_t} num_pages TwoQReplacer最多需要存储的page数量
+     * @param {size_t} a1in_size A1in队列的目标大小
+     * @param {size_t} a1out_size A1out幽灵队列最多记录的页面数
+     */
+    explicit TwoQReplacer(size_t num_pages, size_t a1in_size = 0, size_t a1out_size = 0);
+
+    ~TwoQReplacer();
+
+    bool victim(frame_id_t *frame_id);
+
+    void pin(frame_id_t frame_id);
+
+    void unpin(frame_id_t frame_id);
+
+    void record_access(frame_id_t frame_id, const PageId &page_id);
+
+    size_t Size();
+
+private:
+    enum class Queue { NONE, A1IN, AM };
+
+    struct FrameInfo {
+        PageId page_id;             // 帧中的页面
+        Queue queue = Queue::NONE;  // 帧所在的队列
+        size_t time = 0;            // A1in中为进入队列的时间，Am中为最近一次访问的时间
+        bool evictable = false;
+    };
+
+    std::set<std::pair<size_t, frame_id_t>> &queue_of(const FrameInfo &info);
+
+    void add_evictable(frame_id_t frame_id);
+
+    void remove_evictable(frame_id_t frame_id);
+
+    void remember_evicted(const PageId &page_id);
+
+    std::mutex latch_;                  // 互斥锁
+    size_t a1in_size_;
+    size_t a1out_size_;
+    size_t a1in_count_ = 0;             // A1in中的帧数，包括被固定的帧
+    size_t current_time_ = 0;           // 逻辑时钟
+    std::vector<FrameInfo> frames_;
+    std::set<std::pair<size_t, frame_id_t>> a1in_;  // A1in中可淘汰的帧，按进入时间排序
+    std::set<std::pair<size_t, frame_id_t>> am_;    // Am中可淘汰的帧，按最近访问时间排序
+    std::list<PageId> a1out_;                       // 最近从A1in淘汰的页面，首部最旧
+    std::unordered_map<PageId, std::list<PageId>::iterator, PageIdHash> a1out_hash_;
+};
@@ -9,6 +9,7 @@ MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
 #include <cstdio>
+#include <cstdlib>
 #include <netinet/in.h>
 #include <readline/history.h>
 #include <readline/readline.h>
@@ -276,11 +277,31 @@ void start_server() {
 }
 
 int main(int argc, char **argv) {
-    if (argc != 2) {
+    if (argc < 2) {
         // 需要指定数据库名称
-        std::cerr << "Usage: " << argv[0] << " <database>" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " <database> [--io_uring] [--direct_io] [--buffer_pool_size=<pages>]" << std::endl;
         exit(1);
     }
+    // 解析启动选项
+    bool use_io_uring = false;
+    bool use_direct_io = false;
+    long buffer_pool_size = BUFFER_POOL_SIZE;
+    const std::string pool_size_option = "--buffer_pool_size=";
+    for (int i = 2; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--io_uring") {
+            use_io_uring = true;
+        } else if (option == "--direct_io") {
+            use_direct_io = true;
+        } else if (option.compare(0, pool_size_option.size(), pool_size_option) == 0 &&
+                   atol(option.c_str() + pool_size_option.size()) > 0) {
+            buffer_pool_size = atol(option.c_str() + pool_size_option.size());
+        } else {
+            std::cerr << "Unknown option: " << option << std::endl;
+            std::cerr << "Usage: " << argv[0] << " <database> [--io_uring] [--direct_io] [--buffer_pool_size=<pages>]" << std::endl;
+            exit(1);
+        }
+    }
 
     signal(SIGINT, sigint_handler);
     try {
@@ -295,6 +316,16 @@ int main(int argc, char **argv) {
                      "Welcome to RMDB!\n"
                      "Type 'help;' for help.\n"
                      "\n";
+        // 选择磁盘I/O后端，内核不支持io_uring时退回同步I/O
+        if (use_io_uring && !disk_manager->enable_io_uring()) {
+            std::cerr << "io_uring is not supported, fall back to synchronous I/O" << std::endl;
+        }
+        // 使用O_DIRECT时数据文件不再占用内核页缓存，省下的内存可以通过--buffer_pool_size交给缓冲池
+        disk_manager->set_direct_io(use_direct_io);
+        if (static_cast<size_t>(buffer_pool_size) != buffer_pool_manager->get_pool_size()) {
+            buffer_pool_manager->set_pool_size(buffer_pool_size);
+        }
+
         // Database name is passed by args
         std::string db_name = argv[1];
         if (!sm_manager->is_dir(db_name)) {
@@ -334,6 +365,10 @@ int main(int argc, char **argv) {
         recovery->redo();
         recovery->undo();
 
+        // 启动后台写线程，脏页只有在日志持久化之后才能写回；进程退出时先于全局对象析构停止该线程
+        buffer_pool_manager->start_background_writer([]() { return log_manager->get_persist_lsn_(); });
+        std::atexit([]() { buffer_pool_manager->stop_background_writer(); });
+
         // 开启服务端，开始接受客户端连接
         start_server();
     } catch (RMDBError &e) {
@@ -0,0 +1,593 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "buffer_pool_instance.h"
+
+BufferPoolInstance::BufferPoolInstance(size_t pool_size, Page *pages, DiskManager *disk_manager)
+    : pool_size_(pool_size), pages_(pages), disk_manager_(disk_manager) {
+    // 可以被Replacer改变
+    if (REPLACER_TYPE == "LRU_K")
+        replacer_ = new LRUKReplacer(pool_size_);
+    else if (REPLACER_TYPE == "2Q")
+        replacer_ = new TwoQReplacer(pool_size_);
+    else if (REPLACER_TYPE == "CLOCK")
+        replacer_ = new ClockReplacer(pool_size_);
+    else {
+        replacer_ = new LRUReplacer(pool_size_);
+    }
+    // 初始化时，所有的帧都在free_list_中
+    for (size_t i = 0; i < pool_size_; ++i) {
+        free_list_.emplace_back(static_cast<frame_id_t>(i));
+    }
+}
+
+BufferPoolInstance::~BufferPoolInstance() { delete replacer_; }
+
+/**
+ * @description: 从free_list或replacer中得到可淘汰帧页的 *frame_id
+ * @return {bool} true: 可替换帧查找成功 , false: 可替换帧查找失败
+ * @param {frame_id_t*} frame_id 帧页id指针,返回成功找到的可替换帧id
+ */
+bool BufferPoolInstance::find_victim_page(frame_id_t *frame_id) {
+    // 1.使用free_list_判断分片是否已满需要淘汰页面
+    if (!free_list_.empty()) {
+        *frame_id = free_list_.back();
+        free_list_.pop_back();
+        return true;
+    }
+
+    // 2.使用置换策略获得可替换帧
+    if (replacer_->victim(frame_id)) {
+        return true;
+    }
+    // 3.既没有空闲帧，也没有可替换帧
+    *frame_id = INVALID_FRAME_ID;
+    return false;
+}
+
+/**
+ * @description: 在持有latch_时为new_page_id预留帧，不进行任何磁盘I/O。
+ *              若帧中原页面为脏页，将其加入flushing_pages_，由调用者在释放锁后写回；
+ *              新页面以is_loading_状态发布到页表，其他线程会等待其读入完成。
+ * @param {Page*} page 预留的帧
+ * @param {PageId} new_page_id 新的page_id
+ * @param {frame_id_t} new_frame_id 新的帧frame_id
+ */
+void BufferPoolInstance::reserve_frame(Page *page, PageId new_page_id, frame_id_t new_frame_id) {
+    // 1.原页面从页表中移除，脏页在写回完成前记录在flushing_pages_中
+    auto iter = page_table_.find(page->id_);
+    if (iter != page_table_.end() && iter->second == new_frame_id) {
+        page_table_.erase(iter);
+        if (page->is_dirty_) {
+            flushing_pages_.insert(page->id_);
+        }
+    }
+
+    // 2.更新page id，固定该帧，标记为正在读入
+    page->id_ = new_page_id;
+    page->is_dirty_ = false;
+    page->pin_count_ = 1;
+    page->is_loading_ = true;
+    replacer_->pin(new_frame_id);
+    page_table_.emplace(new_page_id, new_frame_id);
+}
+
+/**
+ * @description: 预留帧后磁盘I/O失败时撤销预留，调用时必须持有latch_
+ * @param {Page*} page 预留的帧
+ * @param {frame_id_t} frame_id 预留的帧号
+ * @param {PageId} old_page_id 帧中原来的页面
+ * @param {bool} restore_old 原页面是否尚未写回磁盘，若是则把原页面恢复到该帧中
+ */
+void BufferPoolInstance::abort_reserve(Page *page, frame_id_t frame_id, PageId old_page_id, bool restore_old) {
+    page_table_.erase(page->id_);
+    flushing_pages_.erase(old_page_id);
+    page->is_loading_ = false;
+    page->pin_count_ = 0;
+    if (restore_old) {
+        page->id_ = old_page_id;
+        page->is_dirty_ = true;
+        page_table_.emplace(old_page_id, frame_id);
+        replacer_->unpin(frame_id);
+    } else {
+        page->id_.page_no = INVALID_PAGE_ID;
+        page->is_dirty_ = false;
+        free_list_.emplace_back(frame_id);
+    }
+    io_cv_.notify_all();
+}
+
+/**
+ * @description: 等待目标页面上正在进行的读入或写回完成，调用时必须持有latch_
+ * @param {unique_lock<mutex>&} lock 持有latch_的锁
+ * @param {PageId} page_id 目标页面
+ */
+void BufferPoolInstance::wait_for_io(std::unique_lock<std::mutex> &lock, PageId page_id) {
+    io_cv_.wait(lock, [&] {
+        if (flushing_pages_.count(page_id)) {
+            return false;
+        }
+        auto iter = page_table_.find(page_id);
+        return iter == page_table_.end() || !pages_[iter->second].is_loading_;
+    });
+}
+
+/**
+ * @description: 结束对帧的写回，调用时必须持有latch_。写回失败时重新置脏，没有线程固定该页时重新加入replacer
+ * @param {frame_id_t} frame_id 写回的帧
+ * @param {bool} failed 写回是否失败
+ */
+void BufferPoolInstance::finish_write(frame_id_t frame_id, bool failed) {
+    Page *page = &(pages_[frame_id]);
+    if (failed) {
+        page->is_dirty_ = true;
+    }
+    page->is_writing_ = false;
+    if (page->pin_count_ == 0) {
+        replacer_->unpin(frame_id);
+    }
+}
+
+/**
+ * @description: 从分片中获取需要的页。
+ *              如果页表中存在page_id（说明该page在缓冲池中），并且pin_count++。
+ *              如果页表不存在page_id，则预留一个帧，释放锁后写回原脏页并读入目标页，pin_count置1。
+ * @return {Page*} 若获得了需要的页则将其返回，否则返回nullptr
+ * @param {PageId} page_id 需要获取的页的PageId
+ */
+Page *BufferPoolInstance::fetch_page(PageId page_id) {
+    std::unique_lock<std::mutex> lock{latch_};
+    // 1.等待目标页上的I/O完成后，从page_table_中搜寻目标页
+    wait_for_io(lock, page_id);
+    auto iter = page_table_.find(page_id);
+    if (iter != page_table_.end()) {
+        auto frame = iter->second;
+        Page *page = &(pages_[frame]);
+        replacer_->record_access(frame, page_id);
+        replacer_->pin(frame);
+        page->pin_count_++;
+        return page;
+    }
+    // 2.尝试调用find_victim_page获得一个可用的frame，若失败则返回nullptr
+    frame_id_t frame;
+    if (!find_victim_page(&frame)) {
+        return nullptr;
+    }
+    // 3.预留frame并发布页表项，记录原页面是否需要写回
+    Page *page = &(pages_[frame]);
+    PageId old_page_id = page->id_;
+    bool need_flush = page->is_dirty_;
+    reserve_frame(page, page_id, frame);
+    replacer_->record_access(frame, page_id);
+    lock.unlock();
+
+    // 4.释放锁后写回原脏页，再读取目标页到frame
+    bool flushed = !need_flush;
+    try {
+        if (need_flush) {
+            disk_manager_->write_page(old_page_id.fd, old_page_id.page_no, page->data_, PAGE_SIZE);
+            flushed = true;
+        }
+        disk_manager_->read_page(page_id.fd, page_id.page_no, page->data_, PAGE_SIZE);
+    } catch (...) {
+        lock.lock();
+        abort_reserve(page, frame, old_page_id, !flushed);
+        throw;
+    }
+
+    // 5.公开目标页，唤醒等待该页面的线程
+    lock.lock();
+    if (need_flush) {
+        flushing_pages_.erase(old_page_id);
+    }
+    page->is_loading_ = false;
+    io_cv_.notify_all();
+    return page;
+}
+
+/**
+ * @description: 取消固定pin_count>0的在缓冲池中的page
+ * @return {bool} 如果目标页的pin_count<=0则返回false，否则返回true
+ * @param {PageId} page_id 目标page的page_id
+ * @param {bool} is_dirty 若目标page应该被标记为dirty则为true，否则为false
+ */
+bool BufferPoolInstance::unpin_page(PageId page_id, bool is_dirty) {
+    std::scoped_lock lock{latch_};
+    // 1. 尝试在page_table_中搜寻page_id对应的页P
+    auto iter = page_table_.find(page_id);
+    if (iter == page_table_.end()) {
+        return false;
+    }
+    auto frame = iter->second;
+    Page *page = &(pages_[frame]);
+
+    // 2.1 若pin_count_已经等于0，则返回false
+    if (page->pin_count_ <= 0) {
+        return false;
+    }
+    // 2.2 若pin_count_大于0，则pin_count_自减一
+    page->pin_count_--;
+    if (page->pin_count_ == 0 && !page->is_writing_) {
+        // 2.2.1 若自减后等于0且没有在写回，则调用replacer_的unpin
+        replacer_->unpin(frame);
+    }
+    // 3 根据参数is_dirty，更改P的is_dirty_
+    if (is_dirty) {
+        page->is_dirty_ = true;
+    }
+    return true;
+}
+
+/**
+ * @description: 将目标页写回磁盘，不考虑当前页面是否正在被使用。写回期间该帧不可被淘汰，但仍可以被其他线程读取。
+ * @return {bool} 成功则返回true，否则返回false(只有page_table_中没有目标页时)
+ * @param {PageId} page_id 目标页的page_id，不能为INVALID_PAGE_ID
+ */
+bool BufferPoolInstance::flush_page(PageId page_id) {
+    std::unique_lock<std::mutex> lock{latch_};
+    assert(page_id.page_no != INVALID_PAGE_ID);
+
+    // 1.等待目标页上其他I/O完成，目标页P没有被page_table_记录则返回false
+    io_cv_.wait(lock, [&] {
+        auto iter = page_table_.find(page_id);
+        return iter == page_table_.end() ||
+               (!pages_[iter->second].is_loading_ && !pages_[iter->second].is_writing_);
+    });
+    auto iter = page_table_.find(page_id);
+    if (iter == page_table_.end()) {
+        return false;
+    }
+    auto frame = iter->second;
+    Page *page = &(pages_[frame]);
+
+    // 2. 标记为正在写回并移出replacer，写回期间新的修改会重新把页面置脏
+    page->is_writing_ = true;
+    page->is_dirty_ = false;
+    replacer_->pin(frame);
+    lock.unlock();
+
+    // 3. 无论P是否为脏都将其写回磁盘
+    try {
+        disk_manager_->write_page(page_id.fd, page_id.page_no, page->data_, PAGE_SIZE);
+    } catch (...) {
+        lock.lock();
+        finish_write(frame, true);
+        io_cv_.notify_all();
+        throw;
+    }
+
+    // 4. 写回完成，若没有线程固定该页则重新加入replacer
+    lock.lock();
+    finish_write(frame, false);
+    io_cv_.notify_all();
+    return true;
+}
+
+/**
+ * @description: 为已经在磁盘上分配好的page_id创建一个新的page
+ * @return {Page*} 返回新创建的page，若创建失败则返回nullptr
+ * @param {PageId} page_id 新page的page_id
+ */
+Page *BufferPoolInstance::new_page(PageId page_id) {
+    std::unique_lock<std::mutex> lock{latch_};
+
+    // 0.页号可能是复用的已释放页面，缓冲池中残留的旧副本（如被扫描读入）直接在原帧上重新初始化
+    io_cv_.wait(lock, [&] {
+        if (flushing_pages_.count(page_id)) {
+            return false;
+        }
+        auto iter = page_table_.find(page_id);
+        return iter == page_table_.end() ||
+               (!pages_[iter->second].is_loading_ && !pages_[iter->second].is_writing_);
+    });
+    auto iter = page_table_.find(page_id);
+    if (iter != page_table_.end()) {
+        Page *page = &(pages_[iter->second]);
+        if (page->pin_count_ != 0) {
+            return nullptr;
+        }
+        page->reset_memory();
+        page->is_dirty_ = false;
+        page->pin_count_ = 1;
+        replacer_->record_access(iter->second, page_id);
+        replacer_->pin(iter->second);
+        return page;
+    }
+
+    // 1.获得一个可用的frame，若无法获得则返回nullptr
+    frame_id_t frame;
+    if (!find_victim_page(&frame)) {
+        return nullptr;
+    }
+
+    // 2.预留frame，原脏页在释放锁后写回磁盘
+    Page *page = &(pages_[frame]);
+    PageId old_page_id = page->id_;
+    bool need_flush = page->is_dirty_;
+    reserve_frame(page, page_id, frame);
+    replacer_->record_access(frame, page_id);
+    lock.unlock();
+
+    try {
+        if (need_flush) {
+            disk_manager_->write_page(old_page_id.fd, old_page_id.page_no, page->data_, PAGE_SIZE);
+        }
+    } catch (...) {
+        lock.lock();
+        abort_reserve(page, frame, old_page_id, true);
+        throw;
+    }
+    page->reset_memory();
+
+    // 3.公开新页面，pin_count_已经在reserve_frame中置为1
+    lock.lock();
+    if (need_flush) {
+        flushing_pages_.erase(old_page_id);
+    }
+    page->is_loading_ = false;
+    io_cv_.notify_all();
+    return page;
+}
+
+/**
+ * @description: 从分片删除目标页
+ * @return {bool} 如果目标页不存在于分片或者成功被删除则返回true，若其存在于分片但无法删除则返回false
+ * @param {PageId} page_id 目标页
+ */
+bool BufferPoolInstance::delete_page(PageId page_id) {
+    std::unique_lock<std::mutex> lock{latch_};
+    // 1.等待目标页上的I/O完成，在page_table_中查找目标页，若不存在返回true
+    io_cv_.wait(lock, [&] {
+        if (flushing_pages_.count(page_id)) {
+            return false;
+        }
+        auto iter = page_table_.find(page_id);
+        return iter == page_table_.end() ||
+               (!pages_[iter->second].is_loading_ && !pages_[iter->second].is_writing_);
+    });
+    auto iter = page_table_.find(page_id);
+    if (iter == page_table_.end()) {
+        return true;
+    }
+    // 2.若目标页的pin_count不为0，则返回false
+    auto frame = iter->second;
+    Page *page = &(pages_[frame]);
+    if (page->pin_count_ != 0) {
+        return false;
+    }
+    // 3.从页表和replacer中删除目标页，释放锁后将目标页数据写回磁盘
+    page_table_.erase(iter);
+    replacer_->pin(frame);
+    flushing_pages_.insert(page_id);
+    lock.unlock();
+
+    try {
+        disk_manager_->write_page(page_id.fd, page_id.page_no, page->data_, PAGE_SIZE);
+    } catch (...) {
+        lock.lock();
+        flushing_pages_.erase(page_id);
+        page_table_.emplace(page_id, frame);
+        replacer_->unpin(frame);
+        io_cv_.notify_all();
+        throw;
+    }
+
+    // 4.重置其元数据，将其加入free_list_，返回true
+    lock.lock();
+    page->reset_memory();
+    page->id_.page_no = INVALID_PAGE_ID;
+    page->is_dirty_ = false;
+    page->pin_count_ = 0;
+    flushing_pages_.erase(page_id);
+    free_list_.emplace_back(frame);
+    io_cv_.notify_all();
+
+    return true;
+}
+
+/**
+ * @description: 将分片中属于fd的所有页写回到磁盘，写回在释放锁后进行
+ * @param {int} fd 文件句柄
+ */
+void BufferPoolInstance::flush_all_pages(int fd) {
+    std::unique_lock<std::mutex> lock{latch_};
+    // 1.收集fd的所有页面并标记为正在写回
+    std::vector<frame_id_t> frames;
+    for (auto &[page_id, frame]: page_table_) {
+        Page *page = &(pages_[frame]);
+        if (page_id.fd == fd && !page->is_loading_ && !page->is_writing_) {
+            page->is_writing_ = true;
+            page->is_dirty_ = false;
+            replacer_->pin(frame);
+            frames.push_back(frame);
+        }
+    }
+    lock.unlock();
+
+    // 2.释放锁后批量写回，页号相邻的页面合并为一次系统调用，出错时所有页面重新置脏
+    std::vector<std::pair<page_id_t, const char *>> batch;
+    batch.reserve(frames.size());
+    for (auto frame: frames) {
+        batch.emplace_back(pages_[frame].id_.page_no, pages_[frame].data_);
+    }
+    auto finish = [&](bool failed) {
+        for (auto frame: frames) {
+            finish_write(frame, failed);
+        }
+        io_cv_.notify_all();
+    };
+    try {
+        disk_manager_->write_pages(fd, batch);
+    } catch (...) {
+        lock.lock();
+        finish(true);
+        throw;
+    }
+    lock.lock();
+    finish(false);
+
+    // 3.等待其他线程对fd页面的写回完成，保证返回后fd可以被安全关闭
+    io_cv_.wait(lock, [&] {
+        for (auto &page_id: flushing_pages_) {
+            if (page_id.fd == fd) {
+                return false;
+            }
+        }
+        for (auto &[page_id, frame]: page_table_) {
+            if (page_id.fd == fd && pages_[frame].is_writing_) {
+                return false;
+            }
+        }
+        return true;
+    });
+}
+
+/**
+ * @description: 将分片中属于fd的所有页丢弃，不写回磁盘
+ * @param {int} fd 文件句柄
+ */
+void BufferPoolInstance::delete_all_pages(int fd) {
+    std::unique_lock<std::mutex> lock{latch_};
+    // 等待fd页面上的I/O全部完成
+    io_cv_.wait(lock, [&] {
+        for (auto &page_id: flushing_pages_) {
+            if (page_id.fd == fd) {
+                return false;
+            }
+        }
+        for (auto &[page_id, frame]: page_table_) {
+            if (page_id.fd == fd && (pages_[frame].is_loading_ || pages_[frame].is_writing_)) {
+                return false;
+            }
+        }
+        return true;
+    });
+
+    std::vector<PageId> to_be_deleted;
+    for (auto &[page_id, frame]: page_table_) {
+        if (page_id.fd == fd) {
+            to_be_deleted.push_back(page_id);
+        }
+    }
+
+    for (auto page_id: to_be_deleted) {
+        auto frame = page_table_[page_id];
+        // 无论该页面是否还被固定，都将其移出replacer
+        replacer_->pin(frame);
+        // 从页表中删除该页面并添加到free_list中
+        Page *page = &(pages_[frame]);
+        page->reset_memory();
+        page->id_.page_no = INVALID_PAGE_ID;
+        page->is_dirty_ = false;
+        page->pin_count_ = 0;
+
+        page_table_.erase(page_id);
+        free_list_.emplace_back(frame);
+    }
+}
+
+/**
+ * @description: 为预读的页面预留帧。页面已经在分片中、正在写回，或者分片中没有可替换帧时放弃预读，
+ *              预读不应该阻塞，也不应该挤占被固定的页面。
+ * @return {Page*} 预留的帧，放弃预读时返回nullptr
+ * @param {PageId} page_id 需要预读的页面
+ * @param {PageId*} old_page_id 返回帧中原来的页面
+ * @param {bool*} need_flush 返回原页面是否为脏页，若是则调用者需要先将其写回
+ */
+Page *BufferPoolInstance::reserve_prefetch_frame(PageId page_id, PageId *old_page_id, bool *need_flush) {
+    std::scoped_lock lock{latch_};
+    if (page_table_.count(page_id) || flushing_pages_.count(page_id)) {
+        return nullptr;
+    }
+    frame_id_t frame;
+    if (!find_victim_page(&frame)) {
+        return nullptr;
+    }
+    Page *page = &(pages_[frame]);
+    *old_page_id = page->id_;
+    *need_flush = page->is_dirty_;
+    reserve_frame(page, page_id, frame);
+    return page;
+}
+
+/**
+ * @description: 预读的I/O结束后公开页面。预读成功时释放预留时的固定，页面进入replacer等待被扫描使用；
+ *              失败时撤销预留，之后的fetch_page会重新同步读取该页面。
+ * @param {Page*} page reserve_prefetch_frame预留的帧
+ * @param {PageId} old_page_id 帧中原来的页面
+ * @param {bool} need_flush 原页面是否需要写回
+ * @param {bool} flushed 原页面是否已经写回
+ * @param {bool} loaded 目标页面是否已经读入
+ */
+void BufferPoolInstance::finish_prefetch(Page *page, PageId old_page_id, bool need_flush, bool flushed, bool loaded) {
+    std::scoped_lock lock{latch_};
+    auto frame = static_cast<frame_id_t>(page - pages_);
+    if (!loaded) {
+        abort_reserve(page, frame, old_page_id, need_flush && !flushed);
+        return;
+    }
+    if (need_flush) {
+        flushing_pages_.erase(old_page_id);
+    }
+    page->is_loading_ = false;
+    page->pin_count_--;
+    if (page->pin_count_ == 0) {
+        replacer_->unpin(frame);
+    }
+    io_cv_.notify_all();
+}
+
+/**
+ * @description: 后台写线程调用，当分片中空闲帧与干净的可淘汰帧少于BACKGROUND_WRITER_CLEAN_PERCENT时，挑选未被固定的脏页标记为正在写回。
+ *              页面LSN大于已持久化的日志LSN的脏页不能先于日志写回，留在缓冲池中等待下一轮。
+ * @return {vector<Page*>} 需要写回的页面，写回后调用finish_background_write
+ * @param {lsn_t} flushed_lsn 已经持久化的最后一条日志的LSN
+ */
+std::vector<Page *> BufferPoolInstance::begin_background_write(lsn_t flushed_lsn) {
+    std::scoped_lock lock{latch_};
+    size_t target_clean = std::max<size_t>(1, pool_size_ * BACKGROUND_WRITER_CLEAN_PERCENT / 100);
+    // 1.统计空闲帧和干净的可淘汰帧
+    size_t clean = free_list_.size();
+    for (size_t i = 0; i < pool_size_ && clean < target_clean; i++) {
+        Page *page = &(pages_[i]);
+        if (page->id_.page_no != INVALID_PAGE_ID && page->pin_count_ == 0 && !page->is_dirty_ &&
+            !page->is_loading_ && !page->is_writing_) {
+            clean++;
+        }
+    }
+
+    // 2.从上次停下的位置继续挑选可以写回的脏页
+    std::vector<Page *> pages;
+    for (size_t i = 0; i < pool_size_ && clean + pages.size() < target_clean; i++) {
+        auto frame = static_cast<frame_id_t>(writer_cursor_);
+        writer_cursor_ = (writer_cursor_ + 1) % pool_size_;
+        Page *page = &(pages_[frame]);
+        if (page->id_.page_no == INVALID_PAGE_ID || page->pin_count_ != 0 || !page->is_dirty_ ||
+            page->is_loading_ || page->is_writing_ || page->get_page_lsn() > flushed_lsn) {
+            continue;
+        }
+        page->is_writing_ = true;
+        page->is_dirty_ = false;
+        replacer_->pin(frame);
+        pages.push_back(page);
+    }
+    return pages;
+}
+
+/**
+ * @description: 后台写线程写回页面之后调用，公开页面并唤醒等待写回完成的线程
+ * @param {Page*} page begin_background_write返回的页面
+ * @param {bool} failed 写回是否失败
+ */
+void BufferPoolInstance::finish_background_write(Page *page, bool failed) {
+    std::scoped_lock lock{latch_};
+    finish_write(static_cast<frame_id_t>(page - pages_), failed);
+    io_cv_.notify_all();
+}
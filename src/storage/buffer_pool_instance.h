@@ -0,0 +1,86 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "disk_manager.h"
+#include "errors.h"
+#include "page.h"
+#include "replacer/clock_replacer.h"
+#include "replacer/lru_k_replacer.h"
+#include "replacer/lru_replacer.h"
+#include "replacer/two_q_replacer.h"
+#include "replacer/replacer.h"
+
+/**
+ * @description: 缓冲池的一个分片。BufferPoolManager按PageId的哈希值将页面分配到各个分片，
+ * 每个分片拥有独立的页表、空闲帧链表、置换策略和锁。
+ * 磁盘I/O不在分片锁内进行：缺页时先预留帧并发布页表项，释放锁后再读写磁盘，读完后再公开页面。
+ */
+class BufferPoolInstance {
+   private:
+    size_t pool_size_;      // 当前分片中帧的个数
+    Page *pages_;           // 当前分片的帧数组，指向BufferPoolManager中连续内存的一段，不由分片释放
+    std::unordered_map<PageId, frame_id_t, PageIdHash> page_table_; // 页面号到分片内帧号的映射
+    std::list<frame_id_t> free_list_;   // 空闲帧编号的链表
+    std::unordered_set<PageId, PageIdHash> flushing_pages_;    // 已经从页表中移除、但仍在写回磁盘的页面
+    DiskManager *disk_manager_;
+    Replacer *replacer_;    // 当前分片的置换策略
+    std::mutex latch_;      // 用于分片内共享数据结构的并发控制
+    std::condition_variable io_cv_;     // 页面I/O完成时唤醒等待该页面的线程
+    size_t writer_cursor_ = 0;          // 后台写线程下一次开始检查的帧
+
+   public:
+    BufferPoolInstance(size_t pool_size, Page *pages, DiskManager *disk_manager);
+
+    ~BufferPoolInstance();
+
+    Page* fetch_page(PageId page_id);
+
+    bool unpin_page(PageId page_id, bool is_dirty);
+
+    bool flush_page(PageId page_id);
+
+    Page* new_page(PageId page_id);
+
+    bool delete_page(PageId page_id);
+
+    void flush_all_pages(int fd);
+
+    void delete_all_pages(int fd);
+
+    Page* reserve_prefetch_frame(PageId page_id, PageId* old_page_id, bool* need_flush);
+
+    void finish_prefetch(Page* page, PageId old_page_id, bool need_flush, bool flushed, bool loaded);
+
+    std::vector<Page*> begin_background_write(lsn_t flushed_lsn);
+
+    void finish_background_write(Page* page, bool failed);
+
+   private:
+    bool find_victim_page(frame_id_t* frame_id);
+
+    void reserve_frame(Page* page, PageId new_page_id, frame_id_t new_frame_id);
+
+    void abort_reserve(Page* page, frame_id_t frame_id, PageId old_page_id, bool restore_old);
+
+    void wait_for_io(std::unique_lock<std::mutex> &lock, PageId page_id);
+
+    void finish_write(frame_id_t frame_id, bool failed);
+};
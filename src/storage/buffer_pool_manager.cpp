@@ -11,81 +11,56 @@ See the Mulan PSL v2 for more details. */
 #include "buffer_pool_manager.h"
 
 /**
- * @description: 从free_list或replacer中得到可淘汰帧页的 *frame_id
- * @return {bool} true: 可替换帧查找成功 , false: 可替换帧查找失败
- * @param {frame_id_t*} frame_id 帧页id指针,返回成功找到的可替换帧id
+ * @description: 按pool_size_申请帧内存和描述符，并把帧划分给各个分片
  */
-bool BufferPoolManager::find_victim_page(frame_id_t *frame_id) {
-    // 1.使用BufferPoolManager::free_list_判断缓冲池是否已满需要淘汰页面
-    if (!free_list_.empty()) {
-        *frame_id = free_list_.back();
-        free_list_.pop_back();
-        return true;
+void BufferPoolManager::init_frames() {
+    // 页面数据放在一块连续的大页内存中，描述符数组单独分配
+    arena_ = std::make_unique<FrameArena>(pool_size_);
+    pages_ = new Page[pool_size_];
+    for (size_t i = 0; i < pool_size_; ++i) {
+        pages_[i].data_ = arena_->get_frame(i);
     }
-
-    // 2.使用lru算法获得可替换帧
-    if (replacer_->victim(frame_id)) {
-        return true;
+    // 每个分片至少管理BUFFER_POOL_MIN_INSTANCE_SIZE个帧，小缓冲池退化为单个分片
+    size_t num_instances = std::clamp<size_t>(pool_size_ / BUFFER_POOL_MIN_INSTANCE_SIZE, 1, BUFFER_POOL_INSTANCES);
+    size_t offset = 0;
+    for (size_t i = 0; i < num_instances; ++i) {
+        size_t instance_size = pool_size_ / num_instances + (i < pool_size_ % num_instances ? 1 : 0);
+        instances_.emplace_back(std::make_unique<BufferPoolInstance>(instance_size, pages_ + offset, disk_manager_));
+        offset += instance_size;
     }
-    // 3.既没有空闲帧，也没有可替换帧
-    *frame_id = INVALID_FRAME_ID;
-    return false;
 }
 
 /**
- * @description: 更新页面数据, 如果为脏页则需写入磁盘，再更新为新页面，更新page元数据(data, is_dirty, page_id)和page table
- * @param {Page*} page 写回页指针
- * @param {PageId} new_page_id 新的page_id
- * @param {frame_id_t} new_frame_id 新的帧frame_id
+ * @description: 在运行时调整缓冲池的帧个数，用于启动时根据参数设置缓冲池大小。
+ *              只能在没有页面被固定、也没有脏页时调用，且后台预读和写线程都不能在运行，缓冲池中已有的干净页面会被丢弃
+ * @param {size_t} pool_size 新的帧个数
  */
-void BufferPoolManager::update_page(Page *page, PageId new_page_id, frame_id_t new_frame_id) {
-    // 1.如果是脏页，写回磁盘，并且把dirty置为false
-    if (page->is_dirty_) {
-        disk_manager_->write_page(page->id_.fd, page->id_.page_no, page->data_, PAGE_SIZE);
+void BufferPoolManager::set_pool_size(size_t pool_size) {
+    if (pool_size == 0) {
+        throw InternalError("BufferPoolManager::set_pool_size Error: pool size must be positive");
     }
-    // 2.更新page table
-    page_table_.erase(page->id_);
-
-    // 3.重置page的data，更新page id
-    page->id_ = new_page_id;
-    page->is_dirty_ = false;
-    page->reset_memory();
-    page->pin_count_ = 0;
-    page_table_.emplace(new_page_id, new_frame_id);
+    if (prefetch_thread_.joinable() || writer_thread_.joinable()) {
+        throw InternalError("BufferPoolManager::set_pool_size Error: background threads are running");
+    }
+    for (size_t i = 0; i < pool_size_; ++i) {
+        if (pages_[i].pin_count_ > 0 || pages_[i].is_dirty_) {
+            throw InternalError("BufferPoolManager::set_pool_size Error: buffer pool is in use");
+        }
+    }
+    instances_.clear();
+    delete[] pages_;
+    arena_.reset();
+    pool_size_ = pool_size;
+    init_frames();
 }
 
 /**
- * @description: 从buffer pool获取需要的页。
- *              如果页表中存在page_id（说明该page在缓冲池中），并且pin_count++。
- *              如果页表不存在page_id（说明该page在磁盘中），则找缓冲池victim page，将其替换为磁盘中读取的page，pin_count置1。
+ * @description: 从buffer pool获取需要的页，由page_id所属的分片负责
  * @return {Page*} 若获得了需要的页则将其返回，否则返回nullptr
  * @param {PageId} page_id 需要获取的页的PageId
  */
 Page *BufferPoolManager::fetch_page(PageId page_id) {
-    std::scoped_lock lock{latch_};
-    // 1.从page_table_中搜寻目标页
-    if (page_table_.count(page_id)) {
-        auto frame = page_table_[page_id];
-        Page *page = &(pages_[frame]);
-        replacer_->pin(frame);
-        page->pin_count_++;
-        return page;
-    }
-    // 2.尝试调用find_victim_page获得一个可用的frame，若失败则返回nullptr
-    frame_id_t frame;
-    if (!find_victim_page(&frame)) {
-        return nullptr;
-    }
-    // 3.若获得的可用frame存储的为dirty page，则须调用update_page将page写回到磁盘
-    Page *page = &(pages_[frame]);
-    update_page(page, page_id, frame);
-    // 4.调用disk_manager_的read_page读取目标页到frame
-    disk_manager_->read_page(page_id.fd, page_id.page_no, page->data_, PAGE_SIZE);
-    // 5.固定目标页，更新pin_count_
-    replacer_->pin(frame);
-    page->pin_count_ = 1;
-    // 6.返回目标页
-    return page;
+    return get_instance(page_id)->fetch_page(page_id);
 }
 
 /**
@@ -95,29 +70,7 @@ Page *BufferPoolManager::fetch_page(PageId page_id) {
  * @param {bool} is_dirty 若目标page应该被标记为dirty则为true，否则为false
  */
 bool BufferPoolManager::unpin_page(PageId page_id, bool is_dirty) {
-    std::scoped_lock lock{latch_};
-    if (!page_table_.count(page_id)) {
-        return false;
-    }
-    // 1. 尝试在page_table_中搜寻page_id对应的页P
-    auto frame = page_table_[page_id];
-    Page *page = &(pages_[frame]);
-
-    // 2.1 若pin_count_已经等于0，则返回false
-    if (page->pin_count_ <= 0) {
-        return false;
-    }
-    // 2.2 若pin_count_大于0，则pin_count_自减一
-    page->pin_count_--;
-    if (page->pin_count_ == 0) {
-        // 2.2.1 若自减后等于0，则调用replacer_的unpin
-        replacer_->unpin(frame);
-    }
-    // 3 根据参数is_dirty，更改P的is_dirty_
-    if (is_dirty) {
-        page->is_dirty_ = true;
-    }
-    return true;
+    return get_instance(page_id)->unpin_page(page_id, is_dirty);
 }
 
 /**
@@ -126,51 +79,29 @@ bool BufferPoolManager::unpin_page(PageId page_id, bool is_dirty) {
  * @param {PageId} page_id 目标页的page_id，不能为INVALID_PAGE_ID
  */
 bool BufferPoolManager::flush_page(PageId page_id) {
-    std::scoped_lock lock{latch_};
-    assert(page_id.page_no != INVALID_PAGE_ID);
-
-    // 1.目标页P没有被page_table_记录 ，返回false
-    if (page_table_.count(page_id) == 0) {
-        return false;
-    }
-    // 1.1 查找页表,尝试获取目标页P
-    auto frame = page_table_[page_id];
-    Page *page = &(pages_[frame]);
-
-    // 2. 无论P是否为脏都将其写回磁盘
-    disk_manager_->write_page(page->id_.fd, page->id_.page_no, page->data_, PAGE_SIZE);
-
-    // 3. 更新P的is_dirty_
-    page->is_dirty_ = false;
-    return true;
+    return get_instance(page_id)->flush_page(page_id);
 }
 
 /**
  * @description: 创建一个新的page，即从磁盘中移动一个新建的空page到缓冲池某个位置。
+ *              页号决定了页面所属的分片，因此先在磁盘上分配页号，再由对应分片分配帧。
  * @return {Page*} 返回新创建的page，若创建失败则返回nullptr
  * @param {PageId*} page_id 当成功创建一个新的page时存储其page_id
  */
 Page *BufferPoolManager::new_page(PageId *page_id) {
-    std::scoped_lock lock{latch_};
-
-    // 1.获得一个可用的frame，若无法获得则返回nullptr
-    frame_id_t frame;
-    if (!find_victim_page(&frame)) {
-        return nullptr;
-    }
-    // 2.在fd对应的文件分配一个新的page_id
+    // 1.在fd对应的文件分配一个新的page_id
     page_id->page_no = disk_manager_->allocate_page(page_id->fd);
 
-    // 3.将frame的数据写回磁盘
-    Page *page = &(pages_[frame]);
-    update_page(page, *page_id, frame);
-
-    // 4.固定frame，更新pin_count_
-    replacer_->pin(frame);
-    page->pin_count_ = 1;
+    // 2.由page_id所属的分片分配帧，若分片中所有帧都被固定则返回nullptr
+    return get_instance(*page_id)->new_page(*page_id);
+}
 
-    // 5.返回获得的page
-    return page;
+/**
+ * @description: 为调用者已经通过DiskManager::allocate_page_at分配好的页号创建新页面，页面内容全部清零
+ * @param {PageId} page_id 新页面的page_id
+ */
+Page *BufferPoolManager::new_page_at(PageId page_id) {
+    return get_instance(page_id)->new_page(page_id);
 }
 
 /**
@@ -179,65 +110,258 @@ Page *BufferPoolManager::new_page(PageId *page_id) {
  * @param {PageId} page_id 目标页
  */
 bool BufferPoolManager::delete_page(PageId page_id) {
-    std::scoped_lock lock{latch_};
-    // 1.在page_table_中查找目标页，若不存在返回true
-    if (!page_table_.count(page_id)) {
-        return true;
+    return get_instance(page_id)->delete_page(page_id);
+}
+
+/**
+ * @description: 将buffer_pool中的所有页写回到磁盘
+ * @param {int} fd 文件句柄
+ */
+void BufferPoolManager::flush_all_pages(int fd) {
+    cancel_read_ahead(fd);
+    for (auto &instance: instances_) {
+        instance->flush_all_pages(fd);
     }
-    // 2.若目标页的pin_count不为0，则返回false
-    auto frame = page_table_[page_id];
-    Page *page = &(pages_[frame]);
-    if (page->pin_count_ != 0) {
-        return false;
+}
+
+/**
+ * @description: 将buffer_pool中属于fd的所有页丢弃
+ * @param {int} fd 文件句柄
+ */
+void BufferPoolManager::delete_all_pages(int fd) {
+    cancel_read_ahead(fd);
+    for (auto &instance: instances_) {
+        instance->delete_all_pages(fd);
     }
-    // 3.将目标页数据写回磁盘，从页表中删除目标页，重置其元数据，将其加入free_list_，返回true
-    disk_manager_->write_page(page_id.fd, page_id.page_no, page->data_, PAGE_SIZE);
+}
 
-    page->reset_memory();
-    page->is_dirty_ = false;
-    page->pin_count_ = 0;
+/**
+ * @description: 扫描进入新页面时给出的预读提示。访问保持顺序时逐步扩大预读窗口，
+ *              当已预读而尚未访问的页面不足半个窗口时，把后续页面交给后台线程读入缓冲池。
+ * @param {PageId} page_id 扫描当前访问的页面
+ * @param {page_id_t} end_page_no 可以预读的页号上界（不含），通常为文件的页面数
+ * @param {ReadAheadState*} state 扫描的预读状态
+ */
+void BufferPoolManager::read_ahead(PageId page_id, page_id_t end_page_no, ReadAheadState *state) {
+    page_id_t page_no = page_id.page_no;
+    // 1.跳跃访问时清空预读窗口，等待下一次顺序访问
+    bool sequential = page_no == state->next_page_no;
+    state->next_page_no = page_no + 1;
+    if (!sequential) {
+        state->window = 0;
+        state->prefetched_end = page_no + 1;
+        return;
+    }
 
-    page_table_.erase(page_id);
-    free_list_.emplace_back(frame);
+    // 2.预读的页面还剩半个窗口以上时不需要新的预读
+    if (state->prefetched_end - (page_no + 1) > state->window / 2) {
+        return;
+    }
+    state->window = state->window == 0 ? READ_AHEAD_MIN_PAGES : std::min(state->window * 2, READ_AHEAD_MAX_PAGES);
+    page_id_t begin = std::max(page_no + 1, state->prefetched_end);
+    page_id_t end = std::min(page_no + 1 + state->window, end_page_no);
+    if (begin >= end) {
+        return;
+    }
+    state->prefetched_end = end;
 
-    return true;
+    // 3.交给后台线程执行
+    {
+        std::scoped_lock lock{prefetch_latch_};
+        if (stop_prefetch_) {
+            return;
+        }
+        if (!prefetch_thread_.joinable()) {
+            prefetch_thread_ = std::thread(&BufferPoolManager::prefetch_worker, this);
+        }
+        prefetch_queue_.push_back({page_id.fd, begin, end});
+    }
+    prefetch_cv_.notify_all();
 }
 
 /**
- * @description: 将buffer_pool中的所有页写回到磁盘
+ * @description: 丢弃fd尚未执行的预读请求，并等待正在进行的预读结束，保证之后fd可以被安全关闭
  * @param {int} fd 文件句柄
  */
-void BufferPoolManager::flush_all_pages(int fd) {
-    std::scoped_lock lock{latch_};
-    for (auto &[page_id, frame]: page_table_) {
-        if (page_id.fd == fd) {
-            Page *page = &(pages_[frame]);
-            disk_manager_->write_page(page->id_.fd, page->id_.page_no, page->data_, PAGE_SIZE);
-            page->is_dirty_ = false;
+void BufferPoolManager::cancel_read_ahead(int fd) {
+    std::unique_lock<std::mutex> lock{prefetch_latch_};
+    prefetch_queue_.erase(std::remove_if(prefetch_queue_.begin(), prefetch_queue_.end(),
+                                         [&](const PrefetchRequest &request) { return request.fd == fd; }),
+                          prefetch_queue_.end());
+    prefetch_cv_.wait(lock, [&] { return prefetching_fd_ != fd; });
+}
+
+/**
+ * @description: 后台预读线程，依次执行队列中的预读请求
+ */
+void BufferPoolManager::prefetch_worker() {
+    std::unique_lock<std::mutex> lock{prefetch_latch_};
+    while (true) {
+        prefetch_cv_.wait(lock, [&] { return stop_prefetch_ || !prefetch_queue_.empty(); });
+        if (stop_prefetch_) {
+            return;
         }
+        PrefetchRequest request = prefetch_queue_.front();
+        prefetch_queue_.pop_front();
+        prefetching_fd_ = request.fd;
+        lock.unlock();
+
+        prefetch_pages(request);
+
+        lock.lock();
+        prefetching_fd_ = -1;
+        prefetch_cv_.notify_all();
     }
 }
 
-void BufferPoolManager::delete_all_pages(int fd) {
-    std::scoped_lock lock{latch_};
-    std::vector<PageId> to_be_deleted;
-    for (auto &[page_id, frame]: page_table_) {
-        if (page_id.fd == fd) {
-            to_be_deleted.push_back(page_id);
+/**
+ * @description: 把[begin, end)中不在缓冲池的页面读入缓冲池。先为每个页面预留帧，
+ *              再按文件批量写回被替换的脏页，最后用一次read_pages读入所有页面。
+ *              预读只是优化，任何失败都只撤销预留，由之后的fetch_page重新读取。
+ * @param {PrefetchRequest&} request 预读请求
+ */
+void BufferPoolManager::prefetch_pages(const PrefetchRequest &request) {
+    struct Reserved {
+        BufferPoolInstance *instance;
+        Page *page;
+        PageId old_page_id;
+        bool need_flush;
+        bool flushed;
+    };
+    // 1.为每个页面预留帧，已经在缓冲池中或者没有可替换帧的页面跳过
+    std::vector<Reserved> reserved;
+    for (page_id_t page_no = request.begin; page_no < request.end; page_no++) {
+        PageId page_id = {.fd = request.fd, .page_no = page_no};
+        BufferPoolInstance *instance = get_instance(page_id);
+        Reserved frame = {.instance = instance, .need_flush = false, .flushed = false};
+        frame.page = instance->reserve_prefetch_frame(page_id, &frame.old_page_id, &frame.need_flush);
+        if (frame.page != nullptr) {
+            reserved.push_back(frame);
+        }
+    }
+    if (reserved.empty()) {
+        return;
+    }
+
+    // 2.被替换的脏页按文件分组，批量写回
+    std::unordered_map<int, std::vector<Reserved *>> victims;
+    for (auto &frame: reserved) {
+        if (frame.need_flush) {
+            victims[frame.old_page_id.fd].push_back(&frame);
+        }
+    }
+    for (auto &[fd, frames]: victims) {
+        std::vector<std::pair<page_id_t, const char *>> batch;
+        for (auto *frame: frames) {
+            batch.emplace_back(frame->old_page_id.page_no, frame->page->get_data());
         }
+        try {
+            disk_manager_->write_pages(fd, batch);
+            for (auto *frame: frames) {
+                frame->flushed = true;
+            }
+        } catch (...) {
+        }
+    }
+
+    // 3.读入所有腾出的帧
+    std::vector<std::pair<page_id_t, char *>> batch;
+    for (auto &frame: reserved) {
+        if (!frame.need_flush || frame.flushed) {
+            batch.emplace_back(frame.page->get_page_id().page_no, frame.page->get_data());
+        }
+    }
+    bool loaded = false;
+    try {
+        disk_manager_->read_pages(request.fd, batch);
+        loaded = true;
+    } catch (...) {
     }
 
-    for (auto page_id: to_be_deleted) {
-        auto frame = page_table_[page_id];
-        // 如果该页面还没有unpin，则unpin
-        replacer_->unpin(frame);
-        // 从页表中删除该页面并添加到free_list中
-        Page *page = &(pages_[frame]);
-        page->reset_memory();
-        page->is_dirty_ = false;
-        page->pin_count_ = 0;
+    // 4.公开读入的页面，失败的页面撤销预留
+    for (auto &frame: reserved) {
+        frame.instance->finish_prefetch(frame.page, frame.old_page_id, frame.need_flush, frame.flushed,
+                                        loaded && (!frame.need_flush || frame.flushed));
+    }
+}
 
-        page_table_.erase(page_id);
-        free_list_.emplace_back(frame);
+/**
+ * @description: 启动后台写线程
+ * @param {function<lsn_t()>} flushed_lsn 返回已经持久化的日志LSN，页面LSN不超过它的脏页才能写回
+ */
+void BufferPoolManager::start_background_writer(std::function<lsn_t()> flushed_lsn) {
+    std::scoped_lock lock{writer_latch_};
+    if (writer_thread_.joinable()) {
+        return;
     }
-}
\ No newline at end of file
+    flushed_lsn_ = std::move(flushed_lsn);
+    stop_writer_ = false;
+    writer_thread_ = std::thread(&BufferPoolManager::background_writer, this);
+}
+
+/**
+ * @description: 停止后台写线程，等待正在进行的写回结束
+ */
+void BufferPoolManager::stop_background_writer() {
+    {
+        std::scoped_lock lock{writer_latch_};
+        stop_writer_ = true;
+    }
+    writer_cv_.notify_all();
+    if (writer_thread_.joinable()) {
+        writer_thread_.join();
+    }
+}
+
+/**
+ * @description: 后台写线程，每隔BACKGROUND_WRITER_INTERVAL_MS写回一轮脏页
+ */
+void BufferPoolManager::background_writer() {
+    std::unique_lock<std::mutex> lock{writer_latch_};
+    while (!stop_writer_) {
+        lock.unlock();
+        try {
+            write_dirty_pages();
+        } catch (...) {
+            // 写回失败的页面已经重新置脏，由下一轮或者淘汰时再写回
+        }
+        lock.lock();
+        writer_cv_.wait_for(lock, std::chrono::milliseconds(BACKGROUND_WRITER_INTERVAL_MS),
+                            [&] { return stop_writer_; });
+    }
+}
+
+/**
+ * @description: 写回一轮脏页：每个分片挑选需要写回的脏页，按文件分组后批量写回，write_pages会按页号排序并合并相邻页面
+ */
+void BufferPoolManager::write_dirty_pages() {
+    lsn_t flushed_lsn = flushed_lsn_ ? flushed_lsn_() : std::numeric_limits<lsn_t>::max();
+
+    // 1.收集各个分片中需要写回的页面
+    std::vector<std::pair<BufferPoolInstance *, Page *>> pages;
+    for (auto &instance: instances_) {
+        for (auto *page: instance->begin_background_write(flushed_lsn)) {
+            pages.emplace_back(instance.get(), page);
+        }
+    }
+
+    // 2.按文件分组批量写回
+    std::unordered_map<int, std::vector<std::pair<page_id_t, const char *>>> batches;
+    for (auto &[instance, page]: pages) {
+        batches[page->get_page_id().fd].emplace_back(page->get_page_id().page_no, page->get_data());
+    }
+    std::unordered_map<int, bool> failed;
+    for (auto &[fd, batch]: batches) {
+        try {
+            disk_manager_->write_pages(fd, batch);
+            failed[fd] = false;
+        } catch (...) {
+            failed[fd] = true;
+        }
+    }
+
+    // 3.公开写回的页面
+    for (auto &[instance, page]: pages) {
+        instance->finish_background_write(page, failed[page->get_page_id().fd]);
+    }
+}
@@ -12,51 +12,87 @@ See the Mulan PSL v2 for more details. */
 #include <fcntl.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <limits>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
+#include "buffer_pool_instance.h"
 #include "disk_manager.h"
 #include "errors.h"
+#include "frame_arena.h"
 #include "page.h"
 #include "replacer/lru_replacer.h"
 #include "replacer/replacer.h"
 
+/**
+ * @description: 一次扫描的预读状态，由扫描算子持有，每次进入新页面时交给BufferPoolManager::read_ahead更新。
+ * 访问保持顺序时预读窗口从READ_AHEAD_MIN_PAGES开始倍增，直到READ_AHEAD_MAX_PAGES；出现跳跃则窗口清零。
+ */
+struct ReadAheadState {
+    page_id_t next_page_no = INVALID_PAGE_ID;   // 顺序访问时下一次应当访问的页号
+    page_id_t prefetched_end = 0;               // 已经提交预读的页号上界（不含）
+    int window = 0;                             // 当前预读窗口大小，0表示尚未确认为顺序访问
+};
+
 class BufferPoolManager {
    private:
     size_t pool_size_;      // buffer_pool中可容纳页面的个数，即帧的个数
-    Page *pages_;           // buffer_pool中的Page对象数组，在构造空间中申请内存空间，在析构函数中释放，大小为BUFFER_POOL_SIZE
-    std::unordered_map<PageId, frame_id_t, PageIdHash> page_table_; // 帧号和页面号的映射哈希表，用于根据页面的PageId定位该页面的帧编号
-    std::list<frame_id_t> free_list_;   // 空闲帧编号的链表
+    std::unique_ptr<FrameArena> arena_;     // 所有帧的页面数据
+    Page *pages_;           // buffer_pool中的帧描述符数组，在构造函数中申请内存空间，在析构函数中释放，大小为pool_size_
+    std::vector<std::unique_ptr<BufferPoolInstance>> instances_;    // buffer_pool的各个分片，每个分片管理pages_中连续的一段帧
     DiskManager *disk_manager_;
-    Replacer *replacer_;    // buffer_pool的置换策略，当前赛题中为LRU置换策略
-    std::recursive_mutex latch_;      // 用于共享数据结构的并发控制
+
+    // 一段需要预读的页面[begin, end)
+    struct PrefetchRequest {
+        int fd;
+        page_id_t begin;
+        page_id_t end;
+    };
+    std::thread prefetch_thread_;                   // 后台预读线程，第一次收到预读请求时启动
+    std::deque<PrefetchRequest> prefetch_queue_;    // 等待执行的预读请求
+    int prefetching_fd_ = -1;                       // 预读线程正在读取的文件，-1表示空闲
+    bool stop_prefetch_ = false;
+    std::mutex prefetch_latch_;                     // 保护预读队列和上面的状态
+    std::condition_variable prefetch_cv_;
+
+    std::thread writer_thread_;                     // 后台写线程，提前写回脏页，使缺页时总有干净的帧可以替换
+    std::function<lsn_t()> flushed_lsn_;            // 返回已经持久化的日志LSN，为空时不检查WAL顺序
+    bool stop_writer_ = false;
+    std::mutex writer_latch_;                       // 保护后台写线程的启停
+    std::condition_variable writer_cv_;
 
    public:
     BufferPoolManager(size_t pool_size, DiskManager *disk_manager)
-        : pool_size_(pool_size), disk_manager_(disk_manager) {
-        // 为buffer pool分配一块连续的内存空间
-        pages_ = new Page[pool_size_];
-        // 可以被Replacer改变
-        if (REPLACER_TYPE.compare("LRU"))
-            replacer_ = new LRUReplacer(pool_size_);
-        else if (REPLACER_TYPE.compare("CLOCK"))
-            replacer_ = new LRUReplacer(pool_size_);
-        else {
-            replacer_ = new LRUReplacer(pool_size_);
-        }
-        // 初始化时，所有的page都在free_list_中
-        for (size_t i = 0; i < pool_size_; ++i) {
-            free_list_.emplace_back(static_cast<frame_id_t>(i));  // static_cast转换数据类型
-        }
+        : pool_size_(pool_size), pages_(nullptr), disk_manager_(disk_manager) {
+        init_frames();
     }
 
     ~BufferPoolManager() {
+        stop_background_writer();
+        {
+            std::scoped_lock lock{prefetch_latch_};
+            stop_prefetch_ = true;
+        }
+        prefetch_cv_.notify_all();
+        if (prefetch_thread_.joinable()) {
+            prefetch_thread_.join();
+        }
+        instances_.clear();
         delete[] pages_;
-        delete replacer_;
     }
 
+    size_t get_pool_size() const { return pool_size_; }
+
     /**
      * @description: 将目标页面标记为脏页
      * @param {Page*} page 脏页
@@ -72,16 +108,39 @@ class BufferPoolManager {
 
     Page* new_page(PageId* page_id);
 
+    Page* new_page_at(PageId page_id);
+
     bool delete_page(PageId page_id);
 
     void flush_all_pages(int fd);
 
     void delete_all_pages(int fd);
 
+    void read_ahead(PageId page_id, page_id_t end_page_no, ReadAheadState* state);
+
+    void start_background_writer(std::function<lsn_t()> flushed_lsn);
+
+    void stop_background_writer();
+
+    void set_pool_size(size_t pool_size);
+
    private:
-    bool find_victim_page(frame_id_t* frame_id);
+    void init_frames();
+
+    void background_writer();
+
+    void write_dirty_pages();
 
-    void update_page(Page* page, PageId new_page_id, frame_id_t new_frame_id);
+    void cancel_read_ahead(int fd);
+
+    void prefetch_worker();
+
+    void prefetch_pages(const PrefetchRequest &request);
+
+    // 根据PageId的哈希值选择页面所属的分片
+    BufferPoolInstance *get_instance(const PageId &page_id) {
+        return instances_[PageIdHash()(page_id) % instances_.size()].get();
+    }
 };
 
 //RALL
@@ -0,0 +1,250 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/compressed_file.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "errors.h"
+#include "lz4.h"
+
+/**
+ * @description: 从文件的指定位置读写num_bytes字节，处理被信号打断和部分读写的情况
+ * @return {bool} 读到文件末尾而没有读满时返回false
+ */
+static bool transfer_full(int fd, char *buf, size_t num_bytes, off_t offset, bool is_write) {
+    while (num_bytes > 0) {
+        ssize_t n = is_write ? pwrite(fd, buf, num_bytes, offset) : pread(fd, buf, num_bytes, offset);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw UnixError();
+        }
+        if (n == 0) {
+            return false;
+        }
+        buf += n;
+        num_bytes -= n;
+        offset += n;
+    }
+    return true;
+}
+
+static uint32_t sectors_of(uint16_t size) { return (size + COMPRESSED_SECTOR_SIZE - 1) / COMPRESSED_SECTOR_SIZE; }
+
+CompressedFile::CompressedFile(int fd, int map_fd) : fd_(fd), map_fd_(map_fd) {
+    // 1.读出页面映射表
+    struct stat st;
+    if (fstat(map_fd_, &st) == -1) {
+        throw UnixError();
+    }
+    entries_.resize(st.st_size / sizeof(CompressedPageEntry));
+    if (!entries_.empty() &&
+        !transfer_full(map_fd_, reinterpret_cast<char *>(entries_.data()),
+                       entries_.size() * sizeof(CompressedPageEntry), 0, false)) {
+        throw InternalError("CompressedFile: short read of page map");
+    }
+
+    // 2.已使用区间之间的空隙就是空闲区间
+    std::vector<std::pair<uint32_t, uint32_t>> used;
+    for (auto &entry : entries_) {
+        if (entry.size != 0) {
+            used.emplace_back(entry.sector, entry.num_sectors);
+        }
+    }
+    std::sort(used.begin(), used.end());
+    for (auto &[sector, num_sectors] : used) {
+        if (sector > end_sector_) {
+            free_extents_[end_sector_] = sector - end_sector_;
+        }
+        end_sector_ = std::max(end_sector_, sector + num_sectors);
+    }
+}
+
+CompressedFile::~CompressedFile() { close(map_fd_); }
+
+/**
+ * @description: 读出一个页面并解压
+ * @param {page_id_t} page_no 页号
+ * @param {char*} buf 输出，长度为PAGE_SIZE
+ */
+void CompressedFile::read_page(page_id_t page_no, char *buf) {
+    CompressedPageEntry entry{};
+    {
+        std::scoped_lock lock{latch_};
+        if (static_cast<size_t>(page_no) < entries_.size()) {
+            entry = entries_[page_no];
+        }
+    }
+    if (entry.size == 0) {
+        memset(buf, 0, PAGE_SIZE);
+        return;
+    }
+    off_t offset = static_cast<off_t>(entry.sector) * COMPRESSED_SECTOR_SIZE;
+    if (entry.size == PAGE_SIZE) {
+        if (!transfer_full(fd_, buf, PAGE_SIZE, offset, false)) {
+            throw InternalError("CompressedFile::read_page Error");
+        }
+        return;
+    }
+    char compressed[PAGE_SIZE];
+    if (!transfer_full(fd_, compressed, entry.size, offset, false) ||
+        LZ4_decompress_safe(compressed, buf, entry.size, PAGE_SIZE) != PAGE_SIZE) {
+        throw InternalError("CompressedFile::read_page Error: corrupted page " + std::to_string(page_no));
+    }
+}
+
+/**
+ * @description: 压缩并写入一个页面。压缩后节省不到一个扇区时按原样存放，解压时不需要额外的CPU
+ * @param {page_id_t} page_no 页号
+ * @param {char*} buf 页面数据，长度为PAGE_SIZE
+ */
+void CompressedFile::write_page(page_id_t page_no, const char *buf) {
+    char compressed[PAGE_SIZE];
+    int size = LZ4_compress_default(buf, compressed, PAGE_SIZE, PAGE_SIZE - COMPRESSED_SECTOR_SIZE);
+    const char *data = compressed;
+    if (size == 0) {
+        size = PAGE_SIZE;
+        data = buf;
+    }
+    CompressedPageEntry entry{0, static_cast<uint16_t>(sectors_of(size)), static_cast<uint16_t>(size)};
+
+    // 1.原来的空间放得下时原地写入，否则分配新的空间
+    {
+        std::scoped_lock lock{latch_};
+        if (static_cast<size_t>(page_no) >= entries_.size()) {
+            entries_.resize(page_no + 1, CompressedPageEntry{0, 0, 0});
+        }
+        const CompressedPageEntry &old = entries_[page_no];
+        entry.sector = old.size != 0 && old.num_sectors >= entry.num_sectors ? old.sector
+                                                                             : alloc_sectors(entry.num_sectors);
+    }
+
+    // 2.先写入页面数据，再更新映射表，之后才释放原来的空间
+    if (!transfer_full(fd_, const_cast<char *>(data), size, static_cast<off_t>(entry.sector) * COMPRESSED_SECTOR_SIZE,
+                       true)) {
+        throw InternalError("CompressedFile::write_page Error");
+    }
+    std::scoped_lock lock{latch_};
+    CompressedPageEntry old = entries_[page_no];
+    entries_[page_no] = entry;
+    write_entry(page_no);
+    if (old.size == 0) {
+        return;
+    }
+    if (old.sector != entry.sector) {
+        free_sectors(old.sector, old.num_sectors);
+    } else if (old.num_sectors > entry.num_sectors) {
+        free_sectors(old.sector + entry.num_sectors, old.num_sectors - entry.num_sectors);
+    }
+}
+
+/**
+ * @description: 释放页号不小于num_pages的页面，截断映射文件和数据文件末尾的空闲空间
+ */
+void CompressedFile::truncate(page_id_t num_pages) {
+    std::scoped_lock lock{latch_};
+    for (size_t page_no = num_pages; page_no < entries_.size(); page_no++) {
+        if (entries_[page_no].size != 0) {
+            free_sectors(entries_[page_no].sector, entries_[page_no].num_sectors);
+        }
+    }
+    if (static_cast<size_t>(num_pages) < entries_.size()) {
+        entries_.resize(num_pages);
+        if (ftruncate(map_fd_, static_cast<off_t>(num_pages) * sizeof(CompressedPageEntry)) == -1) {
+            throw UnixError();
+        }
+    }
+    struct stat st;
+    if (fstat(fd_, &st) == -1) {
+        throw UnixError();
+    }
+    off_t size = static_cast<off_t>(end_sector_) * COMPRESSED_SECTOR_SIZE;
+    if (st.st_size > size && ftruncate(fd_, size) == -1) {
+        throw UnixError();
+    }
+}
+
+void CompressedFile::sync() {
+    if (fdatasync(fd_) == -1 || fdatasync(map_fd_) == -1) {
+        throw UnixError();
+    }
+}
+
+size_t CompressedFile::stored_bytes() {
+    std::scoped_lock lock{latch_};
+    size_t bytes = 0;
+    for (auto &entry : entries_) {
+        if (entry.size != 0) {
+            bytes += static_cast<size_t>(entry.num_sectors) * COMPRESSED_SECTOR_SIZE;
+        }
+    }
+    return bytes;
+}
+
+/**
+ * @description: 分配连续的num_sectors个扇区，优先使用第一个足够大的空闲区间，否则在文件末尾分配。调用者需持有latch_
+ * @return {uint32_t} 起始扇区
+ */
+uint32_t CompressedFile::alloc_sectors(uint32_t num_sectors) {
+    for (auto iter = free_extents_.begin(); iter != free_extents_.end(); iter++) {
+        if (iter->second < num_sectors) {
+            continue;
+        }
+        uint32_t sector = iter->first;
+        uint32_t remaining = iter->second - num_sectors;
+        free_extents_.erase(iter);
+        if (remaining > 0) {
+            free_extents_[sector + num_sectors] = remaining;
+        }
+        return sector;
+    }
+    uint32_t sector = end_sector_;
+    end_sector_ += num_sectors;
+    return sector;
+}
+
+/**
+ * @description: 将一段扇区加入空闲区间并与相邻的空闲区间合并，位于文件末尾时直接缩小已使用的范围。调用者需持有latch_
+ */
+void CompressedFile::free_sectors(uint32_t sector, uint32_t num_sectors) {
+    auto next = free_extents_.lower_bound(sector);
+    if (next != free_extents_.end() && next->first == sector + num_sectors) {
+        num_sectors += next->second;
+        next = free_extents_.erase(next);
+    }
+    if (next != free_extents_.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == sector) {
+            sector = prev->first;
+            num_sectors += prev->second;
+            free_extents_.erase(prev);
+        }
+    }
+    if (sector + num_sectors == end_sector_) {
+        end_sector_ = sector;
+    } else {
+        free_extents_[sector] = num_sectors;
+    }
+}
+
+// 将映射表中的一项写入映射文件。调用者需持有latch_
+void CompressedFile::write_entry(page_id_t page_no) {
+    if (!transfer_full(map_fd_, reinterpret_cast<char *>(&entries_[page_no]), sizeof(CompressedPageEntry),
+                       static_cast<off_t>(page_no) * sizeof(CompressedPageEntry), true)) {
+        throw InternalError("CompressedFile::write_entry Error");
+    }
+}
@@ -0,0 +1,68 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "common/config.h"
+
+/* 页面映射表中的一项，记录一个逻辑页面在数据文件中的位置 */
+struct CompressedPageEntry {
+    uint32_t sector;        // 页面在数据文件中的起始扇区
+    uint16_t num_sectors;   // 页面占用的扇区个数
+    uint16_t size;          // 压缩后的长度，0表示页面还没有写入过，PAGE_SIZE表示页面不可压缩、按原样存放
+};
+
+/**
+ * @description: 压缩数据文件的页面映射层。每个页面写回时用LZ4压缩，按COMPRESSED_SECTOR_SIZE向上取整后
+ * 存放在数据文件的任意位置，页号到存放位置的映射保存在同名的.pmap文件中（第i项对应第i个页面）。
+ * 页面重写后变大时重新分配空间，原来的空间加入空闲区间，之后分配时复用
+ */
+class CompressedFile {
+   public:
+    /**
+     * @param {int} fd 数据文件的文件句柄
+     * @param {int} map_fd 页面映射文件的文件句柄，由CompressedFile负责关闭
+     */
+    CompressedFile(int fd, int map_fd);
+
+    ~CompressedFile();
+
+    // 读出一个完整的页面，页面还没有写入过时内容全为0
+    void read_page(page_id_t page_no, char *buf);
+
+    void write_page(page_id_t page_no, const char *buf);
+
+    // 释放页号不小于num_pages的页面，并截断数据文件末尾的空闲空间
+    void truncate(page_id_t num_pages);
+
+    void sync();
+
+    // 已经写入的页面压缩后占用的字节数（按扇区计算）
+    size_t stored_bytes();
+
+   private:
+    uint32_t alloc_sectors(uint32_t num_sectors);
+
+    void free_sectors(uint32_t sector, uint32_t num_sectors);
+
+    void write_entry(page_id_t page_no);
+
+    int fd_;
+    int map_fd_;
+    std::vector<CompressedPageEntry> entries_;      // 页号到存放位置的映射
+    std::map<uint32_t, uint32_t> free_extents_;     // 数据文件中的空闲区间：起始扇区 -> 扇区个数，相邻区间已合并
+    uint32_t end_sector_ = 0;                       // 数据文件中已使用的扇区上界
+    std::mutex latch_;                              // 保护上面的映射和空间分配信息
+};
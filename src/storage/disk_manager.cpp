@@ -11,14 +11,180 @@ See the Mulan PSL v2 for more details. */
 #include "storage/disk_manager.h"
 
 #include <cassert>    // for assert
+#include <climits>    // for IOV_MAX
+#include <cstdint>    // for uintptr_t
+#include <cstdlib>    // for aligned_alloc
 #include <cstring>    // for memset
 #include <sys/stat.h>  // for stat
-#include <unistd.h>    // for lseek
+#include <sys/uio.h>   // for preadv, pwritev
+#include <unistd.h>    // for pread, pwrite
+
+#include <algorithm>
 
 #include "defs.h"
 
 DiskManager::DiskManager() { memset(fd2pageno_, 0, MAX_FD * (sizeof(std::atomic<page_id_t>) / sizeof(char))); }
 
+/**
+ * @description: 跳过缓冲区数组中已经完成读写的前n个字节
+ * @param {iovec*&} iov 内存缓冲区数组，指向第一个未完成的缓冲区
+ * @param {int&} iovcnt 剩余的缓冲区个数
+ * @param {size_t} n 已经完成读写的字节数
+ */
+static void advance_iov(struct iovec *&iov, int &iovcnt, size_t n) {
+    while (iovcnt > 0 && n >= iov->iov_len) {
+        n -= iov->iov_len;
+        iov++;
+        iovcnt--;
+    }
+    if (iovcnt > 0) {
+        iov->iov_base = static_cast<char *>(iov->iov_base) + n;
+        iov->iov_len -= n;
+    }
+}
+
+/**
+ * @description: 对一段连续的文件区域调用preadv/pwritev，处理被信号打断和部分读写的情况
+ * @return {ssize_t} 实际读写的字节数，读到文件末尾时小于请求的字节数
+ * @param {int} fd 磁盘文件的文件句柄
+ * @param {iovec*} iov 内存缓冲区数组，调用过程中会被修改
+ * @param {int} iovcnt 缓冲区个数
+ * @param {off_t} offset 在文件中的起始偏移
+ * @param {bool} is_write true表示写文件，false表示读文件
+ */
+static ssize_t positional_io(int fd, struct iovec *iov, int iovcnt, off_t offset, bool is_write) {
+    ssize_t total = 0;
+    while (iovcnt > 0) {
+        ssize_t n = is_write ? pwritev(fd, iov, iovcnt, offset) : preadv(fd, iov, iovcnt, offset);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw UnixError();
+        }
+        if (n == 0) {
+            break;
+        }
+        total += n;
+        offset += n;
+        // 跳过已经完成的缓冲区，继续读写剩余部分
+        advance_iov(iov, iovcnt, n);
+    }
+    return total;
+}
+
+/**
+ * @description: 通过io_uring读写一段连续的文件区域并等待完成，只完成了一部分时剩余部分同步补齐
+ * @return {ssize_t} 实际读写的字节数，读到文件末尾时小于请求的字节数
+ */
+static ssize_t ring_io(IoUring *ring, int fd, char *buf, size_t num_bytes, off_t offset, bool is_write) {
+    struct iovec iov = {buf, num_bytes};
+    IoRequest request{fd, offset, &iov, 1, is_write};
+    std::vector<IoRequest *> requests{&request};
+    ring->submit(requests);
+    ring->wait(requests);
+    if (request.result < 0) {
+        errno = static_cast<int>(-request.result);
+        throw UnixError();
+    }
+    if (request.result == 0 || static_cast<size_t>(request.result) == num_bytes) {
+        return request.result;
+    }
+    iov = {buf + request.result, num_bytes - request.result};
+    return request.result + positional_io(fd, &iov, 1, offset + request.result, is_write);
+}
+
+/**
+ * @description: 按页号排序后，将页号相邻的页面合并为一次preadv/pwritev。
+ *              启用io_uring时，所有段作为一批请求同时提交，最多queue_depth个请求同时在内核中执行
+ * @param {IoUring*} ring io_uring队列，为空时逐段同步读写
+ * @param {int} fd 磁盘文件的文件句柄
+ * @param {vector<pair<page_id_t, T>>&} pages 需要读写的(页号, 页面数据)列表，会被按页号排序
+ * @param {bool} is_write true表示写文件，false表示读文件
+ */
+template <typename T>
+static void transfer_pages(IoUring *ring, int fd, std::vector<std::pair<page_id_t, T>> &pages, bool is_write) {
+    std::sort(pages.begin(), pages.end(),
+              [](const std::pair<page_id_t, T> &a, const std::pair<page_id_t, T> &b) { return a.first < b.first; });
+
+    // 1.将页号连续的页面划分为一段，每段对应一个请求
+    std::vector<struct iovec> iov(pages.size());
+    std::vector<IoRequest> requests;
+    for (size_t i = 0; i < pages.size(); i++) {
+        iov[i] = {const_cast<char *>(pages[i].second), PAGE_SIZE};
+        if (requests.empty() || pages[i].first != pages[i - 1].first + 1 || requests.back().iovcnt >= IOV_MAX) {
+            requests.push_back(IoRequest{fd, static_cast<off_t>(pages[i].first) * PAGE_SIZE, &iov[i], 0, is_write});
+        }
+        requests.back().iovcnt++;
+    }
+
+    // 2.启用io_uring时一次提交所有请求再统一等待
+    if (ring != nullptr) {
+        std::vector<IoRequest *> batch;
+        for (auto &request : requests) {
+            batch.push_back(&request);
+        }
+        ring->submit(batch);
+        ring->wait(batch);
+    }
+
+    // 3.检查每段的读写结果，io_uring只完成了一部分时剩余部分同步补齐
+    for (auto &request : requests) {
+        ssize_t expected = static_cast<ssize_t>(request.iovcnt) * PAGE_SIZE;
+        ssize_t bytes;
+        if (ring != nullptr) {
+            if (request.result < 0) {
+                errno = static_cast<int>(-request.result);
+                throw UnixError();
+            }
+            bytes = request.result;
+            if (bytes > 0 && bytes < expected) {
+                advance_iov(request.iov, request.iovcnt, bytes);
+                bytes += positional_io(fd, request.iov, request.iovcnt, request.offset + bytes, is_write);
+            }
+        } else {
+            bytes = positional_io(fd, request.iov, request.iovcnt, request.offset, is_write);
+        }
+        if (bytes != expected) {
+            page_id_t failed_page_no = static_cast<page_id_t>(request.offset / PAGE_SIZE + bytes / PAGE_SIZE);
+            throw InternalError(std::string(is_write ? "DiskManager::write_pages" : "DiskManager::read_pages") +
+                                " Error: short transfer at page " + std::to_string(failed_page_no));
+        }
+    }
+}
+
+// O_DIRECT要求内存地址、文件偏移和读写长度都按块大小对齐，这里统一按PAGE_SIZE对齐
+static bool is_direct_aligned(const void *buf, size_t num_bytes) {
+    return reinterpret_cast<uintptr_t>(buf) % PAGE_SIZE == 0 && num_bytes % PAGE_SIZE == 0;
+}
+
+using AlignedBuffer = std::unique_ptr<char, decltype(&free)>;
+
+static AlignedBuffer make_aligned_buffer(size_t size) {
+    char *buf = static_cast<char *>(aligned_alloc(PAGE_SIZE, size));
+    if (buf == nullptr) {
+        throw UnixError();
+    }
+    return AlignedBuffer(buf, &free);
+}
+
+/**
+ * @description: 启用io_uring异步I/O后端，内核不支持时保持同步的pread/pwrite
+ * @return {bool} 成功启用返回true，否则返回false
+ * @param {unsigned} queue_depth 同时在内核中执行的请求个数上限
+ */
+bool DiskManager::enable_io_uring(unsigned queue_depth) {
+    if (!IoUring::is_supported()) {
+        return false;
+    }
+    try {
+        io_uring_ = std::make_unique<IoUring>(queue_depth);
+    } catch (UnixError &) {
+        return false;
+    }
+    return true;
+}
+
 /**
  * @description: 将数据写入文件的指定磁盘页面中
  * @param {int} fd 磁盘文件的文件句柄
@@ -29,10 +195,26 @@ DiskManager::DiskManager() { memset(fd2pageno_, 0, MAX_FD * (sizeof(std::atomic<
 void DiskManager::write_page(int fd, page_id_t page_no, const char *offset, int num_bytes) {
     // 1.查看文件是否打开
     assert(fd2path_.count(fd));
-    // 1.lseek()定位到文件头，通过(fd,page_no)可以定位指定页面及其在磁盘文件中的偏移量
-    lseek(fd, page_no * PAGE_SIZE, SEEK_SET);
-    // 2.调用write()函数
-    ssize_t write_bytes = write(fd, offset, num_bytes);
+    if (compressed_[fd] != nullptr) {
+        // 压缩文件中只能整页写入，不足整页时先读出原有内容
+        if (num_bytes == PAGE_SIZE) {
+            compressed_[fd]->write_page(page_no, offset);
+        } else {
+            char buf[PAGE_SIZE];
+            compressed_[fd]->read_page(page_no, buf);
+            memcpy(buf, offset, num_bytes);
+            compressed_[fd]->write_page(page_no, buf);
+        }
+        return;
+    }
+    if (direct_fd_[fd] && !is_direct_aligned(offset, num_bytes)) {
+        direct_write(fd, page_no, offset, num_bytes);
+        return;
+    }
+    // 2.调用pwrite()函数，通过(fd,page_no)定位页面在磁盘文件中的偏移量，不修改共享的文件偏移
+    off_t file_offset = static_cast<off_t>(page_no) * PAGE_SIZE;
+    ssize_t write_bytes = io_uring_ ? ring_io(io_uring_.get(), fd, const_cast<char *>(offset), num_bytes, file_offset, true)
+                                    : pwrite(fd, offset, num_bytes, file_offset);
     if (write_bytes != num_bytes) {
         throw InternalError("DiskManager::write_page Error");
     }
@@ -48,27 +230,282 @@ void DiskManager::write_page(int fd, page_id_t page_no, const char *offset, int
 void DiskManager::read_page(int fd, page_id_t page_no, char *offset, int num_bytes) {
     // 0.检查文件是否打开
     assert(fd2path_.count(fd));
-    // 1.lseek()定位到文件头，通过(fd,page_no)可以定位指定页面及其在磁盘文件中的偏移量
-    lseek(fd, page_no * PAGE_SIZE, SEEK_SET);
-    // 2.调用read()函数
-    ssize_t read_bytes = read(fd, offset, num_bytes);
+    if (compressed_[fd] != nullptr) {
+        if (num_bytes == PAGE_SIZE) {
+            compressed_[fd]->read_page(page_no, offset);
+        } else {
+            char buf[PAGE_SIZE];
+            compressed_[fd]->read_page(page_no, buf);
+            memcpy(offset, buf, num_bytes);
+        }
+        return;
+    }
+    if (direct_fd_[fd] && !is_direct_aligned(offset, num_bytes)) {
+        direct_read(fd, page_no, offset, num_bytes);
+        return;
+    }
+    // 1.调用pread()函数，通过(fd,page_no)定位页面在磁盘文件中的偏移量，不修改共享的文件偏移
+    off_t file_offset = static_cast<off_t>(page_no) * PAGE_SIZE;
+    ssize_t read_bytes = io_uring_ ? ring_io(io_uring_.get(), fd, offset, num_bytes, file_offset, false)
+                                   : pread(fd, offset, num_bytes, file_offset);
     if (read_bytes != num_bytes) {
         throw InternalError("DiskManager::read_page Error");
     }
 }
 
 /**
- * @description: 分配一个新的页号
+ * @description: 批量写入多个页面，页号相邻的页面合并为一次pwritev
+ * @param {int} fd 磁盘文件的文件句柄
+ * @param {vector<pair<page_id_t, const char*>>&} pages 需要写入的(页号, 页面数据)列表，每个页面PAGE_SIZE字节，会被按页号排序
+ */
+void DiskManager::write_pages(int fd, std::vector<std::pair<page_id_t, const char *>> &pages) {
+    assert(fd2path_.count(fd));
+    if (compressed_[fd] != nullptr ||
+        (direct_fd_[fd] && std::any_of(pages.begin(), pages.end(), [](const std::pair<page_id_t, const char *> &page) {
+            return !is_direct_aligned(page.second, PAGE_SIZE);
+        }))) {
+        // 压缩文件和未对齐的O_DIRECT缓冲区逐页读写
+        for (auto &page : pages) {
+            write_page(fd, page.first, page.second, PAGE_SIZE);
+        }
+        return;
+    }
+    transfer_pages(io_uring_.get(), fd, pages, true);
+}
+
+/**
+ * @description: 批量读取多个页面，页号相邻的页面合并为一次preadv。
+ *              如果某个页面超出了文件末尾而没有读满，抛出InternalError并指明该页面的页号
+ * @param {int} fd 磁盘文件的文件句柄
+ * @param {vector<pair<page_id_t, char*>>&} pages 需要读取的(页号, 页面缓冲区)列表，每个缓冲区PAGE_SIZE字节，会被按页号排序
+ */
+void DiskManager::read_pages(int fd, std::vector<std::pair<page_id_t, char *>> &pages) {
+    assert(fd2path_.count(fd));
+    if (compressed_[fd] != nullptr ||
+        (direct_fd_[fd] && std::any_of(pages.begin(), pages.end(), [](const std::pair<page_id_t, char *> &page) {
+            return !is_direct_aligned(page.second, PAGE_SIZE);
+        }))) {
+        // 压缩文件和未对齐的O_DIRECT缓冲区逐页读写
+        for (auto &page : pages) {
+            read_page(fd, page.first, page.second, PAGE_SIZE);
+        }
+        return;
+    }
+    transfer_pages(io_uring_.get(), fd, pages, false);
+}
+
+/**
+ * @description: 以O_DIRECT方式读取未对齐的缓冲区或不足一页的数据：先把整页读入对齐的临时缓冲区，再复制需要的部分
+ * @param {int} fd 以O_DIRECT方式打开的文件句柄
+ * @param {page_id_t} page_no 指定的页面编号
+ * @param {char} *offset 读取的内容写入到offset中
+ * @param {int} num_bytes 读取的数据量大小
+ */
+void DiskManager::direct_read(int fd, page_id_t page_no, char *offset, int num_bytes) {
+    size_t size = (static_cast<size_t>(num_bytes) + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+    AlignedBuffer buf = make_aligned_buffer(size);
+    struct iovec iov = {buf.get(), size};
+    ssize_t read_bytes = positional_io(fd, &iov, 1, static_cast<off_t>(page_no) * PAGE_SIZE, false);
+    if (read_bytes < num_bytes) {
+        throw InternalError("DiskManager::read_page Error");
+    }
+    memcpy(offset, buf.get(), num_bytes);
+}
+
+/**
+ * @description: 以O_DIRECT方式写入未对齐的缓冲区或不足一页的数据。
+ *              不足整页时先读出原有内容再整页写回，调用者需保证此时没有其他线程写同一个页面（只用于文件头等不经过缓冲池的页面）
+ * @param {int} fd 以O_DIRECT方式打开的文件句柄
+ * @param {page_id_t} page_no 写入目标页面的page_id
+ * @param {char} *offset 要写入磁盘的数据
+ * @param {int} num_bytes 要写入磁盘的数据大小
+ */
+void DiskManager::direct_write(int fd, page_id_t page_no, const char *offset, int num_bytes) {
+    size_t size = (static_cast<size_t>(num_bytes) + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+    AlignedBuffer buf = make_aligned_buffer(size);
+    off_t file_offset = static_cast<off_t>(page_no) * PAGE_SIZE;
+    struct iovec iov = {buf.get(), size};
+    if (static_cast<size_t>(num_bytes) != size) {
+        // 超出文件末尾的部分补0
+        ssize_t read_bytes = positional_io(fd, &iov, 1, file_offset, false);
+        memset(buf.get() + read_bytes, 0, size - read_bytes);
+        iov = {buf.get(), size};
+    }
+    memcpy(buf.get(), offset, num_bytes);
+    if (positional_io(fd, &iov, 1, file_offset, true) != static_cast<ssize_t>(size)) {
+        throw InternalError("DiskManager::write_page Error");
+    }
+}
+
+/**
+ * @description: 将文件已写入的数据和文件大小持久化到磁盘。O_DIRECT绕过了页缓存，但磁盘写缓存和文件大小等元数据仍需fdatasync
+ * @param {int} fd 磁盘文件的文件句柄
+ */
+void DiskManager::sync_file(int fd) {
+    if (compressed_[fd] != nullptr) {
+        compressed_[fd]->sync();
+        return;
+    }
+    if (fdatasync(fd) == -1) {
+        throw UnixError();
+    }
+}
+
+/**
+ * @description: 分配一个新的页号，优先复用文件中已经释放的页面号最小的页面，没有空闲页面时在文件末尾分配
  * @return {page_id_t} 分配的新页号
  * @param {int} fd 指定文件的文件句柄
  */
 page_id_t DiskManager::allocate_page(int fd) {
-    // 简单的自增分配策略，指定文件的页面编号加1
     assert(fd >= 0 && fd < MAX_FD);
+    {
+        std::scoped_lock lock{free_pages_latch_};
+        auto iter = fd2free_pages_.find(fd);
+        if (iter != fd2free_pages_.end() && !iter->second.empty()) {
+            page_id_t page_no = *iter->second.begin();
+            iter->second.erase(iter->second.begin());
+            return page_no;
+        }
+    }
+    // 简单的自增分配策略，指定文件的页面编号加1
     return fd2pageno_[fd]++;
 }
 
-void DiskManager::deallocate_page(__attribute__((unused)) page_id_t page_id) {}
+/**
+ * @description: 分配指定的页号，用于恢复时重做崩溃前的页面分配。页号已经释放时将其移出空闲页面；
+ *              页号超出已分配的范围时扩展文件，中间跳过的页面作为空闲页面，调用者需保证这些页面在磁盘上存在
+ * @return {bool} 页面原来是否处于未分配状态，此时调用者需要初始化页面
+ * @param {int} fd 指定文件的文件句柄
+ * @param {page_id_t} page_no 要分配的页号
+ */
+bool DiskManager::allocate_page_at(int fd, page_id_t page_no) {
+    assert(fd >= 0 && fd < MAX_FD);
+    std::scoped_lock lock{free_pages_latch_};
+    if (page_no < fd2pageno_[fd]) {
+        auto iter = fd2free_pages_.find(fd);
+        return iter != fd2free_pages_.end() && iter->second.erase(page_no) != 0;
+    }
+    auto &free_pages = fd2free_pages_[fd];
+    for (page_id_t i = fd2pageno_[fd]; i < page_no; i++) {
+        free_pages.insert(i);
+    }
+    fd2pageno_[fd] = page_no + 1;
+    return true;
+}
+
+/**
+ * @description: 释放文件中的一个页面，之后allocate_page可以重新分配该页号。调用者需保证页面已经不在缓冲池中
+ * @param {int} fd 指定文件的文件句柄
+ * @param {page_id_t} page_no 要释放的页号
+ */
+void DiskManager::deallocate_page(int fd, page_id_t page_no) {
+    assert(fd >= 0 && fd < MAX_FD);
+    assert(page_no >= 0 && page_no < fd2pageno_[fd]);
+    std::scoped_lock lock{free_pages_latch_};
+    fd2free_pages_[fd].insert(page_no);
+}
+
+/**
+ * @description: 判断页面是否已经被释放
+ */
+bool DiskManager::is_free_page(int fd, page_id_t page_no) {
+    std::scoped_lock lock{free_pages_latch_};
+    auto iter = fd2free_pages_.find(fd);
+    return iter != fd2free_pages_.end() && iter->second.count(page_no) != 0;
+}
+
+/**
+ * @description: 获得文件中已经释放的页面个数
+ */
+size_t DiskManager::get_num_free_pages(int fd) {
+    std::scoped_lock lock{free_pages_latch_};
+    auto iter = fd2free_pages_.find(fd);
+    return iter == fd2free_pages_.end() ? 0 : iter->second.size();
+}
+
+/**
+ * @description: 回收文件末尾连续的空闲页面：将它们从空闲页面中移除，并截断磁盘文件。
+ *              调用者需保证没有其他线程同时在该文件中分配页面
+ * @return {page_id_t} 截断之后文件中的页面个数
+ * @param {int} fd 指定文件的文件句柄
+ */
+page_id_t DiskManager::truncate_free_pages(int fd) {
+    assert(fd2path_.count(fd));
+    page_id_t num_pages;
+    {
+        std::scoped_lock lock{free_pages_latch_};
+        auto &free_pages = fd2free_pages_[fd];
+        num_pages = fd2pageno_[fd];
+        while (!free_pages.empty() && *free_pages.rbegin() == num_pages - 1) {
+            free_pages.erase(std::prev(free_pages.end()));
+            num_pages--;
+        }
+        fd2pageno_[fd] = num_pages;
+    }
+    if (compressed_[fd] != nullptr) {
+        compressed_[fd]->truncate(num_pages);
+        return num_pages;
+    }
+    // 文件中可能还没有写入最后几个已分配的页面，只在文件更大时截断
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        throw UnixError();
+    }
+    off_t size = static_cast<off_t>(num_pages) * PAGE_SIZE;
+    if (st.st_size > size && ftruncate(fd, size) == -1) {
+        throw UnixError();
+    }
+    return num_pages;
+}
+
+/**
+ * @description: 将文件的空闲页面按页号从小到大串成链表写入磁盘，每个空闲页面在link_offset处记录下一个空闲页面的页号。
+ *              链表头由调用者写入文件头，打开文件时交给load_free_pages恢复
+ * @return {page_id_t} 链表中第一个空闲页面的页号，没有空闲页面时为INVALID_PAGE_ID
+ * @param {int} fd 指定文件的文件句柄
+ * @param {size_t} link_offset 链表指针在页面中的偏移
+ */
+page_id_t DiskManager::save_free_pages(int fd, size_t link_offset) {
+    std::vector<page_id_t> pages;
+    {
+        std::scoped_lock lock{free_pages_latch_};
+        auto iter = fd2free_pages_.find(fd);
+        if (iter != fd2free_pages_.end()) {
+            pages.assign(iter->second.begin(), iter->second.end());
+        }
+    }
+    char buf[PAGE_SIZE];
+    for (size_t i = 0; i < pages.size(); i++) {
+        page_id_t next_page_no = i + 1 < pages.size() ? pages[i + 1] : INVALID_PAGE_ID;
+        read_page(fd, pages[i], buf, PAGE_SIZE);
+        memcpy(buf + link_offset, &next_page_no, sizeof(page_id_t));
+        write_page(fd, pages[i], buf, PAGE_SIZE);
+    }
+    return pages.empty() ? INVALID_PAGE_ID : pages[0];
+}
+
+/**
+ * @description: 打开文件时沿着save_free_pages写入的链表恢复文件的空闲页面，需要在set_fd2pageno之后调用
+ * @param {int} fd 指定文件的文件句柄
+ * @param {page_id_t} first_page_no 链表中第一个空闲页面的页号
+ * @param {size_t} link_offset 链表指针在页面中的偏移
+ */
+void DiskManager::load_free_pages(int fd, page_id_t first_page_no, size_t link_offset) {
+    // 第0页总是文件头，不会被释放；旧版本的文件头中没有记录链表头，读出为0，按没有空闲页面处理
+    if (first_page_no <= 0) {
+        return;
+    }
+    char buf[PAGE_SIZE];
+    page_id_t page_no = first_page_no;
+    while (page_no != INVALID_PAGE_ID) {
+        if (page_no <= 0 || page_no >= fd2pageno_[fd] || is_free_page(fd, page_no)) {
+            throw InternalError("DiskManager::load_free_pages Error: corrupted free page list");
+        }
+        read_page(fd, page_no, buf, static_cast<int>(link_offset + sizeof(page_id_t)));
+        deallocate_page(fd, page_no);
+        memcpy(&page_no, buf + link_offset, sizeof(page_id_t));
+    }
+}
 
 bool DiskManager::is_dir(const std::string &path) {
     struct stat st;
@@ -122,6 +559,15 @@ void DiskManager::create_file(const std::string &path) {
     }
 }
 
+/**
+ * @description: 创建压缩数据文件：数据文件和同名的页面映射文件，之后打开该文件时读写的页面自动压缩和解压
+ * @param {string} &path 数据文件的路径
+ */
+void DiskManager::create_compressed_file(const std::string &path) {
+    create_file(path);
+    create_file(path + COMPRESSED_MAP_SUFFIX);
+}
+
 /**
  * @description: 删除指定路径的文件
  * @param {string} &path 文件所在路径
@@ -135,10 +581,14 @@ void DiskManager::destroy_file(const std::string &path) {
     if (path2fd_.count(path)) {
         throw FileNotClosedError(path);
     }
-    // 3.调用unlink()函数删除文件
+    // 3.调用unlink()函数删除文件，压缩数据文件同时删除页面映射文件
     if (unlink(path.c_str()) == -1) {
         throw FileNotDeleteError(path);
     }
+    std::string map_path = path + COMPRESSED_MAP_SUFFIX;
+    if (is_file(map_path) && unlink(map_path.c_str()) == -1) {
+        throw FileNotDeleteError(map_path);
+    }
 }
 
 /**
@@ -155,14 +605,32 @@ int DiskManager::open_file(const std::string &path) {
     if (path2fd_.count(path)) {
         return path2fd_[path];
     }
-    // 3.调用open()函数，使用O_RDWR模式
-    int fd = open(path.c_str(), O_RDWR);
+    // 3.调用open()函数，使用O_RDWR模式；启用O_DIRECT时数据文件绕过页缓存，日志文件按字节追加写，仍走页缓存。
+    //   压缩数据文件中的页面按扇区存放，不满足O_DIRECT的对齐要求
+    std::string map_path = path + COMPRESSED_MAP_SUFFIX;
+    bool compressed = is_file(map_path);
+    bool direct = direct_io_ && path != LOG_FILE_NAME && !compressed;
+    int fd = open(path.c_str(), O_RDWR | (direct ? O_DIRECT : 0));
+    if (fd == -1 && direct && errno == EINVAL) {
+        // 文件系统不支持O_DIRECT（如tmpfs），退回普通模式
+        direct = false;
+        fd = open(path.c_str(), O_RDWR);
+    }
     if (fd == -1) {
         throw UnixError();
     }
+    if (compressed) {
+        int map_fd = open(map_path.c_str(), O_RDWR);
+        if (map_fd == -1) {
+            close(fd);
+            throw UnixError();
+        }
+        compressed_[fd] = std::make_unique<CompressedFile>(fd, map_fd);
+    }
     // 4.更新文件打开列表
     path2fd_.emplace(path, fd);
     fd2path_.emplace(fd, path);
+    direct_fd_[fd] = direct;
     return fd;
 }
 
@@ -175,13 +643,22 @@ void DiskManager::close_file(int fd) {
     if (fd2path_.count(fd) == 0) {
         return;
     }
-    // 2.调用close()函数关闭文件
+    // 2.O_DIRECT写入的数据不会在关闭时随页缓存回写，关闭前同步一次；再调用close()函数关闭文件
+    if (direct_fd_[fd]) {
+        sync_file(fd);
+    }
     if (close(fd) == -1) {
         throw FileNotClosedError(fd2path_[fd]);
     }
     // 3.更新元信息
     path2fd_.erase(fd2path_[fd]);
     fd2path_.erase(fd);
+    direct_fd_[fd] = false;
+    compressed_[fd].reset();
+    {
+        std::scoped_lock lock{free_pages_latch_};
+        fd2free_pages_.erase(fd);
+    }
 }
 
 /**
@@ -239,8 +716,7 @@ int DiskManager::read_log(char *log_data, int size, int offset) {
 
     size = std::min(size, file_size - offset);
     if (size == 0) return 0;
-    lseek(log_fd_, offset, SEEK_SET);
-    ssize_t bytes_read = read(log_fd_, log_data, size);
+    ssize_t bytes_read = pread(log_fd_, log_data, size, offset);
     assert(bytes_read == size);
     return bytes_read;
 }
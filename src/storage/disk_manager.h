@@ -17,11 +17,18 @@ See the Mulan PSL v2 for more details. */
 #include <atomic>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "common/config.h"
 #include "errors.h"  
+#include "storage/compressed_file.h"
+#include "storage/io_uring.h"
 
 /**
  * @description: DiskManager的作用主要是根据上层的需要对磁盘文件进行操作
@@ -32,13 +39,53 @@ class DiskManager {
 
     ~DiskManager() = default;
 
+    bool enable_io_uring(unsigned queue_depth = IO_URING_QUEUE_DEPTH);
+
+    bool is_io_uring_enabled() const { return io_uring_ != nullptr; }
+
+    /**
+     * @description: 设置之后打开的表文件和索引文件是否使用O_DIRECT，绕过内核页缓存，只由缓冲池缓存页面
+     * @param {bool} direct_io 为true时启用O_DIRECT
+     */
+    void set_direct_io(bool direct_io) { direct_io_ = direct_io; }
+
+    bool is_direct_io() const { return direct_io_; }
+
+    // 文件是否以O_DIRECT方式打开（文件系统不支持时会退回普通模式）
+    bool is_direct_fd(int fd) const { return fd >= 0 && fd < MAX_FD && direct_fd_[fd]; }
+
+    // 文件是否是压缩数据文件
+    bool is_compressed_fd(int fd) const { return fd >= 0 && fd < MAX_FD && compressed_[fd] != nullptr; }
+
+    // 压缩数据文件中已经写入的页面压缩后占用的字节数
+    size_t get_compressed_size(int fd) const { return compressed_[fd]->stored_bytes(); }
+
+    void sync_file(int fd);
+
     void write_page(int fd, page_id_t page_no, const char *offset, int num_bytes);
 
     void read_page(int fd, page_id_t page_no, char *offset, int num_bytes);
 
+    void write_pages(int fd, std::vector<std::pair<page_id_t, const char *>> &pages);
+
+    void read_pages(int fd, std::vector<std::pair<page_id_t, char *>> &pages);
+
     page_id_t allocate_page(int fd);
 
-    void deallocate_page(page_id_t page_id);
+    bool allocate_page_at(int fd, page_id_t page_no);
+
+    void deallocate_page(int fd, page_id_t page_no);
+
+    /*空闲页面管理*/
+    bool is_free_page(int fd, page_id_t page_no);
+
+    size_t get_num_free_pages(int fd);
+
+    page_id_t truncate_free_pages(int fd);
+
+    page_id_t save_free_pages(int fd, size_t link_offset);
+
+    void load_free_pages(int fd, page_id_t first_page_no, size_t link_offset);
 
     /*目录操作*/
     bool is_dir(const std::string &path);
@@ -52,6 +99,8 @@ class DiskManager {
 
     void create_file(const std::string &path);
 
+    void create_compressed_file(const std::string &path);
+
     void destroy_file(const std::string &path);
 
     int open_file(const std::string &path);
@@ -90,10 +139,20 @@ class DiskManager {
     static constexpr int MAX_FD = 8192;
 
    private:
+    void direct_read(int fd, page_id_t page_no, char *offset, int num_bytes);
+
+    void direct_write(int fd, page_id_t page_no, const char *offset, int num_bytes);
+
     // 文件打开列表，用于记录文件是否被打开
     std::unordered_map<std::string, int> path2fd_;  //<Page文件磁盘路径,Page fd>哈希表
     std::unordered_map<int, std::string> fd2path_;  //<Page fd,Page文件磁盘路径>哈希表
 
     int log_fd_ = -1;                             // WAL日志文件的文件句柄，默认为-1，代表未打开日志文件
     std::atomic<page_id_t> fd2pageno_[MAX_FD]{};  // 文件中已经分配的页面个数，初始值为0
+    std::unique_ptr<IoUring> io_uring_;           // 启用io_uring后端时的异步I/O队列，为空时使用同步的pread/pwrite
+    bool direct_io_ = false;                      // 新打开的数据文件是否使用O_DIRECT
+    bool direct_fd_[MAX_FD]{};                    // 文件是否以O_DIRECT方式打开，只在打开和关闭文件时修改
+    std::unique_ptr<CompressedFile> compressed_[MAX_FD];  // 压缩数据文件的页面映射层，普通文件为空，只在打开和关闭文件时修改
+    std::unordered_map<int, std::set<page_id_t>> fd2free_pages_;  // 每个文件中已经释放、可以重新分配的页面
+    std::mutex free_pages_latch_;                 // 保护fd2free_pages_
 };
\ No newline at end of file
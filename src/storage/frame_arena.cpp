@@ -0,0 +1,51 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/frame_arena.h"
+
+#include <sys/mman.h>
+
+#include <cstdint>
+
+#include "errors.h"
+
+/**
+ * @description: 为num_frames个帧申请页面数据的内存，mmap得到的匿名内存已经被清零
+ * @param {size_t} num_frames 帧的个数
+ */
+FrameArena::FrameArena(size_t num_frames) {
+    size_t size = (num_frames * PAGE_SIZE + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+
+    // 1.优先使用显式大页，映射本身就是按大页对齐的
+    mapping_ = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (mapping_ != MAP_FAILED) {
+        mapping_size_ = size;
+        base_ = static_cast<char *>(mapping_);
+        huge_page_ = true;
+        return;
+    }
+
+    // 2.退回普通页面：多映射一个大页，从中截取按大页对齐的一段，再建议内核使用透明大页
+    mapping_size_ = size + HUGE_PAGE_SIZE;
+    mapping_ = mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping_ == MAP_FAILED) {
+        mapping_ = nullptr;
+        throw UnixError();
+    }
+    auto addr = reinterpret_cast<uintptr_t>(mapping_);
+    base_ = reinterpret_cast<char *>((addr + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE);
+    madvise(base_, size, MADV_HUGEPAGE);
+}
+
+FrameArena::~FrameArena() {
+    if (mapping_ != nullptr) {
+        munmap(mapping_, mapping_size_);
+    }
+}
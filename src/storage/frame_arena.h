@@ -0,0 +1,45 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <cstddef>
+
+#include "common/config.h"
+
+/**
+ * @description: 缓冲池所有帧的页面数据所在的一整块连续内存。
+ * 内存通过mmap申请并按2MB对齐，优先使用显式大页(MAP_HUGETLB)，系统没有预留大页时退回普通页面并建议内核使用透明大页，
+ * 以减少遍历整个缓冲池时的TLB缺失。每一帧都按PAGE_SIZE对齐，可以直接用于O_DIRECT读写。
+ */
+class FrameArena {
+   public:
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    explicit FrameArena(size_t num_frames);
+
+    ~FrameArena();
+
+    FrameArena(const FrameArena &) = delete;
+
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    // 第frame_id帧的页面数据
+    char *get_frame(size_t frame_id) const { return base_ + frame_id * PAGE_SIZE; }
+
+    // 是否使用了显式大页
+    bool is_huge_page() const { return huge_page_; }
+
+   private:
+    char *base_ = nullptr;      // 按HUGE_PAGE_SIZE对齐的起始地址
+    void *mapping_ = nullptr;   // mmap返回的地址
+    size_t mapping_size_ = 0;   // mmap映射的大小
+    bool huge_page_ = false;
+};
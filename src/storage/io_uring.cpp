@@ -0,0 +1,222 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/io_uring.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "errors.h"
+
+static int io_uring_setup(unsigned entries, struct io_uring_params *params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int io_uring_enter(int ring_fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+/**
+ * @description: 创建io_uring并映射提交队列和完成队列
+ * @param {unsigned} queue_depth 提交队列大小，即同时未完成请求数的上限
+ */
+IoUring::IoUring(unsigned queue_depth) : queue_depth_(queue_depth) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ring_fd_ = io_uring_setup(queue_depth, &params);
+    if (ring_fd_ < 0) {
+        throw UnixError();
+    }
+    queue_depth_ = params.sq_entries;
+
+    // 1.映射提交队列和完成队列，新内核中二者可以共用一次mmap
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap) {
+        sq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    }
+    sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                    IORING_OFF_SQ_RING);
+    if (sq_ring_ == MAP_FAILED) {
+        sq_ring_ = nullptr;
+        close(ring_fd_);
+        throw UnixError();
+    }
+    if (single_mmap) {
+        cq_ring_ = sq_ring_;
+        cq_ring_size_ = 0;
+    } else {
+        cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                        IORING_OFF_CQ_RING);
+        if (cq_ring_ == MAP_FAILED) {
+            munmap(sq_ring_, sq_ring_size_);
+            close(ring_fd_);
+            throw UnixError();
+        }
+    }
+    // 2.映射提交队列项数组
+    sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+    void *sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                      IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        munmap(sq_ring_, sq_ring_size_);
+        if (cq_ring_size_ != 0) {
+            munmap(cq_ring_, cq_ring_size_);
+        }
+        close(ring_fd_);
+        throw UnixError();
+    }
+    sqes_ = static_cast<struct io_uring_sqe *>(sqes);
+
+    char *sq = static_cast<char *>(sq_ring_);
+    sq_head_ = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sq_mask_ = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+
+    char *cq = static_cast<char *>(cq_ring_);
+    cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cq_mask_ = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<struct io_uring_cqe *>(cq + params.cq_off.cqes);
+}
+
+IoUring::~IoUring() {
+    munmap(sqes_, sqes_size_);
+    if (cq_ring_size_ != 0) {
+        munmap(cq_ring_, cq_ring_size_);
+    }
+    munmap(sq_ring_, sq_ring_size_);
+    close(ring_fd_);
+}
+
+/**
+ * @description: 判断当前内核是否支持io_uring（容器中可能被seccomp禁用）
+ */
+bool IoUring::is_supported() {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = io_uring_setup(1, &params);
+    if (fd < 0) {
+        return false;
+    }
+    close(fd);
+    return true;
+}
+
+/**
+ * @description: 收割完成队列中所有已完成的请求，调用时必须持有latch_
+ */
+void IoUring::reap_completions() {
+    unsigned head = *cq_head_;
+    unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+        struct io_uring_cqe *cqe = &cqes_[head & *cq_mask_];
+        auto *request = reinterpret_cast<IoRequest *>(cqe->user_data);
+        request->result = cqe->res;
+        request->done = true;
+        inflight_--;
+        head++;
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+}
+
+/**
+ * @description: 提交一批请求，不等待它们完成。当未完成请求数达到queue_depth时，先等待已有请求完成
+ * @param {vector<IoRequest*>&} requests 需要提交的请求，在wait返回之前必须保持有效
+ */
+void IoUring::submit(std::vector<IoRequest *> &requests) {
+    std::unique_lock<std::mutex> lock{latch_};
+    unsigned to_submit = 0;
+    auto flush = [&]() {
+        while (to_submit > 0) {
+            int ret = io_uring_enter(ring_fd_, to_submit, 0, 0);
+            if (ret < 0) {
+                if (errno == EINTR || errno == EAGAIN) {
+                    continue;
+                }
+                throw UnixError();
+            }
+            to_submit -= ret;
+        }
+    };
+
+    for (auto *request : requests) {
+        // 1.队列已满时先把已填写的请求交给内核，再等待有请求完成
+        while (inflight_ >= queue_depth_) {
+            flush();
+            if (!reaping_) {
+                reaping_ = true;
+                lock.unlock();
+                io_uring_enter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS);
+                lock.lock();
+                reap_completions();
+                reaping_ = false;
+                cv_.notify_all();
+            } else {
+                cv_.wait(lock);
+            }
+        }
+        // 2.填写提交队列项
+        unsigned tail = *sq_tail_;
+        unsigned index = tail & *sq_mask_;
+        struct io_uring_sqe *sqe = &sqes_[index];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = request->is_write ? IORING_OP_WRITEV : IORING_OP_READV;
+        sqe->fd = request->fd;
+        sqe->off = request->offset;
+        sqe->addr = reinterpret_cast<unsigned long>(request->iov);
+        sqe->len = request->iovcnt;
+        sqe->user_data = reinterpret_cast<unsigned long>(request);
+        sq_array_[index] = index;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+
+        request->done = false;
+        inflight_++;
+        to_submit++;
+    }
+    // 3.把剩余的请求交给内核
+    flush();
+}
+
+/**
+ * @description: 等待一批已经提交的请求全部完成。同一时刻只有一个线程阻塞在完成队列上，由它唤醒其他等待者
+ * @param {vector<IoRequest*>&} requests 已经提交的请求
+ */
+void IoUring::wait(std::vector<IoRequest *> &requests) {
+    std::unique_lock<std::mutex> lock{latch_};
+    auto all_done = [&]() {
+        for (auto *request : requests) {
+            if (!request->done) {
+                return false;
+            }
+        }
+        return true;
+    };
+    while (!all_done()) {
+        if (!reaping_) {
+            reaping_ = true;
+            lock.unlock();
+            io_uring_enter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS);
+            lock.lock();
+            reap_completions();
+            reaping_ = false;
+            cv_.notify_all();
+        } else {
+            cv_.wait(lock);
+        }
+    }
+}
@@ -0,0 +1,80 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <linux/io_uring.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+/**
+ * @description: 一次异步读写请求，由调用者持有，直到IoUring::wait返回
+ */
+struct IoRequest {
+    int fd;                 // 磁盘文件的文件句柄
+    off_t offset;           // 在文件中的起始偏移
+    struct iovec *iov;      // 内存缓冲区数组
+    int iovcnt;             // 缓冲区个数
+    bool is_write;          // true表示写文件，false表示读文件
+    ssize_t result = 0;     // 完成后为实际读写的字节数，出错时为-errno
+    bool done = false;      // 请求是否已经完成
+};
+
+/**
+ * @description: 基于io_uring系统调用的异步I/O队列，不依赖liburing。
+ * 多个线程可以同时提交请求，提交后请求在内核中并发执行，最多同时存在queue_depth个未完成的请求；
+ * 等待完成的线程中同一时刻只有一个负责收割完成队列，并唤醒其他请求的所有者。
+ */
+class IoUring {
+   public:
+    explicit IoUring(unsigned queue_depth);
+
+    ~IoUring();
+
+    // 当前内核是否支持io_uring
+    static bool is_supported();
+
+    void submit(std::vector<IoRequest *> &requests);
+
+    void wait(std::vector<IoRequest *> &requests);
+
+   private:
+    void reap_completions();
+
+    int ring_fd_ = -1;
+    unsigned queue_depth_;      // 提交队列的大小，也是同时未完成请求数的上限
+    unsigned inflight_ = 0;     // 已提交但尚未收割的请求个数
+    bool reaping_ = false;      // 是否已经有线程在等待完成队列
+
+    // 提交队列，与内核共享
+    void *sq_ring_ = nullptr;
+    size_t sq_ring_size_ = 0;
+    unsigned *sq_head_;
+    unsigned *sq_tail_;
+    unsigned *sq_mask_;
+    unsigned *sq_array_;
+    struct io_uring_sqe *sqes_ = nullptr;
+    size_t sqes_size_ = 0;
+
+    // 完成队列，与内核共享
+    void *cq_ring_ = nullptr;
+    size_t cq_ring_size_ = 0;
+    unsigned *cq_head_;
+    unsigned *cq_tail_;
+    unsigned *cq_mask_;
+    struct io_uring_cqe *cqes_;
+
+    std::mutex latch_;                  // 保护提交队列和上面的计数
+    std::condition_variable cv_;        // 有请求完成或队列腾出空间时唤醒等待者
+};
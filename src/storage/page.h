@@ -10,6 +10,10 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <cstring>
+#include <ostream>
+#include <string>
+
 #include "common/config.h"
 #include "common/rwlatch.h"
 
@@ -53,16 +57,18 @@ struct std::hash<PageId> {
 
 /**
  * @description: Page类声明, Page是RMDB数据块的单位、是负责数据操作Record模块的操作对象，
- * Page对象在磁盘上有文件存储, 若在Buffer中则有帧偏移, 并非特指Buffer或Disk上的数据
+ * Page对象在磁盘上有文件存储, 若在Buffer中则有帧偏移, 并非特指Buffer或Disk上的数据。
+ * Page对象只是帧的描述符，页面数据存放在FrameArena中；描述符按缓存行对齐，相邻帧的元数据不会共享缓存行。
  */
-class Page {
+class alignas(CACHE_LINE_SIZE) Page {
     friend class BufferPoolManager;
+    friend class BufferPoolInstance;
 
 public:
 
     RWLatch rw_latch_;
 
-    Page() { reset_memory(); }
+    Page() = default;
 
     ~Page() = default;
 
@@ -93,13 +99,19 @@ private:
     PageId id_;
 
     /** The actual data that is stored within a page.
-     *  该页面在bufferPool中的偏移地址
+     *  该页面在FrameArena中的地址，由BufferPoolManager在构造时设置
      */
-    char data_[PAGE_SIZE] = {};
+    char *data_ = nullptr;
 
     /** 脏页判断 */
     bool is_dirty_ = false;
 
     /** The pin count of this page. */
     int pin_count_ = 0;
+
+    /** 页面正在从磁盘读入，数据尚不可用 */
+    bool is_loading_ = false;
+
+    /** 页面正在写回磁盘，此时不能被淘汰或删除 */
+    bool is_writing_ = false;
 };
\ No newline at end of file
@@ -104,7 +104,16 @@ void SmManager::open_db(const std::string &db_name) {
     for (auto & tab : db_.tabs_) {
         fhs_.emplace(tab.first, rm_manager_->open_file(tab.first));
         for (const auto &index: tab.second.indexes) {
-            ihs_.emplace(ix_manager_->get_index_name(tab.first, index.cols), ix_manager_->open_index(tab.first, index.cols));
+            std::string index_name = ix_manager_->get_index_name(tab.first, index.cols);
+            if (ix_manager_->is_current_version(tab.first, index.cols)) {
+                ihs_.emplace(index_name, ix_manager_->open_index(tab.first, index.cols));
+                continue;
+            }
+            // 旧格式的索引文件无法直接使用，按表中的数据重建
+            ix_manager_->destroy_index(tab.first, index.cols);
+            ix_manager_->create_index(tab.first, index.cols);
+            ihs_.emplace(index_name, ix_manager_->open_index(tab.first, index.cols));
+            build_index(tab.first, index, ihs_.at(index_name).get());
         }
 //        //TODO:为什么是去打开字段信息而不是索引信息呢？
 //        if (!tab.second.indexes.empty()) {
@@ -127,7 +136,11 @@ void SmManager::flush_meta() {
  * @description: 关闭数据库并把数据落盘
  */
 void SmManager::close_db() {
-    //
+    // 关闭索引时写回文件头，其中的file_lsn_让下次恢复跳过已经写回的索引日志
+    for (auto &[index_name, index_handle]: ihs_) {
+        ix_manager_->close_index(index_handle.get());
+    }
+    ihs_.clear();
     for (auto &[tab_name, tabfilehandle]: fhs_) {
         rm_manager_->close_file(&(*tabfilehandle));
         fhs_.erase(tab_name);
@@ -178,7 +191,8 @@ void SmManager::desc_table(const std::string &tab_name, Context *context) {
     printer.print_separator(context);
     // Print fields
     for (auto &col: tab.cols) {
-        std::vector<std::string> field_info = {col.name, coltype2str(col.type), col.index ? "YES" : "NO"};
+        std::vector<std::string> field_info = {col.name, col.is_varchar ? "VARCHAR" : coltype2str(col.type),
+                                               col.index ? "YES" : "NO"};
         printer.print_record(field_info, context);
     }
     // Print footer
@@ -190,8 +204,10 @@ void SmManager::desc_table(const std::string &tab_name, Context *context) {
  * @param {string&} tableName 表的名称
  * @param {vector<ColDef>&} col_defs 表的字段
  * @param {Context*} context
+ * @param {TabOptions&} options 表选项
  */
-void SmManager::create_table(const std::string &tab_name, const std::vector<ColDef> &col_defs, Context *context) {
+void SmManager::create_table(const std::string &tab_name, const std::vector<ColDef> &col_defs, Context *context,
+                             const TabOptions &options) {
     if (db_.is_table(tab_name)) {
         throw TableExistsError(tab_name);
     }
@@ -199,19 +215,38 @@ void SmManager::create_table(const std::string &tab_name, const std::vector<ColD
     int curr_offset = 0;
     TabMeta tab;
     tab.name = tab_name;
+    std::vector<RmColRange> var_cols;
+    std::vector<RmColRange> pax_cols;
     for (auto &col_def: col_defs) {
         ColMeta col = {.tab_name = tab_name,
                 .name = col_def.name,
                 .type = col_def.type,
                 .len = col_def.len,
                 .offset = curr_offset,
-                .index = false};
+                .index = false,
+                .is_varchar = col_def.is_varchar};
+        if (col.is_varchar) {
+            var_cols.push_back(RmColRange{static_cast<short>(curr_offset), static_cast<short>(col_def.len)});
+        }
+        if (options.columnar) {
+            pax_cols.push_back(RmColRange{static_cast<short>(curr_offset), static_cast<short>(col_def.len)});
+        }
         curr_offset += col_def.len;
         tab.cols.push_back(col);
     }
     // Create & open record file
     int record_size = curr_offset;  // record_size就是col meta所占的大小（表的元数据也是以记录的形式进行存储的）
-    rm_manager_->create_file(tab_name, record_size);
+    rm_manager_->create_file(tab_name, record_size, var_cols, options.compressed, pax_cols);
+    // INT、FLOAT字段维护每个页面的取值范围，顺序扫描时跳过不可能满足条件的页面
+    std::vector<RmZoneCol> zone_cols;
+    for (auto &col: tab.cols) {
+        if (col.type == TYPE_INT || col.type == TYPE_FLOAT) {
+            zone_cols.push_back(RmZoneCol{col.offset, col.type});
+        }
+    }
+    if (!zone_cols.empty()) {
+        rm_manager_->create_zone_map(tab_name, zone_cols);
+    }
     db_.tabs_[tab_name] = tab;
     // fhs_[tableName] = rm_manager_->open_file(tableName);
     fhs_.emplace(tab_name, rm_manager_->open_file(tab_name));
@@ -292,8 +327,6 @@ void SmManager::create_index(const std::string &tab_name, const std::vector<std:
     }
     db_.get_table(tab_name).indexes.push_back(index);
 
-    char *key = new char[index.col_tot_len];
-
     buffer_pool_manager_->unpin_page(page->get_page_id(), false);
     disk_manager_->close_file(fd);
 
@@ -303,21 +336,13 @@ void SmManager::create_index(const std::string &tab_name, const std::vector<std:
 
     // 6. 将表已存在的record创建索引
     auto tab = db_.get_table(tab_name);
-    auto file_hdl = fhs_.at(tab_name).get();
-    for (RmScan rm_scan(file_hdl); !rm_scan.is_end(); rm_scan.next()) {
-        auto rec = file_hdl->get_record(rm_scan.rid(), context);
-        int offset = 0;
-        for (size_t i = 0; i < index.col_num; ++i) {
-            memcpy(key + offset, rec->data + index.cols[i].offset, index.cols[i].len);
-            offset += index.cols[i].len;
-        }
-//        ix_hdl->insert_entry(key, rm_scan.rid(), context->txn_);
-        if (context != nullptr) {
-            ix_hdl->insert_entry(key, rm_scan.rid(), context->txn_);
-        } else {
-            ix_hdl->insert_entry(key, rm_scan.rid(), nullptr);
-        }
-
+    try {
+        build_index(tab_name, index, ix_hdl);
+    } catch (RMDBError &) {
+        // 建立失败（例如有重复的键）时删除不完整的索引
+        drop_index(tab_name, col_names, nullptr);
+        flush_meta();
+        throw;
     }
 
 //    if (nullptr != context) {
@@ -329,6 +354,32 @@ void SmManager::create_index(const std::string &tab_name, const std::vector<std:
     flush_meta();
 }
 
+/**
+ * @description: 用表中已有的记录填充新建的空索引：取出所有键排序后自底向上建立B+树，不再逐个插入
+ * @param {string&} tab_name 表名称
+ * @param {IndexMeta&} index 索引的元数据
+ * @param {IxIndexHandle*} ih 新建的索引
+ */
+void SmManager::build_index(const std::string &tab_name, const IndexMeta &index, IxIndexHandle *ih) {
+    auto file_hdl = fhs_.at(tab_name).get();
+    std::vector<char> key(index.col_tot_len);
+    IxBulkLoader bulk_loader(ih);
+    RmRecordView view;
+    for (RmScan rm_scan(file_hdl); !rm_scan.is_end(); rm_scan.next()) {
+        file_hdl->get_record_view(rm_scan.rid(), view);
+        int offset = 0;
+        for (size_t i = 0; i < index.col_num; ++i) {
+            memcpy(key.data() + offset, view.data() + index.cols[i].offset, index.cols[i].len);
+            offset += index.cols[i].len;
+        }
+        bulk_loader.add(key.data(), rm_scan.rid());
+    }
+    view.release();
+    bulk_loader.finish();
+    // 批量建立的结点不写日志，建好后立即写回，恢复时不再需要重建索引
+    ix_manager_->flush_index(ih);
+}
+
 /**
  * @description: 删除索引
  * @param {string&} tableName 表名称
@@ -416,4 +467,42 @@ void SmManager::show_index(std::string tab_name, Context *context) {
     } catch (std::exception &e) {
         std::cerr << "sm_manager show_index() only pingcas can do" << e.what() << std::endl;
     }
-}
\ No newline at end of file
+}
+/**
+ * @description: 整理表及其索引的文件，释放空页面并截断文件末尾的空闲页面
+ * @param {string&} tab_name 表名称，为空时整理所有的表
+ * @param {Context*} context
+ */
+void SmManager::vacuum(const std::string &tab_name, Context *context) {
+    std::vector<std::string> tab_names;
+    if (tab_name.empty()) {
+        for (auto &entry: db_.tabs_) {
+            tab_names.push_back(entry.first);
+        }
+    } else {
+        if (!db_.is_table(tab_name)) {
+            throw TableNotFoundError(tab_name);
+        }
+        tab_names.push_back(tab_name);
+    }
+
+    std::vector<std::string> captions = {"Table", "Pages", "Free pages"};
+    RecordPrinter printer(captions.size());
+    printer.print_separator(context);
+    printer.print_record(captions, context);
+    printer.print_separator(context);
+    for (auto &name: tab_names) {
+        auto file_handle = fhs_.at(name).get();
+        // vacuum会让已删除记录的位置重新可用，需要等待其他事务释放本表的锁
+        if (context != nullptr) {
+            context->lock_mgr_->lock_exclusive_on_table(context->txn_, file_handle->GetFd());
+        }
+        int free_pages = file_handle->vacuum();
+        for (auto &index: db_.get_table(name).indexes) {
+            ihs_.at(ix_manager_->get_index_name(name, index.cols))->vacuum();
+        }
+        printer.print_record({name, std::to_string(file_handle->get_file_hdr().num_pages), std::to_string(free_pages)},
+                             context);
+    }
+    printer.print_separator(context);
+}
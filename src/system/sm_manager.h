@@ -23,6 +23,13 @@ struct ColDef {
     std::string name;       // 字段名称
     ColType type;           // 字段类型
     int len;                // 字段长度
+    bool is_varchar = false;    // 是否为VARCHAR字段
+};
+
+/* CREATE TABLE ... WITH (...)中指定的表选项 */
+struct TabOptions {
+    bool compressed = false;    // compression = lz4：数据文件中的页面压缩存放
+    bool columnar = false;      // layout = columnar：数据页按字段划分为minipage存放（PAX）
 };
 
 class record_unpin_guard {
@@ -84,9 +91,12 @@ public:
 
     void show_index(std::string tab_name, Context *context);
 
+    void vacuum(const std::string &tab_name, Context *context);
+
     void desc_table(const std::string &tab_name, Context *context);
 
-    void create_table(const std::string &tab_name, const std::vector<ColDef> &col_defs, Context *context);
+    void create_table(const std::string &tab_name, const std::vector<ColDef> &col_defs, Context *context,
+                      const TabOptions &options = {});
 
     void drop_table(const std::string &tab_name, Context *context);
 
@@ -95,4 +105,7 @@ public:
     void drop_index(const std::string &tab_name, const std::vector<std::string> &col_names, Context *context);
 
     void drop_index(const std::string &tab_name, const std::vector<ColMeta> &col_names, Context *context);
+
+private:
+    void build_index(const std::string &tab_name, const IndexMeta &index, IxIndexHandle *ih);
 };
\ No newline at end of file
@@ -26,15 +26,16 @@ struct ColMeta {
     int len;                // 字段长度
     int offset;             // 字段位于记录中的偏移量
     bool index;             /** unused */
+    bool is_varchar = false;    // VARCHAR字段：内存中按最大长度存放，数据文件中只存放实际长度
 
     friend std::ostream &operator<<(std::ostream &os, const ColMeta &col) {
         // ColMeta中有各个基本类型的变量，然后调用重载的这些变量的操作符<<（具体实现逻辑在defs.h）
         return os << col.tab_name << ' ' << col.name << ' ' << col.type << ' ' << col.len << ' ' << col.offset << ' '
-                  << col.index;
+                  << col.index << ' ' << col.is_varchar;
     }
 
     friend std::istream &operator>>(std::istream &is, ColMeta &col) {
-        return is >> col.tab_name >> col.name >> col.type >> col.len >> col.offset >> col.index;
+        return is >> col.tab_name >> col.name >> col.type >> col.len >> col.offset >> col.index >> col.is_varchar;
     }
 };
 
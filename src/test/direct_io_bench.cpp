@@ -0,0 +1,164 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+/**
+ * O_DIRECT的微基准测试：比较经过页缓存和绕过页缓存时，缓冲池随机访问的吞吐量与内存占用。
+ * 用法: direct_io_bench [num_pages] [pool_size] [num_threads]
+ * 默认文件大小为缓冲池的2倍。内存占用包括进程的RSS和测试文件在内核页缓存中的页面数，
+ * 不使用O_DIRECT时这两部分会重复缓存同一份数据。
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "storage/buffer_pool_manager.h"
+#include "storage/disk_manager.h"
+
+static const std::string BENCH_FILE_NAME = "direct_io_bench.dat";
+static constexpr int READS_PER_THREAD = 50000;
+static constexpr int BATCH_SIZE = 64;
+
+using bench_clock = std::chrono::steady_clock;
+
+// 读取/proc/self/status中的VmRSS，单位KB
+static long get_rss_kb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmRSS:") == 0) {
+            return atol(line.c_str() + 6);
+        }
+    }
+    return -1;
+}
+
+// 统计文件在内核页缓存中的页面数
+static long get_cached_pages(const std::string &path, int num_pages) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    size_t length = static_cast<size_t>(num_pages) * PAGE_SIZE;
+    void *addr = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        return -1;
+    }
+    size_t os_page_size = sysconf(_SC_PAGESIZE);
+    std::vector<unsigned char> resident((length + os_page_size - 1) / os_page_size);
+    long cached = 0;
+    if (mincore(addr, length, resident.data()) == 0) {
+        for (unsigned char r : resident) {
+            cached += r & 1;
+        }
+    }
+    munmap(addr, length);
+    return cached * static_cast<long>(os_page_size) / PAGE_SIZE;
+}
+
+// 把测试文件从页缓存中清除，两种模式从相同的状态开始
+static void drop_page_cache(const std::string &path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fdatasync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+}
+
+static void bench_mode(const char *mode, bool direct_io, int num_pages, size_t pool_size, int num_threads) {
+    drop_page_cache(BENCH_FILE_NAME);
+    DiskManager disk_manager;
+    disk_manager.set_direct_io(direct_io);
+    int fd = disk_manager.open_file(BENCH_FILE_NAME);
+    disk_manager.set_fd2pageno(fd, num_pages);
+    if (direct_io && !disk_manager.is_direct_fd(fd)) {
+        printf("%-10s O_DIRECT is not supported by the file system\n", mode);
+        disk_manager.close_file(fd);
+        return;
+    }
+
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(pool_size, &disk_manager);
+    auto start = bench_clock::now();
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&, tid]() {
+            std::mt19937 rng(tid);
+            for (int i = 0; i < READS_PER_THREAD; i++) {
+                PageId page_id = {.fd = fd, .page_no = static_cast<page_id_t>(rng() % num_pages)};
+                Page *page = buffer_pool_manager->fetch_page(page_id);
+                if (page == nullptr) {
+                    continue;
+                }
+                buffer_pool_manager->unpin_page(page_id, i % 8 == 0);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    buffer_pool_manager->flush_all_pages(fd);
+    double seconds = std::chrono::duration<double>(bench_clock::now() - start).count();
+    long total_reads = static_cast<long>(READS_PER_THREAD) * num_threads;
+    long rss_kb = get_rss_kb();
+    long cached_pages = get_cached_pages(BENCH_FILE_NAME, num_pages);
+    printf("%-10s %8.3f s %12.0f fetches/s   rss %8.1f MB   page cache %8.1f MB   total %8.1f MB\n", mode, seconds,
+           total_reads / seconds, rss_kb / 1024.0, cached_pages * PAGE_SIZE / 1048576.0,
+           rss_kb / 1024.0 + cached_pages * PAGE_SIZE / 1048576.0);
+    buffer_pool_manager.reset();
+    disk_manager.close_file(fd);
+}
+
+int main(int argc, char **argv) {
+    size_t pool_size = argc > 2 ? atol(argv[2]) : BUFFER_POOL_SIZE / 4;
+    int num_pages = argc > 1 ? atoi(argv[1]) : static_cast<int>(pool_size * 2);
+    int num_threads = argc > 3 ? atoi(argv[3]) : 8;
+    printf("file: %d pages (%.1f MB), buffer pool: %zu pages (%.1f MB), threads: %d\n", num_pages,
+           static_cast<double>(num_pages) * PAGE_SIZE / (1 << 20), pool_size,
+           static_cast<double>(pool_size) * PAGE_SIZE / (1 << 20), num_threads);
+
+    // 准备测试文件
+    {
+        DiskManager disk_manager;
+        if (disk_manager.is_file(BENCH_FILE_NAME)) {
+            disk_manager.destroy_file(BENCH_FILE_NAME);
+        }
+        disk_manager.create_file(BENCH_FILE_NAME);
+        int fd = disk_manager.open_file(BENCH_FILE_NAME);
+        std::vector<char> buf(static_cast<size_t>(PAGE_SIZE) * BATCH_SIZE, 'x');
+        std::vector<std::pair<page_id_t, const char *>> batch;
+        for (int page_no = 0; page_no < num_pages; page_no += BATCH_SIZE) {
+            batch.clear();
+            for (int j = 0; j < BATCH_SIZE && page_no + j < num_pages; j++) {
+                batch.emplace_back(page_no + j, buf.data() + static_cast<size_t>(j) * PAGE_SIZE);
+            }
+            disk_manager.write_pages(fd, batch);
+        }
+        disk_manager.close_file(fd);
+    }
+
+    bench_mode("buffered", false, num_pages, pool_size, num_threads);
+    bench_mode("O_DIRECT", true, num_pages, pool_size, num_threads);
+
+    DiskManager().destroy_file(BENCH_FILE_NAME);
+    return 0;
+}
@@ -0,0 +1,163 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+/**
+ * 磁盘I/O后端的微基准测试：比较同步pread/pwrite与io_uring。
+ * 用法: disk_io_bench [num_pages] [num_threads]
+ * 默认的文件大小为BUFFER_POOL_SIZE的1.25倍，因此经过缓冲池的随机访问一定会缺页。
+ * 测试文件写入后仍在内核页缓存中，若要测量真实磁盘的延迟，运行前需要清空页缓存。
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "storage/buffer_pool_manager.h"
+#include "storage/disk_manager.h"
+
+static const std::string BENCH_FILE_NAME = "disk_io_bench.dat";
+static constexpr int READS_PER_THREAD = 20000;
+static constexpr int BATCH_SIZE = 64;
+
+using bench_clock = std::chrono::steady_clock;
+
+// 用num_threads个线程并发执行work(tid)，返回耗时（秒）
+template <typename F>
+static double run_threads(int num_threads, F work) {
+    auto start = bench_clock::now();
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back(work, tid);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    return std::chrono::duration<double>(bench_clock::now() - start).count();
+}
+
+static void report(const char *backend, const char *workload, long pages, double seconds) {
+    printf("%-10s %-28s %10ld pages %8.3f s %12.0f pages/s\n", backend, workload, pages, seconds, pages / seconds);
+}
+
+static void bench_backend(const char *backend, DiskManager *disk_manager, int fd, int num_pages, int num_threads) {
+    long total_reads = static_cast<long>(READS_PER_THREAD) * num_threads;
+
+    // 1.每个线程逐页随机读取
+    double seconds = run_threads(num_threads, [&](int tid) {
+        std::mt19937 rng(tid);
+        std::vector<char> buf(PAGE_SIZE);
+        for (int i = 0; i < READS_PER_THREAD; i++) {
+            disk_manager->read_page(fd, rng() % num_pages, buf.data(), PAGE_SIZE);
+        }
+    });
+    report(backend, "random read_page", total_reads, seconds);
+
+    // 2.每个线程每次批量读取BATCH_SIZE个随机页面
+    seconds = run_threads(num_threads, [&](int tid) {
+        std::mt19937 rng(tid);
+        std::vector<char> buf(static_cast<size_t>(PAGE_SIZE) * BATCH_SIZE);
+        std::vector<std::pair<page_id_t, char *>> batch;
+        for (int i = 0; i < READS_PER_THREAD; i += BATCH_SIZE) {
+            batch.clear();
+            for (int j = 0; j < BATCH_SIZE; j++) {
+                batch.emplace_back(rng() % num_pages, buf.data() + static_cast<size_t>(j) * PAGE_SIZE);
+            }
+            disk_manager->read_pages(fd, batch);
+        }
+    });
+    report(backend, "random read_pages (batch)", total_reads, seconds);
+
+    // 3.每个线程顺序批量读取文件中属于自己的一段
+    seconds = run_threads(num_threads, [&](int tid) {
+        std::vector<char> buf(static_cast<size_t>(PAGE_SIZE) * BATCH_SIZE);
+        std::vector<std::pair<page_id_t, char *>> batch;
+        int begin = static_cast<int>(static_cast<long>(num_pages) * tid / num_threads);
+        int end = static_cast<int>(static_cast<long>(num_pages) * (tid + 1) / num_threads);
+        for (int page_no = begin; page_no < end; page_no += BATCH_SIZE) {
+            batch.clear();
+            for (int j = 0; j < BATCH_SIZE && page_no + j < end; j++) {
+                batch.emplace_back(page_no + j, buf.data() + static_cast<size_t>(j) * PAGE_SIZE);
+            }
+            disk_manager->read_pages(fd, batch);
+        }
+    });
+    report(backend, "sequential read_pages", num_pages, seconds);
+
+    // 4.经过缓冲池随机访问，文件大于缓冲池，缺页时由DiskManager读入并写回被修改的页面
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager);
+    seconds = run_threads(num_threads, [&](int tid) {
+        std::mt19937 rng(tid);
+        for (int i = 0; i < READS_PER_THREAD; i++) {
+            PageId page_id = {.fd = fd, .page_no = static_cast<page_id_t>(rng() % num_pages)};
+            Page *page = buffer_pool_manager->fetch_page(page_id);
+            if (page == nullptr) {
+                continue;
+            }
+            buffer_pool_manager->unpin_page(page_id, i % 8 == 0);
+        }
+    });
+    buffer_pool_manager->flush_all_pages(fd);
+    report(backend, "buffer pool fetch (12% dirty)", total_reads, seconds);
+}
+
+int main(int argc, char **argv) {
+    int num_pages = argc > 1 ? atoi(argv[1]) : BUFFER_POOL_SIZE + BUFFER_POOL_SIZE / 4;
+    int num_threads = argc > 2 ? atoi(argv[2]) : 16;
+    printf("file: %d pages (%.1f MB), buffer pool: %d pages, threads: %d\n", num_pages,
+           static_cast<double>(num_pages) * PAGE_SIZE / (1 << 20), BUFFER_POOL_SIZE, num_threads);
+
+    // 准备测试文件
+    {
+        DiskManager disk_manager;
+        if (disk_manager.is_file(BENCH_FILE_NAME)) {
+            disk_manager.destroy_file(BENCH_FILE_NAME);
+        }
+        disk_manager.create_file(BENCH_FILE_NAME);
+        int fd = disk_manager.open_file(BENCH_FILE_NAME);
+        std::vector<char> buf(static_cast<size_t>(PAGE_SIZE) * BATCH_SIZE, 'x');
+        std::vector<std::pair<page_id_t, const char *>> batch;
+        for (int page_no = 0; page_no < num_pages; page_no += BATCH_SIZE) {
+            batch.clear();
+            for (int j = 0; j < BATCH_SIZE && page_no + j < num_pages; j++) {
+                batch.emplace_back(page_no + j, buf.data() + static_cast<size_t>(j) * PAGE_SIZE);
+            }
+            disk_manager.write_pages(fd, batch);
+        }
+        disk_manager.close_file(fd);
+    }
+
+    {
+        DiskManager disk_manager;
+        int fd = disk_manager.open_file(BENCH_FILE_NAME);
+        disk_manager.set_fd2pageno(fd, num_pages);
+        bench_backend("sync", &disk_manager, fd, num_pages, num_threads);
+        disk_manager.close_file(fd);
+    }
+
+    {
+        DiskManager disk_manager;
+        if (!disk_manager.enable_io_uring()) {
+            printf("io_uring is not supported on this kernel\n");
+        } else {
+            int fd = disk_manager.open_file(BENCH_FILE_NAME);
+            disk_manager.set_fd2pageno(fd, num_pages);
+            bench_backend("io_uring", &disk_manager, fd, num_pages, num_threads);
+            disk_manager.close_file(fd);
+        }
+    }
+
+    DiskManager().destroy_file(BENCH_FILE_NAME);
+    return 0;
+}
@@ -0,0 +1,104 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+/**
+ * 在已有数据上建立索引的微基准测试：比较逐个键调用insert_entry与IxBulkLoader批量建立。
+ * 用法: ix_bulk_load_bench [num_keys] [sort_memory_kb]
+ * 随机顺序的num_keys个INT键，分别用两种方式建立索引，给出耗时、结点页面数和点查询的结果是否一致。
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "errors.h"
+#include "index/ix.h"
+
+using bench_clock = std::chrono::steady_clock;
+
+static constexpr int POOL_FRAMES = 65536;
+
+static std::unique_ptr<IxIndexHandle> create(IxManager *ix_manager, const std::string &filename,
+                                             const std::vector<ColMeta> &cols) {
+    if (ix_manager->exists(filename, cols)) {
+        ix_manager->destroy_index(filename, cols);
+    }
+    ix_manager->create_index(filename, cols);
+    return ix_manager->open_index(filename, cols);
+}
+
+static void destroy(IxManager *ix_manager, IxIndexHandle *ih, const std::string &filename) {
+    ix_manager->close_index(ih);
+    ix_manager->destroy_index(ih, filename, std::vector<std::string>{"id"});
+}
+
+int main(int argc, char **argv) {
+    int num_keys = argc > 1 ? atoi(argv[1]) : 1000000;
+    size_t sort_memory = argc > 2 ? static_cast<size_t>(atoi(argv[2])) << 10 : IX_BULK_LOAD_SORT_MEMORY;
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto bpm = std::make_unique<BufferPoolManager>(POOL_FRAMES, disk_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), bpm.get());
+    std::vector<ColMeta> cols = {ColMeta{"bench", "id", TYPE_INT, sizeof(int), 0, true}};
+
+    std::vector<int> ids(num_keys);
+    for (int i = 0; i < num_keys; i++) {
+        ids[i] = i * 2 - num_keys;
+    }
+    std::shuffle(ids.begin(), ids.end(), std::mt19937(0));
+    printf("keys: %d, sort memory: %zu KB\n", num_keys, sort_memory >> 10);
+
+    // 1. 逐个插入
+    auto ih = create(ix_manager.get(), "ix_insert_bench", cols);
+    auto start = bench_clock::now();
+    for (int i = 0; i < num_keys; i++) {
+        ih->insert_entry(reinterpret_cast<const char *>(&ids[i]), Rid{ids[i], 0}, nullptr);
+    }
+    double insert_sec = std::chrono::duration<double>(bench_clock::now() - start).count();
+    int insert_pages = ih->getFileHdr().num_pages_;
+
+    // 2. 批量建立
+    auto bulk = create(ix_manager.get(), "ix_bulk_bench", cols);
+    start = bench_clock::now();
+    size_t num_runs;
+    {
+        IxBulkLoader loader(bulk.get(), IX_BULK_LOAD_FILL_PERCENT, sort_memory);
+        for (int i = 0; i < num_keys; i++) {
+            loader.add(reinterpret_cast<const char *>(&ids[i]), Rid{ids[i], 0});
+        }
+        loader.finish();
+        num_runs = loader.num_runs();
+    }
+    double bulk_sec = std::chrono::duration<double>(bench_clock::now() - start).count();
+    int bulk_pages = bulk->getFileHdr().num_pages_;
+
+    int mismatch = 0;
+    for (int i = 0; i < num_keys; i += 7) {
+        int key = i - num_keys;
+        std::vector<Rid> a, b;
+        if (ih->get_value(reinterpret_cast<const char *>(&key), &a, nullptr) !=
+                bulk->get_value(reinterpret_cast<const char *>(&key), &b, nullptr) ||
+            a.size() != b.size() || (!a.empty() && a[0].page_no != b[0].page_no)) {
+            mismatch++;
+        }
+    }
+
+    printf("insert_entry  %8.3f s  %8d pages\n", insert_sec, insert_pages);
+    printf("bulk load     %8.3f s  %8d pages  %zu sorted runs, %d%% fill  (%s)\n", bulk_sec, bulk_pages, num_runs,
+           IX_BULK_LOAD_FILL_PERCENT, mismatch == 0 ? "same result" : "MISMATCH");
+
+    destroy(ix_manager.get(), ih.get(), "ix_insert_bench");
+    destroy(ix_manager.get(), bulk.get(), "ix_bulk_bench");
+    return 0;
+}
@@ -0,0 +1,166 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+/**
+ * B+树点查询的微基准测试：比较结点内逐个调用ix_compare的顺序查找与编码后的键上的二分查找。
+ * 用法: ix_search_bench [num_keys] [num_lookups]
+ * 分别对单个INT字段和(INT, CHAR(16))两种索引，随机插入num_keys个键，然后：
+ * 1. 对同一批叶子结点，分别用原来的顺序查找（键还原为记录中的格式）和IxNodeHandle::lower_bound查找，比较单个结点内的查找耗时；
+ * 2. 通过IxIndexHandle::get_value执行完整的点查询，给出每秒点查询次数。
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "errors.h"
+#include "index/ix_manager.h"
+
+using bench_clock = std::chrono::steady_clock;
+
+static constexpr int STR_LEN = 16;
+static constexpr int POOL_FRAMES = 4096;
+
+// 修改之前IxNodeHandle::lower_bound的实现：逐个键调用ix_compare
+static int linear_lower_bound(const char *keys, int num_key, const char *target, const IxFileHdr &hdr) {
+    int key_idx = 0;
+    for (; key_idx < num_key; key_idx++) {
+        if (ix_compare(target, keys + key_idx * hdr.col_tot_len_, hdr.col_types_, hdr.col_lens_) <= 0) {
+            break;
+        }
+    }
+    return key_idx;
+}
+
+static void make_key(int id, bool composite, char *key) {
+    memcpy(key, &id, sizeof(int));
+    if (composite) {
+        // 字符串部分对所有键相同，比较需要走完整个键
+        memset(key + sizeof(int), 0, STR_LEN);
+        snprintf(key + sizeof(int), STR_LEN, "key-%d", id % 7);
+    }
+}
+
+static void run(IxManager *ix_manager, BufferPoolManager *bpm, bool composite, int num_keys, int num_lookups) {
+    std::vector<ColMeta> cols = {ColMeta{"bench", "id", TYPE_INT, sizeof(int), 0, true}};
+    if (composite) {
+        cols.push_back(ColMeta{"bench", "name", TYPE_STRING, STR_LEN, sizeof(int), true});
+    }
+    std::string filename = "ix_search_bench";
+    if (ix_manager->exists(filename, cols)) {
+        ix_manager->destroy_index(filename, cols);
+    }
+    ix_manager->create_index(filename, cols);
+    auto ih = ix_manager->open_index(filename, cols);
+    IxFileHdr hdr = ih->getFileHdr();
+
+    std::mt19937 rng(0);
+    std::vector<int> ids(num_keys);
+    for (int i = 0; i < num_keys; i++) {
+        ids[i] = i * 2 - num_keys;
+    }
+    std::shuffle(ids.begin(), ids.end(), rng);
+    char key[IX_MAX_COL_LEN];
+    for (int i = 0; i < num_keys; i++) {
+        make_key(ids[i], composite, key);
+        ih->insert_entry(key, Rid{i, 0}, nullptr);
+    }
+
+    // 查找的目标，一半存在一半不存在
+    std::vector<std::vector<char>> targets(num_lookups, std::vector<char>(hdr.col_tot_len_));
+    std::vector<std::vector<char>> encoded(num_lookups, std::vector<char>(hdr.col_tot_len_));
+    for (int i = 0; i < num_lookups; i++) {
+        int id = static_cast<int>(rng() % (2 * num_keys)) - num_keys;
+        make_key(id, composite, targets[i].data());
+        ix_encode_key(targets[i].data(), encoded[i].data(), hdr.col_types_, hdr.col_lens_);
+    }
+
+    // 1. 结点内查找：每个目标所在的叶子结点，键分别还原为原始格式和保留编码格式
+    std::unordered_map<page_id_t, std::pair<IxNodeHandle *, std::vector<char>>> leaf_map;
+    std::vector<std::pair<IxNodeHandle *, std::vector<char>> *> leaves(num_lookups);
+    for (int i = 0; i < num_lookups; i++) {
+        // find_leaf_page返回加了读latch的叶子结点，释放之后单线程下再固定一次，供下面的计时使用
+        IxNodeHandle *leaf = ih->find_leaf_page(targets[i].data(), Operation::FIND, nullptr).first;
+        PageId page_id = leaf->get_page_id();
+        ih->release_leaf(leaf, Operation::FIND, false);
+        auto &entry = leaf_map[page_id.page_no];
+        if (entry.first == nullptr) {
+            leaf = new IxNodeHandle(&hdr, bpm->fetch_page(page_id));
+            entry.first = leaf;
+            entry.second.resize(static_cast<size_t>(leaf->get_size()) * hdr.col_tot_len_);
+            for (int k = 0; k < leaf->get_size(); k++) {
+                ix_decode_key(leaf->get_key(k), entry.second.data() + k * hdr.col_tot_len_, hdr.col_types_,
+                              hdr.col_lens_);
+            }
+        }
+        leaves[i] = &entry;
+    }
+    long checksum_linear = 0;
+    auto start = bench_clock::now();
+    for (int i = 0; i < num_lookups; i++) {
+        checksum_linear += linear_lower_bound(leaves[i]->second.data(), leaves[i]->first->get_size(),
+                                              targets[i].data(), hdr);
+    }
+    double linear_sec = std::chrono::duration<double>(bench_clock::now() - start).count();
+    long checksum_binary = 0;
+    start = bench_clock::now();
+    for (int i = 0; i < num_lookups; i++) {
+        checksum_binary += leaves[i]->first->lower_bound(encoded[i].data());
+    }
+    double binary_sec = std::chrono::duration<double>(bench_clock::now() - start).count();
+    for (auto &[page_no, entry] : leaf_map) {
+        bpm->unpin_page(entry.first->get_page_id(), false);
+        delete entry.first;
+    }
+
+    // 2. 完整的点查询
+    int found = 0;
+    std::vector<Rid> result;
+    start = bench_clock::now();
+    for (int i = 0; i < num_lookups; i++) {
+        result.clear();
+        found += ih->get_value(targets[i].data(), &result, nullptr);
+    }
+    double lookup_sec = std::chrono::duration<double>(bench_clock::now() - start).count();
+
+    const char *name = composite ? "(int, char16)" : "int";
+    printf("%-14s keys/node %4d  linear %8.1f ns/node  binary %8.1f ns/node  (%s)\n", name, hdr.btree_order_,
+           linear_sec * 1e9 / num_lookups, binary_sec * 1e9 / num_lookups,
+           checksum_linear == checksum_binary ? "same result" : "MISMATCH");
+    printf("%-14s point lookups %12.0f /s, found %d of %d\n", name, num_lookups / lookup_sec, found, num_lookups);
+
+    // 同时删除缓冲池中的页面，避免下一个索引文件复用同一个fd时读到旧页面
+    ix_manager->close_index(ih.get());
+    std::vector<std::string> col_names;
+    for (const auto &col : cols) {
+        col_names.push_back(col.name);
+    }
+    ix_manager->destroy_index(ih.get(), filename, col_names);
+}
+
+int main(int argc, char **argv) {
+    int num_keys = argc > 1 ? atoi(argv[1]) : 200000;
+    int num_lookups = argc > 2 ? atoi(argv[2]) : 200000;
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto bpm = std::make_unique<BufferPoolManager>(POOL_FRAMES, disk_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), bpm.get());
+    printf("keys: %d, lookups: %d\n", num_keys, num_lookups);
+    run(ix_manager.get(), bpm.get(), false, num_keys, num_lookups);
+    run(ix_manager.get(), bpm.get(), true, num_keys, num_lookups);
+    return 0;
+}
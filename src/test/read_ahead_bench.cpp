@@ -0,0 +1,92 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+/**
+ * 顺序扫描预读的基准测试：模拟RmScan逐页扫描一个比缓冲池大的文件，比较有无read_ahead提示的耗时。
+ * 用法: read_ahead_bench [num_pages] [passes]
+ * 每个页面都做一次校验和计算，代表扫描算子在页面上的CPU开销，预读可以让磁盘读取与这部分计算重叠。
+ * 测试文件写入后仍在内核页缓存中，若要测量真实磁盘的效果，运行前需要清空页缓存。
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "storage/buffer_pool_manager.h"
+#include "storage/disk_manager.h"
+
+static const std::string BENCH_FILE_NAME = "read_ahead_bench.dat";
+static constexpr int BATCH_SIZE = 64;
+
+using bench_clock = std::chrono::steady_clock;
+
+static double scan(DiskManager *disk_manager, int fd, int num_pages, bool use_read_ahead, unsigned long *checksum) {
+    // 每次扫描使用新的缓冲池，保证所有页面都需要从磁盘读取
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE / 4, disk_manager);
+    ReadAheadState state;
+    auto start = bench_clock::now();
+    for (int page_no = 0; page_no < num_pages; page_no++) {
+        PageId page_id = {.fd = fd, .page_no = page_no};
+        if (use_read_ahead) {
+            buffer_pool_manager->read_ahead(page_id, num_pages, &state);
+        }
+        Page *page = buffer_pool_manager->fetch_page(page_id);
+        const char *data = page->get_data();
+        for (int i = 0; i < PAGE_SIZE; i++) {
+            *checksum = *checksum * 31 + static_cast<unsigned char>(data[i]);
+        }
+        buffer_pool_manager->unpin_page(page_id, false);
+    }
+    double seconds = std::chrono::duration<double>(bench_clock::now() - start).count();
+    buffer_pool_manager->flush_all_pages(fd);
+    return seconds;
+}
+
+int main(int argc, char **argv) {
+    int num_pages = argc > 1 ? atoi(argv[1]) : BUFFER_POOL_SIZE / 2;
+    int passes = argc > 2 ? atoi(argv[2]) : 3;
+    printf("file: %d pages (%.1f MB), buffer pool: %d pages\n", num_pages,
+           static_cast<double>(num_pages) * PAGE_SIZE / (1 << 20), BUFFER_POOL_SIZE / 4);
+
+    DiskManager disk_manager;
+    if (disk_manager.is_file(BENCH_FILE_NAME)) {
+        disk_manager.destroy_file(BENCH_FILE_NAME);
+    }
+    disk_manager.create_file(BENCH_FILE_NAME);
+    int fd = disk_manager.open_file(BENCH_FILE_NAME);
+    std::vector<char> buf(static_cast<size_t>(PAGE_SIZE) * BATCH_SIZE);
+    for (size_t i = 0; i < buf.size(); i++) {
+        buf[i] = static_cast<char>(i * 7);
+    }
+    std::vector<std::pair<page_id_t, const char *>> batch;
+    for (int page_no = 0; page_no < num_pages; page_no += BATCH_SIZE) {
+        batch.clear();
+        for (int j = 0; j < BATCH_SIZE && page_no + j < num_pages; j++) {
+            batch.emplace_back(page_no + j, buf.data() + static_cast<size_t>(j) * PAGE_SIZE);
+        }
+        disk_manager.write_pages(fd, batch);
+    }
+    disk_manager.set_fd2pageno(fd, num_pages);
+
+    for (int pass = 0; pass < passes; pass++) {
+        unsigned long checksum = 0;
+        double seconds = scan(&disk_manager, fd, num_pages, false, &checksum);
+        printf("%-12s pass %d %8.3f s %12.0f pages/s\n", "no hint", pass, seconds, num_pages / seconds);
+        seconds = scan(&disk_manager, fd, num_pages, true, &checksum);
+        printf("%-12s pass %d %8.3f s %12.0f pages/s\n", "read ahead", pass, seconds, num_pages / seconds);
+    }
+
+    disk_manager.close_file(fd);
+    disk_manager.destroy_file(BENCH_FILE_NAME);
+    return 0;
+}
@@ -0,0 +1,160 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+/**
+ * 置换策略的命中率基准测试：点查询与全表扫描混合的负载。
+ * 用法: replacer_bench [num_frames] [scan_pages] [rounds]
+ * 点查询集中访问一小部分热点页面（模拟B+树内部结点和district表），每轮之间插入一次大表的全表扫描
+ * （模拟对order_line的分析查询），扫描中每个页面被连续访问多次（逐条读取记录）。
+ * 按BufferPoolInstance调用Replacer的顺序直接驱动各个置换策略，分别统计点查询和扫描的命中率。
+ * 最后测量多个线程并发执行命中路径（record_access、pin、unpin）的吞吐量。
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "replacer/clock_replacer.h"
+#include "replacer/lru_k_replacer.h"
+#include "replacer/lru_replacer.h"
+#include "replacer/two_q_replacer.h"
+
+static constexpr int HOT_PAGES_PERCENT = 20;    // 热点页面占缓冲池的百分比
+static constexpr int COLD_PAGES_FACTOR = 4;     // 点查询访问的全部页面是缓冲池的几倍
+static constexpr int LOOKUPS_PER_ROUND = 200000;
+static constexpr int RECORDS_PER_PAGE = 16;
+static constexpr int SCAN_FILE_BASE = 1 << 20;  // 扫描表的页号从这里开始，与点查询的页面区分
+static constexpr int HITS_PER_THREAD = 1000000;
+
+// 模拟一个只有页表和帧的缓冲池
+class SimulatedPool {
+   public:
+    SimulatedPool(Replacer *replacer, size_t num_frames) : replacer_(replacer), num_frames_(num_frames) {
+        frame_pages_.resize(num_frames, -1);
+    }
+
+    // 访问一个页面，命中返回true
+    bool access(int page_no) {
+        frame_id_t frame;
+        bool hit = false;
+        auto iter = page_table_.find(page_no);
+        if (iter != page_table_.end()) {
+            frame = iter->second;
+            hit = true;
+        } else {
+            if (page_table_.size() < num_frames_) {
+                frame = static_cast<frame_id_t>(page_table_.size());
+            } else {
+                replacer_->victim(&frame);
+                page_table_.erase(frame_pages_[frame]);
+            }
+            page_table_[page_no] = frame;
+            frame_pages_[frame] = page_no;
+        }
+        replacer_->record_access(frame, {0, page_no});
+        replacer_->pin(frame);
+        replacer_->unpin(frame);
+        return hit;
+    }
+
+   private:
+    Replacer *replacer_;
+    size_t num_frames_;
+    std::unordered_map<int, frame_id_t> page_table_;
+    std::vector<int> frame_pages_;
+};
+
+static void run(const char *name, Replacer *replacer, int num_frames, int scan_pages, int rounds) {
+    SimulatedPool pool(replacer, num_frames);
+    std::mt19937 rng(42);
+    int hot_pages = num_frames * HOT_PAGES_PERCENT / 100;
+    int cold_pages = num_frames * COLD_PAGES_FACTOR;
+    long lookups = 0, lookup_hits = 0, scans = 0, scan_hits = 0;
+
+    for (int round = 0; round < rounds; round++) {
+        // 1.点查询：90%访问热点页面，10%访问其余页面
+        for (int i = 0; i < LOOKUPS_PER_ROUND; i++) {
+            int page_no = rng() % 10 < 9 ? rng() % hot_pages : hot_pages + rng() % cold_pages;
+            lookup_hits += pool.access(page_no);
+            lookups++;
+        }
+        // 2.全表扫描：每个页面被连续访问RECORDS_PER_PAGE次
+        for (int page_no = 0; page_no < scan_pages; page_no++) {
+            for (int i = 0; i < RECORDS_PER_PAGE; i++) {
+                scan_hits += pool.access(SCAN_FILE_BASE + page_no);
+                scans++;
+            }
+        }
+    }
+    // 最后一次扫描之后的点查询命中率，反映扫描对热点页面的破坏
+    long after_lookups = 0, after_hits = 0;
+    for (int i = 0; i < hot_pages; i++) {
+        after_hits += pool.access(i);
+        after_lookups++;
+    }
+    printf("%-6s lookup hit ratio %6.2f%%  scan hit ratio %6.2f%%  hot pages kept after scan %6.2f%%\n", name,
+           100.0 * lookup_hits / lookups, 100.0 * scan_hits / scans, 100.0 * after_hits / after_lookups);
+}
+
+// 多个线程并发地在各自的帧上执行命中路径，返回每秒完成的命中次数
+static void run_hit_path(const char *name, Replacer *replacer, int num_frames, int num_threads) {
+    for (int i = 0; i < num_frames; i++) {
+        replacer->unpin(i);
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([=]() {
+            std::mt19937 rng(tid);
+            for (int i = 0; i < HITS_PER_THREAD; i++) {
+                frame_id_t frame = static_cast<frame_id_t>(rng() % num_frames);
+                replacer->record_access(frame, {0, frame});
+                replacer->pin(frame);
+                replacer->unpin(frame);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("%-6s hit path, %d threads %14.0f hits/s\n", name, num_threads,
+           static_cast<double>(HITS_PER_THREAD) * num_threads / seconds);
+}
+
+int main(int argc, char **argv) {
+    int num_frames = argc > 1 ? atoi(argv[1]) : 4096;
+    int scan_pages = argc > 2 ? atoi(argv[2]) : num_frames * 2;
+    int rounds = argc > 3 ? atoi(argv[3]) : 5;
+    printf("frames: %d, scan: %d pages, rounds: %d\n", num_frames, scan_pages, rounds);
+
+    auto lru = std::make_unique<LRUReplacer>(num_frames);
+    run("LRU", lru.get(), num_frames, scan_pages, rounds);
+    auto lru_k = std::make_unique<LRUKReplacer>(num_frames);
+    run("LRU_K", lru_k.get(), num_frames, scan_pages, rounds);
+    auto two_q = std::make_unique<TwoQReplacer>(num_frames);
+    run("2Q", two_q.get(), num_frames, scan_pages, rounds);
+    auto clock = std::make_unique<ClockReplacer>(num_frames);
+    run("CLOCK", clock.get(), num_frames, scan_pages, rounds);
+
+    int num_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    run_hit_path("LRU", std::make_unique<LRUReplacer>(num_frames).get(), num_frames, num_threads);
+    run_hit_path("LRU_K", std::make_unique<LRUKReplacer>(num_frames).get(), num_frames, num_threads);
+    run_hit_path("2Q", std::make_unique<TwoQReplacer>(num_frames).get(), num_frames, num_threads);
+    run_hit_path("CLOCK", std::make_unique<ClockReplacer>(num_frames).get(), num_frames, num_threads);
+    return 0;
+}
@@ -0,0 +1,127 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+/**
+ * 页面级谓词过滤的微基准测试：比较逐条判断与AVX2的各个比较内核。
+ * 用法: slot_filter_bench [record_size] [num_pages]
+ * 每个页面按表数据文件的格式计算slot个数，约有90%的slot被占用，列值在[0, 1000)中均匀分布。
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "defs.h"
+#include "record/bitmap.h"
+#include "record/rm_defs.h"
+#include "record/rm_slot_filter.h"
+
+using bench_clock = std::chrono::steady_clock;
+
+static constexpr int ROUNDS = 20;
+
+struct BenchPage {
+    std::vector<char> bitmap;
+    std::vector<char> slots;
+};
+
+// 对所有页面执行ROUNDS次过滤，返回耗时（秒）和最后一次选中的记录数
+template <typename F>
+static double run_kernel(const std::vector<BenchPage> &pages, int bitmap_size, long &selected, F filter) {
+    std::vector<char> mask(bitmap_size);
+    auto start = bench_clock::now();
+    for (int round = 0; round < ROUNDS; round++) {
+        selected = 0;
+        for (const auto &page : pages) {
+            memcpy(mask.data(), page.bitmap.data(), bitmap_size);
+            filter(page.slots.data(), mask.data());
+            for (int i = 0; i < bitmap_size; i++) {
+                selected += __builtin_popcount(static_cast<unsigned char>(mask[i]));
+            }
+        }
+    }
+    return std::chrono::duration<double>(bench_clock::now() - start).count();
+}
+
+static SlotPredicate make_pred(ColType type, SlotFilterOp op, std::vector<int> vals) {
+    SlotPredicate pred;
+    pred.type = type;
+    pred.op = op;
+    pred.offset = type == TYPE_INT ? 0 : sizeof(int);
+    pred.num_vals = static_cast<int>(vals.size());
+    for (size_t i = 0; i < vals.size(); i++) {
+        pred.int_vals[i] = vals[i];
+        pred.float_vals[i] = static_cast<float>(vals[i]);
+    }
+    return pred;
+}
+
+int main(int argc, char **argv) {
+    int record_size = argc > 1 ? atoi(argv[1]) : 32;
+    int num_pages = argc > 2 ? atoi(argv[2]) : 4096;
+    // 与RmManager::create_file中的计算方式相同
+    int num_slots = (BITMAP_WIDTH * (PAGE_SIZE - 1 - RM_FIXED_PAGE_RESERVED) + 1) /
+                    (1 + record_size * BITMAP_WIDTH);
+    int bitmap_size = (num_slots + BITMAP_WIDTH - 1) / BITMAP_WIDTH;
+    printf("record size: %d, slots per page: %d, pages: %d, avx2: %s\n", record_size, num_slots, num_pages,
+           SlotFilter::has_avx2() ? "yes" : "no");
+
+    std::mt19937 rng(0);
+    std::vector<BenchPage> pages(num_pages);
+    for (auto &page : pages) {
+        page.bitmap.assign(bitmap_size, 0);
+        page.slots.assign(static_cast<size_t>(num_slots) * record_size, 0);
+        for (int i = 0; i < num_slots; i++) {
+            int a = static_cast<int>(rng() % 1000);
+            float b = static_cast<float>(a);
+            memcpy(page.slots.data() + static_cast<size_t>(i) * record_size, &a, sizeof(int));
+            memcpy(page.slots.data() + static_cast<size_t>(i) * record_size + sizeof(int), &b, sizeof(float));
+            if (rng() % 10 != 0) {
+                Bitmap::set(page.bitmap.data(), i);
+            }
+        }
+    }
+
+    struct Case {
+        const char *name;
+        SlotPredicate pred;
+    };
+    std::vector<Case> cases = {
+        {"int =", make_pred(TYPE_INT, SlotFilterOp::EQ, {500})},
+        {"int <", make_pred(TYPE_INT, SlotFilterOp::LT, {100})},
+        {"int >", make_pred(TYPE_INT, SlotFilterOp::GT, {500})},
+        {"int between", make_pred(TYPE_INT, SlotFilterOp::BETWEEN, {250, 750})},
+        {"int in (4)", make_pred(TYPE_INT, SlotFilterOp::IN, {1, 10, 100, 999})},
+        {"float <", make_pred(TYPE_FLOAT, SlotFilterOp::LT, {100})},
+        {"float between", make_pred(TYPE_FLOAT, SlotFilterOp::BETWEEN, {250, 750})},
+        {"float in (8)", make_pred(TYPE_FLOAT, SlotFilterOp::IN, {1, 2, 3, 5, 8, 13, 21, 34})},
+    };
+
+    long total_rows = static_cast<long>(num_pages) * num_slots * ROUNDS;
+    for (const auto &c : cases) {
+        long selected = 0;
+        double seconds = run_kernel(pages, bitmap_size, selected, [&](const char *slots, char *mask) {
+            SlotFilter::filter_scalar(c.pred, slots, record_size, num_slots, mask);
+        });
+        printf("%-14s %-7s %8ld selected %8.3f s %14.0f rows/s\n", c.name, "scalar", selected, seconds,
+               total_rows / seconds);
+        if (SlotFilter::has_avx2()) {
+            seconds = run_kernel(pages, bitmap_size, selected, [&](const char *slots, char *mask) {
+                SlotFilter::filter_avx2(c.pred, slots, record_size, num_slots, mask);
+            });
+            printf("%-14s %-7s %8ld selected %8.3f s %14.0f rows/s\n", c.name, "avx2", selected, seconds,
+                   total_rows / seconds);
+        }
+    }
+    return 0;
+}
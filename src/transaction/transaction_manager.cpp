@@ -56,6 +56,17 @@ void TransactionManager::commit(Transaction *txn, LogManager *log_manager) {
     txn->set_prev_lsn(lsn);
     log_manager->flush_log_to_disk();
 
+    // 删除已经持久化，被删除记录的位置可以分配给新插入的记录
+    for (auto write_rcd: *txn->get_table_write_set()) {
+        if (write_rcd->GetWriteType() != WType::DELETE_TUPLE) {
+            continue;
+        }
+        auto iter = sm_manager_->fhs_.find(write_rcd->GetTableName());
+        if (iter != sm_manager_->fhs_.end()) {
+            iter->second->release_deleted_slot(write_rcd->GetRid());
+        }
+    }
+
     //释放所有txn加的锁
     std::shared_ptr<std::unordered_set<LockDataId>> lock_set_ = txn->get_lock_set();
     for (auto iter: *lock_set_) {
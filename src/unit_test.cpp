@@ -12,13 +12,17 @@ See the Mulan PSL v2 for more details. */
 
 #define private public
 
+#include "index/ix.h"
 #include "record/rm.h"
 #include "storage/buffer_pool_manager.h"
 
 #undef private
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <climits>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -32,8 +36,15 @@ See the Mulan PSL v2 for more details. */
 #include <unordered_map>
 #include <vector>
 
+#include "execution/execution_batch.h"
+#include "execution/execution_predicate.h"
 #include "gtest/gtest.h"
+#include "lz4.h"
+#include "record/rm_slot_filter.h"
+#include "replacer/clock_replacer.h"
+#include "replacer/lru_k_replacer.h"
 #include "replacer/lru_replacer.h"
+#include "replacer/two_q_replacer.h"
 #include "storage/disk_manager.h"
 
 const std::string TEST_DB_NAME = "BufferPoolManagerTest_db";  // 以数据库名作为根目录
@@ -191,6 +202,392 @@ class BigStorageTest : public ::testing::Test {
     };
 };
 
+TEST_F(BigStorageTest, VectorIOTest) {
+    const int num_pages = 64;
+    std::vector<std::vector<char>> write_bufs(num_pages, std::vector<char>(PAGE_SIZE));
+    std::vector<std::vector<char>> read_bufs(num_pages, std::vector<char>(PAGE_SIZE));
+
+    // 乱序写入所有页面，write_pages会按页号排序并合并为连续的pwritev
+    std::vector<std::pair<page_id_t, const char *>> writes;
+    for (int i = num_pages - 1; i >= 0; i--) {
+        rand_buf(PAGE_SIZE, write_bufs[i].data());
+        writes.emplace_back(i, write_bufs[i].data());
+    }
+    disk_manager_->write_pages(fd_, writes);
+
+    // 读取不连续的页面，与单页读取的结果对比
+    std::vector<std::pair<page_id_t, char *>> reads;
+    for (int i = 0; i < num_pages; i++) {
+        if (i % 5 != 3) {
+            reads.emplace_back(i, read_bufs[i].data());
+        }
+    }
+    disk_manager_->read_pages(fd_, reads);
+    char buf[PAGE_SIZE];
+    for (auto &[page_no, data] : reads) {
+        disk_manager_->read_page(fd_, page_no, buf, PAGE_SIZE);
+        EXPECT_EQ(0, memcmp(buf, data, PAGE_SIZE));
+        EXPECT_EQ(0, memcmp(write_bufs[page_no].data(), data, PAGE_SIZE));
+    }
+
+    // 读到文件末尾之后的页面应当报错
+    std::vector<std::pair<page_id_t, char *>> short_reads = {{num_pages - 1, read_bufs[0].data()},
+                                                             {num_pages, read_bufs[1].data()}};
+    EXPECT_THROW(disk_manager_->read_pages(fd_, short_reads), InternalError);
+}
+
+TEST_F(BigStorageTest, IoUringTest) {
+    if (!disk_manager_->enable_io_uring(8)) {
+        GTEST_SKIP() << "io_uring is not supported";
+    }
+    const int num_pages = 100;
+    std::vector<std::vector<char>> write_bufs(num_pages, std::vector<char>(PAGE_SIZE));
+    std::vector<std::vector<char>> read_bufs(num_pages, std::vector<char>(PAGE_SIZE));
+
+    // 不连续的页号会被拆分为多个请求，请求数超过队列深度
+    std::vector<std::pair<page_id_t, const char *>> writes;
+    for (int i = 0; i < num_pages; i++) {
+        rand_buf(PAGE_SIZE, write_bufs[i].data());
+        if (i % 3 != 1) {
+            writes.emplace_back(i, write_bufs[i].data());
+        }
+    }
+    for (int i = 1; i < num_pages; i += 3) {
+        disk_manager_->write_page(fd_, i, write_bufs[i].data(), PAGE_SIZE);
+    }
+    disk_manager_->write_pages(fd_, writes);
+
+    std::vector<std::pair<page_id_t, char *>> reads;
+    for (int i = 0; i < num_pages; i++) {
+        reads.emplace_back(i, read_bufs[i].data());
+    }
+    disk_manager_->read_pages(fd_, reads);
+    for (int i = 0; i < num_pages; i++) {
+        EXPECT_EQ(0, memcmp(write_bufs[i].data(), read_bufs[i].data(), PAGE_SIZE));
+    }
+    char buf[PAGE_SIZE];
+    EXPECT_THROW(disk_manager_->read_page(fd_, num_pages, buf, PAGE_SIZE), InternalError);
+}
+
+TEST_F(BigStorageTest, ReadAheadTest) {
+    const int num_pages = 256;
+    std::vector<std::vector<char>> write_bufs(num_pages, std::vector<char>(PAGE_SIZE));
+    std::vector<std::pair<page_id_t, const char *>> writes;
+    for (int i = 0; i < num_pages; i++) {
+        rand_buf(PAGE_SIZE, write_bufs[i].data());
+        writes.emplace_back(i, write_bufs[i].data());
+    }
+    disk_manager_->write_pages(fd_, writes);
+
+    // 缓冲池只有READ_AHEAD_MAX_PAGES的两倍大，预读必须不断替换已经扫描过的页面
+    auto bpm = std::make_unique<BufferPoolManager>(2 * READ_AHEAD_MAX_PAGES, disk_manager_.get());
+    auto is_cached = [&](page_id_t page_no) {
+        PageId page_id = {.fd = fd_, .page_no = page_no};
+        BufferPoolInstance *instance = bpm->get_instance(page_id);
+        std::scoped_lock lock{instance->latch_};
+        auto iter = instance->page_table_.find(page_id);
+        return iter != instance->page_table_.end() && !instance->pages_[iter->second].is_loading_;
+    };
+
+    // 第二次顺序访问时开始预读，后台线程会把后续页面读入缓冲池
+    ReadAheadState state;
+    bpm->read_ahead({fd_, 0}, num_pages, &state);
+    EXPECT_EQ(state.window, 0);
+    bpm->read_ahead({fd_, 1}, num_pages, &state);
+    EXPECT_EQ(state.window, READ_AHEAD_MIN_PAGES);
+    for (int i = 0; i < 1000 && !is_cached(1 + READ_AHEAD_MIN_PAGES); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_TRUE(is_cached(1 + READ_AHEAD_MIN_PAGES));
+
+    // 顺序扫描全部页面，窗口增长到上限，预读的页面内容与磁盘一致
+    for (int i = 2; i < num_pages; i++) {
+        bpm->read_ahead({fd_, i}, num_pages, &state);
+        Page *page = bpm->fetch_page({fd_, i});
+        ASSERT_NE(page, nullptr);
+        EXPECT_EQ(0, memcmp(page->get_data(), write_bufs[i].data(), PAGE_SIZE));
+        bpm->unpin_page({fd_, i}, false);
+    }
+    EXPECT_EQ(state.window, READ_AHEAD_MAX_PAGES);
+    EXPECT_EQ(state.prefetched_end, num_pages);
+
+    // 跳跃访问时窗口清零
+    bpm->read_ahead({fd_, 10}, num_pages, &state);
+    EXPECT_EQ(state.window, 0);
+
+    // flush_all_pages会等待预读结束，之后所有帧都没有被固定
+    bpm->flush_all_pages(fd_);
+    for (size_t i = 0; i < bpm->pool_size_; i++) {
+        EXPECT_EQ(bpm->pages_[i].pin_count_, 0);
+    }
+}
+
+TEST_F(BigStorageTest, BackgroundWriterTest) {
+    const int num_pages = 64;
+    auto bpm = std::make_unique<BufferPoolManager>(num_pages, disk_manager_.get());
+    ASSERT_EQ(bpm->instances_.size(), 1);
+
+    // 填满缓冲池，所有页面都是脏页，前一半页面的LSN大于已持久化的日志
+    std::vector<std::vector<char>> bufs(num_pages, std::vector<char>(PAGE_SIZE));
+    for (int i = 0; i < num_pages; i++) {
+        PageId page_id = {.fd = fd_, .page_no = INVALID_PAGE_ID};
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(page, nullptr);
+        rand_buf(PAGE_SIZE, page->get_data());
+        page->set_page_lsn(i < num_pages / 2 ? 100 : 0);
+        memcpy(bufs[page_id.page_no].data(), page->get_data(), PAGE_SIZE);
+        bpm->unpin_page(page_id, true);
+    }
+    lsn_t flushed_lsn = 50;
+    bpm->flushed_lsn_ = [&]() { return flushed_lsn; };
+
+    // 一轮写回使干净帧达到目标数量，LSN大于已持久化日志的页面不会被写回
+    bpm->write_dirty_pages();
+    size_t target_clean = num_pages * BACKGROUND_WRITER_CLEAN_PERCENT / 100;
+    size_t clean = 0;
+    char buf[PAGE_SIZE];
+    for (int i = 0; i < num_pages; i++) {
+        Page *page = &bpm->pages_[i];
+        EXPECT_FALSE(page->is_writing_);
+        if (!page->is_dirty_) {
+            clean++;
+            EXPECT_LE(page->get_page_lsn(), flushed_lsn);
+            disk_manager_->read_page(fd_, page->get_page_id().page_no, buf, PAGE_SIZE);
+            EXPECT_EQ(0, memcmp(buf, bufs[page->get_page_id().page_no].data(), PAGE_SIZE));
+        }
+    }
+    EXPECT_EQ(clean, target_clean);
+
+    // 日志持久化之后，后台写线程可以写回剩下的页面
+    flushed_lsn = 100;
+    bpm->start_background_writer([&]() { return flushed_lsn; });
+    bpm->stop_background_writer();
+    bpm->flush_all_pages(fd_);
+}
+
+TEST_F(BigStorageTest, DirectIOTest) {
+    // 以O_DIRECT方式重新打开测试文件，文件系统不支持时open_file会退回普通模式
+    disk_manager_->close_file(fd_);
+    disk_manager_->set_direct_io(true);
+    fd_ = disk_manager_->open_file(TEST_FILE_NAME_BIG);
+    if (!disk_manager_->is_direct_fd(fd_)) {
+        GTEST_SKIP() << "O_DIRECT is not supported by the file system";
+    }
+    const int num_pages = 32;
+    std::vector<std::vector<char>> bufs(num_pages, std::vector<char>(PAGE_SIZE));
+
+    // 缓冲池的帧按页对齐，可以直接进行O_DIRECT读写
+    auto bpm = std::make_unique<BufferPoolManager>(num_pages / 2, disk_manager_.get());
+    for (int i = 0; i < num_pages; i++) {
+        PageId page_id = {.fd = fd_, .page_no = INVALID_PAGE_ID};
+        Page *page = bpm->new_page(&page_id);
+        ASSERT_NE(page, nullptr);
+        rand_buf(PAGE_SIZE, page->get_data());
+        memcpy(bufs[page_id.page_no].data(), page->get_data(), PAGE_SIZE);
+        bpm->unpin_page(page_id, true);
+    }
+    bpm->flush_all_pages(fd_);
+    for (int i = 0; i < num_pages; i++) {
+        Page *page = bpm->fetch_page({fd_, i});
+        ASSERT_NE(page, nullptr);
+        EXPECT_EQ(0, memcmp(page->get_data(), bufs[i].data(), PAGE_SIZE));
+        bpm->unpin_page({fd_, i}, false);
+    }
+
+    // 未对齐的缓冲区和不足一页的读写经过对齐的临时缓冲区
+    std::vector<char> unaligned(PAGE_SIZE + 1);
+    disk_manager_->read_page(fd_, 3, unaligned.data() + 1, PAGE_SIZE);
+    EXPECT_EQ(0, memcmp(unaligned.data() + 1, bufs[3].data(), PAGE_SIZE));
+    const char header[] = "file header";
+    disk_manager_->write_page(fd_, 5, header, sizeof(header));
+    memcpy(bufs[5].data(), header, sizeof(header));
+    disk_manager_->read_page(fd_, 5, unaligned.data() + 1, 100);
+    EXPECT_EQ(0, memcmp(unaligned.data() + 1, bufs[5].data(), 100));
+
+    std::vector<std::pair<page_id_t, const char *>> writes = {{7, unaligned.data() + 1}};
+    memcpy(bufs[7].data(), unaligned.data() + 1, PAGE_SIZE);
+    disk_manager_->write_pages(fd_, writes);
+    std::vector<std::vector<char>> read_bufs(num_pages, std::vector<char>(PAGE_SIZE + 1));
+    std::vector<std::pair<page_id_t, char *>> reads;
+    for (int i = 0; i < num_pages; i++) {
+        reads.emplace_back(i, read_bufs[i].data() + 1);
+    }
+    disk_manager_->read_pages(fd_, reads);
+    for (int i = 0; i < num_pages; i++) {
+        EXPECT_EQ(0, memcmp(read_bufs[i].data() + 1, bufs[i].data(), PAGE_SIZE));
+    }
+    char buf[PAGE_SIZE];
+    EXPECT_THROW(disk_manager_->read_page(fd_, num_pages, buf, 100), InternalError);
+}
+
+TEST_F(BigStorageTest, ResizeBufferPoolTest) {
+    auto bpm = std::make_unique<BufferPoolManager>(64, disk_manager_.get());
+    PageId page_id = {.fd = fd_, .page_no = INVALID_PAGE_ID};
+    ASSERT_NE(bpm->new_page(&page_id), nullptr);
+
+    // 有页面被固定或者有脏页时不能调整大小
+    EXPECT_THROW(bpm->set_pool_size(4 * BUFFER_POOL_MIN_INSTANCE_SIZE), InternalError);
+    bpm->unpin_page(page_id, true);
+    EXPECT_THROW(bpm->set_pool_size(4 * BUFFER_POOL_MIN_INSTANCE_SIZE), InternalError);
+    bpm->flush_all_pages(fd_);
+
+    // 调整大小后重新划分分片，之前写回的页面可以从磁盘读回
+    bpm->set_pool_size(4 * BUFFER_POOL_MIN_INSTANCE_SIZE);
+    EXPECT_EQ(bpm->get_pool_size(), 4 * BUFFER_POOL_MIN_INSTANCE_SIZE);
+    EXPECT_EQ(bpm->instances_.size(), 4);
+    Page *page = bpm->fetch_page(page_id);
+    ASSERT_NE(page, nullptr);
+    bpm->unpin_page(page_id, false);
+}
+
+TEST_F(BigStorageTest, FreePageTest) {
+    const int num_pages = 10;
+    char buf[PAGE_SIZE];
+    for (int i = 0; i < num_pages; i++) {
+        ASSERT_EQ(disk_manager_->allocate_page(fd_), i);
+        rand_buf(PAGE_SIZE, buf);
+        disk_manager_->write_page(fd_, i, buf, PAGE_SIZE);
+    }
+
+    // 释放的页面优先被重新分配，页号小的先分配
+    disk_manager_->deallocate_page(fd_, 8);
+    disk_manager_->deallocate_page(fd_, 3);
+    disk_manager_->deallocate_page(fd_, 9);
+    EXPECT_TRUE(disk_manager_->is_free_page(fd_, 3));
+    EXPECT_EQ(disk_manager_->allocate_page(fd_), 3);
+    EXPECT_FALSE(disk_manager_->is_free_page(fd_, 3));
+    disk_manager_->deallocate_page(fd_, 3);
+
+    // 空闲页面链表写入磁盘，重新打开文件后可以恢复
+    page_id_t first_page_no = disk_manager_->save_free_pages(fd_, sizeof(int));
+    EXPECT_EQ(first_page_no, 3);
+    disk_manager_->close_file(fd_);
+    fd_ = disk_manager_->open_file(TEST_FILE_NAME_BIG);
+    EXPECT_EQ(disk_manager_->get_num_free_pages(fd_), 0);
+    disk_manager_->set_fd2pageno(fd_, num_pages);
+    disk_manager_->load_free_pages(fd_, first_page_no, sizeof(int));
+    EXPECT_EQ(disk_manager_->get_num_free_pages(fd_), 3);
+    EXPECT_TRUE(disk_manager_->is_free_page(fd_, 8));
+
+    // 截断文件末尾连续的空闲页面，中间的空闲页面保留
+    EXPECT_EQ(disk_manager_->truncate_free_pages(fd_), 8);
+    EXPECT_EQ(disk_manager_->get_file_size(TEST_FILE_NAME_BIG), 8 * PAGE_SIZE);
+    EXPECT_EQ(disk_manager_->get_num_free_pages(fd_), 1);
+    EXPECT_EQ(disk_manager_->allocate_page(fd_), 3);
+    EXPECT_EQ(disk_manager_->allocate_page(fd_), 8);
+}
+
+TEST(CompressedFileTest, PageMapTest) {
+    // LZ4编解码：可压缩、不可压缩和很短的输入都能还原，输出缓冲区不够时压缩失败
+    std::vector<char> input(PAGE_SIZE), output(LZ4_compressBound(PAGE_SIZE)), restored(PAGE_SIZE);
+    for (int i = 0; i < PAGE_SIZE; i++) {
+        input[i] = static_cast<char>(i % 64 < 48 ? 'a' + i % 7 : i / 64);
+    }
+    int size = LZ4_compress_default(input.data(), output.data(), PAGE_SIZE, static_cast<int>(output.size()));
+    ASSERT_GT(size, 0);
+    EXPECT_LT(size, PAGE_SIZE / 4);
+    EXPECT_EQ(LZ4_decompress_safe(output.data(), restored.data(), size, PAGE_SIZE), PAGE_SIZE);
+    EXPECT_EQ(input, restored);
+    EXPECT_LT(LZ4_decompress_safe(output.data(), restored.data(), size, PAGE_SIZE - 1), 0);
+    rand_buf(PAGE_SIZE, input.data());
+    size = LZ4_compress_default(input.data(), output.data(), PAGE_SIZE, static_cast<int>(output.size()));
+    ASSERT_GT(size, 0);
+    EXPECT_EQ(LZ4_decompress_safe(output.data(), restored.data(), size, PAGE_SIZE), PAGE_SIZE);
+    EXPECT_EQ(input, restored);
+    EXPECT_EQ(LZ4_compress_default(input.data(), output.data(), PAGE_SIZE, PAGE_SIZE / 2), 0);
+    size = LZ4_compress_default(input.data(), output.data(), 5, static_cast<int>(output.size()));
+    EXPECT_EQ(LZ4_decompress_safe(output.data(), restored.data(), size, PAGE_SIZE), 5);
+    EXPECT_EQ(memcmp(input.data(), restored.data(), 5), 0);
+
+    auto disk_manager = std::make_unique<DiskManager>();
+    std::string filename = "compressed.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    disk_manager->create_compressed_file(filename);
+    int fd = disk_manager->open_file(filename);
+    ASSERT_TRUE(disk_manager->is_compressed_fd(fd));
+
+    // 可压缩的页面只占用几个扇区，没有写入过的页面读出全0
+    const int num_pages = 20;
+    std::vector<std::string> pages(num_pages);
+    char buf[PAGE_SIZE];
+    for (int i = 0; i < num_pages; i++) {
+        for (int j = 0; j < PAGE_SIZE; j++) {
+            buf[j] = static_cast<char>(j % 64 < 4 ? (i * 131 + j / 64) & 0xff : 'x');
+        }
+        pages[i].assign(buf, PAGE_SIZE);
+        disk_manager->write_page(fd, i, buf, PAGE_SIZE);
+    }
+    EXPECT_LT(disk_manager->get_file_size(filename), num_pages * PAGE_SIZE / 3);
+    disk_manager->read_page(fd, num_pages + 5, buf, PAGE_SIZE);
+    EXPECT_TRUE(std::all_of(buf, buf + PAGE_SIZE, [](char c) { return c == 0; }));
+
+    // 重写为不可压缩的内容后页面变大，搬到新的位置；不足整页的读写只影响页面开头
+    for (int i = 0; i < num_pages; i += 4) {
+        rand_buf(PAGE_SIZE, buf);
+        pages[i].assign(buf, PAGE_SIZE);
+        disk_manager->write_page(fd, i, buf, PAGE_SIZE);
+    }
+    std::vector<std::pair<page_id_t, const char *>> batch;
+    for (int i = 1; i < num_pages; i += 4) {
+        pages[i].replace(0, 8, "rewrite!");
+        batch.emplace_back(i, pages[i].data());
+    }
+    disk_manager->write_pages(fd, batch);
+    disk_manager->write_page(fd, 2, "header", 6);
+    pages[2].replace(0, 6, "header");
+    disk_manager->read_page(fd, 2, buf, 6);
+    EXPECT_EQ(memcmp(buf, "header", 6), 0);
+
+    // 重新打开文件后映射表恢复
+    disk_manager->close_file(fd);
+    fd = disk_manager->open_file(filename);
+    std::vector<std::vector<char>> bufs(num_pages, std::vector<char>(PAGE_SIZE));
+    std::vector<std::pair<page_id_t, char *>> read_batch;
+    for (int i = 0; i < num_pages; i++) {
+        read_batch.emplace_back(i, bufs[i].data());
+    }
+    disk_manager->read_pages(fd, read_batch);
+    for (int i = 0; i < num_pages; i++) {
+        EXPECT_EQ(std::string(bufs[i].data(), PAGE_SIZE), pages[i]) << "page " << i;
+    }
+
+    // 截断之后释放的空间被回收，文件末尾的空闲空间被截掉
+    int size_before = disk_manager->get_file_size(filename);
+    disk_manager->set_fd2pageno(fd, num_pages);
+    for (int i = num_pages / 2; i < num_pages; i++) {
+        disk_manager->deallocate_page(fd, i);
+    }
+    EXPECT_EQ(disk_manager->truncate_free_pages(fd), num_pages / 2);
+    EXPECT_LT(disk_manager->get_file_size(filename), size_before);
+    EXPECT_LE(static_cast<int>(disk_manager->get_compressed_size(fd)), disk_manager->get_file_size(filename));
+    disk_manager->read_page(fd, 3, buf, PAGE_SIZE);
+    EXPECT_EQ(std::string(buf, PAGE_SIZE), pages[3]);
+
+    disk_manager->close_file(fd);
+    disk_manager->destroy_file(filename);
+    EXPECT_FALSE(disk_manager->is_file(filename + COMPRESSED_MAP_SUFFIX));
+}
+
+TEST(FrameArenaTest, LayoutTest) {
+    const size_t pool_size = 1000;
+    auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager.get());
+
+    // 描述符按缓存行对齐，页面数据连续存放并按大页对齐
+    EXPECT_EQ(alignof(Page), CACHE_LINE_SIZE);
+    EXPECT_EQ(sizeof(Page) % CACHE_LINE_SIZE, 0);
+    char *base = bpm->pages_[0].get_data();
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(base) % FrameArena::HUGE_PAGE_SIZE, 0);
+    for (size_t i = 0; i < pool_size; i++) {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(&bpm->pages_[i]) % CACHE_LINE_SIZE, 0);
+        EXPECT_EQ(bpm->pages_[i].get_data(), base + i * PAGE_SIZE);
+    }
+    // 新申请的内存已经清零，并且每一帧都可以读写
+    EXPECT_EQ(bpm->pages_[pool_size - 1].get_data()[PAGE_SIZE - 1], 0);
+    memset(base, 'x', pool_size * PAGE_SIZE);
+}
+
 TEST(LRUReplacerTest, SampleTest) {
     LRUReplacer lru_replacer(7);
 
@@ -231,6 +628,226 @@ TEST(LRUReplacerTest, SampleTest) {
     EXPECT_EQ(4, value);
 }
 
+TEST(LRUKReplacerTest, SampleTest) {
+    // correlated_period为0时每次访问都计入历史
+    LRUKReplacer lru_k_replacer(7, 2, 0);
+
+    // Scenario: access and unpin six frames, frame 1 is accessed twice.
+    for (int i = 1; i <= 6; i++) {
+        lru_k_replacer.record_access(i, {0, i});
+        lru_k_replacer.unpin(i);
+    }
+    lru_k_replacer.record_access(1, {0, 1});
+    EXPECT_EQ(6, lru_k_replacer.Size());
+
+    // Scenario: frames with less than k accesses are evicted first, in order of their first access.
+    int value;
+    lru_k_replacer.victim(&value);
+    EXPECT_EQ(2, value);
+    lru_k_replacer.victim(&value);
+    EXPECT_EQ(3, value);
+    lru_k_replacer.victim(&value);
+    EXPECT_EQ(4, value);
+
+    // Scenario: pinned frames can not be evicted.
+    lru_k_replacer.pin(5);
+    EXPECT_EQ(2, lru_k_replacer.Size());
+    lru_k_replacer.victim(&value);
+    EXPECT_EQ(6, value);
+    lru_k_replacer.victim(&value);
+    EXPECT_EQ(1, value);
+    EXPECT_FALSE(lru_k_replacer.victim(&value));
+
+    // Scenario: a reused frame forgets the history of its previous page.
+    lru_k_replacer.unpin(5);
+    lru_k_replacer.record_access(1, {0, 7});
+    lru_k_replacer.unpin(1);
+    lru_k_replacer.record_access(1, {0, 7});
+    lru_k_replacer.victim(&value);
+    EXPECT_EQ(5, value);
+    lru_k_replacer.victim(&value);
+    EXPECT_EQ(1, value);
+}
+
+TEST(TwoQReplacerTest, SampleTest) {
+    // A1in的目标大小为2，A1out最多记录2个页面
+    TwoQReplacer two_q_replacer(7, 2, 2);
+
+    // Scenario: new pages enter A1in, re-accesses in A1in do not change their order.
+    for (int i = 1; i <= 4; i++) {
+        two_q_replacer.record_access(i, {0, i});
+        two_q_replacer.unpin(i);
+    }
+    two_q_replacer.record_access(1, {0, 1});
+    EXPECT_EQ(4, two_q_replacer.Size());
+
+    // Scenario: evicted A1in pages are remembered in A1out.
+    int value;
+    two_q_replacer.victim(&value);
+    EXPECT_EQ(1, value);
+    two_q_replacer.victim(&value);
+    EXPECT_EQ(2, value);
+
+    // Scenario: page 1 is accessed again while in A1out, so it enters Am.
+    two_q_replacer.record_access(1, {0, 1});
+    two_q_replacer.unpin(1);
+    two_q_replacer.record_access(2, {0, 5});
+    two_q_replacer.unpin(2);
+
+    // A1in holds 3, 4 and 5, more than its target size, so it is evicted first.
+    two_q_replacer.victim(&value);
+    EXPECT_EQ(3, value);
+    // A1in is back to its target size, Am is evicted before it.
+    two_q_replacer.victim(&value);
+    EXPECT_EQ(1, value);
+    // Am is empty, A1in is evicted even if it is not larger than its target size.
+    two_q_replacer.pin(2);
+    two_q_replacer.victim(&value);
+    EXPECT_EQ(4, value);
+    EXPECT_FALSE(two_q_replacer.victim(&value));
+    EXPECT_EQ(0, two_q_replacer.Size());
+}
+
+TEST(ClockReplacerTest, SampleTest) {
+    ClockReplacer clock_replacer(7);
+
+    // Scenario: unpin six elements, i.e. add them to the replacer.
+    for (int i = 1; i <= 6; i++) {
+        clock_replacer.unpin(i);
+    }
+    clock_replacer.unpin(1);
+    EXPECT_EQ(6, clock_replacer.Size());
+
+    // Scenario: the first sweep clears all reference bits, then frames are evicted in clock order.
+    int value;
+    clock_replacer.victim(&value);
+    EXPECT_EQ(1, value);
+    clock_replacer.victim(&value);
+    EXPECT_EQ(2, value);
+
+    // Scenario: a referenced frame gets a second chance.
+    clock_replacer.record_access(3, {0, 3});
+    clock_replacer.victim(&value);
+    EXPECT_EQ(4, value);
+
+    // Scenario: pinned frames are skipped, pinning an evicted frame has no effect.
+    clock_replacer.pin(4);
+    clock_replacer.pin(5);
+    EXPECT_EQ(2, clock_replacer.Size());
+    clock_replacer.victim(&value);
+    EXPECT_EQ(6, value);
+    clock_replacer.victim(&value);
+    EXPECT_EQ(3, value);
+    EXPECT_FALSE(clock_replacer.victim(&value));
+    EXPECT_EQ(0, clock_replacer.Size());
+}
+
+TEST(ClockReplacerTest, ConcurrencyTest) {
+    const int num_frames = 256;
+    const int num_threads = 8;
+    ClockReplacer clock_replacer(num_frames);
+    for (int i = 0; i < num_frames; i++) {
+        clock_replacer.unpin(i);
+    }
+
+    // 每个线程反复淘汰一个帧再放回，同一个帧不能同时被两个线程淘汰
+    std::vector<std::atomic<int>> owners(num_frames);
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&, tid]() {
+            for (int i = 0; i < 10000; i++) {
+                frame_id_t frame;
+                ASSERT_TRUE(clock_replacer.victim(&frame));
+                EXPECT_EQ(0, owners[frame].fetch_add(1));
+                clock_replacer.record_access(frame, {0, frame});
+                owners[frame].fetch_sub(1);
+                clock_replacer.unpin(frame);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(num_frames, clock_replacer.Size());
+}
+
+/**
+ * @description: 按照BufferPoolInstance调用Replacer的顺序模拟页面访问序列，返回命中次数
+ * @param {Replacer&} replacer 模拟使用的置换策略
+ * @param {size_t} num_frames 帧的个数
+ * @param {vector<int>&} accesses 访问的页号序列
+ * @param {unordered_map<int, frame_id_t>&} page_table 模拟的页表，可以在多次调用之间保留
+ */
+int simulate_accesses(Replacer &replacer, size_t num_frames, const std::vector<int> &accesses,
+                      std::unordered_map<int, frame_id_t> &page_table) {
+    int hits = 0;
+    for (int page_no : accesses) {
+        PageId page_id = {0, page_no};
+        frame_id_t frame;
+        auto iter = page_table.find(page_no);
+        if (iter != page_table.end()) {
+            hits++;
+            frame = iter->second;
+        } else if (page_table.size() < num_frames) {
+            frame = static_cast<frame_id_t>(page_table.size());
+            page_table[page_no] = frame;
+        } else {
+            EXPECT_TRUE(replacer.victim(&frame));
+            for (auto it = page_table.begin(); it != page_table.end(); ++it) {
+                if (it->second == frame) {
+                    page_table.erase(it);
+                    break;
+                }
+            }
+            page_table[page_no] = frame;
+        }
+        replacer.record_access(frame, page_id);
+        replacer.pin(frame);
+        replacer.unpin(frame);
+    }
+    return hits;
+}
+
+TEST(ReplacerTest, ScanResistanceTest) {
+    const size_t num_frames = 10;
+    const int num_hot = 6;
+    // 预热：热点页面与冷页面交替访问，冷页面不断被换入换出
+    std::vector<int> warm_up;
+    for (int round = 0; round < 20; round++) {
+        for (int i = 0; i < num_hot; i++) {
+            warm_up.push_back(i);
+        }
+        warm_up.push_back(1000 + 2 * round);
+        warm_up.push_back(1000 + 2 * round + 1);
+    }
+    // 全表扫描：每个页面被连续访问多次（逐条读取页面中的记录）
+    std::vector<int> scan;
+    for (int page_no = 100; page_no < 200; page_no++) {
+        for (int i = 0; i < 3; i++) {
+            scan.push_back(page_no);
+        }
+    }
+    std::vector<int> hot;
+    for (int i = 0; i < num_hot; i++) {
+        hot.push_back(i);
+    }
+
+    auto hot_hits_after_scan = [&](Replacer &replacer) {
+        std::unordered_map<int, frame_id_t> page_table;
+        simulate_accesses(replacer, num_frames, warm_up, page_table);
+        simulate_accesses(replacer, num_frames, scan, page_table);
+        return simulate_accesses(replacer, num_frames, hot, page_table);
+    };
+
+    // LRU被扫描冲掉所有热点页面，LRU-K和2Q保留全部热点页面
+    LRUReplacer lru_replacer(num_frames);
+    LRUKReplacer lru_k_replacer(num_frames);
+    TwoQReplacer two_q_replacer(num_frames);
+    EXPECT_EQ(0, hot_hits_after_scan(lru_replacer));
+    EXPECT_EQ(num_hot, hot_hits_after_scan(lru_k_replacer));
+    EXPECT_EQ(num_hot, hot_hits_after_scan(two_q_replacer));
+}
+
 /** 注意：每个测试点只测试了单个文件！
  * 对于每个测试点，先创建和进入目录TEST_DB_NAME
  * 然后在此目录下创建和打开文件TEST_FILE_NAME，记录其文件描述符fd */
@@ -425,6 +1042,45 @@ TEST_F(BufferPoolManagerConcurrencyTest, ConcurrencyTest) {
     }  // end loop run=[0,num_runs)
 }
 
+TEST_F(BufferPoolManagerConcurrencyTest, ShardedConcurrencyTest) {
+    const int num_threads = 8;
+    const int num_pages = 256;
+    const size_t buffer_pool_size = BUFFER_POOL_MIN_INSTANCE_SIZE * 4;
+
+    int fd = BufferPoolManagerConcurrencyTest::fd_;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager);
+    ASSERT_EQ(4, bpm->instances_.size());
+
+    // 先写入num_pages个页面并刷回磁盘，再清空缓冲池，让所有线程同时缺页
+    PageId temp_page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+    for (int i = 0; i < num_pages; i++) {
+        auto page = bpm->new_page(&temp_page_id);
+        ASSERT_NE(nullptr, page);
+        strcpy(page->get_data(), std::to_string(temp_page_id.page_no).c_str());  // NOLINT
+        EXPECT_EQ(true, bpm->unpin_page(temp_page_id, true));
+    }
+    bpm->flush_all_pages(fd);
+    bpm->delete_all_pages(fd);
+
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.push_back(std::thread([&bpm, fd, tid]() {  // NOLINT
+            for (int i = 0; i < num_pages; i++) {
+                PageId page_id = {.fd = fd, .page_no = (i + tid * 31) % num_pages};
+                auto page = bpm->fetch_page(page_id);
+                ASSERT_NE(nullptr, page);
+                EXPECT_EQ(0, std::strcmp(std::to_string(page_id.page_no).c_str(), page->get_data()));
+                EXPECT_EQ(true, bpm->unpin_page(page_id, false));
+            }
+        }));
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    bpm->flush_all_pages(fd);
+}
+
 // TODO: fix detected memory leaks found by Google Test
 TEST(StorageTest, SimpleTest) {
     srand((unsigned)time(nullptr));
@@ -661,3 +1317,1468 @@ TEST(RecordManagerTest, SimpleTest) {
     rm_manager->close_file(file_handle.get());
     rm_manager->destroy_file(filename);
 }
+
+TEST(RecordManagerTest, VacuumTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(MAX_PAGES, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    std::string filename = "vacuum.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    rm_manager->create_file(filename, 64);
+    auto file_handle = rm_manager->open_file(filename);
+
+    // 写满6个数据页面
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    int records_per_page = file_handle->file_hdr_.num_records_per_page;
+    char buf[64];
+    for (int i = 0; i < records_per_page * 6; i++) {
+        rand_buf(64, buf);
+        Rid rid = file_handle->insert_record(buf, nullptr);
+        mock[rid] = std::string(buf, 64);
+    }
+    ASSERT_EQ(file_handle->file_hdr_.num_pages, 7);
+
+    // 删除第2、5、6页的全部记录和第3页的一半记录
+    int page3_deleted = 0;
+    for (auto iter = mock.begin(); iter != mock.end();) {
+        Rid rid = iter->first;
+        if (rid.page_no == 2 || rid.page_no >= 5 || (rid.page_no == 3 && rid.slot_no % 2 == 0)) {
+            file_handle->delete_record(rid, nullptr);
+            page3_deleted += rid.page_no == 3;
+            iter = mock.erase(iter);
+        } else {
+            iter++;
+        }
+    }
+
+    // 末尾的两个空页面被截断，第2页被释放，第3页被删除的位置重新可用
+    EXPECT_EQ(file_handle->vacuum(), 1);
+    EXPECT_EQ(file_handle->file_hdr_.num_pages, 5);
+    EXPECT_EQ(disk_manager->get_file_size(filename), 5 * PAGE_SIZE);
+    EXPECT_TRUE(disk_manager->is_free_page(file_handle->GetFd(), 2));
+    check_equal(file_handle.get(), mock);
+
+    // 空闲页面在关闭文件后仍然保留
+    rm_manager->close_file(file_handle.get());
+    file_handle = rm_manager->open_file(filename);
+    EXPECT_TRUE(disk_manager->is_free_page(file_handle->GetFd(), 2));
+
+    // 先填满第3页的空位，再复用被释放的第2页，文件不再增长
+    for (int i = 0; i < records_per_page; i++) {
+        rand_buf(64, buf);
+        Rid rid = file_handle->insert_record(buf, nullptr);
+        EXPECT_EQ(rid.page_no, i < page3_deleted ? 3 : 2);
+        mock[rid] = std::string(buf, 64);
+    }
+    EXPECT_EQ(file_handle->file_hdr_.num_pages, 5);
+    check_equal(file_handle.get(), mock);
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(RecordManagerTest, OldFileHeaderTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(MAX_PAGES, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    std::string filename = "old_header.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+
+    // 旧版本的文件头只有record_size、num_pages、num_records_per_page、first_free_page_no、bitmap_size
+    int records_per_page = RmManager::fixed_records_per_page(64);
+    int old_hdr[5] = {64, 1, records_per_page, RM_NO_PAGE, (records_per_page + BITMAP_WIDTH - 1) / BITMAP_WIDTH};
+    disk_manager->create_file(filename);
+    int fd = disk_manager->open_file(filename);
+    disk_manager->write_page(fd, RM_FILE_HDR_PAGE, (char *) old_hdr, sizeof(old_hdr));
+    disk_manager->close_file(fd);
+
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    char buf[64];
+    auto file_handle = rm_manager->open_file(filename);
+    EXPECT_EQ(file_handle->file_hdr_.format, RM_FORMAT_FIXED);
+    for (int i = 0; i < records_per_page + 1; i++) {
+        rand_buf(64, buf);
+        Rid rid = file_handle->insert_record(buf, nullptr);
+        mock[rid] = std::string(buf, 64);
+    }
+    rm_manager->close_file(file_handle.get());
+
+    file_handle = rm_manager->open_file(filename);
+    EXPECT_EQ(file_handle->file_hdr_.num_pages, 3);
+    check_equal(file_handle.get(), mock);
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(RecordManagerTest, UncleanShutdownFreePagesTest) {
+    std::string filename = "unclean_shutdown.txt";
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    char buf[64];
+    {
+        auto disk_manager = std::make_unique<DiskManager>();
+        auto buffer_pool_manager = std::make_unique<BufferPoolManager>(MAX_PAGES, disk_manager.get());
+        auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+        if (disk_manager->is_file(filename)) {
+            disk_manager->destroy_file(filename);
+        }
+        rm_manager->create_file(filename, 64);
+        auto file_handle = rm_manager->open_file(filename);
+
+        // 写满4个数据页面，清空第2页后整理，第2页被释放
+        int records_per_page = file_handle->file_hdr_.num_records_per_page;
+        for (int i = 0; i < records_per_page * 4; i++) {
+            rand_buf(64, buf);
+            Rid rid = file_handle->insert_record(buf, nullptr);
+            mock[rid] = std::string(buf, 64);
+        }
+        for (int slot_no = 0; slot_no < records_per_page; slot_no++) {
+            Rid rid{.page_no = 2, .slot_no = slot_no};
+            file_handle->delete_record(rid, nullptr);
+            mock.erase(rid);
+        }
+        EXPECT_EQ(file_handle->vacuum(), 1);
+        rm_manager->close_file(file_handle.get());
+
+        // 正常打开后复用第2页，数据页写回磁盘，但没有正常关闭文件
+        file_handle = rm_manager->open_file(filename);
+        ASSERT_TRUE(disk_manager->is_free_page(file_handle->GetFd(), 2));
+        for (int i = 0; i < records_per_page; i++) {
+            rand_buf(64, buf);
+            Rid rid = file_handle->insert_record(buf, nullptr);
+            ASSERT_EQ(rid.page_no, 2);
+            mock[rid] = std::string(buf, 64);
+        }
+        buffer_pool_manager->flush_all_pages(file_handle->GetFd());
+    }
+
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(MAX_PAGES, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    // 文件头中过时的空闲页面链表被忽略，已经复用的第2页不再是空闲页面
+    auto file_handle = rm_manager->open_file(filename);
+    int fd = file_handle->GetFd();
+    EXPECT_FALSE(disk_manager->is_free_page(fd, 2));
+    check_equal(file_handle.get(), mock);
+
+    // 重做页面分配时只分配记录所在的页面及其之前新扩展的页面
+    Rid rid{.page_no = 7, .slot_no = 0};
+    file_handle->allocpage(rid);
+    EXPECT_EQ(file_handle->file_hdr_.num_pages, 8);
+    for (int page_no = 5; page_no < 8; page_no++) {
+        EXPECT_FALSE(disk_manager->is_free_page(fd, page_no));
+    }
+    rand_buf(64, buf);
+    file_handle->insert_record(rid, buf);
+    mock[rid] = std::string(buf, 64);
+    check_equal(file_handle.get(), mock);
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(RecordManagerTest, RecordViewTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(MAX_PAGES, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    std::string filename = "view.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    rm_manager->create_file(filename, 32);
+    auto file_handle = rm_manager->open_file(filename);
+
+    std::vector<std::pair<Rid, std::string>> records;
+    char buf[32];
+    for (int i = 0; i < file_handle->file_hdr_.num_records_per_page + 1; i++) {
+        rand_buf(32, buf);
+        records.emplace_back(file_handle->insert_record(buf, nullptr), std::string(buf, 32));
+    }
+    PageId first_page = {.fd = file_handle->GetFd(), .page_no = records.front().first.page_no};
+
+    {
+        // 视图直接指向页面中的记录，同一页面中的记录复用对页面的固定
+        RmRecordView view;
+        for (auto &[rid, data] : records) {
+            file_handle->get_record_view(rid, view);
+            ASSERT_TRUE(view.is_valid());
+            EXPECT_EQ(view.size(), 32);
+            EXPECT_EQ(memcmp(view.data(), data.c_str(), 32), 0);
+            if (rid.page_no == first_page.page_no) {
+                EXPECT_FALSE(buffer_pool_manager->delete_page(first_page));
+            }
+        }
+        // 视图移动到下一个页面后，原页面不再被固定
+        EXPECT_NE(records.back().first.page_no, first_page.page_no);
+        EXPECT_TRUE(buffer_pool_manager->delete_page(first_page));
+
+        // 复制出的记录在视图释放后仍然有效
+        auto record = view.to_record();
+        view.release();
+        EXPECT_FALSE(view.is_valid());
+        EXPECT_EQ(memcmp(record->data, records.back().second.c_str(), 32), 0);
+    }
+
+    // 不存在的记录抛出异常，且不会残留对页面的固定
+    Rid rid = records.front().first;
+    file_handle->delete_record(rid, nullptr);
+    {
+        RmRecordView view;
+        EXPECT_THROW(file_handle->get_record_view(rid, view), RecordNotFoundError);
+        EXPECT_FALSE(view.is_valid());
+    }
+    EXPECT_TRUE(buffer_pool_manager->delete_page(first_page));
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(RecordManagerTest, SlottedPageTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(MAX_PAGES, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    std::string filename = "slotted.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    // 记录格式：INT, VARCHAR(200), INT
+    constexpr int record_size = 208;
+    rm_manager->create_file(filename, record_size, {RmColRange{4, 200}});
+    auto file_handle = rm_manager->open_file(filename);
+    ASSERT_TRUE(file_handle->is_slotted());
+    EXPECT_GT(file_handle->file_hdr_.num_records_per_page, 10 * RmManager::fixed_records_per_page(record_size));
+
+    auto make_record = [&](int id, int str_len) {
+        std::string rec(record_size, '\0');
+        memcpy(&rec[0], &id, sizeof(int));
+        for (int i = 0; i < str_len; i++) {
+            rec[4 + i] = static_cast<char>('a' + (id + i) % 26);
+        }
+        memcpy(&rec[204], &id, sizeof(int));
+        return rec;
+    };
+
+    // 短字符串的记录在一个页面中放得下，定长格式需要11个页面
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    std::vector<Rid> rids;
+    for (int id = 0; id < 200; id++) {
+        std::string rec = make_record(id, id % 10);
+        Rid rid = file_handle->insert_record(&rec[0], nullptr);
+        mock[rid] = rec;
+        rids.push_back(rid);
+    }
+    EXPECT_EQ(file_handle->file_hdr_.num_pages, 2);
+    check_equal(file_handle.get(), mock);
+
+    // 变长的更新放不下时搬到其他页面，记录的Rid不变，扫描时每条记录只出现一次
+    for (int i = 0; i < 40; i++) {
+        std::string rec = make_record(i, 200);
+        file_handle->update_record(rids[i], &rec[0], nullptr);
+        mock[rids[i]] = rec;
+    }
+    EXPECT_GT(file_handle->file_hdr_.num_pages, 2);
+    check_equal(file_handle.get(), mock);
+
+    // 搬走的记录再次变长、变短
+    for (int i = 0; i < 40; i++) {
+        std::string rec = make_record(i + 1000, i % 2 == 0 ? 150 : 3);
+        file_handle->update_record(rids[i], &rec[0], nullptr);
+        mock[rids[i]] = rec;
+    }
+    check_equal(file_handle.get(), mock);
+
+    // 删除的记录可以在原位置重新插入（回滚）
+    for (int i = 0; i < 200; i += 3) {
+        file_handle->delete_record(rids[i], nullptr);
+        mock.erase(rids[i]);
+    }
+    check_equal(file_handle.get(), mock);
+    for (int i = 0; i < 30; i += 3) {
+        std::string rec = make_record(i + 2000, 120);
+        file_handle->insert_record(rids[i], &rec[0]);
+        mock[rids[i]] = rec;
+    }
+    check_equal(file_handle.get(), mock);
+
+    // 整理之后空间被回收，插入不再需要新页面
+    int num_pages = file_handle->file_hdr_.num_pages;
+    file_handle->vacuum();
+    check_equal(file_handle.get(), mock);
+    for (int id = 3000; id < 3040; id++) {
+        std::string rec = make_record(id, 5);
+        mock[file_handle->insert_record(&rec[0], nullptr)] = rec;
+    }
+    EXPECT_LE(file_handle->file_hdr_.num_pages, num_pages);
+    check_equal(file_handle.get(), mock);
+
+    // 重新打开文件
+    rm_manager->close_file(file_handle.get());
+    file_handle = rm_manager->open_file(filename);
+    check_equal(file_handle.get(), mock);
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(RecordManagerTest, CompressedTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(MAX_PAGES, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    std::string filename = "rm_compressed.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    rm_manager->create_file(filename, 64, {}, true);
+    auto file_handle = rm_manager->open_file(filename);
+
+    // 只有开头几个字节不同的记录，页面写回时压缩存放
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    char buf[64];
+    memset(buf, 'r', sizeof(buf));
+    for (int i = 0; i < 2000; i++) {
+        memcpy(buf, &i, sizeof(int));
+        mock[file_handle->insert_record(buf, nullptr)] = std::string(buf, 64);
+    }
+    int num_pages = file_handle->file_hdr_.num_pages;
+    rm_manager->close_file(file_handle.get());
+    EXPECT_LT(disk_manager->get_file_size(filename), num_pages * PAGE_SIZE / 3);
+
+    // 换一个空的缓冲池，页面从磁盘读出并解压
+    buffer_pool_manager = std::make_unique<BufferPoolManager>(MAX_PAGES, disk_manager.get());
+    rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    file_handle = rm_manager->open_file(filename);
+    check_equal(file_handle.get(), mock);
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(RecordManagerTest, PaxTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(MAX_PAGES, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    std::string filename = "pax.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    // 记录格式：INT, CHAR(7), FLOAT，列存格式与定长格式的页面容量相同
+    constexpr int record_size = 15;
+    rm_manager->create_file(filename, record_size, {}, false,
+                            {RmColRange{0, 4}, RmColRange{4, 7}, RmColRange{11, 4}});
+    auto file_handle = rm_manager->open_file(filename);
+    ASSERT_TRUE(file_handle->is_pax());
+    int num_slots = file_handle->file_hdr_.num_records_per_page;
+    EXPECT_EQ(num_slots, RmManager::fixed_records_per_page(record_size));
+
+    auto make_record = [&](int id) {
+        std::string rec(record_size, '\0');
+        float f = static_cast<float>(id) / 2;
+        memcpy(&rec[0], &id, sizeof(int));
+        for (int i = 0; i < 7; i++) {
+            rec[4 + i] = static_cast<char>('a' + (id + i) % 26);
+        }
+        memcpy(&rec[11], &f, sizeof(float));
+        return rec;
+    };
+
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    std::vector<Rid> rids;
+    for (int id = 0; id < 2 * num_slots; id++) {
+        std::string rec = make_record(id);
+        Rid rid = file_handle->insert_record(&rec[0], nullptr);
+        mock[rid] = rec;
+        rids.push_back(rid);
+    }
+    check_equal(file_handle.get(), mock);
+
+    // 同一字段的值在页面中连续存放
+    RmRecordView view;
+    RmColumnVector column = file_handle->get_column_vector(rids[0].page_no, 11, view);
+    EXPECT_EQ(column.stride, 4);
+    for (int slot_no = 1; slot_no < num_slots; slot_no++) {
+        EXPECT_EQ(column.at(slot_no) - column.at(slot_no - 1), 4);
+        EXPECT_EQ(*reinterpret_cast<const float *>(column.at(slot_no)), static_cast<float>(slot_no) / 2);
+    }
+
+    // 只取出部分字段
+    std::vector<int> col_ids = {2};
+    file_handle->get_record_view(rids[5], view, &col_ids);
+    EXPECT_EQ(memcmp(view.data() + 11, mock[rids[5]].data() + 11, sizeof(float)), 0);
+
+    // 页面级过滤只读取条件所在字段的minipage
+    SlotPredicate pred;
+    pred.type = TYPE_FLOAT;
+    pred.op = SlotFilterOp::LT;
+    pred.offset = 11;
+    pred.float_vals[0] = 10;
+    std::vector<char> mask(file_handle->file_hdr_.bitmap_size);
+    file_handle->filter_page(rids[0].page_no, {pred}, mask.data(), view);
+    EXPECT_EQ(Bitmap::count(mask.data(), num_slots), 20);
+    view.release();
+
+    // 更新、删除、在原位置重新插入
+    for (int i = 0; i < 2 * num_slots; i += 3) {
+        std::string rec = make_record(i + 10000);
+        file_handle->update_record(rids[i], &rec[0], nullptr);
+        mock[rids[i]] = rec;
+    }
+    for (int i = 1; i < 2 * num_slots; i += 3) {
+        file_handle->delete_record(rids[i], nullptr);
+        mock.erase(rids[i]);
+    }
+    check_equal(file_handle.get(), mock);
+    for (int i = 1; i < 30; i += 3) {
+        std::string rec = make_record(i + 20000);
+        file_handle->insert_record(rids[i], &rec[0]);
+        mock[rids[i]] = rec;
+    }
+    check_equal(file_handle.get(), mock);
+
+    // 重新打开文件
+    rm_manager->close_file(file_handle.get());
+    file_handle = rm_manager->open_file(filename);
+    check_equal(file_handle.get(), mock);
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(RecordManagerTest, ZoneMapTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(MAX_PAGES, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    std::string filename = "zone_map.txt";
+    if (disk_manager->is_file(filename)) {
+        rm_manager->destroy_file(filename);
+    }
+    // 记录格式：INT, FLOAT, CHAR(56)
+    constexpr int record_size = 64;
+    rm_manager->create_file(filename, record_size);
+    rm_manager->create_zone_map(filename, {RmZoneCol{0, TYPE_INT}, RmZoneCol{4, TYPE_FLOAT}});
+    auto file_handle = rm_manager->open_file(filename);
+    int num_slots = file_handle->file_hdr_.num_records_per_page;
+
+    // 按id递增插入，每个页面中的id是连续的一段
+    std::vector<Rid> rids;
+    for (int id = 0; id < 4 * num_slots; id++) {
+        std::string rec(record_size, '\0');
+        float f = static_cast<float>(id);
+        memcpy(&rec[0], &id, sizeof(int));
+        memcpy(&rec[4], &f, sizeof(float));
+        rids.push_back(file_handle->insert_record(&rec[0], nullptr));
+    }
+    auto make_pred = [](SlotFilterOp op, int val) {
+        SlotPredicate pred;
+        pred.op = op;
+        pred.num_vals = 1;
+        pred.int_vals[0] = val;
+        pred.float_vals[0] = static_cast<float>(val);
+        return pred;
+    };
+    auto count_scanned = [&](const std::vector<SlotPredicate> &preds) {
+        int num_pages = 0;
+        for (int page_no = RM_FIRST_RECORD_PAGE; page_no < file_handle->file_hdr_.num_pages; page_no++) {
+            num_pages += file_handle->page_may_match(page_no, preds);
+        }
+        return num_pages;
+    };
+    std::vector<SlotPredicate> lt = {make_pred(SlotFilterOp::LT, 10)};
+    std::vector<SlotPredicate> ge = {make_pred(SlotFilterOp::GE, 3 * num_slots)};
+    EXPECT_EQ(count_scanned(lt), 1);
+    EXPECT_EQ(count_scanned(ge), 1);
+    EXPECT_EQ(count_scanned({make_pred(SlotFilterOp::EQ, 4 * num_slots)}), 0);
+    // FLOAT字段，以及INT字段与浮点数常量比较
+    SlotPredicate float_pred = make_pred(SlotFilterOp::LT, 10);
+    float_pred.offset = 4;
+    float_pred.type = TYPE_FLOAT;
+    EXPECT_EQ(count_scanned({float_pred}), 1);
+    SlotPredicate as_float = make_pred(SlotFilterOp::GT, 4 * num_slots - 2);
+    as_float.int_as_float = true;
+    EXPECT_EQ(count_scanned({as_float}), 1);
+
+    // 跳过的页面中的记录不会被扫描到
+    int num_records = 0;
+    for (RmScan scan(file_handle.get(), &ge); !scan.is_end(); scan.next()) {
+        EXPECT_EQ(scan.rid().page_no, rids.back().page_no);
+        num_records++;
+    }
+    EXPECT_EQ(num_records, num_slots);
+
+    // 更新扩大页面的取值范围
+    std::string rec(record_size, '\0');
+    int big = 1 << 20;
+    memcpy(&rec[0], &big, sizeof(int));
+    file_handle->update_record(rids[0], &rec[0], nullptr);
+    EXPECT_EQ(count_scanned(ge), 2);
+
+    // 删除之后整理文件时按剩下的记录重新计算
+    file_handle->delete_record(rids[0], nullptr);
+    EXPECT_EQ(count_scanned(ge), 2);
+    file_handle->vacuum();
+    EXPECT_EQ(count_scanned(ge), 1);
+
+    // 正常关闭之后重新打开
+    rm_manager->close_file(file_handle.get());
+    file_handle = rm_manager->open_file(filename);
+    EXPECT_EQ(count_scanned(lt), 1);
+    EXPECT_EQ(count_scanned(ge), 1);
+
+    // 没有正常关闭时（dirty标记仍在），打开时扫描数据文件重新计算
+    rm_manager->close_file(file_handle.get());
+    RmZoneMap zone_map;
+    EXPECT_TRUE(zone_map.load(filename + ZONE_MAP_SUFFIX));
+    EXPECT_FALSE(zone_map.load(filename + ZONE_MAP_SUFFIX));
+    file_handle = rm_manager->open_file(filename);
+    EXPECT_EQ(count_scanned(lt), 1);
+    EXPECT_EQ(count_scanned(ge), 1);
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+    EXPECT_FALSE(disk_manager->is_file(filename + ZONE_MAP_SUFFIX));
+}
+
+TEST(RecordManagerTest, FreeSpaceMapTest) {
+    // 空闲空间索引：优先使用本线程上次使用的页面，其次是较满的页面，取出的页面归还前不会再被取出
+    RmFreeSpaceMap fsm;
+    fsm.reset(100);
+    fsm.release(5, 80);
+    fsm.release(6, 10);
+    fsm.release(7, 50);
+    EXPECT_EQ(fsm.num_pages(), 3);
+    EXPECT_EQ(fsm.acquire(20), 7);
+    EXPECT_EQ(fsm.acquire(20), 5);
+    EXPECT_EQ(fsm.acquire(20), RM_NO_PAGE);
+    EXPECT_EQ(fsm.acquire(5, 6), RM_NO_PAGE);
+    EXPECT_EQ(fsm.acquire(5), 6);
+    fsm.release(7, 0);
+    fsm.release(5, 60);
+    EXPECT_EQ(fsm.num_pages(), 1);
+    EXPECT_EQ(fsm.acquire(60), 5);
+
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(MAX_PAGES, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    std::string filename = "free_space_map.txt";
+    if (disk_manager->is_file(filename)) {
+        rm_manager->destroy_file(filename);
+    }
+    rm_manager->create_file(filename, 64);
+    auto file_handle = rm_manager->open_file(filename);
+    int records_per_page = file_handle->file_hdr_.num_records_per_page;
+
+    // 多个线程并发插入，每个线程写自己的页面，记录不会互相覆盖
+    constexpr int num_threads = 4;
+    int per_thread = records_per_page * 3 + 7;
+    std::vector<std::vector<std::pair<Rid, std::string>>> inserted(num_threads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t]() {
+            char buf[64];
+            for (int i = 0; i < per_thread; i++) {
+                rand_buf(64, buf);
+                Rid rid = file_handle->insert_record(buf, nullptr);
+                inserted[t].emplace_back(rid, std::string(buf, 64));
+            }
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    for (const auto &records: inserted) {
+        for (const auto &[rid, rec]: records) {
+            EXPECT_TRUE(mock.emplace(rid, rec).second);
+        }
+    }
+    ASSERT_EQ(static_cast<int>(mock.size()), num_threads * per_thread);
+    check_equal(file_handle.get(), mock);
+    // 每个线程最多留下一个未满的页面
+    int min_pages = (num_threads * per_thread + records_per_page - 1) / records_per_page;
+    EXPECT_LE(file_handle->file_hdr_.num_pages - RM_FIRST_RECORD_PAGE, min_pages + num_threads);
+
+    // 重新打开后扫描页面重建索引，未满的页面被继续使用
+    rm_manager->close_file(file_handle.get());
+    file_handle = rm_manager->open_file(filename);
+    int num_pages = file_handle->file_hdr_.num_pages;
+    int num_free = num_pages * records_per_page - RM_FIRST_RECORD_PAGE * records_per_page - num_threads * per_thread;
+    char buf[64];
+    for (int i = 0; i < num_free; i++) {
+        rand_buf(64, buf);
+        mock[file_handle->insert_record(buf, nullptr)] = std::string(buf, 64);
+    }
+    EXPECT_EQ(file_handle->file_hdr_.num_pages, num_pages);
+    check_equal(file_handle.get(), mock);
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(RecordManagerTest, DeletedSlotReuseTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(MAX_PAGES, disk_manager.get());
+    auto log_manager = std::make_unique<LogManager>(disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    std::string filename = "deleted_slot.txt";
+    if (disk_manager->is_file(filename)) {
+        rm_manager->destroy_file(filename);
+    }
+    if (disk_manager->is_file(LOG_FILE_NAME)) {
+        disk_manager->destroy_file(LOG_FILE_NAME);
+    }
+    disk_manager->create_file(LOG_FILE_NAME);
+    rm_manager->create_file(filename, 64);
+    auto file_handle = rm_manager->open_file(filename);
+    int records_per_page = file_handle->file_hdr_.num_records_per_page;
+
+    // 写满第1页
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    char buf[64];
+    for (int i = 0; i < records_per_page; i++) {
+        rand_buf(64, buf);
+        mock[file_handle->insert_record(buf, nullptr)] = std::string(buf, 64);
+    }
+
+    // 事务删除两条记录，提交之前这两个位置不会分配给新记录
+    Transaction txn(1);
+    Context context(nullptr, log_manager.get(), &txn, nullptr);
+    Rid committed{.page_no = 1, .slot_no = 5};
+    Rid aborted{.page_no = 1, .slot_no = 2};
+    std::string aborted_rec = mock[aborted];
+    for (Rid rid : {committed, aborted}) {
+        file_handle->delete_record(rid, &context);
+        mock.erase(rid);
+    }
+    rand_buf(64, buf);
+    Rid rid = file_handle->insert_record(buf, nullptr);
+    EXPECT_EQ(rid.page_no, 2);
+    mock[rid] = std::string(buf, 64);
+
+    // 删除提交后位置立即可以复用，未提交的删除仍然可以在原位置回滚
+    file_handle->release_deleted_slot(committed);
+    rand_buf(64, buf);
+    rid = file_handle->insert_record(buf, nullptr);
+    EXPECT_EQ(rid, committed);
+    mock[rid] = std::string(buf, 64);
+    rand_buf(64, buf);
+    rid = file_handle->insert_record(buf, nullptr);
+    EXPECT_EQ(rid.page_no, 2);
+    mock[rid] = std::string(buf, 64);
+    file_handle->insert_record(aborted, aborted_rec.data(), &context, true);
+    mock[aborted] = aborted_rec;
+    check_equal(file_handle.get(), mock);
+
+    // 回滚后页面重新写满
+    RmPageHandle page_hdl = file_handle->fetch_page_handle(1);
+    EXPECT_EQ(page_hdl.page_hdr->num_records, records_per_page);
+    EXPECT_EQ(*page_hdl.deleted, 0);
+    buffer_pool_manager->unpin_page(page_hdl.page->get_page_id(), false);
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(RecordBatchTest, FilterTest) {
+    const size_t tuple_len = sizeof(int) * 2;
+    RecordBatch batch(tuple_len, 16);
+    for (int i = 0; i < 16; i++) {
+        int row[2] = {i, i * 10};
+        batch.append_row(reinterpret_cast<const char *>(row));
+    }
+    EXPECT_TRUE(batch.is_full());
+    ASSERT_EQ(batch.size(), 16);
+
+    // 过滤只修改选择向量，可以连续过滤
+    auto col0 = [](const char *row) { return *reinterpret_cast<const int *>(row); };
+    batch.filter([&](const char *row) { return col0(row) % 2 == 0; });
+    ASSERT_EQ(batch.size(), 8);
+    batch.filter([&](const char *row) { return col0(row) >= 6; });
+    ASSERT_EQ(batch.size(), 5);
+    for (size_t i = 0; i < batch.size(); i++) {
+        EXPECT_EQ(col0(batch.row(i)), 6 + 2 * static_cast<int>(i));
+    }
+    auto record = batch.to_record(1);
+    EXPECT_EQ(record->size, static_cast<int>(tuple_len));
+    EXPECT_EQ(*reinterpret_cast<int *>(record->data + sizeof(int)), 80);
+
+    // 重置后选择向量失效，缓冲区按新的记录长度复用
+    batch.reset(sizeof(int), 4);
+    EXPECT_TRUE(batch.empty());
+    int value = 42;
+    batch.append_row(reinterpret_cast<const char *>(&value));
+    ASSERT_EQ(batch.size(), 1);
+    EXPECT_EQ(col0(batch.row(0)), 42);
+    batch.filter([](const char *) { return false; });
+    EXPECT_TRUE(batch.empty());
+    EXPECT_EQ(batch.num_rows(), 1);
+}
+
+TEST(CompiledPredicateTest, EvalTest) {
+    // 记录格式: a INT, b FLOAT, c CHAR(8)
+    std::vector<ColMeta> cols = {{"t", "a", TYPE_INT, 4, 0, false},
+                                 {"t", "b", TYPE_FLOAT, 4, 4, false},
+                                 {"t", "c", TYPE_STRING, 8, 8, false}};
+    auto make_record = [](int a, float b, const char *c) {
+        std::vector<char> record(16, 0);
+        memcpy(record.data(), &a, sizeof(int));
+        memcpy(record.data() + 4, &b, sizeof(float));
+        memcpy(record.data() + 8, c, strlen(c));
+        return record;
+    };
+    auto col_val = [](const std::string &col, CompOp op, Value val) {
+        Condition cond;
+        cond.lhs_col = {"t", col};
+        cond.op = op;
+        cond.is_rhs_val = true;
+        cond.is_rhs_in = false;
+        cond.rhs_val = std::move(val);
+        return cond;
+    };
+    Value int_val, float_val, str_val;
+    int_val.set_int(3);
+    float_val.set_float(2.5f);
+    str_val.set_str("bcd");
+
+    auto r1 = make_record(5, 2.5f, "bcd");
+    auto r2 = make_record(2, 7.0f, "abcdefgh");
+    auto r3 = make_record(3, 3.0f, "bc");
+
+    // 列与常量比较，包括整数列与浮点常量、不以'\0'结尾的定长字符串
+    CompiledPredicate gt(cols, {col_val("a", OP_GT, int_val)});
+    EXPECT_TRUE(gt(r1.data()));
+    EXPECT_FALSE(gt(r2.data()));
+    EXPECT_FALSE(gt(r3.data()));
+    CompiledPredicate mixed(cols, {col_val("a", OP_GE, float_val), col_val("c", OP_LE, str_val)});
+    EXPECT_TRUE(mixed(r1.data()));
+    EXPECT_FALSE(mixed(r2.data()));
+    EXPECT_TRUE(mixed(r3.data()));
+
+    // 同一条记录中两列比较
+    Condition col_col;
+    col_col.lhs_col = {"t", "b"};
+    col_col.op = OP_LT;
+    col_col.is_rhs_val = false;
+    col_col.is_rhs_in = false;
+    col_col.rhs_col = {"t", "a"};
+    CompiledPredicate lt(cols, {col_col});
+    EXPECT_TRUE(lt(r1.data()));
+    EXPECT_FALSE(lt(r2.data()));
+    EXPECT_FALSE(lt(r3.data()));
+
+    // IN列表，复制后哈希集合仍然有效
+    Condition in_str = col_val("c", OP_IN, Value());
+    in_str.is_rhs_val = false;
+    in_str.is_rhs_in = true;
+    for (const char *str : {"bc", "abcdefgh", "zz"}) {
+        Value val;
+        val.set_str(str);
+        in_str.rhs_in_vals.push_back(val);
+    }
+    Condition in_num = in_str;
+    in_num.lhs_col = {"t", "a"};
+    in_num.rhs_in_vals.clear();
+    in_num.rhs_in_vals.push_back(int_val);
+    Value five;
+    five.set_float(5.0f);
+    in_num.rhs_in_vals.push_back(five);
+    CompiledPredicate in_pred;
+    {
+        CompiledPredicate tmp(cols, {in_str, in_num});
+        in_pred = tmp;
+    }
+    EXPECT_FALSE(in_pred(r1.data()));
+    EXPECT_FALSE(in_pred(r2.data()));
+    EXPECT_TRUE(in_pred(r3.data()));
+
+    // 批量过滤
+    RecordBatch batch(16, 4);
+    batch.append_row(r1.data());
+    batch.append_row(r2.data());
+    batch.append_row(r3.data());
+    mixed.filter(batch);
+    ASSERT_EQ(batch.size(), 2);
+    EXPECT_EQ(batch.row(1)[8], 'b');
+
+    // 类型不兼容时在判断时抛出异常
+    CompiledPredicate bad(cols, {col_val("c", OP_EQ, int_val)});
+    EXPECT_THROW(bad(r1.data()), IncompatibleTypeError);
+    EXPECT_THROW(CompiledPredicate(cols, {col_val("d", OP_EQ, int_val)}), ColumnNotFoundError);
+}
+
+TEST(SlotFilterTest, KernelTest) {
+    // 记录格式: a INT, b FLOAT, 填充到12字节；slot个数不是8的倍数，覆盖尾部逐条判断的情况
+    const int record_size = 12;
+    const int num_slots = 203;
+    const int bitmap_size = (num_slots + 7) / 8;
+    std::mt19937 rng(20231018);
+    std::vector<char> slots(record_size * num_slots);
+    std::vector<char> bitmap(bitmap_size, 0);
+    for (int i = 0; i < num_slots; i++) {
+        int a = static_cast<int>(rng() % 41) - 20;
+        float b = static_cast<float>(a) / 4;
+        memcpy(slots.data() + i * record_size, &a, sizeof(int));
+        memcpy(slots.data() + i * record_size + 4, &b, sizeof(float));
+        if (rng() % 4 != 0) {
+            Bitmap::set(bitmap.data(), i);
+        }
+    }
+
+    auto make_pred = [](ColType type, SlotFilterOp op, std::vector<float> vals, bool int_as_float = false) {
+        SlotPredicate pred;
+        pred.type = type;
+        pred.int_as_float = int_as_float;
+        pred.op = op;
+        pred.offset = type == TYPE_INT ? 0 : 4;
+        pred.num_vals = static_cast<int>(vals.size());
+        for (size_t i = 0; i < vals.size(); i++) {
+            pred.int_vals[i] = static_cast<int>(vals[i]);
+            pred.float_vals[i] = vals[i];
+        }
+        return pred;
+    };
+    auto expect = [&](const SlotPredicate &pred, int slot_no) {
+        float val;
+        if (pred.type == TYPE_INT) {
+            int tmp;
+            memcpy(&tmp, slots.data() + slot_no * record_size, sizeof(int));
+            val = static_cast<float>(tmp);  // 测试数据的范围很小，转换为float没有误差
+        } else {
+            memcpy(&val, slots.data() + slot_no * record_size + 4, sizeof(float));
+        }
+        const float *c = pred.int_as_float || pred.type == TYPE_FLOAT ? pred.float_vals : nullptr;
+        float c0 = c ? c[0] : static_cast<float>(pred.int_vals[0]);
+        float c1 = c ? c[1] : static_cast<float>(pred.int_vals[1]);
+        switch (pred.op) {
+            case SlotFilterOp::EQ: return val == c0;
+            case SlotFilterOp::NE: return val != c0;
+            case SlotFilterOp::LT: return val < c0;
+            case SlotFilterOp::GT: return val > c0;
+            case SlotFilterOp::LE: return val <= c0;
+            case SlotFilterOp::GE: return val >= c0;
+            case SlotFilterOp::BETWEEN: return val >= c0 && val <= c1;
+            case SlotFilterOp::IN:
+                for (int i = 0; i < pred.num_vals; i++) {
+                    if (val == (c ? c[i] : static_cast<float>(pred.int_vals[i]))) {
+                        return true;
+                    }
+                }
+                return false;
+        }
+        return false;
+    };
+
+    std::vector<SlotPredicate> preds = {
+        make_pred(TYPE_INT, SlotFilterOp::EQ, {3}),
+        make_pred(TYPE_INT, SlotFilterOp::NE, {3}),
+        make_pred(TYPE_INT, SlotFilterOp::LT, {-5}),
+        make_pred(TYPE_INT, SlotFilterOp::GT, {7}),
+        make_pred(TYPE_INT, SlotFilterOp::LE, {0}),
+        make_pred(TYPE_INT, SlotFilterOp::GE, {0}),
+        make_pred(TYPE_INT, SlotFilterOp::BETWEEN, {-3, 4}),
+        make_pred(TYPE_INT, SlotFilterOp::IN, {-20, 1, 5, 19, 20}),
+        make_pred(TYPE_INT, SlotFilterOp::LT, {2.5f}, true),
+        make_pred(TYPE_FLOAT, SlotFilterOp::EQ, {1.25f}),
+        make_pred(TYPE_FLOAT, SlotFilterOp::GT, {-0.5f}),
+        make_pred(TYPE_FLOAT, SlotFilterOp::BETWEEN, {-1.0f, 2.75f}),
+        make_pred(TYPE_FLOAT, SlotFilterOp::IN, {0.25f, -5.0f, 3.0f}),
+    };
+    for (const auto &pred : preds) {
+        std::vector<char> scalar_mask = bitmap;
+        SlotFilter::filter_scalar(pred, slots.data(), record_size, num_slots, scalar_mask.data());
+        for (int i = 0; i < num_slots; i++) {
+            bool expected = Bitmap::is_set(bitmap.data(), i) && expect(pred, i);
+            ASSERT_EQ(Bitmap::is_set(scalar_mask.data(), i), expected) << "op " << static_cast<int>(pred.op) << " slot " << i;
+        }
+        // AVX2与逐条判断的结果必须完全相同
+        std::vector<char> mask = bitmap;
+        SlotFilter::filter(pred, slots.data(), record_size, num_slots, mask.data());
+        EXPECT_EQ(mask, scalar_mask);
+        if (SlotFilter::has_avx2()) {
+            std::vector<char> avx2_mask = bitmap;
+            SlotFilter::filter_avx2(pred, slots.data(), record_size, num_slots, avx2_mask.data());
+            EXPECT_EQ(avx2_mask, scalar_mask);
+        }
+    }
+
+    // 同一列上的>=和<=合并成BETWEEN，字符串条件留给逐条判断
+    std::vector<ColMeta> cols = {{"t", "a", TYPE_INT, 4, 0, false},
+                                 {"t", "b", TYPE_FLOAT, 4, 4, false},
+                                 {"t", "c", TYPE_STRING, 4, 8, false}};
+    auto make_cond = [](const std::string &col, CompOp op, Value val) {
+        Condition cond;
+        cond.lhs_col = {"t", col};
+        cond.op = op;
+        cond.is_rhs_val = true;
+        cond.is_rhs_in = false;
+        cond.rhs_val = std::move(val);
+        return cond;
+    };
+    Value lo, hi, str;
+    lo.set_int(-3);
+    hi.set_int(4);
+    str.set_str("x");
+    CompiledPredicate predicate(cols, {make_cond("a", OP_GE, lo), make_cond("c", OP_EQ, str),
+                                       make_cond("a", OP_LE, hi), make_cond("b", OP_GT, lo)});
+    std::vector<SlotPredicate> slot_preds;
+    CompiledPredicate residual;
+    predicate.split(slot_preds, residual);
+    ASSERT_EQ(slot_preds.size(), 2);
+    EXPECT_EQ(slot_preds[0].op, SlotFilterOp::BETWEEN);
+    EXPECT_EQ(slot_preds[0].int_vals[0], -3);
+    EXPECT_EQ(slot_preds[0].int_vals[1], 4);
+    EXPECT_EQ(slot_preds[1].type, TYPE_FLOAT);
+    EXPECT_FLOAT_EQ(slot_preds[1].float_vals[0], -3.0f);
+    EXPECT_FALSE(residual.empty());
+
+    // <=在前、>=在后时合并结果相同，原有的上界不能被下界覆盖
+    Value float_lo, float_hi;
+    float_lo.set_float(-1.5f);
+    float_hi.set_float(2.75f);
+    CompiledPredicate reversed(cols, {make_cond("a", OP_LE, hi), make_cond("b", OP_LE, float_hi),
+                                      make_cond("a", OP_GE, lo), make_cond("b", OP_GE, float_lo)});
+    reversed.split(slot_preds, residual);
+    ASSERT_EQ(slot_preds.size(), 2);
+    EXPECT_EQ(slot_preds[0].op, SlotFilterOp::BETWEEN);
+    EXPECT_EQ(slot_preds[0].int_vals[0], -3);
+    EXPECT_EQ(slot_preds[0].int_vals[1], 4);
+    EXPECT_EQ(slot_preds[1].op, SlotFilterOp::BETWEEN);
+    EXPECT_FLOAT_EQ(slot_preds[1].float_vals[0], -1.5f);
+    EXPECT_FLOAT_EQ(slot_preds[1].float_vals[1], 2.75f);
+    EXPECT_TRUE(residual.empty());
+}
+
+TEST(SlotFilterTest, RangeScanTest) {
+    // 与SeqScanExecutor相同，用split得到的条件跳过页面并按页面过滤，结果应当恰好是范围内的记录
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(MAX_PAGES, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    std::string filename = "range_scan.txt";
+    if (disk_manager->is_file(filename)) {
+        rm_manager->destroy_file(filename);
+    }
+    constexpr int record_size = 8;
+    rm_manager->create_file(filename, record_size);
+    rm_manager->create_zone_map(filename, {RmZoneCol{0, TYPE_INT}});
+    auto file_handle = rm_manager->open_file(filename);
+    int num_records = 3 * file_handle->file_hdr_.num_records_per_page;
+    for (int id = 0; id < num_records; id++) {
+        char rec[record_size] = {};
+        memcpy(rec, &id, sizeof(int));
+        file_handle->insert_record(rec, nullptr);
+    }
+
+    std::vector<ColMeta> cols = {{"t", "a", TYPE_INT, 4, 0, false}, {"t", "b", TYPE_INT, 4, 4, false}};
+    auto make_cond = [](CompOp op, int val) {
+        Condition cond;
+        cond.lhs_col = {"t", "a"};
+        cond.op = op;
+        cond.is_rhs_val = true;
+        cond.is_rhs_in = false;
+        cond.rhs_val.set_int(val);
+        return cond;
+    };
+    // 范围跨越三个页面
+    int lo = num_records / 3 - 5, hi = num_records / 3 * 2 + 5;
+    std::vector<int> expected;
+    for (int id = lo; id <= hi; id++) {
+        expected.push_back(id);
+    }
+    for (bool le_first : {true, false}) {
+        std::vector<Condition> conds = {make_cond(OP_GE, lo), make_cond(OP_LE, hi)};
+        if (le_first) {
+            std::swap(conds[0], conds[1]);
+        }
+        CompiledPredicate predicate(cols, conds);
+        std::vector<SlotPredicate> preds;
+        CompiledPredicate residual;
+        predicate.split(preds, residual);
+        ASSERT_EQ(preds.size(), 1);
+        ASSERT_TRUE(residual.empty());
+
+        // 按页面过滤
+        RmFileHdr file_hdr = file_handle->get_file_hdr();
+        std::vector<char> mask(file_hdr.bitmap_size);
+        RmRecordView view;
+        std::vector<int> scanned;
+        for (int page_no = RM_FIRST_RECORD_PAGE; page_no < file_hdr.num_pages; page_no++) {
+            if (!file_handle->page_may_match(page_no, preds)) {
+                continue;
+            }
+            file_handle->filter_page(page_no, preds, mask.data(), view);
+            for (int slot_no = 0; slot_no < file_hdr.num_records_per_page; slot_no++) {
+                if (Bitmap::is_set(mask.data(), slot_no)) {
+                    file_handle->get_record_view(Rid{page_no, slot_no}, view);
+                    scanned.push_back(*reinterpret_cast<const int *>(view.data()));
+                }
+            }
+        }
+        view.release();
+        EXPECT_EQ(scanned, expected) << le_first;
+
+        // 逐条扫描，区域映射跳过的页面中不能有满足条件的记录
+        scanned.clear();
+        for (RmScan scan(file_handle.get(), &preds); !scan.is_end(); scan.next()) {
+            auto rec = file_handle->get_record(scan.rid(), nullptr);
+            if (predicate(rec->data)) {
+                scanned.push_back(*reinterpret_cast<const int *>(rec->data));
+            }
+        }
+        EXPECT_EQ(scanned, expected) << le_first;
+    }
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(BitmapTest, WordScanTest) {
+    // 逐位查找的参考实现，找为0的位时跳过前is_deleted个为0的位
+    auto next_bit_ref = [](bool bit, const char *bm, int max_n, int curr, int is_deleted) {
+        int num = 0;
+        for (int i = curr + 1; i < max_n; i++) {
+            if (Bitmap::is_set(bm, i) == bit) {
+                if (bit || num == is_deleted) {
+                    return i;
+                }
+                ++num;
+            }
+        }
+        return max_n;
+    };
+
+    std::mt19937 rng(42);
+    for (int max_n : {1, 7, 8, 63, 64, 65, 126, 200, 509}) {
+        for (int density : {0, 1, 50, 99, 100}) {
+            int size = (max_n + BITMAP_WIDTH - 1) / BITMAP_WIDTH;
+            // 位图后面的字节填充为1，检查不会读到max_n之后的位
+            std::vector<char> buf(size + 8, static_cast<char>(0xff));
+            Bitmap::init(buf.data(), size);
+            std::vector<int> expected;
+            for (int i = 0; i < max_n; i++) {
+                if (static_cast<int>(rng() % 100) < density) {
+                    Bitmap::set(buf.data(), i);
+                    expected.push_back(i);
+                }
+            }
+            const char *bm = buf.data();
+            for (int curr = -1; curr < max_n; curr++) {
+                ASSERT_EQ(Bitmap::next_bit(true, bm, max_n, curr, 0), next_bit_ref(true, bm, max_n, curr, 0));
+                for (int is_deleted : {0, 1, 5, 70}) {
+                    ASSERT_EQ(Bitmap::next_bit(false, bm, max_n, curr, is_deleted),
+                              next_bit_ref(false, bm, max_n, curr, is_deleted))
+                        << "max_n " << max_n << " curr " << curr << " is_deleted " << is_deleted;
+                }
+            }
+            std::vector<int> positions(max_n);
+            int num = Bitmap::set_positions(bm, max_n, positions.data());
+            positions.resize(num);
+            EXPECT_EQ(positions, expected);
+            EXPECT_EQ(Bitmap::count(bm, max_n), static_cast<int>(expected.size()));
+            EXPECT_EQ(Bitmap::is_empty(bm, max_n), expected.empty());
+            EXPECT_EQ(Bitmap::is_full(bm, max_n), static_cast<int>(expected.size()) == max_n);
+        }
+    }
+}
+
+TEST(IndexTest, KeyEncodingTest) {
+    // 编码后的键按memcmp比较的结果与ix_compare相同，并且可以还原
+    std::vector<ColType> col_types = {TYPE_INT, TYPE_FLOAT, TYPE_STRING};
+    std::vector<int> col_lens = {4, 4, 4};
+    std::vector<int> ints = {INT_MIN, -100, -1, 0, 1, 7, INT_MAX};
+    std::vector<float> floats = {-1e30f, -2.5f, -0.0f, 0.0f, 1e-30f, 3.0f, 1e30f};
+    std::vector<std::string> strs = {std::string("\0\0\0\0", 4), "a\0\0\0", "ab\0\0", "b\0\0\0", "\xff\0\0\0"};
+    std::vector<std::string> keys;
+    for (int i : ints) {
+        for (float f : floats) {
+            for (const auto &str : strs) {
+                std::string key(12, '\0');
+                memcpy(&key[0], &i, 4);
+                memcpy(&key[4], &f, 4);
+                memcpy(&key[8], str.data(), 4);
+                keys.push_back(key);
+            }
+        }
+    }
+    auto sign = [](int x) { return (x > 0) - (x < 0); };
+    std::vector<std::string> encoded;
+    for (const auto &key : keys) {
+        std::string enc(12, '\0'), dec(12, '\0');
+        ix_encode_key(key.data(), &enc[0], col_types, col_lens);
+        ix_decode_key(enc.data(), &dec[0], col_types, col_lens);
+        // -0.0编码为0.0，其余键原样还原
+        EXPECT_EQ(ix_compare(dec.data(), key.data(), col_types, col_lens), 0);
+        encoded.push_back(enc);
+    }
+    for (size_t a = 0; a < keys.size(); a++) {
+        for (size_t b = 0; b < keys.size(); b++) {
+            ASSERT_EQ(sign(memcmp(encoded[a].data(), encoded[b].data(), 12)),
+                      sign(ix_compare(keys[a].data(), keys[b].data(), col_types, col_lens)));
+        }
+    }
+
+    // B+树中的点查询和范围查找
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(MAX_PAGES, disk_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+    std::vector<ColMeta> cols = {ColMeta{"key_encoding", "a", TYPE_INT, 4, 0, true}};
+    if (ix_manager->exists("key_encoding", cols)) {
+        ix_manager->destroy_index("key_encoding", cols);
+    }
+    ix_manager->create_index("key_encoding", cols);
+    auto ih = ix_manager->open_index("key_encoding", cols);
+    std::vector<int> vals;
+    for (int i = -3000; i < 3000; i += 3) {
+        vals.push_back(i);
+    }
+    std::shuffle(vals.begin(), vals.end(), std::mt19937(0));
+    for (int val : vals) {
+        ih->insert_entry(reinterpret_cast<const char *>(&val), Rid{val, 0}, nullptr);
+    }
+    for (int i = -3005; i < 3005; i++) {
+        std::vector<Rid> result;
+        bool exists = i >= -3000 && i < 3000 && (i + 3000) % 3 == 0;
+        ASSERT_EQ(ih->get_value(reinterpret_cast<const char *>(&i), &result, nullptr), exists) << i;
+        if (exists) {
+            EXPECT_EQ(result[0].page_no, i);
+        }
+    }
+    // [-10, 10]之间的键按顺序扫描
+    int lower = -10, upper = 10;
+    std::vector<int> scanned;
+    for (IxScan scan(ih.get(), ih->lower_bound(reinterpret_cast<const char *>(&lower)),
+                     ih->upper_bound(reinterpret_cast<const char *>(&upper)), nullptr);
+         !scan.is_end(); scan.next()) {
+        scanned.push_back(scan.rid().page_no);
+    }
+    EXPECT_EQ(scanned, (std::vector<int>{-9, -6, -3, 0, 3, 6, 9}));
+
+    ix_manager->close_index(ih.get());
+    ix_manager->destroy_index(ih.get(), "key_encoding", std::vector<std::string>{"a"});
+}
+
+TEST(IndexTest, FileVersionTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(MAX_PAGES, disk_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+    std::vector<ColMeta> cols = {ColMeta{"ix_version", "a", TYPE_INT, 4, 0, true}};
+    if (ix_manager->exists("ix_version", cols)) {
+        ix_manager->destroy_index("ix_version", cols);
+    }
+    ix_manager->create_index("ix_version", cols);
+    EXPECT_TRUE(ix_manager->is_current_version("ix_version", cols));
+
+    // 旧格式的文件头末尾没有版本号
+    std::string ix_name = ix_manager->get_index_name("ix_version", cols);
+    int fd = disk_manager->open_file(ix_name);
+    char buf[PAGE_SIZE];
+    disk_manager->read_page(fd, IX_FILE_HDR_PAGE, buf, PAGE_SIZE);
+    IxFileHdr file_hdr;
+    file_hdr.deserialize(buf);
+    EXPECT_EQ(file_hdr.version_, IX_FILE_VERSION);
+    int old_len = file_hdr.tot_len_ - static_cast<int>(sizeof(int));
+    memcpy(buf, &old_len, sizeof(int));
+    memset(buf + old_len, 0, sizeof(int));
+    disk_manager->write_page(fd, IX_FILE_HDR_PAGE, buf, PAGE_SIZE);
+    disk_manager->close_file(fd);
+    EXPECT_FALSE(ix_manager->is_current_version("ix_version", cols));
+
+    ix_manager->destroy_index("ix_version", cols);
+}
+
+TEST(IndexTest, ConcurrencyTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(MAX_PAGES, disk_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+    std::vector<ColMeta> cols = {ColMeta{"index_concurrency", "a", TYPE_INT, 4, 0, true}};
+    if (ix_manager->exists("index_concurrency", cols)) {
+        ix_manager->destroy_index("index_concurrency", cols);
+    }
+    ix_manager->create_index("index_concurrency", cols);
+    auto ih = ix_manager->open_index("index_concurrency", cols);
+
+    // 多个线程插入互不相交的键，结点不断分裂，同时有线程做点查询；之后并发删除一部分键
+    constexpr int num_threads = 4;
+    constexpr int keys_per_thread = 5000;
+    std::atomic<bool> done{false};
+    std::atomic<int> wrong{0};
+    std::thread reader([&] {
+        std::mt19937 rng(1);
+        while (!done) {
+            int key = static_cast<int>(rng() % (num_threads * keys_per_thread));
+            std::vector<Rid> result;
+            if (ih->get_value(reinterpret_cast<const char *>(&key), &result, nullptr) && result[0].page_no != key) {
+                wrong++;
+            }
+        }
+    });
+    auto run = [&](auto &&func) {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; t++) {
+            threads.emplace_back([&, t] {
+                std::vector<int> keys;
+                for (int i = 0; i < keys_per_thread; i++) {
+                    keys.push_back(i * num_threads + t);
+                }
+                std::shuffle(keys.begin(), keys.end(), std::mt19937(t));
+                for (int key : keys) {
+                    func(key);
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    };
+    run([&](int key) { ih->insert_entry(reinterpret_cast<const char *>(&key), Rid{key, 0}, nullptr); });
+    run([&](int key) {
+        if (key % 3 == 0) {
+            ASSERT_TRUE(ih->delete_entry(reinterpret_cast<const char *>(&key), nullptr));
+        }
+    });
+    done = true;
+    reader.join();
+    EXPECT_EQ(wrong, 0);
+
+    int total = num_threads * keys_per_thread;
+    for (int key = 0; key < total; key++) {
+        std::vector<Rid> result;
+        ASSERT_EQ(ih->get_value(reinterpret_cast<const char *>(&key), &result, nullptr), key % 3 != 0) << key;
+    }
+    std::vector<int> scanned;
+    for (IxScan scan(ih.get(), ih->leaf_begin(), ih->leaf_end(), nullptr); !scan.is_end(); scan.next()) {
+        scanned.push_back(scan.rid().page_no);
+    }
+    std::vector<int> expected;
+    for (int key = 0; key < total; key++) {
+        if (key % 3 != 0) {
+            expected.push_back(key);
+        }
+    }
+    EXPECT_EQ(scanned, expected);
+
+    ix_manager->close_index(ih.get());
+    ix_manager->destroy_index(ih.get(), "index_concurrency", std::vector<std::string>{"a"});
+}
+
+TEST(IndexTest, BulkLoadTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(MAX_PAGES, disk_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+    std::vector<ColMeta> cols = {ColMeta{"bulk_load", "a", TYPE_INT, 4, 0, true}};
+    auto create = [&] {
+        if (ix_manager->exists("bulk_load", cols)) {
+            ix_manager->destroy_index("bulk_load", cols);
+        }
+        ix_manager->create_index("bulk_load", cols);
+        return ix_manager->open_index("bulk_load", cols);
+    };
+    auto destroy = [&](IxIndexHandle *ih) {
+        ix_manager->close_index(ih);
+        ix_manager->destroy_index(ih, "bulk_load", std::vector<std::string>{"a"});
+    };
+
+    // 排序内存很小，键被写成多个有序段后归并
+    constexpr int num_keys = 20000;
+    std::vector<int> vals;
+    for (int i = 0; i < num_keys; i++) {
+        vals.push_back(i * 2 - num_keys);
+    }
+    std::shuffle(vals.begin(), vals.end(), std::mt19937(0));
+    auto ih = create();
+    {
+        IxBulkLoader loader(ih.get(), 70, 16 << 10);
+        for (int val : vals) {
+            loader.add(reinterpret_cast<const char *>(&val), Rid{val, 0});
+        }
+        loader.finish();
+        EXPECT_GT(loader.num_runs(), 1u);
+    }
+    // 建立之后仍可以插入和删除，插入的键使叶子结点分裂
+    for (int i = 0; i < num_keys; i += 5) {
+        int val = i * 2 - num_keys + 1;
+        ih->insert_entry(reinterpret_cast<const char *>(&val), Rid{val, 0}, nullptr);
+    }
+    for (int i = 0; i < num_keys; i += 7) {
+        int val = i * 2 - num_keys;
+        ASSERT_TRUE(ih->delete_entry(reinterpret_cast<const char *>(&val), nullptr));
+    }
+    std::vector<int> expected;
+    for (int val = -num_keys - 1; val <= num_keys; val++) {
+        int i = (val + num_keys) / 2;
+        bool exists = (val + num_keys) % 2 == 0 ? i % 7 != 0 : i % 5 == 0;
+        if (val < -num_keys || val >= num_keys) {
+            exists = false;
+        }
+        std::vector<Rid> result;
+        ASSERT_EQ(ih->get_value(reinterpret_cast<const char *>(&val), &result, nullptr), exists) << val;
+        if (exists) {
+            expected.push_back(val);
+        }
+    }
+    std::vector<int> scanned;
+    for (IxScan scan(ih.get(), ih->leaf_begin(), ih->leaf_end(), nullptr); !scan.is_end(); scan.next()) {
+        scanned.push_back(scan.rid().page_no);
+    }
+    EXPECT_EQ(scanned, expected);
+    destroy(ih.get());
+
+    // 重复的键
+    ih = create();
+    {
+        IxBulkLoader loader(ih.get());
+        for (int val : {3, 1, 2, 1}) {
+            loader.add(reinterpret_cast<const char *>(&val), Rid{val, 0});
+        }
+        EXPECT_THROW(loader.finish(), InternalError);
+    }
+    destroy(ih.get());
+}
+
+TEST(IndexTest, RedoTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(MAX_PAGES, disk_manager.get());
+    auto log_manager = std::make_unique<LogManager>(disk_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get(), log_manager.get());
+    std::vector<ColMeta> cols = {ColMeta{"ix_redo", "a", TYPE_INT, 4, 0, true}};
+    if (ix_manager->exists("ix_redo", cols)) {
+        ix_manager->destroy_index("ix_redo", cols);
+    }
+    if (disk_manager->is_file(LOG_FILE_NAME)) {
+        disk_manager->destroy_file(LOG_FILE_NAME);
+    }
+    disk_manager->create_file(LOG_FILE_NAME);
+    ix_manager->create_index("ix_redo", cols);
+    auto ih = ix_manager->open_index("ix_redo", cols);
+
+    // 事务中的插入使结点不断分裂，缓冲池放不下所有结点，一部分页面在崩溃前被换出写回
+    constexpr int num_keys = 60000;
+    std::vector<int> vals(num_keys);
+    for (int i = 0; i < num_keys; i++) {
+        vals[i] = i;
+    }
+    std::shuffle(vals.begin(), vals.end(), std::mt19937(0));
+    Transaction txn(1);
+    for (int val : vals) {
+        ih->insert_entry(reinterpret_cast<const char *>(&val), Rid{val, 0}, &txn);
+    }
+    for (int val = 0; val < num_keys; val += 3) {
+        ASSERT_TRUE(ih->delete_entry(reinterpret_cast<const char *>(&val), &txn));
+    }
+
+    // 模拟崩溃：丢弃缓冲池中的脏页和内存中的文件头，重新打开索引
+    int fd = disk_manager->get_file_fd(ix_manager->get_index_name("ix_redo", cols));
+    buffer_pool_manager->delete_all_pages(fd);
+    disk_manager->close_file(fd);
+    ih = ix_manager->open_index("ix_redo", cols);
+
+    int log_size = disk_manager->get_file_size(LOG_FILE_NAME);
+    std::vector<char> log_buf(log_size);
+    disk_manager->read_log(log_buf.data(), log_size, 0);
+    std::vector<std::unique_ptr<IxLogRecord>> records;
+    for (int offset = 0; offset < log_size; offset += records.back()->log_tot_len_) {
+        LogRecord header;
+        header.deserialize(log_buf.data() + offset);
+        if (header.log_type_ == IX_INSERT) {
+            records.push_back(std::make_unique<IxInsertLogRecord>());
+        } else {
+            ASSERT_EQ(header.log_type_, IX_DELETE);
+            records.push_back(std::make_unique<IxDeleteLogRecord>());
+        }
+        records.back()->deserialize(log_buf.data() + offset);
+    }
+    ASSERT_EQ(records.size(), static_cast<size_t>(num_keys + (num_keys + 2) / 3));
+
+    // 崩溃前写回的空闲页面链表可能已经过时，其中的页面被重新分配后仍记为空闲；redo涉及的结点应当从空闲页面中移除
+    fd = disk_manager->get_file_fd(ix_manager->get_index_name("ix_redo", cols));
+    int num_pages = ih->getFileHdr().num_pages_;
+    std::set<page_id_t> stale_pages;
+    for (auto &record : records) {
+        page_id_t page_no = record->leaf_page_no_;
+        if (page_no > 0 && page_no < num_pages && stale_pages.insert(page_no).second) {
+            disk_manager->deallocate_page(fd, page_no);
+        }
+    }
+    ASSERT_FALSE(stale_pages.empty());
+
+    // 重做两遍，第二遍中所有结点的page_lsn都不小于日志的lsn，不会重复修改
+    std::vector<int> expected;
+    for (int val = 0; val < num_keys; val++) {
+        if (val % 3 != 0) {
+            expected.push_back(val);
+        }
+    }
+    for (int round = 0; round < 2; round++) {
+        for (auto &record : records) {
+            ih->redo(record.get());
+        }
+        for (int val = 0; val < num_keys; val++) {
+            std::vector<Rid> result;
+            ASSERT_EQ(ih->get_value(reinterpret_cast<const char *>(&val), &result, nullptr), val % 3 != 0) << val;
+        }
+        std::vector<int> scanned;
+        for (IxScan scan(ih.get(), ih->leaf_begin(), ih->leaf_end(), nullptr); !scan.is_end(); scan.next()) {
+            scanned.push_back(scan.rid().page_no);
+        }
+        EXPECT_EQ(scanned, expected);
+    }
+    for (page_id_t page_no : stale_pages) {
+        EXPECT_FALSE(disk_manager->is_free_page(fd, page_no)) << page_no;
+    }
+
+    // 关闭时写回的file_lsn_覆盖了所有日志记录，重新打开后redo直接跳过
+    ix_manager->close_index(ih.get());
+    ih = ix_manager->open_index("ix_redo", cols);
+    EXPECT_EQ(ih->getFileHdr().file_lsn_, records.back()->lsn_);
+
+    ix_manager->close_index(ih.get());
+    ix_manager->destroy_index(ih.get(), "ix_redo", std::vector<std::string>{"a"});
+    disk_manager->close_file(disk_manager->GetLogFd());
+    disk_manager->destroy_file(LOG_FILE_NAME);
+}
+
+TEST(IndexTest, IndexOnlyScanTest) {
+    // 覆盖索引扫描直接从叶子结点读出键，读出的键与插入时记录中的格式相同
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(MAX_PAGES, disk_manager.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+    std::vector<ColMeta> cols = {ColMeta{"index_only", "a", TYPE_INT, 4, 0, true},
+                                 ColMeta{"index_only", "b", TYPE_FLOAT, 4, 4, true}};
+    if (ix_manager->exists("index_only", cols)) {
+        ix_manager->destroy_index("index_only", cols);
+    }
+    ix_manager->create_index("index_only", cols);
+    auto ih = ix_manager->open_index("index_only", cols);
+
+    std::vector<int> vals;
+    for (int i = -2000; i < 2000; i++) {
+        vals.push_back(i);
+    }
+    std::shuffle(vals.begin(), vals.end(), std::mt19937(0));
+    auto make_key = [](int a) {
+        std::string key(8, '\0');
+        float b = a * 0.5f - 1;
+        memcpy(&key[0], &a, 4);
+        memcpy(&key[4], &b, 4);
+        return key;
+    };
+    for (int val : vals) {
+        ih->insert_entry(make_key(val).data(), Rid{val, 1}, nullptr);
+    }
+    int lower = -100, upper = 100;
+    std::string lower_key = make_key(lower), upper_key = make_key(upper);
+    int expected = lower;
+    char key[8];
+    for (IxScan scan(ih.get(), ih->lower_bound(lower_key.data()), ih->upper_bound(upper_key.data()), nullptr);
+         !scan.is_end(); scan.next()) {
+        Rid rid = scan.entry(key);
+        EXPECT_EQ(rid, (Rid{expected, 1}));
+        EXPECT_EQ(memcmp(key, make_key(expected).data(), 8), 0) << expected;
+        expected++;
+    }
+    EXPECT_EQ(expected, upper + 1);
+
+    ix_manager->close_index(ih.get());
+    ix_manager->destroy_index(ih.get(), "index_only", std::vector<std::string>{"a", "b"});
+}